@@ -48,6 +48,8 @@ option(PAL_BUILD_DBG_OVERLAY "Build PAL Debug Overlay?" ON)
 
 option(PAL_BUILD_GPU_PROFILER "Build PAL GPU Profiler?" ON)
 
+option(PAL_BUILD_CMD_REPLAY "Build the palCmdReplay command capture replay tool?" OFF)
+
 option(PAL_DISPLAY_DCC "Enable DISPLAY DCC?" ON)
 
 option(PAL_BUILD_DRI3 "Build PAL with DRI3 support?" ON)
@@ -1973,6 +1973,17 @@ struct CmdBufferPayload
     uint32               payload[1];    ///< Initial DWORD of payload data with the other data to follow.
 };
 
+/// Describes a region of embedded data allocated by @ref ICmdBuffer::CmdAllocatePatchableData().
+struct PatchableDataInfo
+{
+    uint32* pCpuAddr;    ///< DWORD-aligned CPU address of the region.  Stays mapped until ICmdBuffer::Reset() or
+                         ///  ICmdBuffer::Begin(), like gpuAddr.  The client may write through it while the command
+                         ///  buffer is being built; after ICmdBuffer::End() the region must only be modified through
+                         ///  @ref ICmdBuffer::PatchEmbeddedData().
+    gpusize gpuAddr;     ///< GPU address of the region.  Valid until ICmdBuffer::Reset() or ICmdBuffer::Begin().
+    uint32  patchId;     ///< Identifies the region in calls to @ref ICmdBuffer::PatchEmbeddedData().
+};
+
 /**
  ***********************************************************************************************************************
  * @interface ICmdBuffer
@@ -3773,6 +3784,53 @@ public:
         uint32   alignmentInDwords,
         gpusize* pGpuAddress) = 0;
 
+    /// Allocates a chunk of embedded data like @ref CmdAllocateEmbeddedData(), except that its contents can still be
+    /// rewritten using @ref PatchEmbeddedData() once the command buffer is executable.
+    ///
+    /// This allows a command buffer to be recorded once as a template and then resubmitted many times with different
+    /// parameters, without paying for validation and command generation again.  Anything the recorded commands read
+    /// from this memory can be patched: SRD and constant tables, tables of GPU addresses referenced through a user data
+    /// entry, and so on.  Values which PAL writes directly into the command stream cannot be patched.
+    ///
+    /// Patchable data remains valid when this command buffer is executed as a nested command buffer, so patching it
+    /// also updates every command buffer which has called this one.
+    ///
+    /// @param [in]  sizeInDwords       Size of the embedded data space in DWORDs. It must be less than or equal to the
+    ///                                 value reported by GetEmbeddedDataLimit().
+    /// @param [in]  alignmentInDwords  Minimum GPU address alignment of the embedded space in DWORDs.
+    /// @param [out] pInfo              Receives the CPU address, GPU address and patch ID of the embedded space.
+    ///
+    /// @returns Success if the space was allocated.  Otherwise, one of the following errors may be returned:
+    ///          + ErrorInvalidPointer if pInfo is null.
+    ///          + ErrorIncompleteCommandBuffer if the command buffer is not being built.
+    ///          + ErrorOutOfMemory if the patch ID could not be recorded.
+    virtual Result CmdAllocatePatchableData(
+        uint32             sizeInDwords,
+        uint32             alignmentInDwords,
+        PatchableDataInfo* pInfo) = 0;
+
+    /// Overwrites part of an embedded data region allocated by @ref CmdAllocatePatchableData().  This can be called
+    /// while the command buffer is being built or once it is executable, until the next Reset() or Begin().
+    ///
+    /// @warning The client must guarantee that this command buffer is not queued for execution or currently being
+    ///          executed, and that the same is true for all command buffers that have referenced this command buffer in
+    ///          a @ref CmdExecuteNestedCmdBuffers call.
+    ///
+    /// @param [in] patchId      Patch ID returned in PatchableDataInfo::patchId.
+    /// @param [in] dwordOffset  Offset of the first DWORD to overwrite, relative to the start of the region.
+    /// @param [in] dwordCount   Number of DWORDs to overwrite.
+    /// @param [in] pData        New values for the DWORDs.
+    ///
+    /// @returns Success if the region was patched.  Otherwise, one of the following errors may be returned:
+    ///          + ErrorInvalidPointer if pData is null.
+    ///          + ErrorInvalidValue if patchId doesn't identify a region of this command buffer or if the DWORD range
+    ///            doesn't fit within the region.
+    virtual Result PatchEmbeddedData(
+        uint32        patchId,
+        uint32        dwordOffset,
+        uint32        dwordCount,
+        const uint32* pData) = 0;
+
     /// Get memory from scratch memory and bind to GPU event. For now only GpuEventPool and CmdBuffer's internal
     /// GpuEvent use this path to allocate and bind GPU memory. These usecases assume the bound GPU memory is GPU access
     /// only, so client is responsible for resetting the event from GPU, and cannot call Set(), Reset(), GetStatus().
@@ -494,6 +494,18 @@ enum class HdrDisplayMode : uint32
     FreeSync2 = 3,  ///< FreeSync2 HDR10 Gamma 2.2.  Requires 10:10:10:2 swap chain.
 };
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+/// Controls when PAL creates the internal pipelines used by its resource processing (blit) paths.
+enum class RpmPipelineCreateMode : uint32
+{
+    Immediate  = 0, ///< All internal pipelines are created when the device is finalized (default).
+    OnFirstUse = 1, ///< Internal compute pipelines are created the first time a blit needs them.  This reduces device
+                    ///  initialization time and the GPU memory used by pipelines the client never needs.
+    Prewarm    = 2, ///< Like OnFirstUse, but internal compute pipelines are also created ahead of time by background
+                    ///  threads which are started when the device is finalized.
+};
+#endif
+
 static constexpr uint32 MaxPathStrLen = 512;
 static constexpr uint32 MaxFileNameStrLen = 256;
 static constexpr uint32 MaxMiscStrLen = 61;
@@ -631,6 +643,21 @@ struct PalPublicSettings
     /// confirm to make the screen not too noisy.
     bool disableDebugOverlayVisualConfirm;
 #endif
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    /// Controls when the internal pipelines used by the resource processing manager are created.  Ignored if
+    /// disableResourceProcessingManager is set.
+    RpmPipelineCreateMode rpmPipelineCreateMode;
+    /// Coalesces back-to-back barriers recorded into universal command buffers: waits and cache operations which an
+    /// immediately preceding barrier already performed are skipped, and layout transition decisions are memoized per
+    /// command buffer.
+    bool coalesceBarriers;
+    /// Base path of the RPM pipeline usage files.  If set and rpmPipelineCreateMode isn't Immediate, PAL records
+    /// which internal compute pipelines each device used in a file when the device is destroyed, and the next run
+    /// creates those pipelines ahead of time from background threads.  Each device uses its own file, named by
+    /// appending its PCI device ID and revision to this path.  Files written by a different PAL version or device are
+    /// ignored.
+    char rpmPipelineUsagePath[MaxPathStrLen];
+#endif
 };
 
 /// Defines the modes that the GPU Profiling layer can use when its buffer fills.
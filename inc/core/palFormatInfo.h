@@ -138,6 +138,35 @@ extern void PackRawClearColor(
 /// Swizzles the color according to the provided format swizzle.
 extern void SwizzleColor(SwizzledFormat format, const uint32* pColorIn, uint32* pColorOut);
 
+/// Checks if ConvertPixels() can read and write pixels of the given format.  The supported formats are the four channel
+/// UNORM, SNORM and SRGB 8-bit formats, the four channel UNORM, SNORM and FLOAT 16-bit formats, X32Y32Z32W32_Float,
+/// X10Y10Z10W2_Unorm, X11Y11Z10_Float and X9Y9Z9E5_Float.  SRGB formats must keep their alpha channel in W.
+///
+/// @param [in] format Format to check
+///
+/// @returns True if the format can be used with ConvertPixels().
+extern bool SupportsBulkConversion(SwizzledFormat format);
+
+/// Converts a span of tightly packed pixels from one format to another.  Each pixel is read as an RGBA color through
+/// the source format's swizzle and then written out exactly like ConvertColor(), SwizzleColor() and PackRawClearColor()
+/// would write it for the destination format, except that FLOAT16 NaNs copied into FLOAT32 pixels may come out quieted.
+/// Large spans are converted with SIMD kernels when the CPU supports them.
+///
+/// @param [in]  srcFormat  Format of the source pixels.
+/// @param [in]  pSrc       Source pixels.
+/// @param [in]  dstFormat  Format of the destination pixels.
+/// @param [out] pDst       Destination pixels.  Must not overlap the source pixels unless it's the same memory and the
+///                         formats have the same number of bytes per pixel.
+/// @param [in]  pixelCount Number of pixels to convert.
+///
+/// @returns Success if the pixels were converted, or ErrorInvalidFormat if either format isn't supported.
+extern Result ConvertPixels(
+    SwizzledFormat srcFormat,
+    const void*    pSrc,
+    SwizzledFormat dstFormat,
+    void*          pDst,
+    size_t         pixelCount);
+
 /// Compares two SwizzledFormats and checks for equality.
 ///
 /// @param lhs [in] Left hand side of comparison
@@ -43,7 +43,7 @@
 ///            compatible, it is not assumed that the client will initialize all input structs to 0.
 ///
 /// @ingroup LibInit
-#define PAL_INTERFACE_MAJOR_VERSION 668
+#define PAL_INTERFACE_MAJOR_VERSION 669
 
 /// Minor interface version.  Note that the interface version is distinct from the PAL version itself, which is returned
 /// in @ref Pal::PlatformProperties.
@@ -53,7 +53,7 @@
 /// of the existing enum values will change.  This number will be reset to 0 when the major version is incremented.
 ///
 /// @ingroup LibInit
-#define PAL_INTERFACE_MINOR_VERSION 2
+#define PAL_INTERFACE_MINOR_VERSION 0
 
 /// Minimum major interface version. This is the minimum interface version PAL supports in order to support backward
 /// compatibility. When it is equal to PAL_INTERFACE_MAJOR_VERSION, only the latest interface version is supported.
@@ -178,8 +178,19 @@ struct PlatformCreateInfo
             uint32 supportRgpTraces               :  1; ///< Indicates that the client supports RGP tracing. PAL will
                                                         ///  use this flag and the hardware support flag to setup the
                                                         ///  DevDriver RgpServer.
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+            uint32 parallelDeviceInit             :  1; ///< Creates independent devices on worker threads during
+                                                        ///  device enumeration instead of one after another.  Only
+                                                        ///  the null device platform currently honors this.
+            uint32 enableSlabAllocator            :  1; ///< Routes PAL's internal system memory allocations through a
+                                                        ///  thread-caching @ref Util::SlabAllocator layered on top of
+                                                        ///  the client (or default) allocation callbacks.  Small
+                                                        ///  allocations will then rarely reach the callbacks.
 
+            uint32 reserved                       : 23; ///< Reserved for future use.
+#else
             uint32 reserved                       : 25; ///< Reserved for future use.
+#endif
         };
         uint32 u32All;                                  ///< Flags packed as 32-bit uint.
     } flags;                                            ///< Platform-wide creation flags.
@@ -428,6 +428,14 @@ public:
     /// @param [in] pBuffer Pointer to the buffer to save to.
     void SaveToBuffer(void* pBuffer);
 
+    /// Save the ELF to a sink in a single pass, without first querying its size.
+    ///
+    /// @param [in] pSink The sink to write to, for example an Elf::ElfBufferSink or a Util::File.
+    ///
+    /// @returns Success if successful, otherwise the first error returned by the sink.
+    template <typename Sink>
+    Result SaveToSink(Sink* pSink);
+
     /// Initialize the ABI processor before generating an ELF.  If LoadFromBuffer is not going to be called, then
     /// this must be called instead before any operations can be done on this ELF.
     ///
@@ -440,7 +448,16 @@ public:
     /// @param [in] bufferSize Size of the buffer in bytes to load from.
     Result LoadFromBuffer(const void* pBuffer, size_t bufferSize);
 
+    /// Load the ELF from a buffer without copying its sections.  The buffer must not change or be freed while this
+    /// PipelineAbiProcessor uses it.  Sections which are modified later get a private copy at that point.
+    ///
+    /// @param [in] pBuffer    Pointer to the buffer to load from.
+    /// @param [in] bufferSize Size of the buffer in bytes to load from.
+    Result LoadFromBufferNoCopy(const void* pBuffer, size_t bufferSize);
+
 private:
+    Result Load(const void* pBuffer, size_t bufferSize, bool copyData);
+
     void RelocationHelper(
         void*                    pBuffer,
         uint64                   baseAddress,
@@ -978,13 +978,47 @@ void PipelineAbiProcessor<Allocator>::SaveToBuffer(
     m_elfProcessor.SaveToBuffer(pBuffer);
 }
 
+// =====================================================================================================================
+template <typename Allocator>
+template <typename Sink>
+Result PipelineAbiProcessor<Allocator>::SaveToSink(
+    Sink* pSink)
+{
+    PAL_ASSERT(m_pTextSection         != nullptr);
+    PAL_ASSERT(m_pNoteSection         != nullptr);
+    PAL_ASSERT(m_pSymbolSection       != nullptr);
+    PAL_ASSERT(m_pSymbolStrTabSection != nullptr);
+
+    return m_elfProcessor.SaveToSink(pSink);
+}
+
 // =====================================================================================================================
 template <typename Allocator>
 Result PipelineAbiProcessor<Allocator>::LoadFromBuffer(
     const void* pBuffer,
     size_t      bufferSize)
 {
-    Result result = m_elfProcessor.LoadFromBuffer(pBuffer, bufferSize);
+    return Load(pBuffer, bufferSize, true);
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+Result PipelineAbiProcessor<Allocator>::LoadFromBufferNoCopy(
+    const void* pBuffer,
+    size_t      bufferSize)
+{
+    return Load(pBuffer, bufferSize, false);
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+Result PipelineAbiProcessor<Allocator>::Load(
+    const void* pBuffer,
+    size_t      bufferSize,
+    bool        copyData)   // If false, the ELF's sections reference pBuffer instead of copying it.
+{
+    Result result = copyData ? m_elfProcessor.LoadFromBuffer(pBuffer, bufferSize)
+                             : m_elfProcessor.LoadFromBufferNoCopy(pBuffer, bufferSize);
 
     if (result == Result::Success)
     {
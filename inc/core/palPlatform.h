@@ -72,6 +72,47 @@ struct Version
     uint16 minor;  ///< Minor version number.
 };
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+/// Phases of platform initialization which PAL times while the platform is being created.
+///
+/// @see PlatformStartupProfile
+enum class PlatformInitPhase : uint32
+{
+    EarlyInitDevDriver = 0, ///< Connecting to the developer driver message bus.
+    ConnectToOsInterface,   ///< Connecting to the host OS and kernel-mode driver.
+    EnumerateDevices,       ///< Querying the OS for devices and creating each of them.
+    LateInitDevDriver,      ///< Setting up the developer driver protocol servers for the enumerated devices.
+    InitProperties,         ///< Initializing the platform properties.
+    Count
+};
+
+/// Phases of device initialization which PAL times.
+///
+/// @see PlatformStartupProfile
+enum class DeviceInitPhase : uint32
+{
+    Create = 0,             ///< Creating the device object and running its early initialization during enumeration.
+    CommitSettingsAndInit,  ///< IDevice::CommitSettingsAndInit(), including the device's late initialization.
+    Finalize,               ///< IDevice::Finalize().
+    Count
+};
+
+/// Reports how long PAL spent in each phase of platform and device initialization.  Durations are in ticks of
+/// Util::GetPerfCpuTime(); phases which haven't run yet report zero.
+///
+/// @see PlatformProperties::startupProfile
+struct PlatformStartupProfile
+{
+    uint64 perfFrequency;  ///< Number of ticks per second.
+    uint64 platformTicks[static_cast<uint32>(PlatformInitPhase::Count)]; ///< Time spent in each platform phase.
+    uint64 deviceTicks[MaxDevices][static_cast<uint32>(DeviceInitPhase::Count)]; ///< Time spent in each device
+                                                                                  ///  phase, indexed in the same order
+                                                                                  ///  as IPlatform::EnumerateDevices().
+    uint32 deviceCount;    ///< Number of valid entries in deviceTicks.
+    bool   parallelDeviceInit; ///< True if the devices were created on worker threads.
+};
+#endif
+
 /// Reports capabilities and general properties of this instantiation of the PAL library.
 ///
 /// This covers any property that it platform-wide as opposed to being tied to a particular device in the system.
@@ -98,6 +139,10 @@ struct PlatformProperties
         };
         uint32 u32All;                               ///< Flags packed as 32-bit uint.
     };
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    PlatformStartupProfile startupProfile;           ///< Timing of platform and device initialization.
+#endif
 };
 
 /// Enumerates the GPU affinity modes which can be selected by an application profile. This determines the preference
@@ -91,6 +91,12 @@ struct ArchiveFileOpenInfo
     bool                allowAsyncFileIo;         ///< Allow use of OS specific asynchronous file routines
     bool                useBufferedReadMemory;    ///< Allow preloading/read-ahead of file into memory
     size_t              maxReadBufferMem;         ///< Maximum size allowed for read buffer
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    bool                useFastChecksum;          ///< Checksum the entries of newly created files with XxHash128 and
+                                                  ///  mark them with XxHashChecksumMajorVersion. Existing files always
+                                                  ///  use the checksum recorded in their header. Also selects the
+                                                  ///  expected major version under useStrictVersionControl.
+#endif
 };
 
 /// Get the memory size needed for an archive file object
@@ -238,6 +244,22 @@ public:
         ArchiveEntryHeader* pHeader,
         const void*         pData) = 0;
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    /// Select the checksum used for the entries of an archive which doesn't have any yet
+    ///
+    /// The checksum algorithm is recorded in the archive header, so it applies to every entry in the file. Switching
+    /// to the fast checksum marks the archive with XxHashChecksumMajorVersion, which older readers will reject.
+    ///
+    /// @param [in] useFastChecksum Checksum entries with XxHash128 instead of MetroHash64
+    ///
+    /// @return Success if the archive now uses the requested checksum. Otherwise, one of the following may be returned:
+    ///         + Unsupported if the file was not opened with write access
+    ///         + ErrorUnavailable if the archive already holds entries checksummed with the other algorithm
+    ///         + ErrorUnknown if there is an internal error.
+    virtual Result SetUseFastChecksum(
+        bool useFastChecksum) = 0;
+#endif
+
     /// Destroy the archive file interface. Closing the file if necessary.
     ///
     ///  If async file writes are allowed this function may block if there are pending writes to complete.
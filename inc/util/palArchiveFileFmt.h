@@ -62,6 +62,15 @@ constexpr uint8 MagicEntryMarker[4]     = {'N','T','R','Y'};    ///< Identifies
 constexpr uint32 CurrentMajorVersion    = 1;    ///< Version number denoting compatibility breaking changes
 constexpr uint32 CurrentMinorVersion    = 1;    ///< Version number denoting changes that should be backward compatible
 
+/**
+***********************************************************************************************************************
+* @brief Major version of archives whose entry checksums are the XxHash128 of the entry data folded to 64 bits rather
+*        than its MetroHash64. The layout is otherwise identical to CurrentMajorVersion, but older readers could not
+*        verify a single entry, so these archives are only written when a client asks for the fast checksum.
+***********************************************************************************************************************
+*/
+constexpr uint32 XxHashChecksumMajorVersion = 2;
+
 /**
 ***********************************************************************************************************************
 * @brief A header stored at the front of the archive file
@@ -102,7 +111,7 @@ struct ArchiveEntryHeader
     uint32 nextBlock;       ///< Byte offset of next block in file from start of archive
     uint32 dataSize;        ///< Size of entry data
     uint32 dataPosition;    ///< Byte offset of entry data from start of archive
-    uint64 dataCrc64;       ///< Checksum for data integrity
+    uint64 dataCrc64;       ///< Checksum for data integrity, algorithm depends on ArchiveFileHeader::majorVersion
     uint32 dataType;        ///< Optional ID signifying the data type for the entry
     uint8  entryKey[20];    ///< 160-bit (max) hash key for the entry
     uint32 metaValue;       ///< Optional meta-data value for use by consumer of data
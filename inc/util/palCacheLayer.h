@@ -445,6 +445,10 @@ struct ArchiveFileCacheCreateInfo
                                            ///  to be keyed to a specific driver/platform fingerprint.
     uint32                   dataTypeId;   ///< Optional 32-bit data type identifier, allows heterogenous data to be
                                            ///  stored within an archive file.
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    bool                     useFastChecksum; ///< Checksum the entries of pFile with XxHash128 if it is still empty.
+                                              ///  An archive which already holds entries keeps its recorded checksum.
+#endif
 };
 
 /// Get the memory size for a archive file backed cache layer
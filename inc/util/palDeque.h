@@ -40,7 +40,8 @@ namespace Util
 // Forward declarations.
 template<typename T, typename Allocator> class Deque;
 
-/// @internal Private structure used by Deque and its iterators to store chunks of data elements.
+/// @internal Private structure used by Deque and its iterators to store chunks of data elements.  The header is placed
+/// after the elements it describes so that the elements start at the beginning of the (cache-line aligned) allocation.
 struct DequeBlockHeader
 {
     DequeBlockHeader* pPrev;   ///< Pointer to the previous block.
@@ -94,10 +95,13 @@ private:
  *
  * This is meant for storing elements of an arbitrary (but uniform) type. Operations which this class supports are:
  *
- * - Insertion from the front and back.
- * - Deletion from the front and back.
+ * - Insertion from the front and back, including bulk insertion at the back.
+ * - Deletion from the front and back, including bulk deletion from the front.
  * - Forwards and reverse iteration
  *
+ * Elements are stored in cache-line aligned blocks whose element count is rounded up to fill whole cache lines.  A few
+ * emptied blocks are kept around for reuse so that a deque whose size oscillates doesn't keep hitting the allocator.
+ *
  * @warning This class is not thread-safe for push, pop, or iteration!
  *
  * @note This class is only designed to work with native types and POD-style structures. If it is needed to have a Deque
@@ -111,7 +115,8 @@ class Deque
 public:
     /// Constructor.
     ///
-    /// @param [in] pAllocator The allocator that will allocate memory if required.
+    /// @param [in] pAllocator          The allocator that will allocate memory if required.
+    /// @param [in] numElementsPerBlock Minimum number of elements per block; rounded up to fill whole cache lines.
     Deque(Allocator*const pAllocator, size_t numElementsPerBlock = 256);
     ~Deque();
 
@@ -187,6 +192,16 @@ public:
     template<typename... Args>
     Result EmplaceBack(Args&&... args);
 
+    /// Pushes copies of an array of items onto the back of the deque, in order.  Either all of the items are added or,
+    /// if memory allocation fails, none of them are.
+    ///
+    /// @param [in] pData Array of items to be added to the back of the deque.
+    /// @param [in] count Number of items in pData.
+    ///
+    /// @returns @ref Success if the items were successfully added to the deque or @ref ErrorOutOfMemory if the
+    ///          operation failed because of an internal failure to allocate system memory.
+    Result PushBack(const T* pData, size_t count);
+
     /// Pops the first item off the front of the deque, returning the popped value.
     ///
     /// @param [out] pOut Item popped off the front of the deque.
@@ -195,6 +210,15 @@ public:
     ///          is empty.
     Result PopFront(T* pOut);
 
+    /// Pops several items off the front of the deque, returning the popped values in order.
+    ///
+    /// @param [out] pOut  Array of count items which receives the popped items.  May be null to discard them.
+    /// @param [in]  count Number of items to pop.
+    ///
+    /// @returns @ref Success if the items were successfully popped from the deque or @ref ErrorUnavailable if the
+    ///          deque holds fewer than count items, in which case the deque is left unchanged.
+    Result PopFront(T* pOut, size_t count);
+
     /// Pops the first item off the back of the deque, returning the popped value.
     ///
     /// @param [out] pOut Item popped off the back of the deque.
@@ -204,10 +228,17 @@ public:
     Result PopBack(T* pOut);
 
 private:
+    // Maximum number of emptied blocks which are cached for reuse.
+    static constexpr uint32 MaxCachedBlocks = 4;
+
+    static size_t CalcElementsPerBlock(size_t minElements);
+
     Result AllocateFront(T**);
     Result AllocateBack(T**);
     DequeBlockHeader* AllocateNewBlock();
     void FreeUnusedBlock(DequeBlockHeader* pHeader);
+    void ReleaseFrontBlock();
+    void CopyElements(T* pDst, const T* pSrc, size_t count);
 
     size_t            m_numElements;         // Number of elements
     const size_t      m_numElementsPerBlock; // Block granularity when we need to alloc a new one
@@ -218,7 +249,8 @@ private:
     T*                m_pFront;              // First data element, null for empty deques.
     T*                m_pBack;               // Last data element, null for empty deques.
 
-    DequeBlockHeader* m_pLazyFreeHeader;     // Cached pointer to the most-recently freed block.
+    DequeBlockHeader* m_pFreeBlocks;         // Cached emptied blocks, linked through their pNext pointers.
+    uint32            m_numFreeBlocks;       // Number of blocks in m_pFreeBlocks.
 
     Allocator*const   m_pAllocator;          // Pointer to the allocator for this deque.
 
@@ -237,12 +269,13 @@ PAL_INLINE Deque<T, Allocator>::Deque(
     size_t          numElementsPerBlock)
     :
     m_numElements(0),
-    m_numElementsPerBlock(numElementsPerBlock),
+    m_numElementsPerBlock(CalcElementsPerBlock(numElementsPerBlock)),
     m_pFrontHeader(nullptr),
     m_pBackHeader(nullptr),
     m_pFront(nullptr),
     m_pBack(nullptr),
-    m_pLazyFreeHeader(nullptr),
+    m_pFreeBlocks(nullptr),
+    m_numFreeBlocks(0),
     m_pAllocator(pAllocator)
 {
 }
@@ -264,10 +297,11 @@ PAL_INLINE Deque<T, Allocator>::~Deque()
 
         if ((m_pFront == m_pFrontHeader->pEnd) || (m_numElements == 0))
         {
-            // Okay, the front block is now empty. Free it and advance to the next block.
+            // Okay, the front block is now empty. Free it and advance to the next block.  The block's memory starts
+            // with its elements.
             DequeBlockHeader* pBlockToFree = m_pFrontHeader;
             m_pFrontHeader = m_pFrontHeader->pNext;
-            PAL_SAFE_FREE(pBlockToFree, m_pAllocator);
+            PAL_FREE(pBlockToFree->pStart, m_pAllocator);
 
             if (m_pFrontHeader != nullptr)
             {
@@ -276,9 +310,11 @@ PAL_INLINE Deque<T, Allocator>::~Deque()
         }
     }
 
-    if (m_pLazyFreeHeader != nullptr)
+    while (m_pFreeBlocks != nullptr)
     {
-        PAL_SAFE_FREE(m_pLazyFreeHeader, m_pAllocator);
+        DequeBlockHeader* pBlockToFree = m_pFreeBlocks;
+        m_pFreeBlocks = m_pFreeBlocks->pNext;
+        PAL_FREE(pBlockToFree->pStart, m_pAllocator);
     }
 }
 
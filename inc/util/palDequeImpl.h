@@ -31,25 +31,54 @@
 
 #pragma once
 
+#include <string.h>
 #include <utility>
 #include "palDeque.h"
+#include "palInlineFuncs.h"
 #include "palSysMemory.h"
 
 namespace Util
 {
 
 // =====================================================================================================================
-// Allocates a new block for storing additional data elements.  If the lazy-free block is present, just use that instead
-// of allocating more memory.
+// Rounds the requested number of elements per block up so that a block, including its header, fills a whole number of
+// cache lines.
+template<typename T, typename Allocator>
+size_t Deque<T, Allocator>::CalcElementsPerBlock(
+    size_t minElements)
+{
+    const size_t minBlockSize = Pow2Align(Max<size_t>(minElements, 1) * sizeof(T), alignof(DequeBlockHeader)) +
+                                sizeof(DequeBlockHeader);
+    const size_t blockSize    = Pow2Align(minBlockSize, PAL_CACHE_LINE_BYTES);
+
+    size_t numElements = (blockSize - sizeof(DequeBlockHeader)) / sizeof(T);
+
+    while ((Pow2Align(numElements * sizeof(T), alignof(DequeBlockHeader)) + sizeof(DequeBlockHeader)) > blockSize)
+    {
+        --numElements;
+    }
+
+    PAL_ASSERT(numElements >= minElements);
+
+    return numElements;
+}
+
+// =====================================================================================================================
+// Allocates a new block for storing additional data elements.  If a cached free block is present, just use that
+// instead of allocating more memory.
+//
+// Blocks are allocated on a cache line boundary with the elements first, so the elements are cache-line aligned and the
+// header sits in the padding after them.
 template<typename T, typename Allocator>
 PAL_INLINE DequeBlockHeader* Deque<T, Allocator>::AllocateNewBlock()
 {
     DequeBlockHeader* pNewBlock = nullptr;
 
-    if (m_pLazyFreeHeader != nullptr)
+    if (m_pFreeBlocks != nullptr)
     {
-        pNewBlock         = m_pLazyFreeHeader;
-        m_pLazyFreeHeader = nullptr;
+        pNewBlock     = m_pFreeBlocks;
+        m_pFreeBlocks = m_pFreeBlocks->pNext;
+        --m_numFreeBlocks;
 
         // Fill in the newly allocated header. The caller is responsible for properly attaching the new block's header
         // to the list.
@@ -58,22 +87,25 @@ PAL_INLINE DequeBlockHeader* Deque<T, Allocator>::AllocateNewBlock()
     }
     else
     {
+        static_assert(alignof(T) <= PAL_CACHE_LINE_BYTES, "Deque elements must not be over-aligned!");
+
         const size_t blockSize   = m_numElementsPerBlock * sizeof(T);
-        const size_t sizeToAlloc = sizeof(DequeBlockHeader) + blockSize;
+        const size_t headerOffset = Pow2Align(blockSize, alignof(DequeBlockHeader));
+        const size_t sizeToAlloc = headerOffset + sizeof(DequeBlockHeader);
 
-        pNewBlock = static_cast<DequeBlockHeader*>(PAL_MALLOC(sizeToAlloc, m_pAllocator, AllocInternal));
+        void*const pMemory = PAL_MALLOC_ALIGNED(sizeToAlloc, PAL_CACHE_LINE_BYTES, m_pAllocator, AllocInternal);
 
-        if (pNewBlock != nullptr)
+        if (pMemory != nullptr)
         {
+            pNewBlock = static_cast<DequeBlockHeader*>(VoidPtrInc(pMemory, headerOffset));
+
             // Fill in the newly allocated header. The caller is responsible for properly attaching the new block's
             // header to the list.
             pNewBlock->pPrev = nullptr;
             pNewBlock->pNext = nullptr;
 
-            pNewBlock->pStart = (pNewBlock + 1);
-            pNewBlock->pEnd   = VoidPtrInc(pNewBlock->pStart, blockSize);
-
-            PAL_ASSERT(pNewBlock->pEnd == VoidPtrInc(pNewBlock, sizeToAlloc));
+            pNewBlock->pStart = pMemory;
+            pNewBlock->pEnd   = VoidPtrInc(pMemory, blockSize);
         }
     }
 
@@ -81,22 +113,76 @@ PAL_INLINE DequeBlockHeader* Deque<T, Allocator>::AllocateNewBlock()
 }
 
 // =====================================================================================================================
-// If there is currently no lazy-free block, cache the given block so that the next block allocation will be faster. If
-// the lazy-free block already exists, actually frees the block's memory.
+// Caches the given block so that later block allocations will be faster, unless the cache is already full, in which
+// case the block's memory is actually freed.
 //
-// The reason for this is because some use cases might cause us to ping-pong between N and N+1 blocks, which would
+// The reason for this is because some use cases might cause us to ping-pong between N and N+k blocks, which would
 // result in excessive calls to PAL_MALLOC & PAL_FREE.
 template<typename T, typename Allocator>
 PAL_INLINE void Deque<T, Allocator>::FreeUnusedBlock(
     DequeBlockHeader* pHeader)
 {
-    if (m_pLazyFreeHeader == nullptr)
+    if (m_numFreeBlocks < MaxCachedBlocks)
     {
-        m_pLazyFreeHeader = pHeader;
+        pHeader->pPrev = nullptr;
+        pHeader->pNext = m_pFreeBlocks;
+        m_pFreeBlocks  = pHeader;
+        ++m_numFreeBlocks;
     }
     else
     {
-        PAL_SAFE_FREE(pHeader, m_pAllocator);
+        PAL_FREE(pHeader->pStart, m_pAllocator);
+    }
+}
+
+// =====================================================================================================================
+// Unlinks the front block after its last element has been popped and moves the front element pointer to the next
+// block, or empties the deque if there is no next block.
+template<typename T, typename Allocator>
+PAL_INLINE void Deque<T, Allocator>::ReleaseFrontBlock()
+{
+    DequeBlockHeader*const pOldFrontHeader = m_pFrontHeader;
+
+    if (m_pFrontHeader->pNext != nullptr)
+    {
+        // Need to fix-up the linked list of blocks.
+        m_pFrontHeader        = m_pFrontHeader->pNext;
+        m_pFrontHeader->pPrev = nullptr;
+        // The new front element is the first element in the new front block.
+        m_pFront = static_cast<T*>(m_pFrontHeader->pStart);
+    }
+    else
+    {
+        // The deque is now empty... clear our block & element pointers.
+        PAL_ASSERT(m_pFrontHeader == m_pBackHeader);
+        m_pFrontHeader = nullptr;
+        m_pBackHeader  = nullptr;
+        m_pFront       = nullptr;
+        m_pBack        = nullptr;
+    }
+
+    // Need to free the now-unused block.
+    FreeUnusedBlock(pOldFrontHeader);
+}
+
+// =====================================================================================================================
+// Copy-constructs count elements into uninitialized storage.
+template<typename T, typename Allocator>
+PAL_INLINE void Deque<T, Allocator>::CopyElements(
+    T*       pDst,
+    const T* pSrc,
+    size_t   count)
+{
+    if (std::is_pod<T>::value)
+    {
+        memcpy(pDst, pSrc, count * sizeof(T));
+    }
+    else
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            PAL_PLACEMENT_NEW(pDst + i) T(pSrc[i]);
+        }
     }
 }
 
@@ -293,28 +379,163 @@ PAL_INLINE Result Deque<T, Allocator>::PopFront(
         {
             // We've reached the end of the front block: therefore it is empty, and all other elements reside in other
             // blocks (if there are any).
-            DequeBlockHeader*const pOldFrontHeader = m_pFrontHeader;
+            ReleaseFrontBlock();
+        }
+
+        result = Result::_Success;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Inserts an array of data elements at the back of the deque.  Every block needed to hold the new elements is obtained
+// up front so that an allocation failure leaves the deque unmodified.
+template<typename T, typename Allocator>
+Result Deque<T, Allocator>::PushBack(
+    const T* pData,
+    size_t   count)
+{
+    Result result = Result::_Success;
+
+    size_t room = (m_pBackHeader != nullptr) ? static_cast<size_t>(static_cast<T*>(m_pBackHeader->pEnd) - (m_pBack + 1))
+                                             : 0;
+
+    DequeBlockHeader* pFirstNewBlock = nullptr;
+    DequeBlockHeader* pLastNewBlock  = nullptr;
 
-            if (m_pFrontHeader->pNext != nullptr)
+    while (room < count)
+    {
+        DequeBlockHeader*const pNewBlock = AllocateNewBlock();
+        if (pNewBlock == nullptr)
+        {
+            result = Result::ErrorOutOfMemory;
+            break;
+        }
+
+        if (pLastNewBlock != nullptr)
+        {
+            pLastNewBlock->pNext = pNewBlock;
+            pNewBlock->pPrev     = pLastNewBlock;
+        }
+        else
+        {
+            pFirstNewBlock = pNewBlock;
+        }
+
+        pLastNewBlock = pNewBlock;
+        room         += m_numElementsPerBlock;
+    }
+
+    if (result != Result::_Success)
+    {
+        while (pFirstNewBlock != nullptr)
+        {
+            DequeBlockHeader*const pNext = pFirstNewBlock->pNext;
+            FreeUnusedBlock(pFirstNewBlock);
+            pFirstNewBlock = pNext;
+        }
+    }
+    else if (count > 0)
+    {
+        // Link the new blocks onto the back of the block list.
+        if (pFirstNewBlock != nullptr)
+        {
+            if (m_pBackHeader != nullptr)
             {
-                // Need to fix-up the linked list of blocks.
-                m_pFrontHeader        = m_pFrontHeader->pNext;
-                m_pFrontHeader->pPrev = nullptr;
-                // The new front element is the first element in the new front block.
-                m_pFront = static_cast<T*>(m_pFrontHeader->pStart);
+                m_pBackHeader->pNext   = pFirstNewBlock;
+                pFirstNewBlock->pPrev  = m_pBackHeader;
             }
             else
             {
-                // The deque is now empty... clear our block & element pointers.
-                PAL_ASSERT(m_pFrontHeader == m_pBackHeader);
-                m_pFrontHeader = nullptr;
-                m_pBackHeader  = nullptr;
-                m_pFront       = nullptr;
-                m_pBack        = nullptr;
+                m_pFrontHeader = pFirstNewBlock;
+                m_pBackHeader  = pFirstNewBlock;
+                m_pFront       = static_cast<T*>(pFirstNewBlock->pStart);
+                m_pBack        = (m_pFront - 1);
             }
+        }
 
-            // Need to free the now-unused block.
-            FreeUnusedBlock(pOldFrontHeader);
+        // Copy the elements in as few chunks as possible: the rest of the current back block, then whole blocks.
+        DequeBlockHeader* pHeader = m_pBackHeader;
+        T*                pDst    = (m_pBack + 1);
+        size_t            copied  = 0;
+
+        while (copied < count)
+        {
+            if (pDst == pHeader->pEnd)
+            {
+                pHeader = pHeader->pNext;
+                pDst    = static_cast<T*>(pHeader->pStart);
+            }
+
+            const size_t chunk = Min(count - copied, static_cast<size_t>(static_cast<T*>(pHeader->pEnd) - pDst));
+
+            CopyElements(pDst, pData + copied, chunk);
+
+            pDst   += chunk;
+            copied += chunk;
+        }
+
+        m_pBackHeader  = pHeader;
+        m_pBack        = (pDst - 1);
+        m_numElements += count;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Pops several elements off of the front of the deque, one block-sized chunk at a time.
+template<typename T, typename Allocator>
+Result Deque<T, Allocator>::PopFront(
+    T*     pOut,
+    size_t count)
+{
+    Result result = Result::ErrorUnavailable;
+
+    if (count <= m_numElements)
+    {
+        while (count > 0)
+        {
+            // The front block ends either at its last slot or, if it is also the back block, at the back element.
+            const T*const pBlockEnd = (m_pFrontHeader == m_pBackHeader) ? (m_pBack + 1)
+                                                                        : static_cast<T*>(m_pFrontHeader->pEnd);
+            const size_t  chunk     = Min(count, static_cast<size_t>(pBlockEnd - m_pFront));
+
+            if (pOut != nullptr)
+            {
+                if (std::is_pod<T>::value)
+                {
+                    memcpy(pOut, m_pFront, chunk * sizeof(T));
+                }
+                else
+                {
+                    for (size_t i = 0; i < chunk; ++i)
+                    {
+                        pOut[i] = m_pFront[i];
+                    }
+                }
+
+                pOut += chunk;
+            }
+
+            // Explicitly destroy the removed values if they're non-trivial.
+            if (!std::is_pod<T>::value)
+            {
+                for (size_t i = 0; i < chunk; ++i)
+                {
+                    m_pFront[i].~T();
+                }
+            }
+
+            m_pFront      += chunk;
+            m_numElements -= chunk;
+            count         -= chunk;
+
+            if ((m_pFront == m_pFrontHeader->pEnd) || (m_numElements == 0))
+            {
+                ReleaseFrontBlock();
+            }
         }
 
         result = Result::_Success;
@@ -223,6 +223,13 @@ public:
     /// @returns  Pointer to the saved data if successful, or nullptr if memory allocation fails.
     void* SetData(const void* pData, size_t dataSize);
 
+    /// Makes the section reference data owned by someone else instead of a private copy.  The data must not change or
+    /// be freed while the section references it.  A later call to SetData or AppendData makes a private copy again.
+    ///
+    /// @param [in] pData    Pointer to the data to reference.
+    /// @param [in] dataSize Size in bytes of the data being referenced.
+    void SetExternalData(const void* pData, size_t dataSize);
+
     /// Append data to the section.
     ///
     /// @param [in] pData    Pointer to the data to append.
@@ -267,6 +274,11 @@ public:
     /// @returns Returns a pointer to the data of the section.
     const void* GetData() const { return m_pData; }
 
+    /// Checks if the section references external data.
+    ///
+    /// @returns True if the section's data was set with SetExternalData.
+    bool HasExternalData() const { return (m_pData != m_pOwnedData); }
+
     /// Gets the data size of the section.
     ///
     /// @returns Returns the data size of the section.
@@ -315,7 +327,8 @@ private:
     uint32              m_index;
 
     const char*         m_pName;
-    void*               m_pData;
+    const void*         m_pData;      // Either m_pOwnedData or external data.
+    void*               m_pOwnedData; // Data allocated by this section, if any.
 
     Section<Allocator>* m_pLinkSection;
     Section<Allocator>* m_pInfoSection;
@@ -727,6 +740,59 @@ private:
     PAL_DISALLOW_COPY_AND_ASSIGN(StringProcessor<Allocator>);
 };
 
+/**
+ ***********************************************************************************************************************
+ * @brief A growable system memory buffer which an ELF can be saved into with ElfProcessor::SaveToSink().
+ *
+ * Any other type with a "Result Write(const void* pData, size_t dataSize)" method, such as Util::File, can be used as
+ * a sink as well.
+ ***********************************************************************************************************************
+ */
+template <typename Allocator>
+class ElfBufferSink
+{
+public:
+    explicit ElfBufferSink(Allocator* const pAllocator);
+    ~ElfBufferSink();
+
+    /// Makes sure at least the given number of bytes can be held without reallocating.
+    ///
+    /// @param [in] capacity Number of bytes to reserve.
+    ///
+    /// @returns Success if successful, or ErrorOutOfMemory upon allocation failure.
+    Result Reserve(size_t capacity);
+
+    /// Appends data to the buffer.
+    ///
+    /// @param [in] pData    Pointer to the data to append.
+    /// @param [in] dataSize Size in bytes of the data being appended.
+    ///
+    /// @returns Success if successful, or ErrorOutOfMemory upon allocation failure.
+    Result Write(const void* pData, size_t dataSize);
+
+    /// Discards the contents of the buffer but keeps its memory.
+    void Reset() { m_size = 0; }
+
+    /// Gets a pointer to the contents of the buffer.
+    ///
+    /// @returns Returns a pointer to the contents of the buffer.
+    const void* GetBuffer() const { return m_pBuffer; }
+
+    /// Gets the size of the contents of the buffer.
+    ///
+    /// @returns Returns the size of the contents of the buffer in bytes.
+    size_t GetSize() const { return m_size; }
+
+private:
+    void*            m_pBuffer;
+    size_t           m_size;
+    size_t           m_capacity;
+
+    Allocator* const m_pAllocator;
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(ElfBufferSink<Allocator>);
+};
+
 /**
  ***********************************************************************************************************************
  * @brief The ElfProcessor manages the elf header and loads and saves the ELF Object to a buffer.
@@ -855,6 +921,15 @@ public:
     /// @param [in] pBuffer Pointer to the buffer to save to.
     void SaveToBuffer(void* pBuffer);
 
+    /// Save the ELF to a sink in a single pass, without first querying its size.
+    ///
+    /// @param [in] pSink The sink to write to, for example an ElfBufferSink or a Util::File.  Its
+    ///                   "Result Write(const void* pData, size_t dataSize)" method is called in file order.
+    ///
+    /// @returns Success if successful, otherwise the first error returned by the sink.
+    template <typename Sink>
+    Result SaveToSink(Sink* pSink);
+
     /// Initialize the ELF processor before generating a new ELF.
     ///
     /// @returns Success if successful, or ErrorOutOfMemory upon allocation failure.
@@ -868,7 +943,18 @@ public:
     /// @returns Success if successful, or ErrorOutOfMemory upon allocation failure.
     Result LoadFromBuffer(const void* pBuffer, size_t bufferSize);
 
+    /// Load the ELF from a buffer without copying the section data.  The sections reference the buffer, so it must
+    /// not change or be freed while this ElfProcessor uses it.
+    ///
+    /// @param [in] pBuffer    Pointer to the buffer to load from.
+    /// @param [in] bufferSize Size of the buffer in bytes to load from.
+    ///
+    /// @returns Success if successful, or ErrorOutOfMemory upon allocation failure.
+    Result LoadFromBufferNoCopy(const void* pBuffer, size_t bufferSize);
+
 private:
+    Result Load(const void* pBuffer, size_t bufferSize, bool copyData);
+
     FileHeader          m_fileHeader;
     Sections<Allocator> m_sections;
     Segments<Allocator> m_segments;
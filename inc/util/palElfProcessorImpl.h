@@ -344,6 +344,7 @@ Section<Allocator>::Section(
     m_index(0),
     m_pName(nullptr),
     m_pData(nullptr),
+    m_pOwnedData(nullptr),
     m_pLinkSection(nullptr),
     m_pInfoSection(nullptr),
     m_sectionHeader(),
@@ -355,7 +356,7 @@ Section<Allocator>::Section(
 template <typename Allocator>
 Section<Allocator>::~Section()
 {
-    PAL_SAFE_FREE(m_pData, m_pAllocator);
+    PAL_SAFE_FREE(m_pOwnedData, m_pAllocator);
 }
 
 // =====================================================================================================================
@@ -391,13 +392,14 @@ void* Section<Allocator>::SetData(
     void* pNewData = PAL_MALLOC(dataSize, m_pAllocator, AllocInternalTemp);
     if (pNewData != nullptr)
     {
-        if (m_pData != nullptr)
+        if (m_pOwnedData != nullptr)
         {
-            PAL_SAFE_FREE(m_pData, m_pAllocator);
+            PAL_SAFE_FREE(m_pOwnedData, m_pAllocator);
         }
 
         memcpy(pNewData, pData, dataSize);
-        m_pData = pNewData;
+        m_pData      = pNewData;
+        m_pOwnedData = pNewData;
         m_sectionHeader.sh_size = dataSize;
     }
     // NOTE: If memory allocation fails, no state will be changed, and nullptr is returned.
@@ -405,6 +407,20 @@ void* Section<Allocator>::SetData(
     return pNewData;
 }
 
+// =====================================================================================================================
+template <typename Allocator>
+void Section<Allocator>::SetExternalData(
+    const void* pData,
+    size_t      dataSize)
+{
+    PAL_ASSERT((pData != nullptr) || (dataSize == 0));
+
+    PAL_SAFE_FREE(m_pOwnedData, m_pAllocator);
+
+    m_pData = pData;
+    m_sectionHeader.sh_size = dataSize;
+}
+
 // =====================================================================================================================
 template <typename Allocator>
 void* Section<Allocator>::AppendData(
@@ -440,10 +456,11 @@ void* Section<Allocator>::AppendUninitializedData(
         if (m_pData != nullptr)
         {
             memcpy(pNewData, m_pData, GetDataSize());
-            PAL_SAFE_FREE(m_pData, m_pAllocator);
+            PAL_SAFE_FREE(m_pOwnedData, m_pAllocator);
         }
 
-        m_pData = pNewData;
+        m_pData      = pNewData;
+        m_pOwnedData = pNewData;
         m_sectionHeader.sh_size = newDataSize;
     }
     // NOTE: If memory allocation fails, no state will be changed, and nullptr is returned.
@@ -1090,6 +1107,81 @@ uint32 StringProcessor<Allocator>::GetNumStrings() const
     return count;
 }
 
+// =====================================================================================================================
+template <typename Allocator>
+ElfBufferSink<Allocator>::ElfBufferSink(
+    Allocator* const pAllocator)
+    :
+    m_pBuffer(nullptr),
+    m_size(0),
+    m_capacity(0),
+    m_pAllocator(pAllocator)
+{
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+ElfBufferSink<Allocator>::~ElfBufferSink()
+{
+    PAL_SAFE_FREE(m_pBuffer, m_pAllocator);
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+Result ElfBufferSink<Allocator>::Reserve(
+    size_t capacity)
+{
+    Result result = Result::Success;
+
+    if (capacity > m_capacity)
+    {
+        void*const pNewBuffer = PAL_MALLOC(capacity, m_pAllocator, AllocInternalTemp);
+
+        if (pNewBuffer != nullptr)
+        {
+            if (m_pBuffer != nullptr)
+            {
+                memcpy(pNewBuffer, m_pBuffer, m_size);
+                PAL_SAFE_FREE(m_pBuffer, m_pAllocator);
+            }
+
+            m_pBuffer  = pNewBuffer;
+            m_capacity = capacity;
+        }
+        else
+        {
+            result = Result::ErrorOutOfMemory;
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+Result ElfBufferSink<Allocator>::Write(
+    const void* pData,
+    size_t      dataSize)
+{
+    // Grow geometrically so that a whole ELF only takes a handful of reallocations.
+    constexpr size_t MinCapacity = 4096;
+
+    Result result = Result::Success;
+
+    if ((m_size + dataSize) > m_capacity)
+    {
+        result = Reserve(Max(m_size + dataSize, Max(m_capacity * 2, MinCapacity)));
+    }
+
+    if ((result == Result::Success) && (dataSize > 0))
+    {
+        memcpy(VoidPtrInc(m_pBuffer, m_size), pData, dataSize);
+        m_size += dataSize;
+    }
+
+    return result;
+}
+
 // =====================================================================================================================
 template <typename Allocator>
 ElfProcessor<Allocator>::ElfProcessor(
@@ -1205,69 +1297,90 @@ size_t ElfProcessor<Allocator>::GetRequiredBufferSizeBytes() const
     return bufferSizeBytes;
 }
 
+// =====================================================================================================================
+// Internal sink which writes into a caller-provided buffer that is known to be large enough.
+struct ElfRawBufferSink
+{
+    void* pWriter;
+
+    Result Write(const void* pData, size_t dataSize)
+    {
+        memcpy(pWriter, pData, dataSize);
+        pWriter = VoidPtrInc(pWriter, dataSize);
+
+        return Result::Success;
+    }
+};
+
 // =====================================================================================================================
 template <typename Allocator>
 void ElfProcessor<Allocator>::SaveToBuffer(
     void* pBuffer)
 {
-    // Finalize offsets and sizes.
-    Finalize();
+    ElfRawBufferSink sink = { pBuffer };
 
-    uint8* pBufferWriter = static_cast<uint8*>(pBuffer);
+    const Result result = SaveToSink(&sink);
+    PAL_ASSERT(result == Result::Success);
 
-    memcpy(pBuffer, &m_fileHeader, FileHeaderSize);
-    pBufferWriter += FileHeaderSize;
+    PAL_ASSERT(VoidPtrDiff(sink.pWriter, pBuffer) == GetRequiredBufferSizeBytes());
+}
 
-    if (m_segments.NumSegments() > 0)
-    {
-        // Iterate through the segment vector to write out the program headers.
-        auto segmentIterator = m_segments.Begin();
-        while (segmentIterator.IsValid())
-        {
-            const Segment<Allocator>* pSegment = segmentIterator.Get();
+// =====================================================================================================================
+template <typename Allocator>
+template <typename Sink>
+Result ElfProcessor<Allocator>::SaveToSink(
+    Sink* pSink)
+{
+    // Finalize offsets and sizes.
+    Finalize();
 
-            memcpy(pBufferWriter, pSegment->GetProgramHeader(), ProgramHeaderSize);
-            pBufferWriter += ProgramHeaderSize;
+    Result result = pSink->Write(&m_fileHeader, FileHeaderSize);
 
-            segmentIterator.Next();
-        }
+    // Iterate through the segment vector to write out the program headers.
+    for (auto segmentIterator = m_segments.Begin();
+         (result == Result::Success) && segmentIterator.IsValid();
+         segmentIterator.Next())
+    {
+        result = pSink->Write(segmentIterator.Get()->GetProgramHeader(), ProgramHeaderSize);
     }
 
     if (m_sections.NumSections() > 0)
     {
+        size_t offset = FileHeaderSize + (m_segments.NumSegments() * ProgramHeaderSize);
+
         // Iterate through the section vector to write out the section contents.
-        auto sectionContentIterator = m_sections.Begin();
-        while (sectionContentIterator.IsValid())
+        for (auto sectionContentIterator = m_sections.Begin();
+             (result == Result::Success) && sectionContentIterator.IsValid();
+             sectionContentIterator.Next())
         {
             const Section<Allocator>* pSection = sectionContentIterator.Get();
 
-            const size_t dataSize =  pSection->GetDataSize();
-            memcpy(pBufferWriter, pSection->GetData(), dataSize);
-            pBufferWriter += dataSize;
-
-            sectionContentIterator.Next();
+            const size_t dataSize = pSection->GetDataSize();
+            if (dataSize > 0)
+            {
+                result = pSink->Write(pSection->GetData(), dataSize);
+            }
+            offset += dataSize;
         }
 
-        const size_t sectionHeaderPadding =
-            VoidPtrDiff(VoidPtrAlign(pBufferWriter, SectionHeaderAlignment), pBufferWriter);
+        const size_t sectionHeaderPadding = RoundUpToMultiple(offset, SectionHeaderAlignment) - offset;
 
-        memset(pBufferWriter, 0, sectionHeaderPadding);
-        pBufferWriter += sectionHeaderPadding;
+        if ((result == Result::Success) && (sectionHeaderPadding > 0))
+        {
+            const uint8 padding[SectionHeaderAlignment] = {};
+            result = pSink->Write(&padding[0], sectionHeaderPadding);
+        }
 
         // Iterate through the section vector to write out the section headers.
-        auto sectionIterator = m_sections.Begin();
-        while (sectionIterator.IsValid())
+        for (auto sectionIterator = m_sections.Begin();
+             (result == Result::Success) && sectionIterator.IsValid();
+             sectionIterator.Next())
         {
-            const Section<Allocator>* pSection = sectionIterator.Get();
-
-            memcpy(pBufferWriter, pSection->GetSectionHeader(), SectionHeaderSize);
-            pBufferWriter += SectionHeaderSize;
-
-            sectionIterator.Next();
+            result = pSink->Write(sectionIterator.Get()->GetSectionHeader(), SectionHeaderSize);
         }
     }
 
-    PAL_ASSERT(VoidPtrDiff(pBufferWriter, pBuffer) == GetRequiredBufferSizeBytes());
+    return result;
 }
 
 // =====================================================================================================================
@@ -1275,6 +1388,25 @@ template <typename Allocator>
 Result ElfProcessor<Allocator>::LoadFromBuffer(
     const void*  pBuffer,
     size_t       bufferSize)
+{
+    return Load(pBuffer, bufferSize, true);
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+Result ElfProcessor<Allocator>::LoadFromBufferNoCopy(
+    const void*  pBuffer,
+    size_t       bufferSize)
+{
+    return Load(pBuffer, bufferSize, false);
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+Result ElfProcessor<Allocator>::Load(
+    const void*  pBuffer,
+    size_t       bufferSize,
+    bool         copyData)   // If false, the sections reference pBuffer instead of copying it.
 {
     const void* pBufferStart = pBuffer;
     PAL_ASSERT(bufferSize >= FileHeaderSize);
@@ -1336,8 +1468,15 @@ Result ElfProcessor<Allocator>::LoadFromBuffer(
                 pSection->SetOffset(static_cast<size_t>(pSectionHdrReader->sh_offset));
 
                 const void* pData = VoidPtrInc(pBufferStart, static_cast<size_t>(pSectionHdrReader->sh_offset));
-                if ((pSectionHdrReader->sh_size != 0) &&
-                    (pSection->SetData(pData, static_cast<size_t>(pSectionHdrReader->sh_size)) == nullptr))
+                if (pSectionHdrReader->sh_size == 0)
+                {
+                    // Nothing to load.
+                }
+                else if (copyData == false)
+                {
+                    pSection->SetExternalData(pData, static_cast<size_t>(pSectionHdrReader->sh_size));
+                }
+                else if (pSection->SetData(pData, static_cast<size_t>(pSectionHdrReader->sh_size)) == nullptr)
                 {
                     result = Result::ErrorOutOfMemory;
                     break;
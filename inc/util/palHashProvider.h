@@ -96,6 +96,26 @@ Result CreateHashContext(
     void*           pPlacementAddr,
     IHashContext**  ppHashContext);
 
+/// Hash a single buffer in one call with a built-in implementation.
+///
+/// This is equivalent to hashing the buffer with a context from CreateHashContext(), but it never touches the OS
+/// provider and needs no context memory.  Only algorithms with a built-in implementation (Sha1, Sha224 and Sha256) are
+/// supported.
+///
+/// @param [in]  algorithm  Enumeration id for the desired hashing method
+/// @param [in]  pData      Data to be hashed.
+/// @param [in]  dataSize   Size of the data to be hashed.
+/// @param [out] pOutput    Receives the digest.  There must be HashContextInfo::outputBufferSize bytes available here.
+///
+/// @returns Success if the buffer was hashed. Otherwise, one of the following errors may be returned:
+///          + Unsupported if there is no built-in implementation of the requested algorithm.
+///          + ErrorInvalidPointer if pOutput is nullptr, or pData is nullptr and dataSize is not zero.
+Result HashBuffer(
+    HashAlgorithm algorithm,
+    const void*   pData,
+    size_t        dataSize,
+    void*         pOutput);
+
 /**
 ***********************************************************************************************************************
 * @brief Interface representing an multi-stage hash calculation. No thread safety is implied.
@@ -384,6 +384,33 @@ PAL_INLINE void IntervalTree<T, K, Allocator>::Inorder(
     }
 }
 
+//======================================================================================================================
+// Overlapping in-order traverse helper.  A sub-tree whose highest value is below the interval's low bound can't hold an
+// overlapping node, and neither can a right sub-tree once a node starts above the interval's high bound.
+template<typename T, typename K, typename Allocator>
+PAL_INLINE void IntervalTree<T, K, Allocator>::OverlappingInorder(
+    IntervalTreeNode<T, K>* pRoot,
+    const Interval<T, K>*   pInterval,
+    void                  (*pfnTraverse)(IntervalTreeNode<T, K>*, void*),
+    void*                   pData
+    ) const
+{
+    if ((pRoot != GetNull()) && (pRoot->highest >= pInterval->low))
+    {
+        OverlappingInorder(pRoot->pLeftChild, pInterval, pfnTraverse, pData);
+
+        if (pRoot->interval.low <= pInterval->high)
+        {
+            if (pRoot->interval.high >= pInterval->low)
+            {
+                (*pfnTraverse)(pRoot, pData);
+            }
+
+            OverlappingInorder(pRoot->pRightChild, pInterval, pfnTraverse, pData);
+        }
+    }
+}
+
 //======================================================================================================================
 // Calculates the highest value of sub-tree of pNode.
 template<typename T, typename K, typename Allocator>
@@ -0,0 +1,266 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palJobSystem.h
+ * @brief PAL utility JobSystem class declaration.
+ ***********************************************************************************************************************
+ */
+
+#pragma once
+
+#include "palMutex.h"
+#include "palSemaphore.h"
+#include "palSysMemory.h"
+#include "palThread.h"
+
+#include <atomic>
+
+namespace Util
+{
+
+/// Function executed by a job.  The job's data pointer is passed through unmodified.
+typedef void (*JobFunction)(void* pData);
+
+/// Function executed for each range of a @ref JobSystem::ParallelFor loop.  Handles the iterations [begin, end).
+typedef void (*JobRangeFunction)(void* pData, uint32 begin, uint32 end);
+
+/**
+ ***********************************************************************************************************************
+ * @brief Tracks the completion of a group of jobs.
+ *
+ * Every job submitted with a counter increments it and decrements it again once the job has finished running.  A job
+ * may submit child jobs against its own counter (or against a new counter and wait on it), which allows recursive
+ * parent/child job graphs to be built without blocking any worker threads.
+ ***********************************************************************************************************************
+ */
+class JobCounter
+{
+public:
+    JobCounter() : m_pending(0) { }
+    ~JobCounter() { PAL_ASSERT(IsDone()); }
+
+    /// Returns true if every job submitted against this counter has finished running.
+    bool IsDone() const { return (m_pending.load(std::memory_order_acquire) == 0); }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<uint32> m_pending;
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(JobCounter);
+};
+
+/// Client callbacks which let a JobSystem run its workers on client-owned threads instead of @ref Thread objects.
+struct JobThreadCallbacks
+{
+    void* pClientData;  ///< Opaque pointer passed back to both callbacks.
+
+    /// Starts the thread for the given worker.  The thread must call pfnEntry(pParam) exactly once and may exit or be
+    /// recycled by the client once it returns.
+    Result (PAL_STDCALL* pfnStartThread)(
+        void*                 pClientData,
+        uint32                workerIndex,
+        Thread::StartFunction pfnEntry,
+        void*                 pParam);
+
+    /// Blocks until the entry function of the given worker's thread has returned.
+    void (PAL_STDCALL* pfnJoinThread)(
+        void*  pClientData,
+        uint32 workerIndex);
+};
+
+/// Specifies properties for @ref JobSystem creation.
+struct JobSystemCreateInfo
+{
+    uint32                    numWorkers;       ///< Number of worker threads.  Zero selects one worker per logical
+                                                ///  CPU core besides the calling thread.  Clamped to MaxWorkers.
+    uint32                    queueCapacity;    ///< Capacity of each worker's job deque; rounded up to a power of two.
+                                                ///  Zero selects DefaultQueueCapacity.
+    const JobThreadCallbacks* pThreadCallbacks; ///< Optional client thread backend.  If null, the JobSystem creates its
+                                                ///  own threads.
+};
+
+/**
+ ***********************************************************************************************************************
+ * @brief Work-stealing job scheduler for PAL-internal parallelism.
+ *
+ * Each worker thread owns a Chase-Lev deque: the owner pushes and pops jobs at the bottom without any locks while idle
+ * workers steal the oldest jobs from the top of a randomly chosen victim.  Jobs submitted from threads which are not
+ * workers of this JobSystem go through a shared, lock-protected injection queue instead.
+ *
+ * Waiting on a @ref JobCounter never blocks a thread while there is runnable work: the waiter keeps executing jobs from
+ * its own deque, the injection queue or other workers until the counter reaches zero.  Workers with nothing to do
+ * sleep on a semaphore which is signaled whenever new work is submitted.
+ *
+ * If a worker's deque is full, the submitted job is executed immediately on the submitting thread.
+ ***********************************************************************************************************************
+ */
+class JobSystem
+{
+public:
+    /// Largest supported number of worker threads.
+    static constexpr uint32 MaxWorkers           = 64;
+    /// Deque capacity used if JobSystemCreateInfo::queueCapacity is zero.
+    static constexpr uint32 DefaultQueueCapacity = 1024;
+
+    /// Constructor.
+    ///
+    /// @param [in] pAllocator The allocator that will allocate memory for the worker state.
+    template <typename Allocator>
+    explicit JobSystem(Allocator*const pAllocator)
+        :
+        m_allocator(pAllocator),
+        m_numWorkers(0),
+        m_pWorkers(nullptr),
+        m_pSlots(nullptr),
+        m_workerKeyValid(false),
+        m_threadCallbacks(),
+        m_useClientThreads(false),
+        m_injectHead(0),
+        m_injectCount(0),
+        m_injectCapacity(0),
+        m_pInjectQueue(nullptr),
+        m_injectPending(0),
+        m_numSleeping(0),
+        m_shutdown(false)
+    { }
+
+    /// Stops and joins all worker threads.  All jobs must have completed before the JobSystem is destroyed.
+    ~JobSystem();
+
+    /// Creates the worker threads and their queues.
+    ///
+    /// @param [in] createInfo Properties of the job system.
+    ///
+    /// @returns Success if initialization succeeded, otherwise an appropriate error code.
+    Result Init(const JobSystemCreateInfo& createInfo);
+
+    /// Schedules a job for execution on any thread.
+    ///
+    /// @param [in] pfnJob   Function to run.
+    /// @param [in] pData    Argument to pass to pfnJob.
+    /// @param [in] pCounter Optional counter which tracks the job's completion.
+    void Submit(JobFunction pfnJob, void* pData, JobCounter* pCounter);
+
+    /// Runs jobs on the calling thread until every job submitted against the given counter has finished.  May be
+    /// called from inside a job to wait on child jobs.
+    ///
+    /// @param [in] pCounter Counter to wait on.
+    void Wait(const JobCounter* pCounter);
+
+    /// Executes pfnRange over the iterations [0, count) in parallel and returns once all of them have finished.  The
+    /// iteration space is split into ranges of at most grainSize iterations which are handed out dynamically; the
+    /// calling thread participates in the loop.
+    ///
+    /// @param [in] count     Number of iterations.
+    /// @param [in] grainSize Maximum number of iterations per call to pfnRange.  Zero is treated as one.
+    /// @param [in] pfnRange  Function called once per range.
+    /// @param [in] pData     Argument to pass to pfnRange.
+    void ParallelFor(uint32 count, uint32 grainSize, JobRangeFunction pfnRange, void* pData);
+
+    /// Returns the number of worker threads (not counting client threads which call Wait or ParallelFor).
+    uint32 NumWorkers() const { return m_numWorkers; }
+
+private:
+    // A job slot.  The fields are atomics because a thief may read a slot while its owner is writing a new job into
+    // it; such a read is always discarded when the thief's CAS on the deque top fails.
+    struct JobSlot
+    {
+        std::atomic<JobFunction> pfnJob;
+        std::atomic<void*>       pData;
+        std::atomic<JobCounter*> pCounter;
+    };
+
+    struct Job
+    {
+        JobFunction pfnJob;
+        void*       pData;
+        JobCounter* pCounter;
+    };
+
+    // Per-worker state.  The contended top index and the owner's fields live on separate cache lines, and each worker
+    // starts on its own cache line, so workers don't cause false sharing for each other.
+    struct Worker
+    {
+        PAL_ALIGN_CACHE_LINE std::atomic<int64> top;    // Next job to steal.  Modified by thieves and by the owner's
+                                                        // pop of the last job.
+        PAL_ALIGN_CACHE_LINE std::atomic<int64> bottom; // Next free slot.  Only modified by the owner.
+        JobSlot*           pSlots;
+        uint32             mask;        // Deque capacity minus one.
+        uint32             index;
+        uint32             rngState;    // Victim selection state.
+        bool               started;     // The worker's thread was successfully launched.
+        JobSystem*         pOwner;
+        Thread             thread;
+    };
+
+    static void WorkerMain(void* pParam);
+    static void ParallelForJob(void* pData);
+
+    Worker* CurrentWorker() const;
+
+    bool Push(Worker* pWorker, const Job& job);
+    bool Pop(Worker* pWorker, Job* pJob);
+    bool Steal(Worker* pVictim, Job* pJob);
+    bool PushInject(const Job& job);
+    bool PopInject(Job* pJob);
+
+    bool FindJob(Worker* pWorker, uint32* pRngState, Job* pJob);
+    bool HasQueuedJobs() const;
+    void RunJob(const Job& job);
+    void WakeWorkers(uint32 count);
+
+    void Shutdown();
+
+    IndirectAllocator  m_allocator;
+
+    uint32             m_numWorkers;
+    Worker*            m_pWorkers;
+    JobSlot*           m_pSlots;            // Backing storage for all of the workers' deques.
+
+    ThreadLocalKey     m_workerKey;         // Maps worker threads to their Worker; null for other threads.
+    bool               m_workerKeyValid;
+
+    JobThreadCallbacks m_threadCallbacks;
+    bool               m_useClientThreads;
+
+    // Bounded ring of jobs submitted by threads which aren't workers.
+    Mutex              m_injectLock;
+    uint32             m_injectHead;
+    uint32             m_injectCount;
+    uint32             m_injectCapacity;
+    Job*               m_pInjectQueue;
+    std::atomic<uint32> m_injectPending;   // Mirrors m_injectCount so idle workers can poll it without the lock.
+
+    Semaphore          m_wakeSemaphore;
+    std::atomic<uint32> m_numSleeping;
+    std::atomic<bool>  m_shutdown;
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(JobSystem);
+    PAL_DISALLOW_DEFAULT_CTOR(JobSystem);
+};
+
+} // Util
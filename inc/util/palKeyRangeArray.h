@@ -0,0 +1,204 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2018-2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  palKeyRangeArray.h
+* @brief PAL utility collection KeyRangeArray class declaration.
+***********************************************************************************************************************
+*/
+
+#pragma once
+
+#include "palInlineFuncs.h"
+
+namespace Util
+{
+
+/**
+ ***********************************************************************************************************************
+ * @brief KeyRangeArray container.
+ *
+ * KeyRangeArray is a fixed-size array with one slot for every key within a specific set of key ranges.  It trades the
+ * memory savings of @ref SparseVector for speed: the slot of a key is a compile-time function of the key ranges, so
+ * inserting or looking up an element never has to count or move the other elements, and a lookup of a constant key
+ * folds down to a fixed offset.
+ *
+ * State about whether a specific key's entry exists is stored in a bitset.  Slots of keys without an entry are left
+ * uninitialized.
+ *
+ * This container is meant for short-lived, densely-keyed data such as the register values of a pipeline, and it should
+ * not be used when the key ranges are large.  Only POD types are supported.
+ *
+ * Operations which this class supports are:
+ *
+ * - Random insertion. (O(1))
+ * - Random access.    (O(1))
+ *
+ * @warning This class is not thread-safe.
+ ***********************************************************************************************************************
+*/
+template <typename T,
+          uint32...  KeyRanges>       ///< This variadic template argument must come in [begin, end] pairs.
+class KeyRangeArray
+{
+static_assert(std::is_pod<T>::value, "KeyRangeArray only supports trivial types.");
+static_assert(((sizeof...(KeyRanges) >= 2) && ((sizeof...(KeyRanges) & 1) == 0)), "KeyRanges must come in pairs.");
+
+public:
+    /// Constructor.
+    KeyRangeArray() : m_numElements(0) { memset(&m_hasEntry[0], 0, sizeof(m_hasEntry)); }
+
+    /// Destructor.
+    ~KeyRangeArray() { }
+
+    /// Associates a key with the given value, replacing any value the key already had.
+    ///
+    /// @param [in] key    Key of the entry to insert.
+    /// @param [in] value  Value of the entry to insert.
+    ///
+    /// @returns Success if successful, ErrorInvalidValue if the key is not within any of the key ranges.
+    Result Insert(uint32 key, T value)
+    {
+        Result result = Result::ErrorInvalidValue;
+
+        if (IsValidKey(key))
+        {
+            const uint32 keyIndex = KeyIndex(key);
+
+            if (WideBitfieldIsSet(m_hasEntry, keyIndex) == false)
+            {
+                WideBitfieldSetBit(m_hasEntry, keyIndex);
+                ++m_numElements;
+            }
+
+            m_data[keyIndex] = value;
+            result           = Result::Success;
+        }
+
+        return result;
+    }
+
+    /// Removes an entry from the container.
+    void Erase(uint32 key)
+    {
+        PAL_ASSERT(IsValidKey(key));
+        const uint32 keyIndex = KeyIndex(key);
+
+        if (WideBitfieldIsSet(m_hasEntry, keyIndex))
+        {
+            WideBitfieldClearBit(m_hasEntry, keyIndex);
+            --m_numElements;
+        }
+    }
+
+    /// Empty the container.
+    void Clear()
+    {
+        memset(&m_hasEntry[0], 0, sizeof(m_hasEntry));
+        m_numElements = 0;
+    }
+
+    /// Returns the element associated with the given key.
+    ///
+    /// @param [in] key  Key to query.
+    const T& At(uint32 key) const
+    {
+        PAL_ASSERT(HasEntry(key));
+        return m_data[KeyIndex(key)];
+    }
+
+    /// Returns the number of elements currently present in the container.
+    uint32 NumElements() const { return m_numElements; }
+
+    /// Returns if the specified key is active in the container.
+    ///
+    /// @param [in] key  Key to query.
+    bool HasEntry(uint32 key) const
+    {
+        PAL_ASSERT(IsValidKey(key));
+        return WideBitfieldIsSet(m_hasEntry, KeyIndex(key));
+    }
+
+    /// Returns if the specified key is active in the container, and if so, returns its associated element through an
+    /// output parameter.
+    ///
+    /// @param [in]  key     Key to query.
+    /// @param [out] pValue  Pointer to where to store the extracted value.
+    bool HasEntry(uint32 key, T* pValue) const
+    {
+        const bool hasEntry = HasEntry(key);
+
+        if (hasEntry)
+        {
+            *pValue = m_data[KeyIndex(key)];
+        }
+
+        return hasEntry;
+    }
+
+    /// Returns true if the specified key falls within one of the key ranges.
+    ///
+    /// @param [in] key  Key to query.
+    static constexpr bool IsValidKey(uint32 key) { return (CalcKeyIndex(key, 0, KeyRanges...) < NumKeys); }
+
+    /// Returns the slot of the specified key.  Keys outside of the key ranges map to @ref NumKeys.
+    ///
+    /// @param [in] key  Key to query.
+    static constexpr uint32 KeyIndex(uint32 key) { return CalcKeyIndex(key, 0, KeyRanges...); }
+
+private:
+    ///@{
+    /// Helper functions to compute the slot of a key and the number of keys a set of ranges encompasses.
+    static constexpr uint32 CalcKeyIndex(uint32 key, uint32 offset) { return offset; }
+
+    template <typename... Ts>
+    static constexpr uint32 CalcKeyIndex(uint32 key, uint32 offset, uint32 begin, uint32 end, Ts... moreRanges)
+    {
+        return ((key >= begin) && (key <= end)) ? ((key - begin) + offset)
+                                                : CalcKeyIndex(key, (offset + (end - begin) + 1), moreRanges...);
+    }
+
+    static constexpr uint32 CalcNumKeys() { return 0; }
+
+    template <typename... Ts>
+    static constexpr uint32 CalcNumKeys(uint32 begin, uint32 end, Ts... moreRanges)
+        { return ((end - begin) + 1 + CalcNumKeys(moreRanges...)); }
+    ///@}
+
+public:
+    /// Total number of keys (and slots) in all of the key ranges.
+    static constexpr uint32 NumKeys = CalcNumKeys(KeyRanges...);
+
+private:
+    static constexpr uint32 NumBitsetChunks = RoundUpQuotient(NumKeys, static_cast<uint32>(sizeof(uint64) * 8));
+
+    T       m_data[NumKeys];             // One slot for each key.
+    uint64  m_hasEntry[NumBitsetChunks]; // Bitset indicating which keys are present.
+    uint32  m_numElements;               // Number of keys which are present.
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(KeyRangeArray);
+};
+
+} // Util
@@ -34,6 +34,7 @@
 #include "palSysMemory.h"
 #include "palVector.h"
 #include "palSparseVector.h"
+#include "palKeyRangeArray.h"
 #include "palHashMap.h"
 
 #include <type_traits>
@@ -489,6 +490,17 @@ public:
     template <typename T, typename CapacityType, CapacityType DefaultCapacity, typename Allocator, uint32... KeyRanges>
     Result Unpack(SparseVector<T, CapacityType, DefaultCapacity, Allocator, KeyRanges...>* pSparseVector);
 
+    /// Unpacks the current map item into a KeyRangeArray of scalars, type casting if necessary.  Keys which are not
+    /// within the array's key ranges are skipped.
+    /// NOTE: This will advance the iterator to the last element.
+    ///
+    /// @param [out] pArray  Pointer to the KeyRangeArray to store the data in.
+    ///
+    /// @returns Result if successful, ErrorInvalidValue if @ref pArray cannot represent the current item,
+    /// Eof if unexpected end-of-file was reached.
+    template <typename T, uint32... KeyRanges>
+    Result Unpack(KeyRangeArray<T, KeyRanges...>* pArray);
+
     /// Unpacks the current map item as a HashMap of scalars, type casting if necessary.
     /// NOTE: This will advance the iterator to the last element.
     ///
@@ -209,6 +209,35 @@ Result MsgPackWriter::Pack(
     return GetStatus();
 }
 
+// =====================================================================================================================
+template <typename T, uint32... KeyRanges>
+Result MsgPackReader::Unpack(
+    KeyRangeArray<T, KeyRanges...>*  pArray)
+{
+    PAL_ASSERT(pArray != nullptr);
+    Result result = (m_context.item.type == CWP_ITEM_MAP) ? Result::Success : Result::ErrorInvalidValue;
+
+    for (uint32 i = m_context.item.as.map.size; ((result == Result::Success) && (i > 0)); --i)
+    {
+        uint32 key;
+        T      value;
+        result = UnpackNextPair(&key, &value);
+
+        // Metadata from a newer compiler may contain registers which this version of PAL doesn't know about.  Those are
+        // skipped rather than failing the whole map, just as unknown keys are skipped elsewhere in the metadata.
+        if ((result == Result::Success) && pArray->IsValidKey(key))
+        {
+            result = pArray->Insert(key, value);
+        }
+        else if (result == Result::Success)
+        {
+            PAL_ALERT_ALWAYS_MSG("Skipping unknown key 0x%X.", key);
+        }
+    }
+
+    return result;
+}
+
 // =====================================================================================================================
 template <typename Key,
           typename Value,
@@ -33,15 +33,33 @@
 
 #include "palSemaphore.h"
 
+#include <atomic>
+
 namespace Util
 {
 
 /// Function for each slot in the ring buffer.
 typedef bool (PAL_STDCALL *RingBufferSlotFunc)(uint32 slotIdx, void* pData, void* pBuffer);
 
+/// Specifies which threads may access a @ref RingBuffer concurrently.
+enum class RingBufferMode : uint32
+{
+    SingleProducerSingleConsumer = 0,   ///< One writer thread and one reader thread.  Slots are handed out in order
+                                        ///  and tracked by a pair of semaphores.
+    MultiProducerMultiConsumer,         ///< Any number of writer and reader threads.  Slots are claimed lock-free using
+                                        ///  per-slot sequence numbers; blocking waits sleep on an OS address-wait.
+};
+
 /**
 ************************************************************************************************************************
 * @brief  Simple container for a ring buffer, useful for multithreaded operations.
+*
+* In @ref RingBufferMode::MultiProducerMultiConsumer mode several threads may hold slots at once, so the ticket-based
+* overloads of the Get/Release functions must be used: every Get call returns a ticket identifying the claimed slot
+* which must be passed to the matching Release call.  The ticket-based overloads also work in the default mode.
+*
+* A slot only becomes readable once its writer releases it, and readers consume slots in the order they were claimed
+* for writing, so a writer which holds a slot for a long time delays the readers behind it.
 ************************************************************************************************************************
 */
 template <typename Allocator>
@@ -53,7 +71,12 @@ public:
     /// @param [in] numElements Number of entries in the ring buffer.
     /// @param [in] elementSize Size, in bytes, of each entry in the ring buffer.
     /// @param [in] pAllocator  The allocator that will allocate memory if required.
-    RingBuffer(uint32 numElements, size_t elementSize, Allocator*const pAllocator);
+    /// @param [in] mode        Which threads may access the ring buffer concurrently.
+    RingBuffer(
+        uint32          numElements,
+        size_t          elementSize,
+        Allocator*const pAllocator,
+        RingBufferMode  mode = RingBufferMode::SingleProducerSingleConsumer);
     ~RingBuffer() {};
 
     /// Initializes the ring buffer, allocating memory for usage.
@@ -94,7 +117,73 @@ public:
     /// Releases the currently held readable buffer.
     void ReleaseReadBuffer();
 
+    /// Retrieves the next buffer to write to, waiting up to waitTimeMs milliseconds for one to become available.
+    ///
+    /// @param [in]  waitTimeMs  Number of milliseconds to wait for the next available buffer.
+    /// @param [out] ppBuffer    Pointer to the claimed writeable buffer.
+    /// @param [out] pTicket     Identifies the claimed buffer; must be passed to ReleaseWriteBuffer().
+    ///
+    /// @returns @ref Success if a buffer is available within the wait time, @ref Timeout otherwise.
+    Result GetBufferForWriting(uint32 waitTimeMs, void** ppBuffer, uint64* pTicket);
+
+    /// Claims the next buffer to write to without waiting.
+    ///
+    /// @param [out] ppBuffer    Pointer to the claimed writeable buffer.
+    /// @param [out] pTicket     Identifies the claimed buffer; must be passed to ReleaseWriteBuffer().
+    ///
+    /// @returns @ref Success if a buffer was claimed, @ref NotReady if the ring buffer is full.
+    Result TryGetBufferForWriting(void** ppBuffer, uint64* pTicket);
+
+    /// Releases a writeable buffer, making it available to readers.
+    ///
+    /// @param [in] ticket  Ticket returned when the buffer was claimed.
+    void ReleaseWriteBuffer(uint64 ticket);
+
+    /// Retrieves the next buffer to read from, waiting up to waitTimeMs milliseconds for one to become available.
+    ///
+    /// @param [in]  waitTimeMs  Number of milliseconds to wait for the next available buffer.
+    /// @param [out] ppBuffer    Pointer to the claimed readable buffer.
+    /// @param [out] pTicket     Identifies the claimed buffer; must be passed to ReleaseReadBuffer().
+    ///
+    /// @returns @ref Success if a buffer is available within the wait time, @ref Timeout otherwise.
+    Result GetBufferForReading(uint32 waitTimeMs, const void** ppBuffer, uint64* pTicket);
+
+    /// Claims the next buffer to read from without waiting.
+    ///
+    /// @param [out] ppBuffer    Pointer to the claimed readable buffer.
+    /// @param [out] pTicket     Identifies the claimed buffer; must be passed to ReleaseReadBuffer().
+    ///
+    /// @returns @ref Success if a buffer was claimed, @ref NotReady if the ring buffer is empty.
+    Result TryGetBufferForReading(const void** ppBuffer, uint64* pTicket);
+
+    /// Releases a readable buffer, making it available to writers.
+    ///
+    /// @param [in] ticket  Ticket returned when the buffer was claimed.
+    void ReleaseReadBuffer(uint64 ticket);
+
+    /// Returns the access mode this ring buffer was created with.
+    RingBufferMode Mode() const { return m_mode; }
+
 private:
+    // Claims the slot at the position tracked by pPosition once its sequence number reaches position + sequenceOffset.
+    bool TryClaim(std::atomic<uint64>* pPosition, uint64 sequenceOffset, uint64* pTicket);
+
+    // Waits until TryClaim() succeeds or waitTimeMs elapses.  The epoch is bumped whenever a claim may have become
+    // possible.
+    Result WaitClaim(
+        uint32               waitTimeMs,
+        std::atomic<uint64>* pPosition,
+        uint64               sequenceOffset,
+        std::atomic<uint32>* pEpoch,
+        std::atomic<uint32>* pNumWaiters,
+        uint64*              pTicket);
+
+    // Publishes a new slot sequence number and wakes any threads waiting on the given epoch.
+    void Publish(uint64 ticket, uint64 sequence, std::atomic<uint32>* pEpoch, std::atomic<uint32>* pNumWaiters);
+
+    // Returns the buffer of the slot a ticket refers to.
+    void* SlotAddress(uint64 ticket) const;
+
     void*             m_pRingBuffer;  // Allocated ring buffer memory.
     const uint32      m_numElements;  // Number of elements in the ring buffer.
     const size_t      m_elementSize;  // Size of each element in the ring buffer.
@@ -103,6 +192,16 @@ private:
     Semaphore         m_semaWrite;    // Semaphore of the writer of the ring buffer.
     Semaphore         m_semaRead;     // Semaphore of the reader of the ring buffer.
     Allocator*const   m_pAllocator;    // Allocator for this ring buffer.
+    const RingBufferMode m_mode;       // Which threads may access the ring buffer concurrently.
+
+    // State for RingBufferMode::MultiProducerMultiConsumer.  Writers and readers each get their own cache lines.
+    std::atomic<uint64>* m_pSequences;  // Per-slot sequence numbers.
+    PAL_ALIGN_CACHE_LINE std::atomic<uint64> m_writePosition;  // Next position to be claimed by a writer.
+    std::atomic<uint32>  m_writableEpoch;                      // Bumped whenever a slot is released by a reader.
+    std::atomic<uint32>  m_numWriteWaiters;
+    PAL_ALIGN_CACHE_LINE std::atomic<uint64> m_readPosition;   // Next position to be claimed by a reader.
+    std::atomic<uint32>  m_readableEpoch;                      // Bumped whenever a slot is released by a writer.
+    std::atomic<uint32>  m_numReadWaiters;
 
     PAL_DISALLOW_COPY_AND_ASSIGN(RingBuffer);
 };
@@ -26,7 +26,9 @@
 #pragma once
 
 #include "palRingBuffer.h"
+#include "palInlineFuncs.h"
 #include "palSysMemory.h"
+#include "palSysUtil.h"
 
 namespace Util
 {
@@ -36,7 +38,8 @@ template <typename Allocator>
 RingBuffer<Allocator>::RingBuffer(
     uint32          numElements,
     size_t          elementSize,
-    Allocator*const pAllocator)
+    Allocator*const pAllocator,
+    RingBufferMode  mode)
     :
     m_pRingBuffer(nullptr),
     m_numElements(numElements),
@@ -45,7 +48,15 @@ RingBuffer<Allocator>::RingBuffer(
     m_readPointer(0),
     m_semaWrite(),
     m_semaRead(),
-    m_pAllocator(pAllocator)
+    m_pAllocator(pAllocator),
+    m_mode(mode),
+    m_pSequences(nullptr),
+    m_writePosition(0),
+    m_writableEpoch(0),
+    m_numWriteWaiters(0),
+    m_readPosition(0),
+    m_readableEpoch(0),
+    m_numReadWaiters(0)
 {
     PAL_ASSERT(numElements > 0);
     PAL_ASSERT(elementSize > 0);
@@ -61,14 +72,31 @@ Result RingBuffer<Allocator>::Init(
     Result result = Result::ErrorOutOfMemory;
     m_pRingBuffer = PAL_MALLOC(m_numElements * m_elementSize, m_pAllocator, SystemAllocType::AllocInternal);
 
-    if (m_pRingBuffer != nullptr)
+    if (m_mode == RingBufferMode::MultiProducerMultiConsumer)
     {
-        result = m_semaWrite.Init(m_numElements, m_numElements);
-    }
+        m_pSequences = static_cast<std::atomic<uint64>*>(PAL_MALLOC(sizeof(std::atomic<uint64>) * m_numElements,
+                                                                    m_pAllocator,
+                                                                    SystemAllocType::AllocInternal));
 
-    if (result == Result::Success)
+        if ((m_pRingBuffer != nullptr) && (m_pSequences != nullptr))
+        {
+            // Slot i is first writable at position i.
+            for (uint32 i = 0; i < m_numElements; i++)
+            {
+                m_pSequences[i].store(i, std::memory_order_relaxed);
+            }
+
+            result = Result::Success;
+        }
+    }
+    else if (m_pRingBuffer != nullptr)
     {
-        result = m_semaRead.Init(m_numElements, 0);
+        result = m_semaWrite.Init(m_numElements, m_numElements);
+
+        if (result == Result::Success)
+        {
+            result = m_semaRead.Init(m_numElements, 0);
+        }
     }
 
     if ((result == Result::Success) && (pfnInit != nullptr))
@@ -114,6 +142,7 @@ Result RingBuffer<Allocator>::Destroy(
     }
 
     PAL_SAFE_FREE(m_pRingBuffer, m_pAllocator);
+    PAL_SAFE_FREE(m_pSequences, m_pAllocator);
 
     return result;
 }
@@ -125,6 +154,8 @@ Result RingBuffer<Allocator>::GetBufferForWriting(
     uint32 waitTimeMs, // Wait time in milliseconds.
     void** ppBuffer)
 {
+    PAL_ASSERT(m_mode == RingBufferMode::SingleProducerSingleConsumer);
+
     Result result = Result::Timeout;
 
     if (m_semaWrite.Wait(waitTimeMs) == Result::Success)
@@ -141,6 +172,8 @@ Result RingBuffer<Allocator>::GetBufferForWriting(
 template <typename Allocator>
 void RingBuffer<Allocator>::ReleaseWriteBuffer()
 {
+    PAL_ASSERT(m_mode == RingBufferMode::SingleProducerSingleConsumer);
+
     m_writePointer = (m_writePointer + 1) % m_numElements;
 
     m_semaRead.Post();
@@ -153,6 +186,8 @@ Result RingBuffer<Allocator>::GetBufferForReading(
     uint32       waitTimeMs, // Wait time in milliseconds.
     const void** ppBuffer)
 {
+    PAL_ASSERT(m_mode == RingBufferMode::SingleProducerSingleConsumer);
+
     Result result = Result::Timeout;
 
     if (m_semaRead.Wait(waitTimeMs) == Result::Success)
@@ -169,9 +204,276 @@ Result RingBuffer<Allocator>::GetBufferForReading(
 template <typename Allocator>
 void RingBuffer<Allocator>::ReleaseReadBuffer()
 {
+    PAL_ASSERT(m_mode == RingBufferMode::SingleProducerSingleConsumer);
+
     m_readPointer = (m_readPointer + 1) % m_numElements;
 
     m_semaWrite.Post();
 }
 
+// =====================================================================================================================
+template <typename Allocator>
+void* RingBuffer<Allocator>::SlotAddress(
+    uint64 ticket
+    ) const
+{
+    return VoidPtrInc(m_pRingBuffer, static_cast<size_t>(ticket % m_numElements) * m_elementSize);
+}
+
+// =====================================================================================================================
+// Attempts to claim the slot at the current position of a writer or reader cursor.  The slot is claimable once its
+// sequence number equals the position plus sequenceOffset: zero for writers, one for readers.  A smaller sequence means
+// the ring buffer is full (for writers) or empty (for readers); a larger one means another thread claimed the position
+// first and the cursor must be reloaded.
+template <typename Allocator>
+bool RingBuffer<Allocator>::TryClaim(
+    std::atomic<uint64>* pPosition,
+    uint64               sequenceOffset,
+    uint64*              pTicket)
+{
+    bool   claimed  = false;
+    bool   done     = false;
+    uint64 position = pPosition->load(std::memory_order_relaxed);
+
+    while (done == false)
+    {
+        const uint64 sequence = m_pSequences[position % m_numElements].load(std::memory_order_acquire);
+        const int64  diff     = static_cast<int64>(sequence - (position + sequenceOffset));
+
+        if (diff == 0)
+        {
+            // On failure, compare_exchange_weak reloads position and we try again at the new position.
+            claimed = pPosition->compare_exchange_weak(position,
+                                                       position + 1,
+                                                       std::memory_order_relaxed,
+                                                       std::memory_order_relaxed);
+            done    = claimed;
+        }
+        else if (diff < 0)
+        {
+            done = true;
+        }
+        else
+        {
+            position = pPosition->load(std::memory_order_relaxed);
+        }
+    }
+
+    if (claimed)
+    {
+        *pTicket = position;
+    }
+
+    return claimed;
+}
+
+// =====================================================================================================================
+// Repeatedly tries to claim a slot, sleeping on the given epoch between attempts, until it succeeds or the wait time
+// runs out.
+template <typename Allocator>
+Result RingBuffer<Allocator>::WaitClaim(
+    uint32               waitTimeMs,
+    std::atomic<uint64>* pPosition,
+    uint64               sequenceOffset,
+    std::atomic<uint32>* pEpoch,
+    std::atomic<uint32>* pNumWaiters,
+    uint64*              pTicket)
+{
+    constexpr uint32 Infinite = UINT32_MAX;
+
+    const int64 startTime   = (waitTimeMs != Infinite) ? GetPerfCpuTime() : 0;
+    uint32      remainingMs = waitTimeMs;
+    Result      result      = Result::Timeout;
+
+    while (result == Result::Timeout)
+    {
+        // Sample the epoch before trying so that a release which happens after our attempt fails also changes the
+        // value WaitOnAddress() compares against, in which case it returns immediately.
+        const uint32 epoch = pEpoch->load(std::memory_order_acquire);
+
+        if (TryClaim(pPosition, sequenceOffset, pTicket))
+        {
+            result = Result::Success;
+        }
+        else if (remainingMs == 0)
+        {
+            break;
+        }
+        else
+        {
+            pNumWaiters->fetch_add(1, std::memory_order_seq_cst);
+            WaitOnAddress(reinterpret_cast<volatile uint32*>(pEpoch), epoch, remainingMs);
+            pNumWaiters->fetch_sub(1, std::memory_order_relaxed);
+
+            if (waitTimeMs != Infinite)
+            {
+                const uint64 elapsedMs = static_cast<uint64>(GetPerfCpuTime() - startTime) * 1000 /
+                                         static_cast<uint64>(GetPerfFrequency());
+
+                remainingMs = (elapsedMs >= waitTimeMs) ? 0 : static_cast<uint32>(waitTimeMs - elapsedMs);
+            }
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Makes a claimed slot available to the other side of the ring buffer by advancing its sequence number, then wakes
+// any threads on that side which went to sleep because no slot was available.
+template <typename Allocator>
+void RingBuffer<Allocator>::Publish(
+    uint64               ticket,
+    uint64               sequence,
+    std::atomic<uint32>* pEpoch,
+    std::atomic<uint32>* pNumWaiters)
+{
+    m_pSequences[ticket % m_numElements].store(sequence, std::memory_order_release);
+
+    // Pairs with the waiter count increment in WaitClaim(): either the waiter sees the new epoch and doesn't sleep,
+    // or we see the waiter and wake it.
+    pEpoch->fetch_add(1, std::memory_order_seq_cst);
+
+    if (pNumWaiters->load(std::memory_order_seq_cst) != 0)
+    {
+        WakeByAddress(reinterpret_cast<volatile uint32*>(pEpoch), true);
+    }
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+Result RingBuffer<Allocator>::GetBufferForWriting(
+    uint32  waitTimeMs,
+    void**  ppBuffer,
+    uint64* pTicket)
+{
+    Result result = Result::Timeout;
+
+    if (m_mode == RingBufferMode::MultiProducerMultiConsumer)
+    {
+        result = WaitClaim(waitTimeMs, &m_writePosition, 0, &m_writableEpoch, &m_numWriteWaiters, pTicket);
+
+        if (result == Result::Success)
+        {
+            (*ppBuffer) = SlotAddress(*pTicket);
+        }
+    }
+    else
+    {
+        result = GetBufferForWriting(waitTimeMs, ppBuffer);
+        (*pTicket) = m_writePointer;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+Result RingBuffer<Allocator>::TryGetBufferForWriting(
+    void**  ppBuffer,
+    uint64* pTicket)
+{
+    Result result = Result::NotReady;
+
+    if (m_mode == RingBufferMode::MultiProducerMultiConsumer)
+    {
+        if (TryClaim(&m_writePosition, 0, pTicket))
+        {
+            (*ppBuffer) = SlotAddress(*pTicket);
+            result      = Result::Success;
+        }
+    }
+    else if (GetBufferForWriting(0, ppBuffer, pTicket) == Result::Success)
+    {
+        result = Result::Success;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+void RingBuffer<Allocator>::ReleaseWriteBuffer(
+    uint64 ticket)
+{
+    if (m_mode == RingBufferMode::MultiProducerMultiConsumer)
+    {
+        // The slot becomes readable at this position.
+        Publish(ticket, ticket + 1, &m_readableEpoch, &m_numReadWaiters);
+    }
+    else
+    {
+        PAL_ASSERT(ticket == m_writePointer);
+        ReleaseWriteBuffer();
+    }
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+Result RingBuffer<Allocator>::GetBufferForReading(
+    uint32       waitTimeMs,
+    const void** ppBuffer,
+    uint64*      pTicket)
+{
+    Result result = Result::Timeout;
+
+    if (m_mode == RingBufferMode::MultiProducerMultiConsumer)
+    {
+        result = WaitClaim(waitTimeMs, &m_readPosition, 1, &m_readableEpoch, &m_numReadWaiters, pTicket);
+
+        if (result == Result::Success)
+        {
+            (*ppBuffer) = SlotAddress(*pTicket);
+        }
+    }
+    else
+    {
+        result = GetBufferForReading(waitTimeMs, ppBuffer);
+        (*pTicket) = m_readPointer;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+Result RingBuffer<Allocator>::TryGetBufferForReading(
+    const void** ppBuffer,
+    uint64*      pTicket)
+{
+    Result result = Result::NotReady;
+
+    if (m_mode == RingBufferMode::MultiProducerMultiConsumer)
+    {
+        if (TryClaim(&m_readPosition, 1, pTicket))
+        {
+            (*ppBuffer) = SlotAddress(*pTicket);
+            result      = Result::Success;
+        }
+    }
+    else if (GetBufferForReading(0, ppBuffer, pTicket) == Result::Success)
+    {
+        result = Result::Success;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+void RingBuffer<Allocator>::ReleaseReadBuffer(
+    uint64 ticket)
+{
+    if (m_mode == RingBufferMode::MultiProducerMultiConsumer)
+    {
+        // The slot becomes writable again one full lap later.
+        Publish(ticket, ticket + m_numElements, &m_writableEpoch, &m_numWriteWaiters);
+    }
+    else
+    {
+        PAL_ASSERT(ticket == m_readPointer);
+        ReleaseReadBuffer();
+    }
+}
+
 } // Util
@@ -0,0 +1,192 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palSlabAllocator.h
+ * @brief PAL utility SlabAllocator class declaration.
+ ***********************************************************************************************************************
+ */
+
+#pragma once
+
+#include "palMutex.h"
+#include "palSysMemory.h"
+#include "palThread.h"
+
+namespace Util
+{
+
+/**
+ ***********************************************************************************************************************
+ * @brief Thread-caching size-class allocator for small system memory allocations.
+ *
+ * Small requests are rounded up to one of a fixed set of size classes and carved out of large slabs which are obtained
+ * from the backing allocator.  Each thread which allocates from a SlabAllocator gets a private cache of free blocks for
+ * every size class, so steady-state allocations and frees never touch a lock or the backing allocator.  Caches are
+ * refilled from (and overflow back to) per-size-class central free lists in batches.
+ *
+ * Requests which are larger than the largest size class, or which require more than @ref PAL_DEFAULT_MEM_ALIGN
+ * alignment, are forwarded to the backing allocator.
+ *
+ * Slab memory is never returned to the backing allocator until the SlabAllocator is destroyed.  All memory allocated
+ * from a SlabAllocator becomes invalid once it is destroyed.
+ *
+ * This allocator can be used with any of the memory management macros. @see Allocators for more information about the
+ * Allocation pattern.  @ref GetAllocCallbacks() can be used to expose it through the @ref AllocCallbacks interface,
+ * for example to install it as a Platform's internal allocator.
+ ***********************************************************************************************************************
+ */
+template <typename Allocator>
+class SlabAllocator
+{
+public:
+    /// Number of distinct size classes.
+    static constexpr uint32 NumSizeClasses = 23;
+    /// Size in bytes of the largest block (including its header) which is served from a slab.
+    static constexpr size_t MaxBlockSize   = 2048;
+    /// Size in bytes of each slab requested from the backing allocator.
+    static constexpr size_t SlabSize       = 64 * 1024;
+
+    /// Constructor.
+    ///
+    /// @param [in] pAllocator The allocator which provides slabs and services large allocations.
+    explicit SlabAllocator(Allocator* pAllocator);
+    ~SlabAllocator();
+
+    /// Initializes the slab allocator.
+    ///
+    /// @returns Success if the thread-local cache key was created, otherwise an appropriate error code.
+    Result Init();
+
+    /// Allocates a block of memory.
+    ///
+    /// @param [in] allocInfo Contains information about the requested allocation.
+    ///
+    /// @returns Pointer to the allocated memory, nullptr if the allocation failed.
+    void* Alloc(const AllocInfo& allocInfo);
+
+    /// Frees a block of memory.
+    ///
+    /// @param [in] freeInfo Contains information about the requested free.
+    void  Free(const FreeInfo& freeInfo);
+
+    /// Fills out an @ref AllocCallbacks structure which forwards to this allocator.  The callbacks are valid for the
+    /// lifetime of this object.
+    ///
+    /// @param [out] pAllocCb Callback structure to fill out.  Must not be null.
+    void GetAllocCallbacks(AllocCallbacks* pAllocCb);
+
+private:
+    // Every block is preceded by a header which identifies where it came from.  Its size also guarantees that the
+    // returned pointer keeps the default allocation alignment.
+    struct BlockHeader
+    {
+        uint32 sizeClass;   // Index of the block's size class, or LargeBlock if it came from the backing allocator.
+        uint32 reserved;
+        void*  pBase;       // Original backing allocation for large blocks.  Unused for slab blocks.
+    };
+
+    static_assert(sizeof(BlockHeader) == PAL_DEFAULT_MEM_ALIGN, "BlockHeader must preserve the default alignment!");
+
+    static constexpr uint32 LargeBlock = UINT32_MAX;
+
+    // Free blocks are kept in singly-linked lists threaded through the blocks themselves.
+    struct FreeBlock
+    {
+        FreeBlock* pNext;
+    };
+
+    // Simple singly-linked list of free blocks with a count.
+    struct FreeList
+    {
+        FreeBlock* pHead;
+        uint32     count;
+    };
+
+    // Central state for one size class, shared by all threads.
+    struct SizeClass
+    {
+        Mutex    lock;
+        FreeList freeList;
+        void*    pSlabCur;      // Next uncarved byte of the slab currently being carved.
+        void*    pSlabEnd;      // End of the slab currently being carved.
+    };
+
+    // Per-thread cache of free blocks.  Caches are linked together so the allocator can release them on destruction.
+    struct ThreadCache
+    {
+        SlabAllocator* pOwner;
+        ThreadCache*   pPrev;
+        ThreadCache*   pNext;
+        FreeList       lists[NumSizeClasses];
+    };
+
+    // Header placed at the start of every slab so that slabs can be released on destruction.
+    struct SlabHeader
+    {
+        SlabHeader* pNext;
+    };
+
+    static void* PAL_STDCALL AllocCb(void* pClientData, size_t size, size_t alignment, SystemAllocType allocType);
+    static void  PAL_STDCALL FreeCb(void* pClientData, void* pMem);
+    static void  ThreadCacheDestructor(void* pCache);
+
+    void* Allocate(size_t size, size_t alignment, SystemAllocType allocType);
+    void  Release(void* pMem);
+
+    void* AllocateLarge(size_t size, size_t alignment, SystemAllocType allocType);
+
+    ThreadCache* GetThreadCache();
+    void         FlushThreadCache(ThreadCache* pCache);
+
+    uint32 RefillFromCentral(uint32 sizeClass, FreeList* pDst, uint32 count);
+    void   ReturnToCentral(uint32 sizeClass, FreeList* pSrc, uint32 count);
+    void*  CarveSlab(SizeClass* pClass, uint32 sizeClass);
+
+    // Number of blocks transferred between a thread cache and the central list at a time.
+    uint32 BatchSize(uint32 sizeClass) const { return m_batchSize[sizeClass]; }
+
+    static size_t ClassBlockSize(uint32 sizeClass);
+
+    Allocator*const m_pAllocator;
+
+    ThreadLocalKey  m_cacheKey;
+    bool            m_cacheKeyValid;
+
+    SizeClass       m_classes[NumSizeClasses];
+    uint32          m_batchSize[NumSizeClasses];
+    uint8           m_classLookup[(MaxBlockSize / PAL_DEFAULT_MEM_ALIGN) + 1]; // Block size in 16-byte units to class.
+
+    Mutex           m_slabLock;
+    SlabHeader*     m_pSlabList;
+
+    Mutex           m_cacheLock;
+    ThreadCache*    m_pCacheList;
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(SlabAllocator);
+    PAL_DISALLOW_DEFAULT_CTOR(SlabAllocator);
+};
+
+} // Util
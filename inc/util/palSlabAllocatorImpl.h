@@ -0,0 +1,528 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palSlabAllocatorImpl.h
+ * @brief PAL utility SlabAllocator class implementation.
+ ***********************************************************************************************************************
+ */
+
+#pragma once
+
+#include "palSlabAllocator.h"
+#include "palInlineFuncs.h"
+
+namespace Util
+{
+
+// =====================================================================================================================
+template <typename Allocator>
+SlabAllocator<Allocator>::SlabAllocator(
+    Allocator* pAllocator)
+    :
+    m_pAllocator(pAllocator),
+    m_cacheKey(),
+    m_cacheKeyValid(false),
+    m_pSlabList(nullptr),
+    m_pCacheList(nullptr)
+{
+    PAL_ASSERT(m_pAllocator != nullptr);
+
+    uint32 sizeClass = 0;
+
+    for (uint32 units = 0; units < ArrayLen(m_classLookup); ++units)
+    {
+        while (ClassBlockSize(sizeClass) < (units * PAL_DEFAULT_MEM_ALIGN))
+        {
+            sizeClass++;
+        }
+
+        m_classLookup[units] = static_cast<uint8>(sizeClass);
+    }
+
+    PAL_ASSERT(ClassBlockSize(NumSizeClasses - 1) == MaxBlockSize);
+
+    for (uint32 i = 0; i < NumSizeClasses; ++i)
+    {
+        // Move roughly 4KB worth of blocks between the central lists and the thread caches at a time.
+        m_batchSize[i] = Clamp(static_cast<uint32>(4096 / ClassBlockSize(i)), 4u, 64u);
+
+        m_classes[i].freeList.pHead = nullptr;
+        m_classes[i].freeList.count = 0;
+        m_classes[i].pSlabCur       = nullptr;
+        m_classes[i].pSlabEnd       = nullptr;
+    }
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+SlabAllocator<Allocator>::~SlabAllocator()
+{
+    if (m_cacheKeyValid)
+    {
+        // Deleting the key first guarantees that no thread-exit destructor can race with the teardown below.
+        const Result result = DeleteThreadLocalKey(m_cacheKey);
+        PAL_ASSERT(result == Result::_Success);
+    }
+
+    // Cached blocks live inside the slabs, so the caches themselves can simply be freed.
+    while (m_pCacheList != nullptr)
+    {
+        ThreadCache*const pNext = m_pCacheList->pNext;
+        PAL_FREE(m_pCacheList, m_pAllocator);
+        m_pCacheList = pNext;
+    }
+
+    while (m_pSlabList != nullptr)
+    {
+        SlabHeader*const pNext = m_pSlabList->pNext;
+        PAL_FREE(m_pSlabList, m_pAllocator);
+        m_pSlabList = pNext;
+    }
+}
+
+// =====================================================================================================================
+// Returns the block size (including the block header) of the given size class.  Classes are spaced four per power of
+// two so no more than 25% of a block is wasted on rounding.
+template <typename Allocator>
+size_t SlabAllocator<Allocator>::ClassBlockSize(
+    uint32 sizeClass)
+{
+    static const uint16 BlockSizes[NumSizeClasses] =
+    {
+          32,   48,   64,   80,   96,  112,  128,
+         160,  192,  224,  256,
+         320,  384,  448,  512,
+         640,  768,  896, 1024,
+        1280, 1536, 1792, 2048,
+    };
+
+    return (sizeClass < NumSizeClasses) ? BlockSizes[sizeClass] : SIZE_MAX;
+}
+
+// =====================================================================================================================
+// Creates the thread-local key used to find each thread's cache.
+template <typename Allocator>
+Result SlabAllocator<Allocator>::Init()
+{
+    PAL_ASSERT(m_cacheKeyValid == false);
+
+    Result result = CreateThreadLocalKey(&m_cacheKey, &ThreadCacheDestructor);
+
+    if (result == Result::_Success)
+    {
+        m_cacheKeyValid = true;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+void* SlabAllocator<Allocator>::Alloc(
+    const AllocInfo& allocInfo)
+{
+    void* pMem = Allocate(allocInfo.bytes, allocInfo.alignment, allocInfo.allocType);
+
+    if ((pMem != nullptr) && allocInfo.zeroMem)
+    {
+        memset(pMem, 0, allocInfo.bytes);
+    }
+
+    return pMem;
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+void SlabAllocator<Allocator>::Free(
+    const FreeInfo& freeInfo)
+{
+    if (freeInfo.pClientMem != nullptr)
+    {
+        Release(freeInfo.pClientMem);
+    }
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+void SlabAllocator<Allocator>::GetAllocCallbacks(
+    AllocCallbacks* pAllocCb)
+{
+    PAL_ASSERT(pAllocCb != nullptr);
+
+    pAllocCb->pClientData = this;
+    pAllocCb->pfnAlloc    = &AllocCb;
+    pAllocCb->pfnFree     = &FreeCb;
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+void* PAL_STDCALL SlabAllocator<Allocator>::AllocCb(
+    void*           pClientData,
+    size_t          size,
+    size_t          alignment,
+    SystemAllocType allocType)
+{
+    return static_cast<SlabAllocator*>(pClientData)->Allocate(size, alignment, allocType);
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+void PAL_STDCALL SlabAllocator<Allocator>::FreeCb(
+    void* pClientData,
+    void* pMem)
+{
+    if (pMem != nullptr)
+    {
+        static_cast<SlabAllocator*>(pClientData)->Release(pMem);
+    }
+}
+
+// =====================================================================================================================
+// Called on thread exit for every thread which owns a cache.  Hands the cached blocks back to the central lists.
+template <typename Allocator>
+void SlabAllocator<Allocator>::ThreadCacheDestructor(
+    void* pCache)
+{
+    ThreadCache*const pThreadCache = static_cast<ThreadCache*>(pCache);
+    pThreadCache->pOwner->FlushThreadCache(pThreadCache);
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+void* SlabAllocator<Allocator>::Allocate(
+    size_t          size,
+    size_t          alignment,
+    SystemAllocType allocType)
+{
+    // Allocating zero bytes of memory results in undefined behavior.
+    PAL_ASSERT(size > 0);
+
+    const size_t blockSize = Pow2Align(size + sizeof(BlockHeader), PAL_DEFAULT_MEM_ALIGN);
+    void*        pMem      = nullptr;
+
+    if ((blockSize > MaxBlockSize) || (alignment > PAL_DEFAULT_MEM_ALIGN) || (m_cacheKeyValid == false))
+    {
+        pMem = AllocateLarge(size, alignment, allocType);
+    }
+    else
+    {
+        const uint32      sizeClass = m_classLookup[blockSize / PAL_DEFAULT_MEM_ALIGN];
+        ThreadCache*const pCache    = GetThreadCache();
+        FreeBlock*        pBlock    = nullptr;
+
+        if (pCache != nullptr)
+        {
+            FreeList*const pList = &pCache->lists[sizeClass];
+
+            if (pList->pHead == nullptr)
+            {
+                RefillFromCentral(sizeClass, pList, BatchSize(sizeClass));
+            }
+
+            pBlock = pList->pHead;
+
+            if (pBlock != nullptr)
+            {
+                pList->pHead = pBlock->pNext;
+                pList->count--;
+            }
+        }
+        else
+        {
+            // We couldn't create a cache for this thread; fall back to the central list one block at a time.
+            FreeList list = { };
+            RefillFromCentral(sizeClass, &list, 1);
+            pBlock = list.pHead;
+        }
+
+        if (pBlock != nullptr)
+        {
+            BlockHeader*const pHeader = reinterpret_cast<BlockHeader*>(pBlock);
+            pHeader->sizeClass = sizeClass;
+            pHeader->pBase     = nullptr;
+
+            pMem = VoidPtrInc(pHeader, sizeof(BlockHeader));
+        }
+    }
+
+    return pMem;
+}
+
+// =====================================================================================================================
+// Services an allocation which cannot come from a slab directly from the backing allocator.
+template <typename Allocator>
+void* SlabAllocator<Allocator>::AllocateLarge(
+    size_t          size,
+    size_t          alignment,
+    SystemAllocType allocType)
+{
+    const size_t align = Max(alignment, sizeof(BlockHeader));
+    void*const   pBase = PAL_MALLOC_ALIGNED(size + align, align, m_pAllocator, allocType);
+    void*        pMem  = nullptr;
+
+    if (pBase != nullptr)
+    {
+        pMem = VoidPtrInc(pBase, align);
+
+        BlockHeader*const pHeader = static_cast<BlockHeader*>(VoidPtrDec(pMem, sizeof(BlockHeader)));
+        pHeader->sizeClass = LargeBlock;
+        pHeader->pBase     = pBase;
+    }
+
+    return pMem;
+}
+
+// =====================================================================================================================
+template <typename Allocator>
+void SlabAllocator<Allocator>::Release(
+    void* pMem)
+{
+    BlockHeader*const pHeader   = static_cast<BlockHeader*>(VoidPtrDec(pMem, sizeof(BlockHeader)));
+    const uint32      sizeClass = pHeader->sizeClass;
+
+    if (sizeClass == LargeBlock)
+    {
+        PAL_FREE(pHeader->pBase, m_pAllocator);
+    }
+    else
+    {
+        PAL_ASSERT(sizeClass < NumSizeClasses);
+
+        FreeBlock*const   pBlock = reinterpret_cast<FreeBlock*>(pHeader);
+        ThreadCache*const pCache = GetThreadCache();
+
+        if (pCache != nullptr)
+        {
+            FreeList*const pList = &pCache->lists[sizeClass];
+
+            pBlock->pNext = pList->pHead;
+            pList->pHead  = pBlock;
+            pList->count++;
+
+            // Keep at most two batches per size class per thread so that memory freed on one thread can be reused by
+            // others.
+            if (pList->count > (2 * BatchSize(sizeClass)))
+            {
+                ReturnToCentral(sizeClass, pList, BatchSize(sizeClass));
+            }
+        }
+        else
+        {
+            FreeList list = { pBlock, 1 };
+            pBlock->pNext = nullptr;
+            ReturnToCentral(sizeClass, &list, 1);
+        }
+    }
+}
+
+// =====================================================================================================================
+// Returns the calling thread's cache, creating it on first use.  Returns null if the cache could not be created.
+template <typename Allocator>
+typename SlabAllocator<Allocator>::ThreadCache* SlabAllocator<Allocator>::GetThreadCache()
+{
+    ThreadCache* pCache = static_cast<ThreadCache*>(GetThreadLocalValue(m_cacheKey));
+
+    if (pCache == nullptr)
+    {
+        pCache = static_cast<ThreadCache*>(PAL_CALLOC(sizeof(ThreadCache), m_pAllocator, AllocInternal));
+
+        if (pCache != nullptr)
+        {
+            if (SetThreadLocalValue(m_cacheKey, pCache) == Result::_Success)
+            {
+                pCache->pOwner = this;
+
+                MutexAuto lock(&m_cacheLock);
+
+                pCache->pNext = m_pCacheList;
+                if (m_pCacheList != nullptr)
+                {
+                    m_pCacheList->pPrev = pCache;
+                }
+                m_pCacheList = pCache;
+            }
+            else
+            {
+                PAL_SAFE_FREE(pCache, m_pAllocator);
+            }
+        }
+    }
+
+    return pCache;
+}
+
+// =====================================================================================================================
+// Returns every block held by the given thread cache to the central lists, then destroys the cache.
+template <typename Allocator>
+void SlabAllocator<Allocator>::FlushThreadCache(
+    ThreadCache* pCache)
+{
+    for (uint32 sizeClass = 0; sizeClass < NumSizeClasses; ++sizeClass)
+    {
+        FreeList*const pList = &pCache->lists[sizeClass];
+
+        if (pList->count > 0)
+        {
+            ReturnToCentral(sizeClass, pList, pList->count);
+        }
+    }
+
+    {
+        MutexAuto lock(&m_cacheLock);
+
+        if (pCache->pPrev != nullptr)
+        {
+            pCache->pPrev->pNext = pCache->pNext;
+        }
+        else
+        {
+            m_pCacheList = pCache->pNext;
+        }
+
+        if (pCache->pNext != nullptr)
+        {
+            pCache->pNext->pPrev = pCache->pPrev;
+        }
+    }
+
+    PAL_FREE(pCache, m_pAllocator);
+}
+
+// =====================================================================================================================
+// Moves up to "count" blocks from the central list of the given size class into pDst, carving new blocks out of slabs
+// as needed.  Returns the number of blocks moved.
+template <typename Allocator>
+uint32 SlabAllocator<Allocator>::RefillFromCentral(
+    uint32    sizeClass,
+    FreeList* pDst,
+    uint32    count)
+{
+    SizeClass*const pClass = &m_classes[sizeClass];
+    uint32          moved  = 0;
+
+    MutexAuto lock(&pClass->lock);
+
+    while (moved < count)
+    {
+        FreeBlock* pBlock = pClass->freeList.pHead;
+
+        if (pBlock != nullptr)
+        {
+            pClass->freeList.pHead = pBlock->pNext;
+            pClass->freeList.count--;
+        }
+        else
+        {
+            pBlock = static_cast<FreeBlock*>(CarveSlab(pClass, sizeClass));
+
+            if (pBlock == nullptr)
+            {
+                break;
+            }
+        }
+
+        pBlock->pNext = pDst->pHead;
+        pDst->pHead   = pBlock;
+        pDst->count++;
+        moved++;
+    }
+
+    return moved;
+}
+
+// =====================================================================================================================
+// Moves "count" blocks from the front of pSrc onto the central list of the given size class.
+template <typename Allocator>
+void SlabAllocator<Allocator>::ReturnToCentral(
+    uint32    sizeClass,
+    FreeList* pSrc,
+    uint32    count)
+{
+    PAL_ASSERT((count > 0) && (count <= pSrc->count));
+
+    FreeBlock*const pFirst = pSrc->pHead;
+    FreeBlock*      pLast  = pFirst;
+
+    for (uint32 i = 1; i < count; ++i)
+    {
+        pLast = pLast->pNext;
+    }
+
+    pSrc->pHead  = pLast->pNext;
+    pSrc->count -= count;
+
+    SizeClass*const pClass = &m_classes[sizeClass];
+
+    MutexAuto lock(&pClass->lock);
+
+    pLast->pNext            = pClass->freeList.pHead;
+    pClass->freeList.pHead  = pFirst;
+    pClass->freeList.count += count;
+}
+
+// =====================================================================================================================
+// Carves one block out of the size class's current slab, requesting a new slab from the backing allocator if the
+// current one is exhausted.  The caller must hold the size class lock.
+template <typename Allocator>
+void* SlabAllocator<Allocator>::CarveSlab(
+    SizeClass* pClass,
+    uint32     sizeClass)
+{
+    const size_t blockSize = ClassBlockSize(sizeClass);
+
+    if ((pClass->pSlabCur == nullptr) || (VoidPtrDiff(pClass->pSlabEnd, pClass->pSlabCur) < blockSize))
+    {
+        SlabHeader*const pSlab = static_cast<SlabHeader*>(PAL_MALLOC_ALIGNED(SlabSize,
+                                                                             PAL_DEFAULT_MEM_ALIGN,
+                                                                             m_pAllocator,
+                                                                             AllocInternal));
+
+        if (pSlab != nullptr)
+        {
+            {
+                MutexAuto lock(&m_slabLock);
+                pSlab->pNext = m_pSlabList;
+                m_pSlabList  = pSlab;
+            }
+
+            // Any leftover space at the end of the previous slab is smaller than one block and is simply abandoned.
+            pClass->pSlabCur = VoidPtrInc(pSlab, Pow2Align(sizeof(SlabHeader), PAL_DEFAULT_MEM_ALIGN));
+            pClass->pSlabEnd = VoidPtrInc(pSlab, SlabSize);
+        }
+    }
+
+    void* pBlock = nullptr;
+
+    if ((pClass->pSlabCur != nullptr) && (VoidPtrDiff(pClass->pSlabEnd, pClass->pSlabCur) >= blockSize))
+    {
+        pBlock           = pClass->pSlabCur;
+        pClass->pSlabCur = VoidPtrInc(pClass->pSlabCur, blockSize);
+    }
+
+    return pBlock;
+}
+
+} // Util
@@ -427,6 +427,24 @@ PAL_INLINE void MemoryBarrier()
 /// @param [in] duration  Amount of time to sleep for, in milliseconds.
 extern void SleepMs(uint32 duration);
 
+/// Puts the calling thread to sleep until another thread calls @ref WakeByAddress on the given address, as long as the
+/// value at that address still equals compareValue.  This is a thin wrapper around the OS's address-wait primitive
+/// (a futex on Linux) and may return spuriously, so callers must re-check their wakeup condition in a loop.
+///
+/// @param [in] pAddress      Address to wait on.  Must be 4-byte aligned.
+/// @param [in] compareValue  Value the caller last observed at pAddress.  No wait occurs if they differ.
+/// @param [in] milliseconds  Maximum time to wait; UINT32_MAX waits indefinitely.
+///
+/// @returns Success if the thread was woken (or pAddress no longer held compareValue), Timeout if the wait timed out,
+///          or ErrorUnknown if an unexpected OS error occurred.
+extern Result WaitOnAddress(const volatile uint32* pAddress, uint32 compareValue, uint32 milliseconds);
+
+/// Wakes threads blocked in @ref WaitOnAddress on the given address.
+///
+/// @param [in] pAddress  Address which other threads may be waiting on.
+/// @param [in] wakeAll   If true, every waiter is woken; otherwise at most one.
+extern void WakeByAddress(const volatile uint32* pAddress, bool wakeAll);
+
 /// Check if the requested key is combo key.
 ///
 /// @param [in]  key    The requested key value
@@ -491,6 +509,42 @@ PAL_INLINE void CpuId(
 }
 #endif
 
+/// Instruction set extensions which can be queried with @ref CpuSupportsFeature().
+enum class CpuFeature : uint32
+{
+    Sse2 = 0, ///< SSE2
+    Ssse3,    ///< Supplemental SSE3
+    Sse41,    ///< SSE4.1
+    Sse42,    ///< SSE4.2
+    Popcnt,   ///< POPCNT instruction
+    Avx,      ///< AVX, including OS support for saving the YMM state
+    Avx2,     ///< AVX2, including OS support for saving the YMM state
+    Bmi2,     ///< BMI2
+    ShaNi,    ///< SHA-1 and SHA-256 extensions
+    F16c,     ///< Half-precision conversion instructions, including OS support for saving the YMM state
+    Count
+};
+
+/// Determines whether the CPU (and OS, where it matters) supports an instruction set extension.
+///
+/// The CPU is only queried the first time this is called; the results are cached for the lifetime of the process so
+/// this is cheap enough to call when selecting between code paths.  Always returns false for every feature on CPUs
+/// which do not support the cpuid instruction.
+///
+/// @param [in] feature  Instruction set extension to query.
+///
+/// @returns True if code using the extension may be executed on the current CPU.
+extern bool CpuSupportsFeature(CpuFeature feature);
+
+#if PAL_HAS_CPUID
+/// Lets a single function use an instruction set extension which the rest of its translation unit is not compiled
+/// for.  Such functions must only be called once @ref CpuSupportsFeature() has confirmed that the extension is present.
+#define PAL_TARGET_SSE2  __attribute__((target("sse2")))
+#define PAL_TARGET_AVX2  __attribute__((target("avx2")))
+#define PAL_TARGET_F16C  __attribute__((target("avx,f16c")))
+#define PAL_TARGET_SHANI __attribute__((target("sha,sse4.1")))
+#endif
+
 /// Play beep sound. Currently function implemented only for WIN platform.
 ///
 /// @param [in]  frequency  Frequency in hertz of the beep sound.
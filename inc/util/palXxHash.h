@@ -0,0 +1,110 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palXxHash.h
+ * @brief PAL utility collection XxHash128 class declaration.
+ ***********************************************************************************************************************
+ */
+
+#pragma once
+
+#include "palUtil.h"
+
+namespace Util
+{
+
+/**
+ ***********************************************************************************************************************
+ * @brief Streaming 128-bit non-cryptographic hash using the XXH3 algorithm.
+ *
+ * This produces the same values as the reference XXH3_128bits_withSeed() function.  It is considerably faster than
+ * MetroHash128 for large inputs since the bulk of the work is done with SSE2 or AVX2 when the CPU supports them; the
+ * kernel is selected at runtime.  The interface mirrors MetroHash128 so the two can be used interchangeably, and the
+ * output can be written directly into a @ref MetroHash::Hash.
+ *
+ * The 16 output bytes hold the low 64 bits of the hash followed by the high 64 bits, both in CPU byte order.
+ ***********************************************************************************************************************
+ */
+class XxHash128
+{
+public:
+    /// Size of the hash output in bits.
+    static const uint32 bits = 128;
+
+    /// Constructor.
+    ///
+    /// @param [in] seed Seed value which perturbs the hash.
+    explicit XxHash128(uint64 seed = 0) { Initialize(seed); }
+
+    /// Resets the hashing state so a new hash can be computed.
+    ///
+    /// @param [in] seed Seed value which perturbs the hash.
+    void Initialize(uint64 seed = 0);
+
+    /// Hashes additional data.
+    ///
+    /// @param [in] pBuffer Data to be hashed.  May only be null if length is zero.
+    /// @param [in] length  Size of the data in bytes.
+    void Update(const uint8* pBuffer, uint64 length);
+
+    /// Hashes the bytes of a trivially copyable object.
+    ///
+    /// @param [in] data Object to be hashed.
+    template <typename T>
+    void Update(const T& data) { Update(reinterpret_cast<const uint8*>(&data), sizeof(T)); }
+
+    /// Writes the hash of all data added since the last call to Initialize().  The hashing state is unaffected, so
+    /// more data may be added afterwards.
+    ///
+    /// @param [out] pHash Receives the 16-byte hash.
+    void Finalize(uint8* pHash) const;
+
+    /// Hashes a single buffer in one shot.
+    ///
+    /// @param [in]  pBuffer Data to be hashed.  May only be null if length is zero.
+    /// @param [in]  length  Size of the data in bytes.
+    /// @param [out] pHash   Receives the 16-byte hash.
+    /// @param [in]  seed    Seed value which perturbs the hash.
+    static void Hash(const uint8* pBuffer, uint64 length, uint8* pHash, uint64 seed = 0);
+
+    /// Size in bytes of the secret which keys the hash.
+    static constexpr size_t SecretSize = 192;
+    /// Size in bytes of the internal input buffer.
+    static constexpr size_t BufferSize = 256;
+
+private:
+    const uint8* GetSecret() const;
+
+    uint64 m_acc[8];                // Long-input accumulators.
+    uint8  m_secret[SecretSize];    // Secret derived from the seed.  Unused when the seed is zero.
+    uint8  m_buffer[BufferSize];    // Input which has not yet been consumed.
+    uint32 m_bufferedSize;          // Number of valid bytes in m_buffer.
+    uint32 m_stripesSoFar;          // Number of stripes consumed in the current block.
+    uint64 m_totalLength;           // Total number of bytes added since initialization.
+    uint64 m_seed;
+};
+
+} // Util
@@ -121,6 +121,7 @@ CmdBuffer::CmdBuffer(
     m_embeddedData(device.GetPlatform()),
     m_gpuScratchMem(device.GetPlatform()),
     m_gpuScratchMemAllocLimit(0),
+    m_patchableData(device.GetPlatform()),
     m_lastPagingFence(0),
     m_p2pBltWaInfo(device.GetPlatform()),
     m_p2pBltWaLastChunkAddr(0),
@@ -279,6 +280,7 @@ Result CmdBuffer::Begin(
             if (result == Result::Success)
             {
                 m_p2pBltWaInfo.Clear();
+                m_patchableData.Clear();
 
                 // Reset and initialize all internal state before we start building commands.
                 ResetState();
@@ -416,6 +418,9 @@ Result CmdBuffer::Reset(
     ReturnDataChunks(&m_embeddedData, EmbeddedDataAlloc, returnGpuMemory);
     ReturnDataChunks(&m_gpuScratchMem, GpuScratchMemAlloc, returnGpuMemory);
 
+    // The patchable data regions lived in the embedded data chunks we just returned.
+    m_patchableData.Clear();
+
     m_status = Result::Success;
     if ((pCmdAllocator != nullptr) && (pCmdAllocator != m_pCmdAllocator))
     {
@@ -541,6 +546,68 @@ uint32* CmdBuffer::CmdAllocateEmbeddedData(
     return pSpace;
 }
 
+// =====================================================================================================================
+// Allocates embedded data which the client can keep patching after End(). The region is an ordinary embedded data
+// allocation; we just remember where it is so that PatchEmbeddedData() can find it again.
+Result CmdBuffer::CmdAllocatePatchableData(
+    uint32             sizeInDwords,
+    uint32             alignmentInDwords,
+    PatchableDataInfo* pInfo)
+{
+    Result result = Result::Success;
+
+    if (pInfo == nullptr)
+    {
+        result = Result::ErrorInvalidPointer;
+    }
+    else if (m_recordState != CmdBufferRecordState::Building)
+    {
+        result = Result::ErrorIncompleteCommandBuffer;
+    }
+    else
+    {
+        PatchableData region = {};
+        region.pCpuAddr     = CmdAllocateEmbeddedData(sizeInDwords, alignmentInDwords, &pInfo->gpuAddr);
+        region.sizeInDwords = sizeInDwords;
+
+        pInfo->pCpuAddr = region.pCpuAddr;
+        pInfo->patchId  = m_patchableData.NumElements();
+
+        result = m_patchableData.PushBack(region);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Overwrites part of a patchable embedded data region. The chunks that hold embedded data are always written through
+// their mapped CPU address, so the new values are visible to the next submission without finalizing anything again.
+Result CmdBuffer::PatchEmbeddedData(
+    uint32        patchId,
+    uint32        dwordOffset,
+    uint32        dwordCount,
+    const uint32* pData)
+{
+    Result result = Result::Success;
+
+    if (pData == nullptr)
+    {
+        result = Result::ErrorInvalidPointer;
+    }
+    else if ((patchId >= m_patchableData.NumElements()) ||
+             (dwordOffset > m_patchableData.At(patchId).sizeInDwords) ||
+             (dwordCount > (m_patchableData.At(patchId).sizeInDwords - dwordOffset)))
+    {
+        result = Result::ErrorInvalidValue;
+    }
+    else
+    {
+        memcpy(m_patchableData.At(patchId).pCpuAddr + dwordOffset, pData, dwordCount * sizeof(uint32));
+    }
+
+    return result;
+}
+
 // =====================================================================================================================
 // Returns the GPU memory object pointer that can accomodate the specified number of dwords of the embedded data.
 // The offset of the embedded data to the allocated memory is also returned.
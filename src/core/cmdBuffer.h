@@ -146,6 +146,16 @@ struct P2pBltWaInfo
 // Convenience typedef for a vector of P2P BLT workaround structures.
 typedef Util::Vector<P2pBltWaInfo, 1, Platform> P2pBltWaInfoVector;
 
+// An embedded data region which the client can patch after the command buffer is finalized.
+struct PatchableData
+{
+    uint32* pCpuAddr;       // Mapped CPU address of the region. Embedded data chunks are never staged.
+    uint32  sizeInDwords;
+};
+
+// Convenience typedef for a vector of patchable embedded data regions, indexed by patch ID.
+typedef Util::Vector<PatchableData, 8, Platform> PatchableDataVector;
+
 // =====================================================================================================================
 // A command buffer can be executed by the GPU multiple times and recycled, provided the command buffer is not pending
 // execution on the GPU when it is recycled.
@@ -667,6 +677,17 @@ public:
         uint32   alignmentInDwords,
         gpusize* pGpuAddress) override final;
 
+    virtual Result CmdAllocatePatchableData(
+        uint32             sizeInDwords,
+        uint32             alignmentInDwords,
+        PatchableDataInfo* pInfo) override final;
+
+    virtual Result PatchEmbeddedData(
+        uint32        patchId,
+        uint32        dwordOffset,
+        uint32        dwordCount,
+        const uint32* pData) override final;
+
     virtual Result AllocateAndBindGpuMemToEvent(
         IGpuEvent* pGpuEvent) override;
 
@@ -972,6 +993,8 @@ protected:
     ChunkData          m_gpuScratchMem;
     uint32             m_gpuScratchMemAllocLimit;
 
+    PatchableDataVector m_patchableData;         // Embedded data regions allocated by CmdAllocatePatchableData().
+
     // Latest GPU memory paging fence seen across this command buffer and all nested command buffers called by this
     // command buffer.
     uint64  m_lastPagingFence;
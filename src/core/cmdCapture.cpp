@@ -0,0 +1,599 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "core/cmdBuffer.h"
+#include "core/cmdCapture.h"
+#include "core/cmdStream.h"
+#include "core/device.h"
+#include "core/queue.h"
+#include "core/hw/gfxip/cmdUploadRing.h"
+#include "core/hw/gfxip/gfxCmdBuffer.h"
+#include "core/hw/gfxip/gfxDevice.h"
+#include "core/hw/gfxip/universalCmdBuffer.h"
+#include "palSysUtil.h"
+
+using namespace Util;
+
+namespace Pal
+{
+
+// =====================================================================================================================
+CmdCaptureWriter::CmdCaptureWriter(
+    const Device& device)
+    :
+    m_device(device),
+    m_writeResult(Result::Success)
+{
+}
+
+// =====================================================================================================================
+// Creates the capture file and writes its header.
+Result CmdCaptureWriter::Open(
+    const char* pFilename)
+{
+    Result result = m_file.Open(pFilename, FileAccessMode::FileAccessWrite | FileAccessMode::FileAccessBinary);
+
+    if (result == Result::Success)
+    {
+        const CmdCaptureFileHeader fileHeader =
+        {
+            static_cast<uint32>(sizeof(CmdCaptureFileHeader)),
+            CmdCaptureMagic,
+            CmdCaptureVersion,
+            m_device.ChipProperties().familyId,
+            m_device.ChipProperties().eRevId,
+            0
+        };
+
+        result = m_file.Write(&fileHeader, sizeof(fileHeader));
+    }
+
+    m_writeResult = result;
+
+    return result;
+}
+
+// =====================================================================================================================
+// Writes the header for a new submit. Like Queue::DumpCmdBuffers, we only capture the first sub-queue.
+Result CmdCaptureWriter::BeginSubmit(
+    const Queue&              queue,
+    const MultiSubmitInfo&    submitInfo,
+    const InternalSubmitInfo& internalSubmitInfo)
+{
+    if ((m_writeResult == Result::Success) && (submitInfo.perSubQueueInfoCount > 0))
+    {
+        const PerSubQueueSubmitInfo& perSubQueueInfo = submitInfo.pPerSubQueueInfo[0];
+
+        CmdCaptureSubmitHeader submitHeader =
+        {
+            static_cast<uint32>(sizeof(CmdCaptureSubmitHeader)),
+            static_cast<uint32>(queue.GetEngineType()),
+            static_cast<uint32>(queue.Type()),
+            perSubQueueInfo.cmdBufferCount,
+            internalSubmitInfo.numPreambleCmdStreams + internalSubmitInfo.numPostambleCmdStreams
+        };
+
+        for (uint32 idxCmdBuf = 0; idxCmdBuf < perSubQueueInfo.cmdBufferCount; ++idxCmdBuf)
+        {
+            const CmdBuffer*const pCmdBuffer = static_cast<CmdBuffer*>(perSubQueueInfo.ppCmdBuffers[idxCmdBuf]);
+
+            for (uint32 idxStream = 0; idxStream < pCmdBuffer->NumCmdStreams(); ++idxStream)
+            {
+                if (pCmdBuffer->GetCmdStream(idxStream) != nullptr)
+                {
+                    submitHeader.streamCount++;
+                }
+            }
+        }
+
+        m_writeResult = m_file.Write(&submitHeader, sizeof(submitHeader));
+    }
+
+    return m_writeResult;
+}
+
+// =====================================================================================================================
+// Callback which writes one command stream of the current submit to the capture file.
+void PAL_STDCALL CmdCaptureWriter::WriteCmdStream(
+    const CmdBufferDumpDesc&      cmdBufferDesc,
+    const CmdBufferChunkDumpDesc* pChunks,
+    uint32                        numChunks,
+    void*                         pUserData)
+{
+    CmdCaptureWriter*const pWriter = static_cast<CmdCaptureWriter*>(pUserData);
+
+    if (pWriter->m_writeResult == Result::Success)
+    {
+        CmdCaptureStreamHeader streamHeader = {};
+        streamHeader.size              = static_cast<uint32>(sizeof(CmdCaptureStreamHeader));
+        streamHeader.subEngineType     = static_cast<uint32>(cmdBufferDesc.subEngineType);
+        streamHeader.flags.isPreamble  = cmdBufferDesc.flags.isPreamble;
+        streamHeader.flags.isPostamble = cmdBufferDesc.flags.isPostamble;
+        streamHeader.cmdBufferIdx      = cmdBufferDesc.cmdBufferIdx;
+        streamHeader.chunkCount        = numChunks;
+
+        Result result = pWriter->m_file.Write(&streamHeader, sizeof(streamHeader));
+
+        for (uint32 idx = 0; (idx < numChunks) && (result == Result::Success); ++idx)
+        {
+            const CmdCaptureChunkHeader chunkHeader =
+            {
+                static_cast<uint32>(sizeof(CmdCaptureChunkHeader)),
+                static_cast<uint32>(pChunks[idx].size)
+            };
+
+            result = pWriter->m_file.Write(&chunkHeader, sizeof(chunkHeader));
+
+            if ((result == Result::Success) && (chunkHeader.dataSize > 0))
+            {
+                result = pWriter->m_file.Write(pChunks[idx].pCommands, chunkHeader.dataSize);
+            }
+        }
+
+        // Once a write fails the file can no longer be parsed, so stop writing to it.
+        pWriter->m_writeResult = result;
+        PAL_ALERT(result != Result::Success);
+    }
+}
+
+// =====================================================================================================================
+CmdCaptureReplayer::CmdCaptureReplayer(
+    Device* pDevice)
+    :
+    m_pDevice(pDevice)
+{
+    memset(&m_engines[0], 0, sizeof(m_engines));
+}
+
+// =====================================================================================================================
+CmdCaptureReplayer::~CmdCaptureReplayer()
+{
+    Platform*const pPlatform = m_pDevice->GetPlatform();
+
+    for (uint32 engineType = 0; engineType < EngineTypeCount; ++engineType)
+    {
+        EngineState*const pState = &m_engines[engineType];
+
+        for (uint32 idx = 0; idx < pState->numCmdBuffers; ++idx)
+        {
+            static_cast<CmdBuffer*>(pState->ppCmdBuffers[idx])->DestroyInternal();
+        }
+
+        PAL_SAFE_FREE(pState->ppCmdBuffers, pPlatform);
+
+        if (pState->pUploadRing != nullptr)
+        {
+            pState->pUploadRing->DestroyInternal();
+        }
+
+        if (pState->pQueue != nullptr)
+        {
+            pState->pQueue->Destroy();
+            PAL_FREE(pState->pQueue, pPlatform);
+        }
+    }
+}
+
+// =====================================================================================================================
+// Returns the queue, upload ring and command buffers used to replay submits on the given engine, creating them if this
+// is the first submit to target the engine.
+Result CmdCaptureReplayer::GetEngineState(
+    EngineType    engineType,
+    QueueType     queueType,
+    EngineState** ppState)
+{
+    EngineState*const pState = &m_engines[engineType];
+    Result            result = Result::Success;
+
+    if (pState->pQueue == nullptr)
+    {
+        QueueCreateInfo createInfo = {};
+        createInfo.queueType  = queueType;
+        createInfo.engineType = engineType;
+
+        const size_t queueSize = m_pDevice->GetQueueSize(createInfo, &result);
+        void*        pMemory   = nullptr;
+
+        if (result == Result::Success)
+        {
+            pMemory = PAL_MALLOC(queueSize, m_pDevice->GetPlatform(), AllocInternal);
+            result  = (pMemory != nullptr) ? Result::Success : Result::ErrorOutOfMemory;
+        }
+
+        if (result == Result::Success)
+        {
+            result = m_pDevice->CreateQueue(createInfo, pMemory, &pState->pQueue);
+
+            if (result != Result::Success)
+            {
+                pState->pQueue = nullptr;
+                PAL_FREE(pMemory, m_pDevice->GetPlatform());
+            }
+        }
+
+        // Mirror the OS queues that batch command buffers through an upload ring; this is optional so we ignore
+        // failures and fall back to submitting the command buffers directly.
+        if ((result == Result::Success) && (m_pDevice->GetGfxDevice() != nullptr))
+        {
+            CmdUploadRingCreateInfo ringInfo = {};
+            ringInfo.engineType    = engineType;
+            ringInfo.numCmdStreams = Device::EngineSupportsGraphics(engineType) ? UniversalCmdBuffer::NumCmdStreamsVal
+                                                                                : 1;
+
+            if (m_pDevice->GetGfxDevice()->CreateCmdUploadRingInternal(ringInfo, &pState->pUploadRing) !=
+                Result::Success)
+            {
+                pState->pUploadRing = nullptr;
+            }
+        }
+    }
+
+    *ppState = pState;
+
+    return result;
+}
+
+// =====================================================================================================================
+// Makes sure that at least the given number of command buffers exist for the given engine.
+Result CmdCaptureReplayer::GetCmdBuffers(
+    EngineState* pState,
+    uint32       count)
+{
+    Result result = Result::Success;
+
+    if (count > pState->numCmdBuffers)
+    {
+        Platform*const pPlatform    = m_pDevice->GetPlatform();
+        ICmdBuffer**   ppCmdBuffers = static_cast<ICmdBuffer**>(PAL_CALLOC(sizeof(ICmdBuffer*) * count,
+                                                                            pPlatform,
+                                                                            AllocInternal));
+
+        if (ppCmdBuffers == nullptr)
+        {
+            result = Result::ErrorOutOfMemory;
+        }
+        else
+        {
+            if (pState->numCmdBuffers > 0)
+            {
+                memcpy(ppCmdBuffers, pState->ppCmdBuffers, sizeof(ICmdBuffer*) * pState->numCmdBuffers);
+            }
+
+            PAL_SAFE_FREE(pState->ppCmdBuffers, pPlatform);
+            pState->ppCmdBuffers = ppCmdBuffers;
+
+            const IQueue& queue = *pState->pQueue;
+
+            CmdBufferCreateInfo createInfo = {};
+            createInfo.pCmdAllocator = m_pDevice->InternalCmdAllocator(queue.GetEngineType());
+            createInfo.queueType     = queue.Type();
+            createInfo.engineType    = queue.GetEngineType();
+
+            CmdBufferInternalCreateInfo internalInfo = {};
+            internalInfo.flags.isInternal = 1;
+
+            while ((result == Result::Success) && (pState->numCmdBuffers < count))
+            {
+                CmdBuffer* pCmdBuffer = nullptr;
+                result = m_pDevice->CreateInternalCmdBuffer(createInfo, internalInfo, &pCmdBuffer);
+
+                if (result == Result::Success)
+                {
+                    pState->ppCmdBuffers[pState->numCmdBuffers++] = pCmdBuffer;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Submits the first "count" command buffers of the given engine, uploading them in batches if we have an upload ring.
+Result CmdCaptureReplayer::SubmitCmdBuffers(
+    EngineState*           pState,
+    uint32                 count,
+    CmdCaptureReplayStats* pStats)
+{
+    Result            result            = Result::Success;
+    uint32            numNextCmdBuffers = count;
+    ICmdBuffer*const* ppNextCmdBuffers  = pState->ppCmdBuffers;
+
+    while ((result == Result::Success) && (numNextCmdBuffers > 0))
+    {
+        UploadedCmdBufferInfo uploadInfo = {};
+        uint32                batchSize  = 1;
+
+        if ((pState->pUploadRing != nullptr) &&
+            (pState->pUploadRing->PredictBatchSize(numNextCmdBuffers, ppNextCmdBuffers) > 1))
+        {
+            result = pState->pUploadRing->UploadCmdBuffers(numNextCmdBuffers, ppNextCmdBuffers, &uploadInfo);
+
+            if (result == Result::Success)
+            {
+                batchSize              = uploadInfo.uploadedCmdBuffers;
+                pStats->uploadedCount += batchSize;
+                result                 = pState->pQueue->WaitQueueSemaphore(uploadInfo.pUploadComplete);
+            }
+        }
+
+        if (result == Result::Success)
+        {
+            PerSubQueueSubmitInfo perSubQueueInfo = {};
+            perSubQueueInfo.cmdBufferCount = batchSize;
+            perSubQueueInfo.ppCmdBuffers   = ppNextCmdBuffers;
+
+            MultiSubmitInfo submitInfo      = {};
+            submitInfo.perSubQueueInfoCount = 1;
+            submitInfo.pPerSubQueueInfo     = &perSubQueueInfo;
+
+            result = pState->pQueue->Submit(submitInfo);
+        }
+
+        if ((result == Result::Success) && (uploadInfo.pExecutionComplete != nullptr))
+        {
+            result = pState->pQueue->SignalQueueSemaphore(uploadInfo.pExecutionComplete);
+        }
+
+        numNextCmdBuffers -= batchSize;
+        ppNextCmdBuffers  += batchSize;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Rebuilds and submits one captured submit. pSubmit points at the submit's header and sizeLeft is the number of bytes
+// left in the capture. On success, pSubmitSize returns the size of the submit's data.
+Result CmdCaptureReplayer::ReplaySubmit(
+    const void*            pSubmit,
+    size_t                 sizeLeft,
+    size_t*                pSubmitSize,
+    CmdCaptureReplayStats* pStats)
+{
+    const auto*const pHeader = static_cast<const CmdCaptureSubmitHeader*>(pSubmit);
+    const void*const pEnd    = VoidPtrInc(pSubmit, sizeLeft);
+    EngineState*     pState  = nullptr;
+    Result           result  = ((sizeLeft >= sizeof(CmdCaptureSubmitHeader))      &&
+                                (pHeader->size >= sizeof(CmdCaptureSubmitHeader)) &&
+                                (pHeader->size <= sizeLeft)                        &&
+                                (pHeader->engineType < EngineTypeCount))
+                                    ? Result::Success : Result::ErrorInvalidFormat;
+
+    // We can only rebuild command buffers for gfxip engines.
+    const EngineType engineType = (result == Result::Success) ? static_cast<EngineType>(pHeader->engineType)
+                                                              : EngineTypeCount;
+    const bool       canReplay  = (result == Result::Success) &&
+                                  (Device::EngineSupportsGraphics(engineType) ||
+                                   Device::EngineSupportsCompute(engineType));
+
+    if (canReplay)
+    {
+        result = GetEngineState(engineType, static_cast<QueueType>(pHeader->queueType), &pState);
+
+        if (result == Result::Success)
+        {
+            result = GetCmdBuffers(pState, pHeader->cmdBufferCount);
+        }
+
+        for (uint32 idx = 0; (idx < pHeader->cmdBufferCount) && (result == Result::Success); ++idx)
+        {
+            const CmdBufferBuildInfo buildInfo = {};
+            result = pState->ppCmdBuffers[idx]->Reset(nullptr, true);
+
+            if (result == Result::Success)
+            {
+                result = pState->ppCmdBuffers[idx]->Begin(buildInfo);
+            }
+        }
+    }
+
+    const void* pCur = (result == Result::Success) ? VoidPtrInc(pSubmit, pHeader->size) : pEnd;
+
+    for (uint32 streamIdx = 0; (result == Result::Success) && (streamIdx < pHeader->streamCount); ++streamIdx)
+    {
+        const auto*const pStreamHeader = static_cast<const CmdCaptureStreamHeader*>(pCur);
+
+        // Every record's size must cover its own header and fit in the bytes left in the capture.
+        if ((VoidPtrDiff(pEnd, pCur) < sizeof(CmdCaptureStreamHeader)) ||
+            (pStreamHeader->size < sizeof(CmdCaptureStreamHeader))    ||
+            (pStreamHeader->size > VoidPtrDiff(pEnd, pCur)))
+        {
+            result = Result::ErrorInvalidFormat;
+            break;
+        }
+
+        // The submitted preamble and postamble streams are rebuilt by the replaying queue's context. The CE streams
+        // can't be rebuilt because gfxip command buffers only expose their DE streams for raw writes.
+        const bool canReplayStream =
+            canReplay                                                                     &&
+            (pStreamHeader->flags.u32All == 0)                                            &&
+            (pStreamHeader->subEngineType == static_cast<uint32>(SubEngineType::Primary)) &&
+            (pStreamHeader->cmdBufferIdx < pHeader->cmdBufferCount);
+
+        GfxCmdBuffer*const pCmdBuffer =
+            canReplayStream ? static_cast<GfxCmdBuffer*>(
+                                static_cast<CmdBuffer*>(pState->ppCmdBuffers[pStreamHeader->cmdBufferIdx]))
+                            : nullptr;
+        CmdStream*const pCmdStream =
+            (pCmdBuffer != nullptr) ? pCmdBuffer->GetCmdStreamByEngine(CmdBufferEngineSupport::Graphics |
+                                                                       CmdBufferEngineSupport::Compute)
+                                    : nullptr;
+
+        if (pCmdStream == nullptr)
+        {
+            pStats->skippedStreams++;
+        }
+
+        pCur = VoidPtrInc(pCur, pStreamHeader->size);
+
+        for (uint32 chunkIdx = 0; (result == Result::Success) && (chunkIdx < pStreamHeader->chunkCount); ++chunkIdx)
+        {
+            const auto*const pChunkHeader = static_cast<const CmdCaptureChunkHeader*>(pCur);
+            const uint32*    pData        = nullptr;
+            const size_t     bytesLeft    = VoidPtrDiff(pEnd, pCur);
+
+            if ((bytesLeft >= sizeof(CmdCaptureChunkHeader))          &&
+                (pChunkHeader->size >= sizeof(CmdCaptureChunkHeader)) &&
+                (pChunkHeader->size <= bytesLeft)                     &&
+                (pChunkHeader->dataSize <= (bytesLeft - pChunkHeader->size)))
+            {
+                pData = static_cast<const uint32*>(VoidPtrInc(pCur, pChunkHeader->size));
+                pCur  = VoidPtrInc(pData, pChunkHeader->dataSize);
+            }
+
+            if (pData == nullptr)
+            {
+                result = Result::ErrorInvalidFormat;
+            }
+            else if (pCmdStream != nullptr)
+            {
+                // Copy the commands in pieces no larger than the command stream's reserve limit.
+                uint32 dwordsLeft = pChunkHeader->dataSize / sizeof(uint32);
+
+                while (dwordsLeft > 0)
+                {
+                    const uint32 numDwords = Min(dwordsLeft, pCmdStream->ReserveLimit());
+                    uint32*const pCmdSpace = pCmdStream->ReserveCommands();
+
+                    memcpy(pCmdSpace, pData, numDwords * sizeof(uint32));
+                    pCmdStream->CommitCommands(pCmdSpace + numDwords);
+
+                    pData      += numDwords;
+                    dwordsLeft -= numDwords;
+                }
+
+                pStats->replayedBytes += pChunkHeader->dataSize;
+            }
+        }
+    }
+
+    if (result == Result::Success)
+    {
+        *pSubmitSize = VoidPtrDiff(pCur, pSubmit);
+    }
+
+    if (canReplay)
+    {
+        for (uint32 idx = 0; (idx < pHeader->cmdBufferCount) && (result == Result::Success); ++idx)
+        {
+            result = pState->ppCmdBuffers[idx]->End();
+        }
+
+        if ((result == Result::Success) && (pHeader->cmdBufferCount > 0))
+        {
+            result = SubmitCmdBuffers(pState, pHeader->cmdBufferCount, pStats);
+        }
+
+        if (result == Result::Success)
+        {
+            pStats->submitCount++;
+            pStats->cmdBufferCount += pHeader->cmdBufferCount;
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Loads the given capture file and replays all of its submits "iterations" times. The time spent loading the file is
+// not included in the returned statistics.
+Result CmdCaptureReplayer::Replay(
+    const char*            pFilename,
+    uint32                 iterations,
+    CmdCaptureReplayStats* pStats)
+{
+    PAL_ASSERT((pFilename != nullptr) && (pStats != nullptr));
+    memset(pStats, 0, sizeof(*pStats));
+
+    Platform*const pPlatform = m_pDevice->GetPlatform();
+    const size_t   fileSize  = File::GetFileSize(pFilename);
+    void*          pData     = (fileSize > 0) ? PAL_MALLOC(fileSize, pPlatform, AllocInternalTemp) : nullptr;
+    Result         result    = (pData != nullptr) ? Result::Success : Result::ErrorOutOfMemory;
+
+    if (result == Result::Success)
+    {
+        File   file;
+        size_t bytesRead = 0;
+
+        result = file.Open(pFilename, FileAccessMode::FileAccessRead | FileAccessMode::FileAccessBinary);
+
+        if (result == Result::Success)
+        {
+            result = file.Read(pData, fileSize, &bytesRead);
+        }
+
+        if ((result == Result::Success) && (bytesRead != fileSize))
+        {
+            result = Result::ErrorInvalidValue;
+        }
+    }
+
+    if (result == Result::Success)
+    {
+        const auto*const pFileHeader = static_cast<const CmdCaptureFileHeader*>(pData);
+
+        if ((fileSize < sizeof(CmdCaptureFileHeader))          ||
+            (pFileHeader->magic != CmdCaptureMagic)            ||
+            (pFileHeader->version > CmdCaptureVersion)         ||
+            (pFileHeader->size < sizeof(CmdCaptureFileHeader)) ||
+            (pFileHeader->size > fileSize))
+        {
+            result = Result::ErrorInvalidFormat;
+        }
+        else
+        {
+            const int64 startTime = GetPerfCpuTime();
+
+            for (uint32 iteration = 0; (iteration < iterations) && (result == Result::Success); ++iteration)
+            {
+                size_t offset = pFileHeader->size;
+
+                while ((result == Result::Success) && (offset < fileSize))
+                {
+                    size_t submitSize = 0;
+                    result  = ReplaySubmit(VoidPtrInc(pData, offset), fileSize - offset, &submitSize, pStats);
+                    offset += submitSize;
+                }
+            }
+
+            for (uint32 engineType = 0; (engineType < EngineTypeCount) && (result == Result::Success); ++engineType)
+            {
+                if (m_engines[engineType].pQueue != nullptr)
+                {
+                    result = m_engines[engineType].pQueue->WaitIdle();
+                }
+            }
+
+            pStats->elapsedTicks = GetPerfCpuTime() - startTime;
+        }
+    }
+
+    PAL_SAFE_FREE(pData, pPlatform);
+
+    return result;
+}
+
+} // Pal
@@ -0,0 +1,193 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#pragma once
+
+#include "pal.h"
+#include "palFile.h"
+#include "palQueue.h"
+
+namespace Pal
+{
+
+class CmdUploadRing;
+class Device;
+class ICmdBuffer;
+class IQueue;
+class Queue;
+struct InternalSubmitInfo;
+
+// The following structures define the binary command capture file format. Unlike the command buffer dump files, a
+// capture holds a whole sequence of submits along with enough metadata to rebuild and resubmit them later on.
+//
+// The general structure of a capture file is as follows:
+//
+//    * First comes a CmdCaptureFileHeader which identifies the file and the device it was captured on.
+//    * Next, we read CmdCaptureSubmitHeaders until we're out of data. Each submit header is followed by:
+//      * submitHeader.streamCount command streams. Each command stream begins with a CmdCaptureStreamHeader followed by:
+//        * streamHeader.chunkCount chunks. Each chunk is a CmdCaptureChunkHeader followed by chunkHeader.size bytes of
+//          commands exactly as they were submitted.
+//
+// Each header begins with its own size in bytes so that readers can skip any fields added by future versions.
+
+constexpr uint32 CmdCaptureMagic   = 0x50414343; // "CCAP"
+constexpr uint32 CmdCaptureVersion = 1;
+
+// Structure defining the top of a command capture file.
+struct CmdCaptureFileHeader
+{
+    uint32 size;         // Size of this structure in bytes.
+    uint32 magic;        // Must be CmdCaptureMagic.
+    uint32 version;      // Version of the capture format. Should be CmdCaptureVersion.
+    uint32 asicFamily;   // ASIC family of the captured device.
+    uint32 asicRevision; // ASIC revision of the captured device.
+    uint32 reserved;     // Reserved field. Set to 0.
+};
+
+// Structure defining the header for one captured submit.
+struct CmdCaptureSubmitHeader
+{
+    uint32 size;           // Size of this structure in bytes.
+    uint32 engineType;     // EngineType of the queue which executed this submit.
+    uint32 queueType;      // QueueType of the queue which executed this submit.
+    uint32 cmdBufferCount; // Number of client command buffers in this submit.
+    uint32 streamCount;    // Number of command streams that follow.
+};
+
+// Flags describing a captured command stream.
+union CmdCaptureStreamFlags
+{
+    struct
+    {
+        uint32 isPreamble  :  1; // The stream is part of the queue's submission preamble.
+        uint32 isPostamble :  1; // The stream is part of the queue's submission postamble.
+        uint32 reserved    : 30;
+    };
+    uint32 u32All;
+};
+
+// Structure defining the header for one captured command stream.
+struct CmdCaptureStreamHeader
+{
+    uint32                size;          // Size of this structure in bytes.
+    uint32                subEngineType; // SubEngineType targeted by this stream.
+    CmdCaptureStreamFlags flags;
+    uint32                cmdBufferIdx;  // Index of the owning command buffer or UINT32_MAX for internal streams.
+    uint32                chunkCount;    // Number of chunks that follow.
+};
+
+// Structure defining the header for one captured command chunk.
+struct CmdCaptureChunkHeader
+{
+    uint32 size;      // Size of this structure in bytes.
+    uint32 dataSize;  // Size of the command data which follows, in bytes.
+};
+
+// =====================================================================================================================
+// Writes every submit made on a queue to a command capture file.
+class CmdCaptureWriter
+{
+public:
+    explicit CmdCaptureWriter(const Device& device);
+    ~CmdCaptureWriter() { }
+
+    Result Open(const char* pFilename);
+
+    // Writes the header for a new submit. The caller must then pass every command stream counted by this function to
+    // WriteCmdStream, in the same order as Queue::DumpCmdBuffers.
+    Result BeginSubmit(
+        const Queue&              queue,
+        const MultiSubmitInfo&    submitInfo,
+        const InternalSubmitInfo& internalSubmitInfo);
+
+    // Matches the CmdDumpCallback signature so that the queue's normal command dumping logic can feed us streams.
+    static void PAL_STDCALL WriteCmdStream(
+        const CmdBufferDumpDesc&      cmdBufferDesc,
+        const CmdBufferChunkDumpDesc* pChunks,
+        uint32                        numChunks,
+        void*                         pUserData);
+
+private:
+    const Device& m_device;
+    Util::File    m_file;
+    Result        m_writeResult; // The first error hit while writing to the file.
+
+    PAL_DISALLOW_DEFAULT_CTOR(CmdCaptureWriter);
+    PAL_DISALLOW_COPY_AND_ASSIGN(CmdCaptureWriter);
+};
+
+// Statistics returned by CmdCaptureReplayer::Replay.
+struct CmdCaptureReplayStats
+{
+    uint64 submitCount;     // Number of submits which were replayed.
+    uint64 cmdBufferCount;  // Number of command buffers which were rebuilt and submitted.
+    uint64 uploadedCount;   // Number of command buffers which were batched through a CmdUploadRing.
+    uint64 replayedBytes;   // Number of bytes of captured commands written into command buffers.
+    uint64 skippedStreams;  // Number of captured streams which could not be replayed (e.g., CE or preamble streams).
+    int64  elapsedTicks;    // CPU time spent rebuilding and submitting, in GetPerfCpuTime() ticks.
+};
+
+// =====================================================================================================================
+// Feeds a command capture back through a device's queues. The replayer rebuilds each captured command buffer by
+// copying the captured DE commands into an internal command buffer, batches the command buffers through a
+// CmdUploadRing when the device supports one and then submits them.
+//
+// Captured command streams contain chain packets and GPU addresses that are only meaningful in the original process,
+// so replays must only be executed on a null device where OsSubmit doesn't reach any hardware. This makes a replay a
+// reproducible benchmark of PAL's CPU-side submission overhead.
+class CmdCaptureReplayer
+{
+public:
+    explicit CmdCaptureReplayer(Device* pDevice);
+    ~CmdCaptureReplayer();
+
+    Result Replay(const char* pFilename, uint32 iterations, CmdCaptureReplayStats* pStats);
+
+private:
+    // Per-engine objects created on the first submit which targets an engine.
+    struct EngineState
+    {
+        IQueue*        pQueue;
+        CmdUploadRing* pUploadRing;
+        ICmdBuffer**   ppCmdBuffers;
+        uint32         numCmdBuffers;
+    };
+
+    Result GetEngineState(EngineType engineType, QueueType queueType, EngineState** ppState);
+    Result GetCmdBuffers(EngineState* pState, uint32 count);
+    Result ReplaySubmit(const void*            pSubmit,
+                        size_t                 sizeLeft,
+                        size_t*                pSubmitSize,
+                        CmdCaptureReplayStats* pStats);
+    Result SubmitCmdBuffers(EngineState* pState, uint32 count, CmdCaptureReplayStats* pStats);
+
+    Device*const m_pDevice;
+    EngineState  m_engines[EngineTypeCount];
+
+    PAL_DISALLOW_DEFAULT_CTOR(CmdCaptureReplayer);
+    PAL_DISALLOW_COPY_AND_ASSIGN(CmdCaptureReplayer);
+};
+
+} // Pal
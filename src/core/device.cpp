@@ -241,6 +241,8 @@ Device::Device(
     m_pDmaUploadRing(nullptr),
     m_referencedGpuMem(ReferencedMemoryMapElements, pPlatform),
     m_referencedGpuMemLock(),
+    m_gpuMemoryRangeIndex(pPlatform),
+    m_gpuMemoryRangeIndexEnabled(false),
     m_pAddrMgr(nullptr),
     m_pTrackedCmdAllocator(nullptr),
     m_pUntrackedCmdAllocator(nullptr),
@@ -457,6 +459,14 @@ Result Device::EarlyInit(
         result = OsEarlyInit();
     }
 
+    // The settings have been read by now and no GPU memory exists yet, so the index sees every object.
+    if ((result == Result::Success) && GetSettingsLoader()->GpuMemoryRangeIndexEnabled())
+    {
+        result = m_gpuMemoryRangeIndex.Init();
+
+        m_gpuMemoryRangeIndexEnabled = (result == Result::Success);
+    }
+
     if (result == Result::Success)
     {
         result = HwlEarlyInit();
@@ -515,6 +525,11 @@ Result Device::SetupPublicSettingDefaults()
 #endif
     m_publicSettings.depthClampBasedOnZExport = true;
     m_publicSettings.forceWaitPointPreColorToPostIndexFetch = false;
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    m_publicSettings.rpmPipelineCreateMode = RpmPipelineCreateMode::Immediate;
+    m_publicSettings.coalesceBarriers = false;
+    m_publicSettings.rpmPipelineUsagePath[0] = '\0';
+#endif
 
     return ret;
 }
@@ -1233,6 +1248,10 @@ Result Device::FixupUsableGpuVirtualAddressRange(
 // =====================================================================================================================
 Result Device::CommitSettingsAndInit()
 {
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    const uint64 startTicks = GetPerfCpuTime();
+#endif
+
     PAL_ASSERT(m_pSettingsLoader != nullptr);
     m_pSettingsLoader->FinalizeSettings();
 
@@ -1273,7 +1292,13 @@ Result Device::CommitSettingsAndInit()
     m_settingsCommitted = true;
 #endif
 
-    return LateInit();
+    const Result result = LateInit();
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    m_pPlatform->RecordDeviceInitTicks(this, DeviceInitPhase::CommitSettingsAndInit, GetPerfCpuTime() - startTicks);
+#endif
+
+    return result;
 }
 
 // =====================================================================================================================
@@ -1506,6 +1531,10 @@ Result Device::Finalize(
     PAL_ASSERT(m_settingsCommitted);
 #endif
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    const uint64 startTicks = GetPerfCpuTime();
+#endif
+
     Result result = Result::Success;
 
     if (result == Result::Success)
@@ -1613,6 +1642,10 @@ Result Device::Finalize(
     m_deviceFinalized = true;
 #endif
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    m_pPlatform->RecordDeviceInitTicks(this, DeviceInitPhase::Finalize, GetPerfCpuTime() - startTicks);
+#endif
+
     return result;
 }
 
@@ -2529,15 +2562,18 @@ Result Device::AcquireRingSlot(
 
 // =====================================================================================================================
 // Record commands which upload part of pipeline ELF from CPU to GPU.
-size_t Device::UploadUsingEmbeddedData(
+size_t Device::UploadUsingStagingMemory(
     UploadRingSlot  slotId,
     Pal::GpuMemory* pDst,
     gpusize         dstOffset,
     size_t          bytes,
-    void**          ppEmbeddedData)
+    void**          ppStagingData)
 {
+    // The staging arena is shared by all slots.
+    Util::MutexAuto lock(&m_dmaUploadRingLock);
+
     PAL_ASSERT(m_pDmaUploadRing != nullptr);
-    return m_pDmaUploadRing->UploadUsingEmbeddedData(slotId,pDst,dstOffset,bytes,ppEmbeddedData);
+    return m_pDmaUploadRing->UploadUsingStagingMemory(slotId, pDst, dstOffset, bytes, ppStagingData);
 }
 
 // =====================================================================================================================
@@ -2566,6 +2602,35 @@ Result Device::WaitForPendingUpload(
     return m_pDmaUploadRing->WaitForPendingUpload(pWaiter, fenceValue);
 }
 
+// =====================================================================================================================
+// Makes sure the DmaUploadRing has submitted the upload batch named by fenceValue to its internal dma queue.
+Result Device::FlushPendingUpload(
+    UploadFenceToken fenceValue)
+{
+    Util::MutexAuto lock(&m_dmaUploadRingLock);
+
+    PAL_ASSERT(m_pDmaUploadRing != nullptr);
+    return m_pDmaUploadRing->FlushPendingUpload(fenceValue);
+}
+
+// =====================================================================================================================
+// Submits every pipeline upload which the DmaUploadRing is still coalescing to its internal dma queue.  Devices without
+// a DmaUploadRing have nothing to flush.  This runs on every universal and compute queue submission, so the ring's lock
+// is only taken if something is pending.
+Result Device::FlushPendingUploads()
+{
+    Result result = Result::Success;
+
+    if ((m_pDmaUploadRing != nullptr) && m_pDmaUploadRing->HasPendingSlots())
+    {
+        Util::MutexAuto lock(&m_dmaUploadRingLock);
+
+        result = m_pDmaUploadRing->FlushPendingSlots();
+    }
+
+    return result;
+}
+
 // =====================================================================================================================
 // Determines the size, in bytes, needed to create an IQueue.
 // NOTE: Part of the public IDevice interface.
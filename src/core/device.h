@@ -32,6 +32,7 @@
 #include "core/hw/ossip/ossDevice.h"
 #include "core/addrMgr/addrMgr.h"
 #include "core/dmaUploadRing.h"
+#include "core/gpuMemoryRangeIndex.h"
 #include "palCmdAllocator.h"
 #include "palDevice.h"
 #include "palDeque.h"
@@ -1914,6 +1915,13 @@ public:
         IGpuMemory*const* ppGpuMemory,
         bool              forceSubtract);
 
+    // Index of the GPU VA ranges of every live GPU memory object on this device, or null if the GpuMemoryRangeIndexEnable
+    // setting is off.
+    GpuMemoryRangeIndex* GetGpuMemoryRangeIndex()
+        { return m_gpuMemoryRangeIndexEnabled ? &m_gpuMemoryRangeIndex : nullptr; }
+    const GpuMemoryRangeIndex* GetGpuMemoryRangeIndex() const
+        { return m_gpuMemoryRangeIndexEnabled ? &m_gpuMemoryRangeIndex : nullptr; }
+
     IfhMode GetIfhMode() const;
 
     // Helper for creating DmaUploadRing for PAL internal use.
@@ -1921,12 +1929,12 @@ public:
 
     Result AcquireRingSlot(UploadRingSlot* pSlotId);
 
-    size_t UploadUsingEmbeddedData(
+    size_t UploadUsingStagingMemory(
         UploadRingSlot  slotId,
         Pal::GpuMemory* pDst,
         gpusize         dstOffset,
         size_t          bytes,
-        void**          ppEmbeddedData);
+        void**          ppStagingData);
 
     Result SubmitDmaUploadRing(
         UploadRingSlot    slotId,
@@ -1937,6 +1945,10 @@ public:
         Pal::Queue* pWaiter,
         UploadFenceToken fenceValue);
 
+    Result FlushPendingUpload(UploadFenceToken fenceValue);
+
+    Result FlushPendingUploads();
+
     virtual bool IsHwEmulationEnabled() const { return false; }
 
 protected:
@@ -2148,6 +2160,9 @@ private:
     Util::Mutex   m_referencedGpuMemLock;
     gpusize       m_referencedGpuMemBytes[GpuHeapCount];
 
+    GpuMemoryRangeIndex m_gpuMemoryRangeIndex;
+    bool                m_gpuMemoryRangeIndexEnabled;
+
     AddrMgr*               m_pAddrMgr;
     CmdAllocator*          m_pTrackedCmdAllocator;
     CmdAllocator*          m_pUntrackedCmdAllocator;
@@ -40,6 +40,15 @@ namespace Pal
 constexpr EngineType UploadEngine = EngineTypeDma;
 constexpr QueueType  UploadQueue  = QueueTypeDma;
 
+// Size of the persistently mapped staging arena.
+constexpr gpusize StagingArenaSize      = 4 * 1024 * 1024;
+// Alignment of every staging allocation.
+constexpr gpusize StagingAlignment      = 256;
+// Marks a ring entry which doesn't own any staging memory.
+constexpr gpusize NoStagingMemory       = UINT64_MAX;
+// Slots submitted within this many microseconds of the first pending slot are coalesced into one DMA submission.
+constexpr int64   CoalesceWindowUs      = 500;
+
 // =====================================================================================================================
 DmaUploadRing::DmaUploadRing(
     Device* pDevice)
@@ -50,9 +59,20 @@ DmaUploadRing::DmaUploadRing(
     m_ringCapacity(RingInitEntries),
     m_firstEntryInUse(0),
     m_firstEntryFree(0),
-    m_numEntriesInUse(0)
+    m_numEntriesInUse(0),
+    m_pStagingCpuAddr(nullptr),
+    m_stagingHead(0),
+    m_stagingTail(0),
+    m_nextBatchId(1),
+    m_retiredBatchId(0),
+    m_batches(pDevice->GetPlatform()),
+    m_numPendingSlots(0),
+    m_lastPendingSlot(0),
+    m_batchOpenTime(0),
+    m_pendingSubmitTime(0)
 {
-
+    memset(&m_pPendingCmdBufs[0], 0, sizeof(m_pPendingCmdBufs));
+    memset(&m_stats, 0, sizeof(m_stats));
 }
 
 // =====================================================================================================================
@@ -100,9 +120,57 @@ Result DmaUploadRing::Init()
     if (result == Result::Success)
     {
         memset(m_pRing, 0, sizeof(Entry)*m_ringCapacity);
+        for (uint32 i = 0; i < m_ringCapacity; i++)
+        {
+            m_pRing[i].stagingStart = NoStagingMemory;
+        }
+
         result = CreateInternalCopyQueue();
     }
 
+    if (result == Result::Success)
+    {
+        // The staging arena is only an optimization: uploads fall back to embedded data without it.
+        const Result arenaResult = InitStagingArena();
+        PAL_ALERT(arenaResult != Result::Success);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Allocates and persistently maps the staging arena which upload data is written to before it is copied by the DMA
+// queue.  Cacheable GART memory is used because the pipeline loader reads back the staged data to apply relocations.
+Result DmaUploadRing::InitStagingArena()
+{
+    GpuMemoryCreateInfo createInfo = {};
+    createInfo.vaRange             = VaRange::Default;
+    createInfo.alignment           = StagingAlignment;
+    createInfo.size                = StagingArenaSize;
+    createInfo.priority            = GpuMemPriority::Normal;
+    createInfo.heaps[0]            = GpuHeapGartCacheable;
+    createInfo.heapCount           = 1;
+
+    GpuMemoryInternalCreateInfo internalCreateInfo = {};
+    internalCreateInfo.flags.alwaysResident        = 1;
+
+    GpuMemory* pGpuMem = nullptr;
+    gpusize    offset  = 0;
+    Result     result  = m_pDevice->MemMgr()->AllocateGpuMem(createInfo, internalCreateInfo, false, &pGpuMem, &offset);
+
+    if (result == Result::Success)
+    {
+        m_stagingMem.Update(pGpuMem, offset);
+        result = m_stagingMem.Map(&m_pStagingCpuAddr);
+
+        if (result != Result::Success)
+        {
+            m_pStagingCpuAddr = nullptr;
+            m_pDevice->MemMgr()->FreeGpuMem(pGpuMem, offset);
+            m_stagingMem.Update(nullptr, 0);
+        }
+    }
+
     return result;
 }
 
@@ -125,6 +193,10 @@ Result DmaUploadRing::ResizeRing()
         // clear the second half of the new ring to 0.
         memset(Util::VoidPtrInc(pNewRing, sizeof(Entry)*m_ringCapacity), 0, sizeof(Entry)*m_ringCapacity);
         memcpy(pNewRing, m_pRing, sizeof(Entry)*m_ringCapacity);
+        for (uint32 i = m_ringCapacity; i < m_ringCapacity * 2; i++)
+        {
+            pNewRing[i].stagingStart = NoStagingMemory;
+        }
         m_firstEntryInUse = 0;
         m_firstEntryFree  = m_ringCapacity;
         // m_numEntriesInUse does not change when resizing the ring.
@@ -137,26 +209,138 @@ Result DmaUploadRing::ResizeRing()
 }
 
 // =====================================================================================================================
+// Advances the upload timeline past every batch which has finished executing, then releases the ring entries and the
+// staging memory used by those batches.
 Result DmaUploadRing::FreeFinishedSlots()
 {
     Result result = Result::Success;
 
+    while ((result == Result::Success) && (m_batches.NumElements() > 0))
+    {
+        Batch* pBatch = &m_batches.Front();
+        if (pBatch->pFence->GetStatus() == Result::Success)
+        {
+            result = m_pDevice->ResetFences(1, &pBatch->pFence);
+        }
+        else
+        {
+            break;
+        }
+        if (result == Result::Success)
+        {
+            m_retiredBatchId = pBatch->id;
+            result = m_batches.PopFront(nullptr);
+        }
+    }
+
+    const uint32 prevEntriesInUse = m_numEntriesInUse;
+
+    // Entries which haven't been submitted yet have a batch ID of zero and keep every later entry alive, just like an
+    // entry whose batch is still executing.
     while ((result == Result::Success) && (m_numEntriesInUse > 0))
     {
         PAL_ASSERT((m_pRing[m_firstEntryInUse].pCmdBuf != nullptr) && (m_pRing[m_firstEntryInUse].pFence != nullptr));
         Entry* pEntry = &m_pRing[m_firstEntryInUse];
-        if (pEntry->pFence->GetStatus() == Result::Success)
+        if ((pEntry->batchId == 0) || (pEntry->batchId > m_retiredBatchId))
         {
-            result = m_pDevice->ResetFences(1, &pEntry->pFence);
+            break;
         }
-        else
+
+        pEntry->batchId      = 0;
+        pEntry->stagingStart = NoStagingMemory;
+        m_numEntriesInUse--;
+        m_firstEntryInUse = (m_firstEntryInUse + 1) % m_ringCapacity;
+    }
+
+    if (m_numEntriesInUse != prevEntriesInUse)
+    {
+        // Slots may allocate staging memory in a different order than they were acquired, so the oldest staging
+        // memory which may still be in use is the lowest start offset of any live entry.
+        gpusize tail = m_stagingHead;
+        for (uint32 i = 0; i < m_numEntriesInUse; i++)
         {
-            break;
+            tail = Util::Min(tail, m_pRing[(m_firstEntryInUse + i) % m_ringCapacity].stagingStart);
         }
+        m_stagingTail = tail;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Returns true if the oldest pending slot has been waiting for longer than the coalescing window.
+bool DmaUploadRing::CoalesceWindowExpired() const
+{
+    const int64 windowTicks = (CoalesceWindowUs * Util::GetPerfFrequency()) / 1000000;
+
+    return ((m_numPendingSlots > 0) && ((Util::GetPerfCpuTime() - m_batchOpenTime) >= windowTicks));
+}
+
+// =====================================================================================================================
+// Prints how many DMA submissions the uploads needed and how long coalescing delayed them.
+void DmaUploadRing::LogUploadStats() const
+{
+#if PAL_ENABLE_PRINTS_ASSERTS
+    if (m_stats.batches > 0)
+    {
+        const double usPerTick = 1000000.0 / Util::GetPerfFrequency();
+
+        PAL_DPINFO("DMA upload ring: %llu uploads in %llu submissions, coalescing delay %.1f us average, %.1f us max",
+                   m_stats.slots,
+                   m_stats.batches,
+                   (m_stats.totalDelayTicks * usPerTick) / m_stats.slots,
+                   m_stats.maxDelayTicks * usPerTick);
+    }
+#endif
+}
+
+// =====================================================================================================================
+// Submits every pending slot to the DMA queue as a single batch.  The batch is signaled through the fence of its last
+// slot.
+Result DmaUploadRing::FlushPendingSlots()
+{
+    Result result = Result::Success;
+
+    if (m_numPendingSlots > 0)
+    {
+        PerSubQueueSubmitInfo perSubQueueInfo = {};
+        perSubQueueInfo.cmdBufferCount        = m_numPendingSlots;
+        perSubQueueInfo.ppCmdBuffers          = &m_pPendingCmdBufs[0];
+
+        Batch batch = {};
+        batch.id     = m_nextBatchId;
+        batch.pFence = m_pRing[m_lastPendingSlot].pFence;
+
+        MultiSubmitInfo submitInfo      = {};
+        submitInfo.perSubQueueInfoCount = 1;
+        submitInfo.pPerSubQueueInfo     = &perSubQueueInfo;
+        submitInfo.fenceCount           = 1;
+        submitInfo.ppFences             = &batch.pFence;
+
+        result = m_pDmaQueue->SubmitInternal(submitInfo, false);
+        PAL_ASSERT(result == Result::Success);
+
         if (result == Result::Success)
         {
-            m_numEntriesInUse--;
-            m_firstEntryInUse = (m_firstEntryInUse + 1) % m_ringCapacity;
+            batch.timestamp = m_pDmaQueue->GetSubmissionContext()->LastTimestamp();
+            PAL_ASSERT(batch.timestamp > 0);
+
+            result = m_batches.PushBack(batch);
+        }
+
+        if (result == Result::Success)
+        {
+            // Every pending slot was submitted after the first one, so the first one has waited the longest.
+            const int64 now = Util::GetPerfCpuTime();
+
+            m_stats.slots           += m_numPendingSlots;
+            m_stats.batches++;
+            m_stats.totalDelayTicks += (now * m_numPendingSlots) - m_pendingSubmitTime;
+            m_stats.maxDelayTicks    = Util::Max(m_stats.maxDelayTicks, now - m_batchOpenTime);
+
+            m_numPendingSlots   = 0;
+            m_pendingSubmitTime = 0;
+            m_nextBatchId++;
         }
     }
 
@@ -167,7 +351,12 @@ Result DmaUploadRing::FreeFinishedSlots()
 Result DmaUploadRing::AcquireRingSlot(
     UploadRingSlot* pSlotId)
 {
-    Result result = FreeFinishedSlots();
+    Result result = CoalesceWindowExpired() ? FlushPendingSlots() : Result::Success;
+
+    if (result == Result::Success)
+    {
+        result = FreeFinishedSlots();
+    }
     PAL_ASSERT(result == Result::Success);
 
     if (result == Result::Success)
@@ -181,7 +370,11 @@ Result DmaUploadRing::AcquireRingSlot(
     // In case we fail to enlarge the ring, we wait from CPU until m_pDmaQueue finishes all pending works.
     if (result == Result::ErrorOutOfMemory)
     {
-        result = m_pDmaQueue->WaitIdle();
+        result = FlushPendingSlots();
+        if (result == Result::Success)
+        {
+            result = m_pDmaQueue->WaitIdle();
+        }
         PAL_ASSERT(result == Result::Success);
         if (result == Result::Success)
         {
@@ -219,6 +412,76 @@ Result DmaUploadRing::AcquireRingSlot(
     return result;
 }
 
+// =====================================================================================================================
+// Carves a block out of the staging arena for the given slot.  Returns false if the arena doesn't have enough free
+// space, in which case the caller falls back to embedded data.
+bool DmaUploadRing::AllocateStaging(
+    UploadRingSlot slotId,
+    size_t         bytes,
+    gpusize*       pOffset)
+{
+    const gpusize size = Util::Pow2Align(static_cast<gpusize>(bytes), StagingAlignment);
+
+    gpusize head = m_stagingHead;
+
+    // Allocations never straddle the end of the arena.
+    if (((head % StagingArenaSize) + size) > StagingArenaSize)
+    {
+        head = Util::Pow2Align(head, StagingArenaSize);
+    }
+
+    const bool fits = (m_pStagingCpuAddr != nullptr) && ((head + size - m_stagingTail) <= StagingArenaSize);
+
+    if (fits)
+    {
+        Entry*const pEntry = &m_pRing[slotId];
+        if (pEntry->stagingStart == NoStagingMemory)
+        {
+            // Padding skipped at the end of the arena belongs to this slot as well.
+            pEntry->stagingStart = m_stagingHead;
+        }
+
+        *pOffset      = head % StagingArenaSize;
+        m_stagingHead = head + size;
+    }
+
+    return fits;
+}
+
+// =====================================================================================================================
+size_t DmaUploadRing::UploadUsingStagingMemory(
+    UploadRingSlot  slotId,
+    Pal::GpuMemory* pDst,
+    gpusize         dstOffset,
+    size_t          bytes,
+    void**          ppStagingData)
+{
+    // Cap the size of each copy so a single huge section can't monopolize the arena.
+    const size_t copySize = static_cast<size_t>(Util::Min(static_cast<gpusize>(bytes), StagingArenaSize / 4));
+
+    gpusize stagingOffset = 0;
+    size_t  bytesCopied   = 0;
+
+    if (AllocateStaging(slotId, copySize, &stagingOffset))
+    {
+        *ppStagingData              = Util::VoidPtrInc(m_pStagingCpuAddr, static_cast<size_t>(stagingOffset));
+        MemoryCopyRegion copyRegion = { };
+        copyRegion.copySize         = copySize;
+        copyRegion.dstOffset        = dstOffset;
+        copyRegion.srcOffset        = m_stagingMem.Offset() + stagingOffset;
+
+        m_pRing[slotId].pCmdBuf->CmdCopyMemory(*m_stagingMem.Memory(), *pDst, 1, &copyRegion);
+
+        bytesCopied = copySize;
+    }
+    else
+    {
+        bytesCopied = UploadUsingEmbeddedData(slotId, pDst, dstOffset, bytes, ppStagingData);
+    }
+
+    return bytesCopied;
+}
+
 // =====================================================================================================================
 size_t DmaUploadRing::UploadUsingEmbeddedData(
     UploadRingSlot  slotId,
@@ -253,6 +516,10 @@ size_t DmaUploadRing::UploadUsingEmbeddedData(
 }
 
 // =====================================================================================================================
+// Ends the slot's command buffer and adds it to the pending batch.  The returned token names that batch.  The batch is
+// submitted right away if no earlier batch is still executing; otherwise it is submitted once the coalescing window
+// expires, once it is full, on the next universal or compute queue submission, or when someone waits on or flushes the
+// token.
 Result DmaUploadRing::Submit(
     UploadRingSlot    slotId,
     UploadFenceToken* pCompletionFence,
@@ -263,25 +530,70 @@ Result DmaUploadRing::Submit(
     {
         static_cast<CmdBuffer*>(m_pRing[slotId].pCmdBuf)->UpdateLastPagingFence(pagingFenceVal);
 
-        PerSubQueueSubmitInfo perSubQueueInfo = {};
-        perSubQueueInfo.cmdBufferCount        = 1;
-        perSubQueueInfo.ppCmdBuffers          = &m_pRing[slotId].pCmdBuf;
+        const int64 now = Util::GetPerfCpuTime();
 
-        MultiSubmitInfo submitInfo      = {};
-        submitInfo.perSubQueueInfoCount = 1;
-        submitInfo.pPerSubQueueInfo     = &perSubQueueInfo;
-        submitInfo.fenceCount           = 1;
-        submitInfo.ppFences             = &m_pRing[slotId].pFence;
+        if (m_numPendingSlots == 0)
+        {
+            m_batchOpenTime = now;
+        }
 
-        result = m_pDmaQueue->SubmitInternal(submitInfo, false);
-        *pCompletionFence = m_pDmaQueue->GetSubmissionContext()->LastTimestamp();
-        PAL_ASSERT(*pCompletionFence > 0);
+        m_pendingSubmitTime += now;
+
+        m_pPendingCmdBufs[m_numPendingSlots] = m_pRing[slotId].pCmdBuf;
+        m_numPendingSlots++;
+        m_lastPendingSlot                      = slotId;
+        m_pRing[slotId].batchId                = m_nextBatchId;
+
+        *pCompletionFence = m_nextBatchId;
+
+        // Coalescing only pays off while an earlier batch keeps the DMA queue busy.  The batch list was last pruned when
+        // this slot was acquired, so a batch which has finished since then only delays this upload until a later flush.
+        if ((m_batches.NumElements() == 0) || (m_numPendingSlots == MaxBatchSlots) || CoalesceWindowExpired())
+        {
+            result = FlushPendingSlots();
+        }
         PAL_ASSERT(result == Result::Success);
     }
 
     return result;
 }
 
+// =====================================================================================================================
+Result DmaUploadRing::FlushPendingUpload(
+    UploadFenceToken fenceValue)
+{
+    PAL_ASSERT(fenceValue <= m_nextBatchId);
+
+    return (fenceValue == m_nextBatchId) ? FlushPendingSlots() : Result::Success;
+}
+
+// =====================================================================================================================
+Result DmaUploadRing::WaitForPendingUpload(
+    Pal::Queue*      pWaiter,
+    UploadFenceToken fenceValue)
+{
+    Result result = FlushPendingUpload(fenceValue);
+
+    if ((result == Result::Success) && (fenceValue > m_retiredBatchId))
+    {
+        // Batches are retired in order, so the batch we need is still tracked.
+        uint64 timestamp = 0;
+        for (auto iter = m_batches.Begin(); iter.Get() != nullptr; iter.Next())
+        {
+            if (iter.Get()->id >= fenceValue)
+            {
+                timestamp = iter.Get()->timestamp;
+                break;
+            }
+        }
+
+        PAL_ASSERT(timestamp > 0);
+        result = WaitForSubmission(pWaiter, timestamp);
+    }
+
+    return result;
+}
+
 // =====================================================================================================================
 // Creates internal fence for tracking previous submission on the internal dma upload queue.
 Result DmaUploadRing::CreateInternalFence(
@@ -377,8 +689,14 @@ DmaUploadRing::~DmaUploadRing()
     // Cleanup the internal device-owned queues.
     if (m_pDmaQueue != nullptr)
     {
-        Result result = m_pDmaQueue->WaitIdle();
+        Result result = FlushPendingSlots();
+        PAL_ASSERT(result == Result::Success);
+
+        result = m_pDmaQueue->WaitIdle();
         PAL_ASSERT(result == Result::Success);
+
+        LogUploadStats();
+
         m_pDmaQueue->Destroy();
         PAL_SAFE_FREE(m_pDmaQueue, m_pDevice->GetPlatform());
     }
@@ -403,6 +721,13 @@ DmaUploadRing::~DmaUploadRing()
 
         PAL_SAFE_DELETE_ARRAY(m_pRing, m_pDevice->GetPlatform());
     }
+
+    if (m_stagingMem.IsBound())
+    {
+        m_stagingMem.Unmap();
+        m_pDevice->MemMgr()->FreeGpuMem(m_stagingMem.Memory(), m_stagingMem.Offset());
+        m_stagingMem.Update(nullptr, 0);
+    }
 }
 
 } // Pal
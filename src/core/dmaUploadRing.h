@@ -26,8 +26,10 @@
 #pragma once
 
 #include "pal.h"
+#include "palDeque.h"
 #include "palMutex.h"
 #include "palInlineFuncs.h"
+#include "core/gpuMemory.h"
 
 namespace Pal
 {
@@ -38,8 +40,11 @@ class Device;
 class CmdBuffer;
 class IFence;
 class ICmdBuffer;
+class Platform;
 
-// Describes a token which can be waited-on to wait for a previously-submitted upload to // finish.
+// Describes a token which can be waited-on to wait for a previously-submitted upload to finish.  Tokens are batch IDs
+// on the upload ring's own timeline: they increase monotonically and a token is complete once the batch of copies it
+// names has finished executing on the DMA queue.
 typedef uint64 UploadFenceToken;
 
 // Describes a slot in the upload ring where work can be recorded.
@@ -48,6 +53,13 @@ typedef uint32 UploadRingSlot;
 constexpr uint32 RingInitEntries = 512;  ///< Max number of entries in DmaUploadRing.
 
 // =====================================================================================================================
+// Serializes uploads of pipeline binaries to invisible local memory onto an internal DMA queue.
+//
+// Upload data is staged in a persistently mapped GART arena which is recycled as batches complete; if the arena is
+// full the data is staged in the slot's embedded data instead.  A slot submitted while the DMA queue is idle is sent to
+// the queue immediately.  While an earlier batch is still executing, submitted slots are coalesced into one pending
+// batch instead, which is flushed when the coalescing window expires, when it reaches its maximum size, when a client
+// submits work to a universal or compute queue, or as soon as anyone needs to wait on its token.
 class DmaUploadRing
 {
 public:
@@ -60,44 +72,113 @@ public:
         UploadFenceToken* pCompletionFence,
         uint64            pagingFenceVal);
 
-    virtual Result WaitForPendingUpload(
+    // Waits for the batch named by fenceValue to complete, first submitting it if it is still being coalesced.
+    Result WaitForPendingUpload(
         Pal::Queue*      pWaiter,
-        UploadFenceToken fenceValue) = 0;
+        UploadFenceToken fenceValue);
 
-    // Records DMA upload commands from embedded data to the destination.  Will only copy
-    // up to the embedded data limit. Actual bytes copied are returned.  Caller must
-    // initialize the embedded data buffer returned through ppEmbeddedData after this
-    // returns.
-    size_t UploadUsingEmbeddedData(
+    // Makes sure that the batch named by fenceValue has been submitted to the DMA queue.
+    Result FlushPendingUpload(UploadFenceToken fenceValue);
+
+    // Submits every slot which is still being coalesced to the DMA queue.
+    Result FlushPendingSlots();
+
+    // Returns true if any slot is being coalesced.  May be called without holding the ring's lock: a slot added by
+    // another thread concurrently with this call isn't ordered with the caller's work either way.
+    bool HasPendingSlots() const { return (m_numPendingSlots > 0); }
+
+    // Records DMA upload commands from staging memory to the destination.  Will only copy up to the staging limit.
+    // Actual bytes copied are returned.  Caller must initialize the staging buffer returned through ppStagingData
+    // before the slot is submitted.
+    size_t UploadUsingStagingMemory(
         UploadRingSlot  slotId,
         Pal::GpuMemory* pDst,
         gpusize         dstOffset,
         size_t          bytes,
-        void**          ppEmbeddedData);
+        void**          ppStagingData);
 
 protected:
+    // Waits until the internal DMA queue's submission with the given timestamp has completed.
+    virtual Result WaitForSubmission(
+        Pal::Queue* pWaiter,
+        uint64      timestamp) = 0;
+
     Pal::Device* m_pDevice;
     Pal::Queue*  m_pDmaQueue;
 
 private:
     struct Entry
     {
-        ICmdBuffer* pCmdBuf;
-        IFence*     pFence;
+        ICmdBuffer*      pCmdBuf;
+        IFence*          pFence;
+        UploadFenceToken batchId;       // Batch this slot was submitted in, or zero if it hasn't been submitted.
+        gpusize          stagingStart;  // Virtual arena offset of this slot's first staging allocation.
     };
+
+    // A coalesced submission which is executing on the DMA queue.
+    struct Batch
+    {
+        UploadFenceToken id;
+        uint64           timestamp;     // DMA queue timestamp of the submission.
+        IFence*          pFence;        // Fence of the batch's last slot, which is signaled by the submission.
+    };
+
     // Initialize each item of the ring from m_firstEntryFree to the end of the ring.
     Result InitRingItem(uint32 slotIdx);
+    Result InitStagingArena();
     Result CreateInternalCopyQueue();
     Result CreateInternalCopyCmdBuffer(CmdBuffer** ppCmdBuffer);
     Result CreateInternalFence(IFence** ppFence);
     Result ResizeRing();
     Result FreeFinishedSlots();
+    bool   CoalesceWindowExpired() const;
+    void   LogUploadStats() const;
+
+    size_t UploadUsingEmbeddedData(
+        UploadRingSlot  slotId,
+        Pal::GpuMemory* pDst,
+        gpusize         dstOffset,
+        size_t          bytes,
+        void**          ppEmbeddedData);
+
+    bool AllocateStaging(
+        UploadRingSlot slotId,
+        size_t         bytes,
+        gpusize*       pOffset);
 
     Entry* m_pRing;
     uint32 m_ringCapacity;
     uint32 m_firstEntryInUse;
     uint32 m_firstEntryFree;
     uint32 m_numEntriesInUse;
+
+    // Staging arena.  Offsets are virtual: they increase monotonically and wrap around the arena modulo its size.
+    BoundGpuMemory m_stagingMem;
+    void*          m_pStagingCpuAddr;
+    gpusize        m_stagingHead;       // Next free virtual offset.
+    gpusize        m_stagingTail;       // Oldest virtual offset which may still be in use.
+
+    // Upload timeline.
+    UploadFenceToken m_nextBatchId;     // Batch which newly submitted slots join.
+    UploadFenceToken m_retiredBatchId;  // Every batch up to and including this one has completed.
+    Util::Deque<Batch, Platform> m_batches;
+
+    // Slots which have been submitted but are still being coalesced.
+    static constexpr uint32 MaxBatchSlots = 32;
+    ICmdBuffer*     m_pPendingCmdBufs[MaxBatchSlots];
+    volatile uint32 m_numPendingSlots;  // Only written under the ring's lock, see HasPendingSlots().
+    uint32          m_lastPendingSlot;
+    int64           m_batchOpenTime;    // CPU timestamp of the first slot added to the pending batch.
+    int64           m_pendingSubmitTime; // Sum of the CPU timestamps at which each pending slot was submitted.
+
+    // Upload statistics, logged when the ring is destroyed.
+    struct
+    {
+        uint64 slots;               // Slots submitted to the DMA queue.
+        uint64 batches;             // DMA queue submissions.
+        int64  totalDelayTicks;     // Sum of the time each slot spent being coalesced.
+        int64  maxDelayTicks;       // Longest time any slot spent being coalesced.
+    } m_stats;
 };
 
 }
@@ -0,0 +1,1351 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "palFormatInfo.h"
+#include "palInlineFuncs.h"
+#include "palMath.h"
+#include "palSysUtil.h"
+
+#include <string.h>
+
+#if PAL_HAS_CPUID
+#include <immintrin.h>
+#endif
+
+using namespace Util;
+using namespace Util::Math;
+
+namespace Pal
+{
+namespace Formats
+{
+
+// Pixels are converted in chunks.  Each chunk is decoded into four floats per pixel, in the source format's component
+// order, then remapped into the destination format's component order and encoded.
+static constexpr uint32 ChunkPixels = 64;
+
+// Identifies the decode and encode kernels for a format.  Every layout has four components per pixel, formats with
+// fewer channels decode the missing ones as zero and ignore them when encoding.
+enum class BulkLayout : uint32
+{
+    Unorm8 = 0,
+    Snorm8,
+    Srgb8,
+    Unorm16,
+    Snorm16,
+    Float16,
+    Float32,
+    Unorm1010102,
+    Float111110,
+    Float999E5,
+    Count
+};
+
+struct BulkFormat
+{
+    ChNumFormat format;
+    BulkLayout  layout;
+};
+
+// Every format which ConvertPixels() supports.
+static constexpr BulkFormat BulkFormatTable[] =
+{
+    { ChNumFormat::X8Y8Z8W8_Unorm,       BulkLayout::Unorm8       },
+    { ChNumFormat::X8Y8Z8W8_Snorm,       BulkLayout::Snorm8       },
+    { ChNumFormat::X8Y8Z8W8_Srgb,        BulkLayout::Srgb8        },
+    { ChNumFormat::X16Y16Z16W16_Unorm,   BulkLayout::Unorm16      },
+    { ChNumFormat::X16Y16Z16W16_Snorm,   BulkLayout::Snorm16      },
+    { ChNumFormat::X16Y16Z16W16_Float,   BulkLayout::Float16      },
+    { ChNumFormat::X32Y32Z32W32_Float,   BulkLayout::Float32      },
+    { ChNumFormat::X10Y10Z10W2_Unorm,    BulkLayout::Unorm1010102 },
+    { ChNumFormat::X11Y11Z10_Float,      BulkLayout::Float111110  },
+    { ChNumFormat::X9Y9Z9E5_Float,       BulkLayout::Float999E5   },
+};
+
+typedef void (*PfnDecodePixels)(const void* pSrc, float* pComps, uint32 count);
+typedef void (*PfnEncodePixels)(const float* pComps, void* pDst, uint32 count);
+
+struct BulkKernels
+{
+    PfnDecodePixels pfnDecode[static_cast<uint32>(BulkLayout::Count)];
+    PfnEncodePixels pfnEncode[static_cast<uint32>(BulkLayout::Count)];
+};
+
+// sRGB conversions go through tables instead of evaluating Pow() per component.
+struct SrgbTables
+{
+    float toLinear[256];     // Linear value of each 8-bit sRGB code.
+    float encodeMin[256];    // Smallest linear value which encodes to each 8-bit sRGB code, entry zero is unused.
+};
+
+// =====================================================================================================================
+// Encodes a linear value to an 8-bit sRGB code exactly like ConvertColor() does.
+static uint32 LinearToSrgb8Reference(
+    float linear)
+{
+    return FloatToUFixed(LinearToGamma(linear), 0, 8, true);
+}
+
+// =====================================================================================================================
+static SrgbTables BuildSrgbTables()
+{
+    SrgbTables tables = {};
+
+    for (uint32 code = 0; code < 256; code++)
+    {
+        tables.toLinear[code] = GammaToLinear(UFixedToFloat(code, 0, 8));
+    }
+
+    // The encoding is monotonic over the non-negative floats, whose bit patterns are ordered like the values, so the
+    // smallest value which reaches each code can be found with a binary search on the bits.  Everything from 1.0 up
+    // encodes to 255.
+    constexpr uint32 OneBits = 0x3F800000;
+
+    for (uint32 code = 1; code < 256; code++)
+    {
+        uint32 lo = 0;
+        uint32 hi = OneBits;
+
+        while (lo < hi)
+        {
+            const uint32 mid = lo + ((hi - lo) / 2);
+            float        value;
+            SetBitsToFloat(&value, mid);
+
+            if (LinearToSrgb8Reference(value) >= code)
+            {
+                hi = mid;
+            }
+            else
+            {
+                lo = mid + 1;
+            }
+        }
+
+        SetBitsToFloat(&tables.encodeMin[code], lo);
+    }
+
+    return tables;
+}
+
+// =====================================================================================================================
+static const SrgbTables& GetSrgbTables()
+{
+    static const SrgbTables Tables = BuildSrgbTables();
+    return Tables;
+}
+
+// =====================================================================================================================
+// Encodes a linear value to an 8-bit sRGB code using the threshold table.  Negative values and NaNs encode to zero.
+static uint32 LinearToSrgb8(
+    const SrgbTables& tables,
+    float             linear)
+{
+    uint32 code = 0;
+
+    for (uint32 step = 128; step > 0; step >>= 1)
+    {
+        code += (linear >= tables.encodeMin[code + step]) ? step : 0;
+    }
+
+    return code;
+}
+
+// =====================================================================================================================
+// Scalar kernels.  These define the results every other kernel must reproduce.
+
+// =====================================================================================================================
+static void DecodeUnorm8Scalar(
+    const void* pSrc,
+    float*      pComps,
+    uint32      count)
+{
+    const uint8* pIn = static_cast<const uint8*>(pSrc);
+
+    for (uint32 i = 0; i < (count * 4); i++)
+    {
+        pComps[i] = UFixedToFloat(pIn[i], 0, 8);
+    }
+}
+
+// =====================================================================================================================
+static void EncodeUnorm8Scalar(
+    const float* pComps,
+    void*        pDst,
+    uint32       count)
+{
+    uint8* pOut = static_cast<uint8*>(pDst);
+
+    for (uint32 i = 0; i < (count * 4); i++)
+    {
+        pOut[i] = static_cast<uint8>(FloatToUFixed(pComps[i], 0, 8, true));
+    }
+}
+
+// =====================================================================================================================
+static void DecodeSnorm8Scalar(
+    const void* pSrc,
+    float*      pComps,
+    uint32      count)
+{
+    const int8* pIn = static_cast<const int8*>(pSrc);
+
+    for (uint32 i = 0; i < (count * 4); i++)
+    {
+        pComps[i] = SFixedToFloat(pIn[i], 0, 8);
+    }
+}
+
+// =====================================================================================================================
+static void EncodeSnorm8Scalar(
+    const float* pComps,
+    void*        pDst,
+    uint32       count)
+{
+    uint8* pOut = static_cast<uint8*>(pDst);
+
+    for (uint32 i = 0; i < (count * 4); i++)
+    {
+        pOut[i] = static_cast<uint8>(FloatToSFixed(pComps[i], 0, 8, true));
+    }
+}
+
+// =====================================================================================================================
+// sRGB conversions never apply to the alpha channel, which SupportsBulkConversion() guarantees is in W.
+static void DecodeSrgb8Scalar(
+    const void* pSrc,
+    float*      pComps,
+    uint32      count)
+{
+    const SrgbTables& tables = GetSrgbTables();
+    const uint8*      pIn    = static_cast<const uint8*>(pSrc);
+
+    for (uint32 i = 0; i < (count * 4); i += 4)
+    {
+        pComps[i + 0] = tables.toLinear[pIn[i + 0]];
+        pComps[i + 1] = tables.toLinear[pIn[i + 1]];
+        pComps[i + 2] = tables.toLinear[pIn[i + 2]];
+        pComps[i + 3] = UFixedToFloat(pIn[i + 3], 0, 8);
+    }
+}
+
+// =====================================================================================================================
+static void EncodeSrgb8Scalar(
+    const float* pComps,
+    void*        pDst,
+    uint32       count)
+{
+    const SrgbTables& tables = GetSrgbTables();
+    uint8*            pOut   = static_cast<uint8*>(pDst);
+
+    for (uint32 i = 0; i < (count * 4); i += 4)
+    {
+        pOut[i + 0] = static_cast<uint8>(LinearToSrgb8(tables, pComps[i + 0]));
+        pOut[i + 1] = static_cast<uint8>(LinearToSrgb8(tables, pComps[i + 1]));
+        pOut[i + 2] = static_cast<uint8>(LinearToSrgb8(tables, pComps[i + 2]));
+        pOut[i + 3] = static_cast<uint8>(FloatToUFixed(pComps[i + 3], 0, 8, true));
+    }
+}
+
+// =====================================================================================================================
+static void DecodeUnorm16Scalar(
+    const void* pSrc,
+    float*      pComps,
+    uint32      count)
+{
+    const uint16* pIn = static_cast<const uint16*>(pSrc);
+
+    for (uint32 i = 0; i < (count * 4); i++)
+    {
+        pComps[i] = UFixedToFloat(pIn[i], 0, 16);
+    }
+}
+
+// =====================================================================================================================
+static void EncodeUnorm16Scalar(
+    const float* pComps,
+    void*        pDst,
+    uint32       count)
+{
+    uint16* pOut = static_cast<uint16*>(pDst);
+
+    for (uint32 i = 0; i < (count * 4); i++)
+    {
+        pOut[i] = static_cast<uint16>(FloatToUFixed(pComps[i], 0, 16, true));
+    }
+}
+
+// =====================================================================================================================
+static void DecodeSnorm16Scalar(
+    const void* pSrc,
+    float*      pComps,
+    uint32      count)
+{
+    const int16* pIn = static_cast<const int16*>(pSrc);
+
+    for (uint32 i = 0; i < (count * 4); i++)
+    {
+        pComps[i] = SFixedToFloat(pIn[i], 0, 16);
+    }
+}
+
+// =====================================================================================================================
+static void EncodeSnorm16Scalar(
+    const float* pComps,
+    void*        pDst,
+    uint32       count)
+{
+    uint16* pOut = static_cast<uint16*>(pDst);
+
+    for (uint32 i = 0; i < (count * 4); i++)
+    {
+        pOut[i] = static_cast<uint16>(FloatToSFixed(pComps[i], 0, 16, true));
+    }
+}
+
+// =====================================================================================================================
+static void DecodeFloat16Scalar(
+    const void* pSrc,
+    float*      pComps,
+    uint32      count)
+{
+    const uint16* pIn = static_cast<const uint16*>(pSrc);
+
+    for (uint32 i = 0; i < (count * 4); i++)
+    {
+        pComps[i] = Float16ToFloat32(pIn[i]);
+    }
+}
+
+// =====================================================================================================================
+static void EncodeFloat16Scalar(
+    const float* pComps,
+    void*        pDst,
+    uint32       count)
+{
+    uint16* pOut = static_cast<uint16*>(pDst);
+
+    for (uint32 i = 0; i < (count * 4); i++)
+    {
+        pOut[i] = static_cast<uint16>(Float32ToFloat16(pComps[i]));
+    }
+}
+
+// =====================================================================================================================
+static void DecodeFloat32(
+    const void* pSrc,
+    float*      pComps,
+    uint32      count)
+{
+    memcpy(pComps, pSrc, count * 4 * sizeof(float));
+}
+
+// =====================================================================================================================
+static void EncodeFloat32(
+    const float* pComps,
+    void*        pDst,
+    uint32       count)
+{
+    memcpy(pDst, pComps, count * 4 * sizeof(float));
+}
+
+// =====================================================================================================================
+static void DecodeUnorm1010102Scalar(
+    const void* pSrc,
+    float*      pComps,
+    uint32      count)
+{
+    const uint32* pIn = static_cast<const uint32*>(pSrc);
+
+    for (uint32 i = 0; i < count; i++)
+    {
+        pComps[(i * 4) + 0] = UFixedToFloat(pIn[i]         & 0x3FF, 0, 10);
+        pComps[(i * 4) + 1] = UFixedToFloat((pIn[i] >> 10) & 0x3FF, 0, 10);
+        pComps[(i * 4) + 2] = UFixedToFloat((pIn[i] >> 20) & 0x3FF, 0, 10);
+        pComps[(i * 4) + 3] = UFixedToFloat(pIn[i] >> 30,           0, 2);
+    }
+}
+
+// =====================================================================================================================
+static void EncodeUnorm1010102Scalar(
+    const float* pComps,
+    void*        pDst,
+    uint32       count)
+{
+    uint32* pOut = static_cast<uint32*>(pDst);
+
+    for (uint32 i = 0; i < count; i++)
+    {
+        pOut[i] = (FloatToUFixed(pComps[(i * 4) + 0], 0, 10, true))       |
+                  (FloatToUFixed(pComps[(i * 4) + 1], 0, 10, true) << 10) |
+                  (FloatToUFixed(pComps[(i * 4) + 2], 0, 10, true) << 20) |
+                  (FloatToUFixed(pComps[(i * 4) + 3], 0, 2,  true) << 30);
+    }
+}
+
+// =====================================================================================================================
+static void DecodeFloat111110Scalar(
+    const void* pSrc,
+    float*      pComps,
+    uint32      count)
+{
+    const uint32* pIn = static_cast<const uint32*>(pSrc);
+
+    for (uint32 i = 0; i < count; i++)
+    {
+        pComps[(i * 4) + 0] = Float11ToFloat32(pIn[i]         & 0x7FF);
+        pComps[(i * 4) + 1] = Float11ToFloat32((pIn[i] >> 11) & 0x7FF);
+        pComps[(i * 4) + 2] = Float10ToFloat32(pIn[i] >> 22);
+        pComps[(i * 4) + 3] = 0.0f;
+    }
+}
+
+// =====================================================================================================================
+static void EncodeFloat111110Scalar(
+    const float* pComps,
+    void*        pDst,
+    uint32       count)
+{
+    uint32* pOut = static_cast<uint32*>(pDst);
+
+    for (uint32 i = 0; i < count; i++)
+    {
+        pOut[i] = (Float32ToFloat11(pComps[(i * 4) + 0]))       |
+                  (Float32ToFloat11(pComps[(i * 4) + 1]) << 11) |
+                  (Float32ToFloat10(pComps[(i * 4) + 2]) << 22);
+    }
+}
+
+// =====================================================================================================================
+static void DecodeFloat999E5(
+    const void* pSrc,
+    float*      pComps,
+    uint32      count)
+{
+    // Each component is a 9-bit mantissa with no implied leading one, scaled by 2^(exponent - bias - mantissa bits).
+    constexpr int32 ExponentBias = 15;
+    constexpr int32 MantissaBits = 9;
+
+    const uint32* pIn = static_cast<const uint32*>(pSrc);
+
+    for (uint32 i = 0; i < count; i++)
+    {
+        float scale;
+        SetBitsToFloat(&scale, static_cast<uint32>((pIn[i] >> 27) - ExponentBias - MantissaBits + 127) << 23);
+
+        pComps[(i * 4) + 0] = static_cast<float>(pIn[i]         & 0x1FF) * scale;
+        pComps[(i * 4) + 1] = static_cast<float>((pIn[i] >> 9)  & 0x1FF) * scale;
+        pComps[(i * 4) + 2] = static_cast<float>((pIn[i] >> 18) & 0x1FF) * scale;
+        pComps[(i * 4) + 3] = 0.0f;
+    }
+}
+
+// =====================================================================================================================
+static void EncodeFloat999E5(
+    const float* pComps,
+    void*        pDst,
+    uint32       count)
+{
+    // The shared exponent needs a log2 and a pow per pixel, so this goes through ConvertColor() rather than trying to
+    // vectorize it.
+    constexpr SwizzledFormat Format =
+    {
+        ChNumFormat::X9Y9Z9E5_Float,
+        { { { ChannelSwizzle::X, ChannelSwizzle::Y, ChannelSwizzle::Z, ChannelSwizzle::One } } },
+    };
+
+    uint32* pOut = static_cast<uint32*>(pDst);
+
+    for (uint32 i = 0; i < count; i++)
+    {
+        uint32 color[4] = {};
+        ConvertColor(Format, &pComps[i * 4], &color[0]);
+
+        pOut[i] = color[0] | (color[1] << 9) | (color[2] << 18) | (color[3] << 27);
+    }
+}
+
+#if PAL_HAS_CPUID
+// =====================================================================================================================
+// SSE2 kernels.  These handle four pixels' worth of 8-bit components or two pixels' worth of 16-bit components per
+// iteration and leave the remainder to the scalar kernels.  The unorm/snorm conversions divide rather than multiply by
+// a reciprocal so that they round exactly like the scalar code.
+
+// =====================================================================================================================
+// Converts four floats to normalized integers like FloatToUFixed(value, 0, n, true) where scale is 2^n - 1.
+static PAL_TARGET_SSE2 __m128i FloatToUnormSse2(
+    __m128 value,
+    __m128 scale)
+{
+    const __m128 notNaN  = _mm_cmpord_ps(value, value);
+    const __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_and_ps(value, notNaN), _mm_setzero_ps()), _mm_set1_ps(1.0f));
+
+    return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, scale), _mm_set1_ps(0.5f)));
+}
+
+// =====================================================================================================================
+// Converts four floats to normalized integers like FloatToSFixed(value, 0, n, true) where scale is 2^(n-1) - 1.
+static PAL_TARGET_SSE2 __m128i FloatToSnormSse2(
+    __m128 value,
+    __m128 scale)
+{
+    const __m128 notNaN  = _mm_cmpord_ps(value, value);
+    const __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_and_ps(value, notNaN), _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+    const __m128 scaled  = _mm_mul_ps(clamped, scale);
+
+    // Round half away from zero.  Zero rounds up, which truncates to zero just like rounding down does.
+    const __m128 half = _mm_or_ps(_mm_set1_ps(0.5f), _mm_and_ps(scaled, _mm_set1_ps(-0.0f)));
+
+    return _mm_cvttps_epi32(_mm_add_ps(scaled, half));
+}
+
+// =====================================================================================================================
+static PAL_TARGET_SSE2 void DecodeUnorm8Sse2(
+    const void* pSrc,
+    float*      pComps,
+    uint32      count)
+{
+    const uint8*  pIn      = static_cast<const uint8*>(pSrc);
+    const uint32  numComps = count * 4;
+    const __m128  scale    = _mm_set1_ps(255.0f);
+    const __m128i zero     = _mm_setzero_si128();
+
+    uint32 i = 0;
+    for (; (i + 16) <= numComps; i += 16)
+    {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + i));
+        const __m128i lo    = _mm_unpacklo_epi8(bytes, zero);
+        const __m128i hi    = _mm_unpackhi_epi8(bytes, zero);
+
+        _mm_storeu_ps(pComps + i + 0,  _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+        _mm_storeu_ps(pComps + i + 4,  _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+        _mm_storeu_ps(pComps + i + 8,  _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+        _mm_storeu_ps(pComps + i + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+    }
+
+    DecodeUnorm8Scalar(pIn + i, pComps + i, (numComps - i) / 4);
+}
+
+// =====================================================================================================================
+static PAL_TARGET_SSE2 void EncodeUnorm8Sse2(
+    const float* pComps,
+    void*        pDst,
+    uint32       count)
+{
+    uint8*       pOut     = static_cast<uint8*>(pDst);
+    const uint32 numComps = count * 4;
+    const __m128 scale    = _mm_set1_ps(255.0f);
+
+    uint32 i = 0;
+    for (; (i + 16) <= numComps; i += 16)
+    {
+        const __m128i a = FloatToUnormSse2(_mm_loadu_ps(pComps + i + 0),  scale);
+        const __m128i b = FloatToUnormSse2(_mm_loadu_ps(pComps + i + 4),  scale);
+        const __m128i c = FloatToUnormSse2(_mm_loadu_ps(pComps + i + 8),  scale);
+        const __m128i d = FloatToUnormSse2(_mm_loadu_ps(pComps + i + 12), scale);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i),
+                         _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+    }
+
+    EncodeUnorm8Scalar(pComps + i, pOut + i, (numComps - i) / 4);
+}
+
+// =====================================================================================================================
+static PAL_TARGET_SSE2 void DecodeSnorm8Sse2(
+    const void* pSrc,
+    float*      pComps,
+    uint32      count)
+{
+    const uint8*  pIn      = static_cast<const uint8*>(pSrc);
+    const uint32  numComps = count * 4;
+    const __m128  scale    = _mm_set1_ps(127.0f);
+    const __m128i zero     = _mm_setzero_si128();
+
+    uint32 i = 0;
+    for (; (i + 16) <= numComps; i += 16)
+    {
+        // Move each byte to the top of its lane and shift it back down to sign extend it.
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + i));
+        const __m128i lo    = _mm_unpacklo_epi8(zero, bytes);
+        const __m128i hi    = _mm_unpackhi_epi8(zero, bytes);
+
+        const __m128i a = _mm_srai_epi32(_mm_unpacklo_epi16(zero, lo), 24);
+        const __m128i b = _mm_srai_epi32(_mm_unpackhi_epi16(zero, lo), 24);
+        const __m128i c = _mm_srai_epi32(_mm_unpacklo_epi16(zero, hi), 24);
+        const __m128i d = _mm_srai_epi32(_mm_unpackhi_epi16(zero, hi), 24);
+
+        _mm_storeu_ps(pComps + i + 0,  _mm_div_ps(_mm_cvtepi32_ps(a), scale));
+        _mm_storeu_ps(pComps + i + 4,  _mm_div_ps(_mm_cvtepi32_ps(b), scale));
+        _mm_storeu_ps(pComps + i + 8,  _mm_div_ps(_mm_cvtepi32_ps(c), scale));
+        _mm_storeu_ps(pComps + i + 12, _mm_div_ps(_mm_cvtepi32_ps(d), scale));
+    }
+
+    DecodeSnorm8Scalar(pIn + i, pComps + i, (numComps - i) / 4);
+}
+
+// =====================================================================================================================
+static PAL_TARGET_SSE2 void EncodeSnorm8Sse2(
+    const float* pComps,
+    void*        pDst,
+    uint32       count)
+{
+    uint8*       pOut     = static_cast<uint8*>(pDst);
+    const uint32 numComps = count * 4;
+    const __m128 scale    = _mm_set1_ps(127.0f);
+
+    uint32 i = 0;
+    for (; (i + 16) <= numComps; i += 16)
+    {
+        const __m128i a = FloatToSnormSse2(_mm_loadu_ps(pComps + i + 0),  scale);
+        const __m128i b = FloatToSnormSse2(_mm_loadu_ps(pComps + i + 4),  scale);
+        const __m128i c = FloatToSnormSse2(_mm_loadu_ps(pComps + i + 8),  scale);
+        const __m128i d = FloatToSnormSse2(_mm_loadu_ps(pComps + i + 12), scale);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i),
+                         _mm_packs_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+    }
+
+    EncodeSnorm8Scalar(pComps + i, pOut + i, (numComps - i) / 4);
+}
+
+// =====================================================================================================================
+static PAL_TARGET_SSE2 void DecodeUnorm16Sse2(
+    const void* pSrc,
+    float*      pComps,
+    uint32      count)
+{
+    const uint16* pIn      = static_cast<const uint16*>(pSrc);
+    const uint32  numComps = count * 4;
+    const __m128  scale    = _mm_set1_ps(65535.0f);
+    const __m128i zero     = _mm_setzero_si128();
+
+    uint32 i = 0;
+    for (; (i + 8) <= numComps; i += 8)
+    {
+        const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + i));
+
+        _mm_storeu_ps(pComps + i + 0, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(words, zero)), scale));
+        _mm_storeu_ps(pComps + i + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(words, zero)), scale));
+    }
+
+    DecodeUnorm16Scalar(pIn + i, pComps + i, (numComps - i) / 4);
+}
+
+// =====================================================================================================================
+static PAL_TARGET_SSE2 void EncodeUnorm16Sse2(
+    const float* pComps,
+    void*        pDst,
+    uint32       count)
+{
+    uint16*       pOut     = static_cast<uint16*>(pDst);
+    const uint32  numComps = count * 4;
+    const __m128  scale    = _mm_set1_ps(65535.0f);
+    const __m128i bias     = _mm_set1_epi32(0x8000);
+
+    uint32 i = 0;
+    for (; (i + 8) <= numComps; i += 8)
+    {
+        // SSE2 can only pack with signed saturation, so pack biased values and flip the top bit back afterward.
+        const __m128i a = _mm_sub_epi32(FloatToUnormSse2(_mm_loadu_ps(pComps + i + 0), scale), bias);
+        const __m128i b = _mm_sub_epi32(FloatToUnormSse2(_mm_loadu_ps(pComps + i + 4), scale), bias);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i),
+                         _mm_xor_si128(_mm_packs_epi32(a, b), _mm_set1_epi16(-0x8000)));
+    }
+
+    EncodeUnorm16Scalar(pComps + i, pOut + i, (numComps - i) / 4);
+}
+
+// =====================================================================================================================
+static PAL_TARGET_SSE2 void DecodeSnorm16Sse2(
+    const void* pSrc,
+    float*      pComps,
+    uint32      count)
+{
+    const uint16* pIn      = static_cast<const uint16*>(pSrc);
+    const uint32  numComps = count * 4;
+    const __m128  scale    = _mm_set1_ps(32767.0f);
+    const __m128i zero     = _mm_setzero_si128();
+
+    uint32 i = 0;
+    for (; (i + 8) <= numComps; i += 8)
+    {
+        const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + i));
+        const __m128i a     = _mm_srai_epi32(_mm_unpacklo_epi16(zero, words), 16);
+        const __m128i b     = _mm_srai_epi32(_mm_unpackhi_epi16(zero, words), 16);
+
+        _mm_storeu_ps(pComps + i + 0, _mm_div_ps(_mm_cvtepi32_ps(a), scale));
+        _mm_storeu_ps(pComps + i + 4, _mm_div_ps(_mm_cvtepi32_ps(b), scale));
+    }
+
+    DecodeSnorm16Scalar(pIn + i, pComps + i, (numComps - i) / 4);
+}
+
+// =====================================================================================================================
+static PAL_TARGET_SSE2 void EncodeSnorm16Sse2(
+    const float* pComps,
+    void*        pDst,
+    uint32       count)
+{
+    uint16*      pOut     = static_cast<uint16*>(pDst);
+    const uint32 numComps = count * 4;
+    const __m128 scale    = _mm_set1_ps(32767.0f);
+
+    uint32 i = 0;
+    for (; (i + 8) <= numComps; i += 8)
+    {
+        const __m128i a = FloatToSnormSse2(_mm_loadu_ps(pComps + i + 0), scale);
+        const __m128i b = FloatToSnormSse2(_mm_loadu_ps(pComps + i + 4), scale);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i), _mm_packs_epi32(a, b));
+    }
+
+    EncodeSnorm16Scalar(pComps + i, pOut + i, (numComps - i) / 4);
+}
+
+// =====================================================================================================================
+// AVX2 kernels.  These process twice as many components per iteration as the SSE2 kernels.  The 256-bit pack
+// instructions work within each 128-bit half, so the packed results are permuted back into order before storing.
+
+// =====================================================================================================================
+static PAL_TARGET_AVX2 __m256i FloatToUnormAvx2(
+    __m256 value,
+    __m256 scale)
+{
+    const __m256 notNaN  = _mm256_cmp_ps(value, value, _CMP_ORD_Q);
+    const __m256 clamped = _mm256_min_ps(_mm256_max_ps(_mm256_and_ps(value, notNaN), _mm256_setzero_ps()),
+                                         _mm256_set1_ps(1.0f));
+
+    return _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(clamped, scale), _mm256_set1_ps(0.5f)));
+}
+
+// =====================================================================================================================
+static PAL_TARGET_AVX2 __m256i FloatToSnormAvx2(
+    __m256 value,
+    __m256 scale)
+{
+    const __m256 notNaN  = _mm256_cmp_ps(value, value, _CMP_ORD_Q);
+    const __m256 clamped = _mm256_min_ps(_mm256_max_ps(_mm256_and_ps(value, notNaN), _mm256_set1_ps(-1.0f)),
+                                         _mm256_set1_ps(1.0f));
+    const __m256 scaled  = _mm256_mul_ps(clamped, scale);
+    const __m256 half    = _mm256_or_ps(_mm256_set1_ps(0.5f), _mm256_and_ps(scaled, _mm256_set1_ps(-0.0f)));
+
+    return _mm256_cvttps_epi32(_mm256_add_ps(scaled, half));
+}
+
+// =====================================================================================================================
+static PAL_TARGET_AVX2 void DecodeUnorm8Avx2(
+    const void* pSrc,
+    float*      pComps,
+    uint32      count)
+{
+    const uint8* pIn      = static_cast<const uint8*>(pSrc);
+    const uint32 numComps = count * 4;
+    const __m256 scale    = _mm256_set1_ps(255.0f);
+
+    uint32 i = 0;
+    for (; (i + 16) <= numComps; i += 16)
+    {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + i));
+
+        _mm256_storeu_ps(pComps + i + 0, _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(bytes)), scale));
+        _mm256_storeu_ps(pComps + i + 8,
+                         _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(bytes, 8))), scale));
+    }
+
+    DecodeUnorm8Scalar(pIn + i, pComps + i, (numComps - i) / 4);
+}
+
+// =====================================================================================================================
+static PAL_TARGET_AVX2 void EncodeUnorm8Avx2(
+    const float* pComps,
+    void*        pDst,
+    uint32       count)
+{
+    uint8*        pOut     = static_cast<uint8*>(pDst);
+    const uint32  numComps = count * 4;
+    const __m256  scale    = _mm256_set1_ps(255.0f);
+    const __m256i order    = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    uint32 i = 0;
+    for (; (i + 32) <= numComps; i += 32)
+    {
+        const __m256i a = FloatToUnormAvx2(_mm256_loadu_ps(pComps + i + 0),  scale);
+        const __m256i b = FloatToUnormAvx2(_mm256_loadu_ps(pComps + i + 8),  scale);
+        const __m256i c = FloatToUnormAvx2(_mm256_loadu_ps(pComps + i + 16), scale);
+        const __m256i d = FloatToUnormAvx2(_mm256_loadu_ps(pComps + i + 24), scale);
+
+        const __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(a, b), _mm256_packs_epi32(c, d));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pOut + i), _mm256_permutevar8x32_epi32(packed, order));
+    }
+
+    EncodeUnorm8Sse2(pComps + i, pOut + i, (numComps - i) / 4);
+}
+
+// =====================================================================================================================
+static PAL_TARGET_AVX2 void DecodeSnorm8Avx2(
+    const void* pSrc,
+    float*      pComps,
+    uint32      count)
+{
+    const uint8* pIn      = static_cast<const uint8*>(pSrc);
+    const uint32 numComps = count * 4;
+    const __m256 scale    = _mm256_set1_ps(127.0f);
+
+    uint32 i = 0;
+    for (; (i + 16) <= numComps; i += 16)
+    {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + i));
+
+        _mm256_storeu_ps(pComps + i + 0, _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(bytes)), scale));
+        _mm256_storeu_ps(pComps + i + 8,
+                         _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_srli_si128(bytes, 8))), scale));
+    }
+
+    DecodeSnorm8Scalar(pIn + i, pComps + i, (numComps - i) / 4);
+}
+
+// =====================================================================================================================
+static PAL_TARGET_AVX2 void EncodeSnorm8Avx2(
+    const float* pComps,
+    void*        pDst,
+    uint32       count)
+{
+    uint8*        pOut     = static_cast<uint8*>(pDst);
+    const uint32  numComps = count * 4;
+    const __m256  scale    = _mm256_set1_ps(127.0f);
+    const __m256i order    = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    uint32 i = 0;
+    for (; (i + 32) <= numComps; i += 32)
+    {
+        const __m256i a = FloatToSnormAvx2(_mm256_loadu_ps(pComps + i + 0),  scale);
+        const __m256i b = FloatToSnormAvx2(_mm256_loadu_ps(pComps + i + 8),  scale);
+        const __m256i c = FloatToSnormAvx2(_mm256_loadu_ps(pComps + i + 16), scale);
+        const __m256i d = FloatToSnormAvx2(_mm256_loadu_ps(pComps + i + 24), scale);
+
+        const __m256i packed = _mm256_packs_epi16(_mm256_packs_epi32(a, b), _mm256_packs_epi32(c, d));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pOut + i), _mm256_permutevar8x32_epi32(packed, order));
+    }
+
+    EncodeSnorm8Sse2(pComps + i, pOut + i, (numComps - i) / 4);
+}
+
+// =====================================================================================================================
+static PAL_TARGET_AVX2 void DecodeUnorm16Avx2(
+    const void* pSrc,
+    float*      pComps,
+    uint32      count)
+{
+    const uint16* pIn      = static_cast<const uint16*>(pSrc);
+    const uint32  numComps = count * 4;
+    const __m256  scale    = _mm256_set1_ps(65535.0f);
+
+    uint32 i = 0;
+    for (; (i + 8) <= numComps; i += 8)
+    {
+        const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + i));
+
+        _mm256_storeu_ps(pComps + i, _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(words)), scale));
+    }
+
+    DecodeUnorm16Scalar(pIn + i, pComps + i, (numComps - i) / 4);
+}
+
+// =====================================================================================================================
+static PAL_TARGET_AVX2 void EncodeUnorm16Avx2(
+    const float* pComps,
+    void*        pDst,
+    uint32       count)
+{
+    uint16*      pOut     = static_cast<uint16*>(pDst);
+    const uint32 numComps = count * 4;
+    const __m256 scale    = _mm256_set1_ps(65535.0f);
+
+    uint32 i = 0;
+    for (; (i + 16) <= numComps; i += 16)
+    {
+        const __m256i a = FloatToUnormAvx2(_mm256_loadu_ps(pComps + i + 0), scale);
+        const __m256i b = FloatToUnormAvx2(_mm256_loadu_ps(pComps + i + 8), scale);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pOut + i),
+                            _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b), _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+
+    EncodeUnorm16Sse2(pComps + i, pOut + i, (numComps - i) / 4);
+}
+
+// =====================================================================================================================
+static PAL_TARGET_AVX2 void DecodeSnorm16Avx2(
+    const void* pSrc,
+    float*      pComps,
+    uint32      count)
+{
+    const uint16* pIn      = static_cast<const uint16*>(pSrc);
+    const uint32  numComps = count * 4;
+    const __m256  scale    = _mm256_set1_ps(32767.0f);
+
+    uint32 i = 0;
+    for (; (i + 8) <= numComps; i += 8)
+    {
+        const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + i));
+
+        _mm256_storeu_ps(pComps + i, _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(words)), scale));
+    }
+
+    DecodeSnorm16Scalar(pIn + i, pComps + i, (numComps - i) / 4);
+}
+
+// =====================================================================================================================
+static PAL_TARGET_AVX2 void EncodeSnorm16Avx2(
+    const float* pComps,
+    void*        pDst,
+    uint32       count)
+{
+    uint16*      pOut     = static_cast<uint16*>(pDst);
+    const uint32 numComps = count * 4;
+    const __m256 scale    = _mm256_set1_ps(32767.0f);
+
+    uint32 i = 0;
+    for (; (i + 16) <= numComps; i += 16)
+    {
+        const __m256i a = FloatToSnormAvx2(_mm256_loadu_ps(pComps + i + 0), scale);
+        const __m256i b = FloatToSnormAvx2(_mm256_loadu_ps(pComps + i + 8), scale);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pOut + i),
+                            _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+
+    EncodeSnorm16Sse2(pComps + i, pOut + i, (numComps - i) / 4);
+}
+
+// =====================================================================================================================
+// Decodes two X11Y11Z10 pixels at a time.  Each lane holds one component, W lanes decode to zero.
+static PAL_TARGET_AVX2 void DecodeFloat111110Avx2(
+    const void* pSrc,
+    float*      pComps,
+    uint32      count)
+{
+    const uint32* pIn = static_cast<const uint32*>(pSrc);
+
+    const __m256i shifts   = _mm256_setr_epi32(0, 11, 22, 0, 0, 11, 22, 0);
+    const __m256i masks    = _mm256_setr_epi32(0x7FF, 0x7FF, 0x3FF, 0, 0x7FF, 0x7FF, 0x3FF, 0);
+    const __m256i expMasks = _mm256_setr_epi32(0x7C0, 0x7C0, 0x3E0, 0, 0x7C0, 0x7C0, 0x3E0, 0);
+    const __m256i toFloat  = _mm256_setr_epi32(17, 17, 18, 0, 17, 17, 18, 0); // Shift from the mantissa to float32's.
+
+    // Denormals are the mantissa times 2^(1 - bias - mantissa bits), which is exact in float32.
+    const __m256 denormScale = _mm256_setr_ps(1.0f / (1 << 20), 1.0f / (1 << 20), 1.0f / (1 << 19), 0.0f,
+                                              1.0f / (1 << 20), 1.0f / (1 << 20), 1.0f / (1 << 19), 0.0f);
+
+    uint32 i = 0;
+    for (; (i + 2) <= count; i += 2)
+    {
+        const __m256i packed = _mm256_setr_epi32(pIn[i], pIn[i], pIn[i], pIn[i],
+                                                 pIn[i + 1], pIn[i + 1], pIn[i + 1], pIn[i + 1]);
+        const __m256i bits   = _mm256_and_si256(_mm256_srlv_epi32(packed, shifts), masks);
+        const __m256i exp    = _mm256_and_si256(bits, expMasks);
+        const __m256i frac   = _mm256_andnot_si256(expMasks, bits);
+
+        // Normal values only need their exponent rebiased from 15 to 127.
+        const __m256i normal  = _mm256_add_epi32(_mm256_sllv_epi32(bits, toFloat), _mm256_set1_epi32(112 << 23));
+        const __m256i special = _mm256_or_si256(_mm256_sllv_epi32(frac, toFloat), _mm256_set1_epi32(0x7F800000));
+        const __m256i denorm  = _mm256_castps_si256(_mm256_mul_ps(_mm256_cvtepi32_ps(frac), denormScale));
+
+        __m256i result = normal;
+        result = _mm256_blendv_epi8(result, denorm,  _mm256_cmpeq_epi32(exp, _mm256_setzero_si256()));
+        result = _mm256_blendv_epi8(result, special, _mm256_andnot_si256(_mm256_cmpeq_epi32(expMasks,
+                                                                                         _mm256_setzero_si256()),
+                                                                      _mm256_cmpeq_epi32(exp, expMasks)));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pComps + (i * 4)), result);
+    }
+
+    DecodeFloat111110Scalar(pIn + i, pComps + (i * 4), count - i);
+}
+
+
+// =====================================================================================================================
+// Encodes two X11Y11Z10 pixels at a time, rounding toward zero and handling special values like Float32ToFloat11() and
+// Float32ToFloat10() do.
+static PAL_TARGET_AVX2 void EncodeFloat111110Avx2(
+    const float* pComps,
+    void*        pDst,
+    uint32       count)
+{
+    uint32* pOut = static_cast<uint32*>(pDst);
+
+    // The W lanes reuse the Y lane constants and are masked off before packing.
+    const __m256i toFloatN    = _mm256_setr_epi32(17, 17, 18, 17, 17, 17, 18, 17);
+    const __m256i maxNormal   = _mm256_setr_epi32(0x4707E000, 0x4707E000, 0x4707C000, 0x4707E000,
+                                                  0x4707E000, 0x4707E000, 0x4707C000, 0x4707E000);
+    const __m256i maxFinite   = _mm256_setr_epi32(0x7BF, 0x7BF, 0x3DF, 0x7BF, 0x7BF, 0x7BF, 0x3DF, 0x7BF);
+    const __m256i infinity    = _mm256_setr_epi32(0x7C0, 0x7C0, 0x3E0, 0x7C0, 0x7C0, 0x7C0, 0x3E0, 0x7C0);
+    const __m256i nan         = _mm256_setr_epi32(0x7FF, 0x7FF, 0x3FF, 0x7FF, 0x7FF, 0x7FF, 0x3FF, 0x7FF);
+    const __m256i keep        = _mm256_setr_epi32(-1, -1, -1, 0, -1, -1, -1, 0);
+    const __m256i packShift   = _mm256_setr_epi32(0, 11, 22, 0, 0, 11, 22, 0);
+    const __m256i minNormal   = _mm256_set1_epi32(113 << 23);
+    const __m256i float32Inf  = _mm256_set1_epi32(0x7F800000);
+
+    uint32 i = 0;
+    for (; (i + 2) <= count; i += 2)
+    {
+        const __m256i bits    = _mm256_castps_si256(_mm256_loadu_ps(pComps + (i * 4)));
+        const __m256i absBits = _mm256_and_si256(bits, _mm256_set1_epi32(0x7FFFFFFF));
+
+        // Normal values have their exponent rebiased from 127 to 15.  Denormals get their implicit one made explicit
+        // and are shifted down by how far their exponent is below the smallest normal exponent.
+        const __m256i normal = _mm256_srlv_epi32(_mm256_sub_epi32(absBits, _mm256_set1_epi32(112 << 23)), toFloatN);
+        const __m256i denorm =
+            _mm256_srlv_epi32(_mm256_srlv_epi32(_mm256_or_si256(_mm256_and_si256(absBits, _mm256_set1_epi32(0x7FFFFF)),
+                                                                _mm256_set1_epi32(0x800000)),
+                                                _mm256_sub_epi32(_mm256_set1_epi32(113),
+                                                                 _mm256_srli_epi32(absBits, 23))),
+                              toFloatN);
+
+        __m256i result = normal;
+        result = _mm256_blendv_epi8(result, denorm,    _mm256_cmpgt_epi32(minNormal, absBits));
+        result = _mm256_blendv_epi8(result, maxFinite, _mm256_cmpgt_epi32(absBits, maxNormal));
+        result = _mm256_blendv_epi8(result, infinity,  _mm256_cmpeq_epi32(absBits, float32Inf));
+        result = _mm256_andnot_si256(_mm256_srai_epi32(bits, 31), result);
+        result = _mm256_blendv_epi8(result, nan,       _mm256_cmpgt_epi32(absBits, float32Inf));
+        result = _mm256_sllv_epi32(_mm256_and_si256(result, keep), packShift);
+
+        // OR the components of each pixel together.
+        result = _mm256_or_si256(result, _mm256_shuffle_epi32(result, _MM_SHUFFLE(2, 3, 0, 1)));
+        result = _mm256_or_si256(result, _mm256_shuffle_epi32(result, _MM_SHUFFLE(1, 0, 3, 2)));
+
+        pOut[i]     = static_cast<uint32>(_mm256_extract_epi32(result, 0));
+        pOut[i + 1] = static_cast<uint32>(_mm256_extract_epi32(result, 4));
+    }
+
+    EncodeFloat111110Scalar(pComps + (i * 4), pOut + i, count - i);
+}
+
+// =====================================================================================================================
+// F16C kernels.
+static PAL_TARGET_F16C void DecodeFloat16F16c(
+    const void* pSrc,
+    float*      pComps,
+    uint32      count)
+{
+    const uint16* pIn      = static_cast<const uint16*>(pSrc);
+    const uint32  numComps = count * 4;
+
+    uint32 i = 0;
+    for (; (i + 8) <= numComps; i += 8)
+    {
+        _mm256_storeu_ps(pComps + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + i))));
+    }
+
+    DecodeFloat16Scalar(pIn + i, pComps + i, (numComps - i) / 4);
+}
+
+// =====================================================================================================================
+// Float32ToFloat16() rounds toward zero and turns every NaN into 0x7FFF, so this does the same.
+static PAL_TARGET_F16C void EncodeFloat16F16c(
+    const float* pComps,
+    void*        pDst,
+    uint32       count)
+{
+    uint16*      pOut     = static_cast<uint16*>(pDst);
+    const uint32 numComps = count * 4;
+
+    uint32 i = 0;
+    for (; (i + 8) <= numComps; i += 8)
+    {
+        const __m256  value   = _mm256_loadu_ps(pComps + i);
+        const __m256  isNaN   = _mm256_cmp_ps(value, value, _CMP_UNORD_Q);
+        const __m128i nanMask = _mm_packs_epi32(_mm_castps_si128(_mm256_castps256_ps128(isNaN)),
+                                                _mm_castps_si128(_mm256_extractf128_ps(isNaN, 1)));
+        const __m128i half    = _mm256_cvtps_ph(value, _MM_FROUND_TO_ZERO);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i),
+                         _mm_or_si128(_mm_andnot_si128(nanMask, half), _mm_and_si128(nanMask, _mm_set1_epi16(0x7FFF))));
+    }
+
+    EncodeFloat16Scalar(pComps + i, pOut + i, (numComps - i) / 4);
+}
+#endif
+
+// =====================================================================================================================
+static BulkKernels SelectKernels()
+{
+    BulkKernels kernels =
+    {
+        {
+            &DecodeUnorm8Scalar,
+            &DecodeSnorm8Scalar,
+            &DecodeSrgb8Scalar,
+            &DecodeUnorm16Scalar,
+            &DecodeSnorm16Scalar,
+            &DecodeFloat16Scalar,
+            &DecodeFloat32,
+            &DecodeUnorm1010102Scalar,
+            &DecodeFloat111110Scalar,
+            &DecodeFloat999E5,
+        },
+        {
+            &EncodeUnorm8Scalar,
+            &EncodeSnorm8Scalar,
+            &EncodeSrgb8Scalar,
+            &EncodeUnorm16Scalar,
+            &EncodeSnorm16Scalar,
+            &EncodeFloat16Scalar,
+            &EncodeFloat32,
+            &EncodeUnorm1010102Scalar,
+            &EncodeFloat111110Scalar,
+            &EncodeFloat999E5,
+        },
+    };
+
+#if PAL_HAS_CPUID
+    constexpr uint32 Unorm8      = static_cast<uint32>(BulkLayout::Unorm8);
+    constexpr uint32 Snorm8      = static_cast<uint32>(BulkLayout::Snorm8);
+    constexpr uint32 Unorm16     = static_cast<uint32>(BulkLayout::Unorm16);
+    constexpr uint32 Snorm16     = static_cast<uint32>(BulkLayout::Snorm16);
+    constexpr uint32 Float16     = static_cast<uint32>(BulkLayout::Float16);
+    constexpr uint32 Float111110 = static_cast<uint32>(BulkLayout::Float111110);
+
+    if (CpuSupportsFeature(CpuFeature::Avx2))
+    {
+        kernels.pfnDecode[Unorm8]      = &DecodeUnorm8Avx2;
+        kernels.pfnEncode[Unorm8]      = &EncodeUnorm8Avx2;
+        kernels.pfnDecode[Snorm8]      = &DecodeSnorm8Avx2;
+        kernels.pfnEncode[Snorm8]      = &EncodeSnorm8Avx2;
+        kernels.pfnDecode[Unorm16]     = &DecodeUnorm16Avx2;
+        kernels.pfnEncode[Unorm16]     = &EncodeUnorm16Avx2;
+        kernels.pfnDecode[Snorm16]     = &DecodeSnorm16Avx2;
+        kernels.pfnEncode[Snorm16]     = &EncodeSnorm16Avx2;
+        kernels.pfnDecode[Float111110] = &DecodeFloat111110Avx2;
+        kernels.pfnEncode[Float111110] = &EncodeFloat111110Avx2;
+    }
+    else if (CpuSupportsFeature(CpuFeature::Sse2))
+    {
+        kernels.pfnDecode[Unorm8]  = &DecodeUnorm8Sse2;
+        kernels.pfnEncode[Unorm8]  = &EncodeUnorm8Sse2;
+        kernels.pfnDecode[Snorm8]  = &DecodeSnorm8Sse2;
+        kernels.pfnEncode[Snorm8]  = &EncodeSnorm8Sse2;
+        kernels.pfnDecode[Unorm16] = &DecodeUnorm16Sse2;
+        kernels.pfnEncode[Unorm16] = &EncodeUnorm16Sse2;
+        kernels.pfnDecode[Snorm16] = &DecodeSnorm16Sse2;
+        kernels.pfnEncode[Snorm16] = &EncodeSnorm16Sse2;
+    }
+
+    if (CpuSupportsFeature(CpuFeature::F16c))
+    {
+        kernels.pfnDecode[Float16] = &DecodeFloat16F16c;
+        kernels.pfnEncode[Float16] = &EncodeFloat16F16c;
+    }
+#endif
+
+    return kernels;
+}
+
+// =====================================================================================================================
+static const BulkKernels& GetKernels()
+{
+    static const BulkKernels Kernels = SelectKernels();
+    return Kernels;
+}
+
+// =====================================================================================================================
+// Looks up the bulk layout of a format.  Returns false if the format isn't supported.
+static bool GetBulkLayout(
+    ChNumFormat format,
+    BulkLayout* pLayout)
+{
+    bool found = false;
+
+    for (uint32 i = 0; i < ArrayLen32(BulkFormatTable); i++)
+    {
+        if (BulkFormatTable[i].format == format)
+        {
+            *pLayout = BulkFormatTable[i].layout;
+            found    = true;
+            break;
+        }
+    }
+
+    return found;
+}
+
+// =====================================================================================================================
+static bool IsChannel(
+    ChannelSwizzle swizzle)
+{
+    return ((swizzle >= ChannelSwizzle::X) && (swizzle <= ChannelSwizzle::W));
+}
+
+// =====================================================================================================================
+bool SupportsBulkConversion(
+    SwizzledFormat format)
+{
+    BulkLayout layout    = BulkLayout::Count;
+    bool       supported = GetBulkLayout(format.format, &layout);
+
+    for (uint32 rgbaIdx = 0; rgbaIdx < 4; rgbaIdx++)
+    {
+        supported &= (format.swizzle.swizzle[rgbaIdx] < ChannelSwizzle::Count);
+    }
+
+    if (supported && (layout == BulkLayout::Srgb8))
+    {
+        // The kernels treat W as the alpha channel, but ConvertColor() treats the alpha component as alpha.
+        supported = ((format.swizzle.a == ChannelSwizzle::W) || (IsChannel(format.swizzle.a) == false)) &&
+                    (format.swizzle.r != ChannelSwizzle::W) &&
+                    (format.swizzle.g != ChannelSwizzle::W) &&
+                    (format.swizzle.b != ChannelSwizzle::W);
+    }
+    else if (supported && (layout == BulkLayout::Float999E5))
+    {
+        // ConvertColor() ignores the swizzle of shared exponent formats.
+        supported = (format.swizzle.r == ChannelSwizzle::X) &&
+                    (format.swizzle.g == ChannelSwizzle::Y) &&
+                    (format.swizzle.b == ChannelSwizzle::Z) &&
+                    (IsChannel(format.swizzle.a) == false);
+    }
+
+    return supported;
+}
+
+// =====================================================================================================================
+// Builds the mapping from source components to destination components.  Each destination component takes the source
+// component, zero or one that the last RGBA component which maps to it reads through the source swizzle.  Returns true
+// if the mapping is the identity.
+static bool BuildComponentRemap(
+    SwizzledFormat srcFormat,
+    SwizzledFormat dstFormat,
+    uint32*        pRemap)    // [out] Source component index for each destination component, RemapZero or RemapOne.
+{
+    constexpr uint32 RemapZero = 4;
+    constexpr uint32 RemapOne  = 5;
+
+    pRemap[0] = RemapZero;
+    pRemap[1] = RemapZero;
+    pRemap[2] = RemapZero;
+    pRemap[3] = RemapZero;
+
+    for (uint32 rgbaIdx = 0; rgbaIdx < 4; rgbaIdx++)
+    {
+        const ChannelSwizzle dstSwizzle = dstFormat.swizzle.swizzle[rgbaIdx];
+
+        if (IsChannel(dstSwizzle))
+        {
+            const ChannelSwizzle srcSwizzle = srcFormat.swizzle.swizzle[rgbaIdx];
+            const uint32         dstComp    = static_cast<uint32>(dstSwizzle) - static_cast<uint32>(ChannelSwizzle::X);
+
+            if (IsChannel(srcSwizzle))
+            {
+                pRemap[dstComp] = static_cast<uint32>(srcSwizzle) - static_cast<uint32>(ChannelSwizzle::X);
+            }
+            else
+            {
+                pRemap[dstComp] = (srcSwizzle == ChannelSwizzle::One) ? RemapOne : RemapZero;
+            }
+        }
+    }
+
+    return ((pRemap[0] == 0) && (pRemap[1] == 1) && (pRemap[2] == 2) && (pRemap[3] == 3));
+}
+
+// =====================================================================================================================
+Result ConvertPixels(
+    SwizzledFormat srcFormat,
+    const void*    pSrc,
+    SwizzledFormat dstFormat,
+    void*          pDst,
+    size_t         pixelCount)
+{
+    Result result = Result::Success;
+
+    BulkLayout srcLayout = BulkLayout::Count;
+    BulkLayout dstLayout = BulkLayout::Count;
+
+    if ((SupportsBulkConversion(srcFormat) == false) || (SupportsBulkConversion(dstFormat) == false))
+    {
+        result = Result::ErrorInvalidFormat;
+    }
+    else if ((srcFormat.format == dstFormat.format) && (srcFormat.swizzle.swizzleValue == dstFormat.swizzle.swizzleValue))
+    {
+        if (pSrc != pDst)
+        {
+            memcpy(pDst, pSrc, pixelCount * BytesPerPixel(srcFormat.format));
+        }
+    }
+    else if (GetBulkLayout(srcFormat.format, &srcLayout) && GetBulkLayout(dstFormat.format, &dstLayout))
+    {
+        const BulkKernels&    kernels   = GetKernels();
+        const PfnDecodePixels pfnDecode = kernels.pfnDecode[static_cast<uint32>(srcLayout)];
+        const PfnEncodePixels pfnEncode = kernels.pfnEncode[static_cast<uint32>(dstLayout)];
+        const uint32          srcBpp    = BytesPerPixel(srcFormat.format);
+        const uint32          dstBpp    = BytesPerPixel(dstFormat.format);
+
+        uint32     remap[4];
+        const bool identity = BuildComponentRemap(srcFormat, dstFormat, &remap[0]);
+
+        float comps[ChunkPixels * 4];
+        float remapped[ChunkPixels * 4];
+
+        // The remap indexes a pixel's four components followed by a constant zero and one.
+        float sources[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+
+        const uint8* pIn  = static_cast<const uint8*>(pSrc);
+        uint8*       pOut = static_cast<uint8*>(pDst);
+
+        for (size_t pixel = 0; pixel < pixelCount; pixel += ChunkPixels)
+        {
+            const uint32 count = static_cast<uint32>(Min<size_t>(ChunkPixels, pixelCount - pixel));
+
+            pfnDecode(pIn + (pixel * srcBpp), &comps[0], count);
+
+            const float* pComps = &comps[0];
+
+            if (identity == false)
+            {
+                for (uint32 i = 0; i < count; i++)
+                {
+                    memcpy(&sources[0], &comps[i * 4], sizeof(float) * 4);
+
+                    remapped[(i * 4) + 0] = sources[remap[0]];
+                    remapped[(i * 4) + 1] = sources[remap[1]];
+                    remapped[(i * 4) + 2] = sources[remap[2]];
+                    remapped[(i * 4) + 3] = sources[remap[3]];
+                }
+
+                pComps = &remapped[0];
+            }
+
+            pfnEncode(pComps, pOut + (pixel * dstBpp), count);
+        }
+    }
+
+    return result;
+}
+
+} // Formats
+} // Pal
@@ -340,6 +340,13 @@ GpuMemory::~GpuMemory()
     IGpuMemory*const pGpuMemory = this;
     m_pDevice->SubtractFromReferencedMemoryTotals(1, &pGpuMemory, true);
 
+    GpuMemoryRangeIndex*const pRangeIndex = m_pDevice->GetGpuMemoryRangeIndex();
+
+    if (pRangeIndex != nullptr)
+    {
+        pRangeIndex->Remove(this);
+    }
+
     m_pDevice->GetPlatform()->GetEventProvider()->LogDestroyGpuMemoryEvent(this);
 
     Developer::GpuMemoryData data = {};
@@ -626,6 +633,7 @@ Result GpuMemory::Init(
         if (IsErrorResult(result) == false)
         {
             DescribeGpuMemory(Developer::GpuMemoryAllocationMethod::Opened);
+            AddToRangeIndex();
         }
     }
     else
@@ -771,6 +779,7 @@ Result GpuMemory::Init(
         if (IsErrorResult(result) == false)
         {
             DescribeGpuMemory(Developer::GpuMemoryAllocationMethod::Normal);
+            AddToRangeIndex();
         }
     }
 
@@ -862,6 +871,7 @@ Result GpuMemory::Init(
     if (IsErrorResult(result) == false)
     {
         DescribeGpuMemory(Developer::GpuMemoryAllocationMethod::Svm);
+        AddToRangeIndex();
     }
 
     return result;
@@ -913,6 +923,7 @@ Result GpuMemory::Init(
     if (IsErrorResult(result) == false)
     {
         DescribeGpuMemory(Developer::GpuMemoryAllocationMethod::Pinned);
+        AddToRangeIndex();
     }
 
     return result;
@@ -983,6 +994,7 @@ Result GpuMemory::Init(
     if (IsErrorResult(result) == false)
     {
         DescribeGpuMemory(Developer::GpuMemoryAllocationMethod::Opened);
+        AddToRangeIndex();
     }
 
     // Verify that if opening the peer memory connection succeeded, we got a GPU virtual address back as expected.
@@ -1052,6 +1064,7 @@ Result GpuMemory::Init(
     if (IsErrorResult(result) == false)
     {
         DescribeGpuMemory(Developer::GpuMemoryAllocationMethod::Peer);
+        AddToRangeIndex();
     }
 
     // Verify that if opening the peer memory connection succeeded, we got a GPU virtual address back as expected.
@@ -1205,6 +1218,20 @@ void GpuMemory::DescribeGpuMemory(
     m_pDevice->DeveloperCb(Developer::CallbackType::AllocGpuMemory, &data);
 }
 
+// =====================================================================================================================
+// Adds this object's GPU VA range to the device's range index, if the device keeps one.  The index is only used for
+// validation, so failing to add the range doesn't fail the allocation.
+void GpuMemory::AddToRangeIndex()
+{
+    GpuMemoryRangeIndex*const pRangeIndex = m_pDevice->GetGpuMemoryRangeIndex();
+
+    if (pRangeIndex != nullptr)
+    {
+        const Result result = pRangeIndex->Insert(this);
+        PAL_ALERT_MSG(result != Result::Success, "Failed to add a GPU memory object to the range index.");
+    }
+}
+
 // =====================================================================================================================
 bool GpuMemory::IsCpuVisible() const
 {
@@ -333,6 +333,7 @@ protected:
     virtual Result OsUnmap() = 0;
 
     virtual void DescribeGpuMemory(Developer::GpuMemoryAllocationMethod allocMethod) const;
+    void AddToRangeIndex();
 
     Device*const   m_pDevice;
     VaPartition    m_vaPartition;
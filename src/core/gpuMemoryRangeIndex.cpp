@@ -0,0 +1,323 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "core/gpuMemory.h"
+#include "core/gpuMemoryRangeIndex.h"
+#include "core/platform.h"
+#include "palHashMapImpl.h"
+#include "palIntervalTreeImpl.h"
+
+using namespace Util;
+
+namespace Pal
+{
+
+// Initial number of buckets in the map from GPU memory objects to their ranges.
+constexpr uint32 RangeMapBuckets = 1024;
+
+// Output state for CollectOverlapping.
+struct OverlapQuery
+{
+    uint32      maxObjects;
+    uint32      numObjects;
+    GpuMemory** ppGpuMemory;
+};
+
+// Output state for FindNode.
+struct NodeQuery
+{
+    const GpuMemory*                       pGpuMemory;
+    gpusize                                high;
+    IntervalTreeNode<gpusize, GpuMemory*>* pNode;
+};
+
+// =====================================================================================================================
+GpuMemoryRangeIndex::NodeArena::~NodeArena()
+{
+    while (m_pChunks != nullptr)
+    {
+        Link*const pNext = m_pChunks->pNext;
+        PAL_FREE(m_pChunks, m_pPlatform);
+        m_pChunks = pNext;
+    }
+}
+
+// =====================================================================================================================
+// Allocates one tree node, carving a new chunk of nodes out of platform memory if the free list is empty.
+void* GpuMemoryRangeIndex::NodeArena::Alloc(
+    const AllocInfo& allocInfo)
+{
+    PAL_ASSERT((allocInfo.bytes <= sizeof(RangeNode)) && (allocInfo.alignment <= alignof(RangeNode)));
+
+    if (m_pFreeNodes == nullptr)
+    {
+        // The first node-sized slot of each chunk holds the chunk list link.
+        void*const pChunk = PAL_MALLOC((NodesPerChunk + 1) * sizeof(RangeNode), m_pPlatform, AllocInternal);
+
+        if (pChunk != nullptr)
+        {
+            Link*const pChunkLink = static_cast<Link*>(pChunk);
+            pChunkLink->pNext     = m_pChunks;
+            m_pChunks             = pChunkLink;
+
+            RangeNode*const pNodes = static_cast<RangeNode*>(pChunk) + 1;
+            for (uint32 i = NodesPerChunk; i > 0; --i)
+            {
+                Link*const pLink = reinterpret_cast<Link*>(&pNodes[i - 1]);
+                pLink->pNext     = m_pFreeNodes;
+                m_pFreeNodes     = pLink;
+            }
+        }
+    }
+
+    void* pNode = nullptr;
+
+    if (m_pFreeNodes != nullptr)
+    {
+        pNode        = m_pFreeNodes;
+        m_pFreeNodes = m_pFreeNodes->pNext;
+    }
+
+    return pNode;
+}
+
+// =====================================================================================================================
+// Returns a tree node to the free list.
+void GpuMemoryRangeIndex::NodeArena::Free(
+    const FreeInfo& freeInfo)
+{
+    if (freeInfo.pClientMem != nullptr)
+    {
+        Link*const pLink = static_cast<Link*>(freeInfo.pClientMem);
+        pLink->pNext     = m_pFreeNodes;
+        m_pFreeNodes     = pLink;
+    }
+}
+
+// =====================================================================================================================
+GpuMemoryRangeIndex::GpuMemoryRangeIndex(
+    Platform* pPlatform)
+    :
+    m_nodeArena(pPlatform),
+    m_tree(&m_nodeArena),
+    m_ranges(RangeMapBuckets, pPlatform),
+    m_insertFailed(false),
+    m_lock()
+{
+}
+
+// =====================================================================================================================
+Result GpuMemoryRangeIndex::Init()
+{
+    return m_ranges.Init();
+}
+
+// =====================================================================================================================
+// Computes the inclusive VA range covered by a GPU memory object.  Returns false if the object covers no VA.
+bool GpuMemoryRangeIndex::GetRange(
+    const GpuMemory* pGpuMemory,
+    RangeInterval*   pInterval)
+{
+    const GpuMemoryDesc& desc = pGpuMemory->Desc();
+
+    pInterval->low   = desc.gpuVirtAddr;
+    pInterval->high  = desc.gpuVirtAddr + desc.size - 1;
+    pInterval->value = const_cast<GpuMemory*>(pGpuMemory);
+
+    return ((desc.gpuVirtAddr != 0) && (desc.size != 0));
+}
+
+// =====================================================================================================================
+// Adds a GPU memory object to the index.  Objects without a GPU VA are ignored.
+Result GpuMemoryRangeIndex::Insert(
+    GpuMemory* pGpuMemory)
+{
+    Result        result = Result::Success;
+    RangeInterval interval;
+
+    if (GetRange(pGpuMemory, &interval))
+    {
+        MutexAuto lock(&m_lock);
+
+        result = m_ranges.Insert(pGpuMemory, interval);
+
+        if ((result == Result::Success) && (m_tree.Insert(&interval) == nullptr))
+        {
+            m_ranges.Erase(pGpuMemory);
+            result = Result::ErrorOutOfMemory;
+        }
+
+        if (result != Result::Success)
+        {
+            m_insertFailed = true;
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Removes a GPU memory object from the index, if it is in it.  Other objects with the same VA range are left untouched.
+void GpuMemoryRangeIndex::Remove(
+    const GpuMemory* pGpuMemory)
+{
+    MutexAuto lock(&m_lock);
+
+    const RangeInterval*const pInterval = m_ranges.FindKey(pGpuMemory);
+
+    if (pInterval != nullptr)
+    {
+        RangeNode*const pMatch = FindNodeLocked(*pInterval);
+
+        if (pMatch != nullptr)
+        {
+            m_tree.Delete(pMatch);
+        }
+        else
+        {
+            PAL_ALERT_ALWAYS_MSG("GPU memory object is missing from the range index.");
+        }
+
+        m_ranges.Erase(pGpuMemory);
+    }
+}
+
+// =====================================================================================================================
+// Looks up a GPU memory object by its address and returns the VA range it had when it was added.  The object itself is
+// never dereferenced, so this may be called with a pointer to an object which has already been destroyed; it then
+// returns false.
+bool GpuMemoryRangeIndex::FindRange(
+    const GpuMemory* pGpuMemory,
+    gpusize*         pGpuVirtAddr,
+    gpusize*         pSize
+    ) const
+{
+    MutexAuto lock(&m_lock);
+
+    const RangeInterval*const pInterval = m_ranges.FindKey(pGpuMemory);
+
+    if (pInterval != nullptr)
+    {
+        *pGpuVirtAddr = pInterval->low;
+        *pSize        = pInterval->high - pInterval->low + 1;
+    }
+
+    return (pInterval != nullptr);
+}
+
+// =====================================================================================================================
+// Returns the node which holds the object and range described by the interval, or null if there is none.  Several
+// objects may share a range, so this looks for the object among everything which overlaps its base address.  The
+// caller must hold the index lock.
+GpuMemoryRangeIndex::RangeNode* GpuMemoryRangeIndex::FindNodeLocked(
+    const RangeInterval& interval
+    ) const
+{
+    const RangeInterval baseAddress = { interval.low, interval.low, nullptr };
+
+    NodeQuery query = { interval.value, interval.high, nullptr };
+    m_tree.OverlappingTraverse(&baseAddress, &FindNode, &query);
+
+    return query.pNode;
+}
+
+// =====================================================================================================================
+// Tree traversal callback which looks for the node which holds a specific object.
+void GpuMemoryRangeIndex::FindNode(
+    RangeNode* pNode,
+    void*      pData)
+{
+    NodeQuery*const pQuery = static_cast<NodeQuery*>(pData);
+
+    if ((pNode->interval.value == pQuery->pGpuMemory) && (pNode->interval.high == pQuery->high))
+    {
+        pQuery->pNode = pNode;
+    }
+}
+
+// =====================================================================================================================
+// Tree traversal callback which records each overlapping object.
+void GpuMemoryRangeIndex::CollectOverlapping(
+    RangeNode* pNode,
+    void*      pData)
+{
+    OverlapQuery*const pQuery = static_cast<OverlapQuery*>(pData);
+
+    if (pQuery->numObjects < pQuery->maxObjects)
+    {
+        pQuery->ppGpuMemory[pQuery->numObjects] = pNode->interval.value;
+    }
+
+    pQuery->numObjects++;
+}
+
+// =====================================================================================================================
+// Returns the total number of objects which overlap the range [gpuVirtAddr, gpuVirtAddr + size), and writes up to
+// maxObjects of them to ppGpuMemory in order of increasing base address.
+uint32 GpuMemoryRangeIndex::FindOverlapping(
+    gpusize     gpuVirtAddr,
+    gpusize     size,
+    uint32      maxObjects,
+    GpuMemory** ppGpuMemory
+    ) const
+{
+    PAL_ASSERT((maxObjects == 0) || (ppGpuMemory != nullptr));
+
+    OverlapQuery query = { maxObjects, 0, ppGpuMemory };
+
+    if (size > 0)
+    {
+        const RangeInterval interval = { gpuVirtAddr, (gpuVirtAddr + size - 1), nullptr };
+
+        MutexAuto lock(&m_lock);
+        m_tree.OverlappingTraverse(&interval, &CollectOverlapping, &query);
+    }
+
+    return query.numObjects;
+}
+
+// =====================================================================================================================
+// Returns the lowest-addressed object which contains the given GPU VA, or null if there is none; e.g., to identify the
+// allocation behind a faulting address.
+GpuMemory* GpuMemoryRangeIndex::FindContaining(
+    gpusize gpuVirtAddr
+    ) const
+{
+    GpuMemory* pGpuMemory = nullptr;
+
+    FindOverlapping(gpuVirtAddr, 1, 1, &pGpuMemory);
+
+    return pGpuMemory;
+}
+
+// =====================================================================================================================
+size_t GpuMemoryRangeIndex::NumObjects() const
+{
+    MutexAuto lock(&m_lock);
+
+    return m_tree.GetCount();
+}
+
+} // Pal
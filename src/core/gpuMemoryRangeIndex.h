@@ -0,0 +1,126 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#pragma once
+
+#include "pal.h"
+#include "palHashMap.h"
+#include "palIntervalTree.h"
+#include "palMutex.h"
+
+namespace Pal
+{
+
+class GpuMemory;
+class Platform;
+
+// =====================================================================================================================
+// An address-range index of the live GPU memory objects on a device.  It answers "which allocations overlap this GPU VA
+// range" in O(log n + k) time, which page-fault analysis, validation of virtual memory remapping and memory snapshots
+// can use instead of walking every allocation.  Keeping the index up to date costs a lock and a tree update on every GPU
+// memory create and destroy, so the device only keeps one if the GpuMemoryRangeIndexEnable setting is set.
+//
+// The index is an IntervalTree keyed on each object's inclusive VA range.  Ranges may overlap (e.g., opened and
+// reserved-VA allocations), so each object's range is also kept in a map keyed on the object's address.  Lookups which
+// start from a GPU memory pointer (e.g., removing an object or checking that a client's object is still alive) only use
+// the pointer's value, so they never touch a destroyed object.  Tree nodes come from an arena which hands out fixed-size
+// nodes from large chunks and recycles freed nodes, so the tree doesn't add a system memory allocation per object.
+class GpuMemoryRangeIndex
+{
+public:
+    explicit GpuMemoryRangeIndex(Platform* pPlatform);
+    ~GpuMemoryRangeIndex() { }
+
+    Result Init();
+
+    Result Insert(GpuMemory* pGpuMemory);
+    void   Remove(const GpuMemory* pGpuMemory);
+
+    bool FindRange(const GpuMemory* pGpuMemory, gpusize* pGpuVirtAddr, gpusize* pSize) const;
+
+    GpuMemory* FindContaining(gpusize gpuVirtAddr) const;
+
+    uint32 FindOverlapping(
+        gpusize     gpuVirtAddr,
+        gpusize     size,
+        uint32      maxObjects,
+        GpuMemory** ppGpuMemory) const;
+
+    size_t NumObjects() const;
+
+    // Returns false if any object with a VA range failed to be added, in which case FindRange may miss live objects.
+    bool IsComplete() const { return (m_insertFailed == false); }
+
+private:
+    typedef Util::Interval<gpusize, GpuMemory*>                       RangeInterval;
+    typedef Util::IntervalTreeNode<gpusize, GpuMemory*>               RangeNode;
+    typedef Util::HashMap<const GpuMemory*, RangeInterval, Platform> RangeMap;
+
+    // Allocator for the tree's nodes.  Nodes are carved out of chunks obtained from the platform and are returned to a
+    // free list when they are deleted; chunks are only released when the index is destroyed.
+    class NodeArena
+    {
+    public:
+        explicit NodeArena(Platform* pPlatform) : m_pPlatform(pPlatform), m_pChunks(nullptr), m_pFreeNodes(nullptr) { }
+        ~NodeArena();
+
+        void* Alloc(const Util::AllocInfo& allocInfo);
+        void  Free(const Util::FreeInfo& freeInfo);
+
+    private:
+        // Number of nodes in each chunk requested from the platform.
+        static constexpr uint32 NodesPerChunk = 1024;
+
+        // Free nodes and chunks are kept in singly-linked lists threaded through the memory itself.
+        struct Link
+        {
+            Link* pNext;
+        };
+
+        Platform*const m_pPlatform;
+        Link*          m_pChunks;
+        Link*          m_pFreeNodes;
+
+        PAL_DISALLOW_COPY_AND_ASSIGN(NodeArena);
+        PAL_DISALLOW_DEFAULT_CTOR(NodeArena);
+    };
+
+    static bool GetRange(const GpuMemory* pGpuMemory, RangeInterval* pInterval);
+    RangeNode*  FindNodeLocked(const RangeInterval& interval) const;
+    static void FindNode(RangeNode* pNode, void* pData);
+    static void CollectOverlapping(RangeNode* pNode, void* pData);
+
+    // The arena must outlive the tree since the tree frees its nodes on destruction.
+    NodeArena                                          m_nodeArena;
+    Util::IntervalTree<gpusize, GpuMemory*, NodeArena> m_tree;
+    RangeMap                                           m_ranges;
+    bool                                               m_insertFailed;
+    mutable Util::Mutex                                m_lock;
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(GpuMemoryRangeIndex);
+    PAL_DISALLOW_DEFAULT_CTOR(GpuMemoryRangeIndex);
+};
+
+} // Pal
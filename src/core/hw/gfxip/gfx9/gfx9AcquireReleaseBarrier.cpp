@@ -992,6 +992,8 @@ LayoutTransitionInfo Device::PrepareColorBlt(
         // really trigger an FCE operation.
         if (fastClearEliminateSupported && TestAnyFlagSet(newLayout.usages, TcCompatReadFlags))
         {
+            transitionInfo.flags.dependsOnClears = 1;
+
             if (gfx9ImageConst.IsFceOptimizationEnabled() &&
                 (gfx9ImageConst.HasSeenNonTcCompatibleClearColor() == false))
             {
@@ -1112,7 +1114,15 @@ LayoutTransitionInfo Device::PrepareBltInfo(
 
     LayoutTransitionInfo layoutTransInfo = {};
 
-    if (TestAnyFlagSet(oldLayout.usages, LayoutUninitializedTarget))
+    // Applications tend to issue the same transitions on the same images over and over again, so the command buffer may
+    // remember which BLTs a given transition needed last time.
+    BarrierCoalescer*const pCoalescer = GetBarrierCoalescer(pCmdBuf, nullptr);
+
+    if ((pCoalescer != nullptr) && pCoalescer->FindTransition(imgBarrier, &layoutTransInfo))
+    {
+        // Nothing else to do, this transition was already prepared earlier in this command buffer.
+    }
+    else if (TestAnyFlagSet(oldLayout.usages, LayoutUninitializedTarget))
     {
         // If the LayoutUninitializedTarget usage is set, no other usages should be set.
         PAL_ASSERT(TestAnyFlagSet(oldLayout.usages, ~LayoutUninitializedTarget) == false);
@@ -1157,6 +1167,11 @@ LayoutTransitionInfo Device::PrepareBltInfo(
         {
             layoutTransInfo = PrepareColorBlt(pCmdBuf, image, subresRange, oldLayout, newLayout);
         }
+
+        if ((pCoalescer != nullptr) && (layoutTransInfo.flags.dependsOnClears == 0))
+        {
+            pCoalescer->AddTransition(imgBarrier, layoutTransInfo);
+        }
     }
 
     return layoutTransInfo;
@@ -715,6 +715,18 @@ void Device::FillCacheOperations(
     }
 }
 
+// =====================================================================================================================
+// Returns the barrier coalescer of the given command buffer, or null if it doesn't coalesce barriers. See
+// UniversalCmdBuffer::GetBarrierCoalescer for the meaning of pSyncStream.
+BarrierCoalescer* Device::GetBarrierCoalescer(
+    GfxCmdBuffer*    pCmdBuf,
+    const CmdStream* pSyncStream)
+{
+    return (pCmdBuf->GetEngineType() == EngineTypeUniversal)
+           ? static_cast<UniversalCmdBuffer*>(pCmdBuf)->GetBarrierCoalescer(pSyncStream)
+           : nullptr;
+}
+
 // =====================================================================================================================
 // Examines the specified sync reqs, and the corresponding hardware commands to satisfy the requirements.
 void Device::IssueSyncs(
@@ -729,6 +741,14 @@ void Device::IssueSyncs(
 {
     const EngineType engineType     = pCmdBuf->GetEngineType();
     const bool       isGfxSupported = pCmdBuf->IsGraphicsSupported();
+
+    // Only full-range syncs can make the whole GPU idle, so those are the only ones we coalesce.
+    BarrierCoalescer*const pCoalescer =
+        ((rangeStartAddr == FullSyncBaseAddr) && (rangeSize == FullSyncSize)) ? GetBarrierCoalescer(pCmdBuf, pCmdStream)
+                                                                              : nullptr;
+    const bool wasIdle = (pCoalescer != nullptr) && pCoalescer->ElideRedundantSyncs(pCmdStream, &syncReqs);
+    bool       cbMdFlushPending = false;
+
     const uint32     origCacheFlags = syncReqs.cacheFlags;
     uint32*          pCmdSpace      = pCmdStream->ReserveCommands();
 
@@ -887,6 +907,9 @@ void Device::IssueSyncs(
 
             releaseInfo.tcCacheOp = SelectTcCacheOp(&syncReqs.cacheFlags);
         }
+
+        // Nothing waits for these pipelined flushes so they can't be assumed complete after this sync.
+        cbMdFlushPending = true;
     }
 
     // Issue accumulated ACQUIRE_MEM commands on the specified memory range. Note that we must issue one ACQUIRE_MEM
@@ -938,6 +961,19 @@ void Device::IssueSyncs(
 
     pCmdStream->CommitCommands(pCmdSpace);
 
+    if (pCoalescer != nullptr)
+    {
+        // The GPU is idle after this sync if we waited on an EOP timestamp or if it was idle already. In both cases all
+        // of the cache operations are complete unless some were left in flight by the pipelined CB flush above.
+        SyncReqs completedReqs   = syncReqs;
+        completedReqs.cacheFlags = origCacheFlags;
+
+        pCoalescer->RecordSync(pCmdStream,
+                               completedReqs,
+                               ((syncReqs.waitOnEopTs != 0) || wasIdle) && (cbMdFlushPending == false),
+                               wasIdle);
+    }
+
     // Clear up xxxBltActive flags
     if (syncReqs.waitOnEopTs || TestAnyFlagSet(syncReqs.cpMeCoherCntl.u32All, CpMeCoherCntlStallMask))
     {
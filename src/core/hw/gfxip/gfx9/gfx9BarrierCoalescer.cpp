@@ -0,0 +1,252 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "core/cmdStream.h"
+#include "core/hw/gfxip/gfx9/gfx9BarrierCoalescer.h"
+#include "palInlineFuncs.h"
+
+using namespace Util;
+
+namespace Pal
+{
+namespace Gfx9
+{
+
+// =====================================================================================================================
+BarrierCoalescer::BarrierCoalescer()
+{
+    Reset();
+}
+
+// =====================================================================================================================
+// Forgets everything about previously recorded barriers. Must be called whenever the command buffer is reset or begun
+// because the command stream positions are no longer meaningful.
+void BarrierCoalescer::Reset()
+{
+    m_pSyncStream    = nullptr;
+    m_syncStreamPos  = 0;
+    m_syncCacheFlags = 0;
+    m_syncPfpSyncMe  = false;
+    m_syncCpDma      = false;
+
+    m_eliminatedSyncs   = 0;
+    m_eliminatedFlushes = 0;
+
+    memset(&m_transitions[0], 0, sizeof(m_transitions));
+}
+
+// =====================================================================================================================
+gpusize BarrierCoalescer::StreamPosition(
+    Pal::CmdStream* pCmdStream)
+{
+    return pCmdStream->IsEmpty() ? 0 : pCmdStream->GetCurrentGpuVa();
+}
+
+// =====================================================================================================================
+// Removes every operation from pSyncReqs which is redundant because the GPU was idled by an earlier full-range sync and
+// nothing has been written to pCmdStream since. Returns true if the GPU is known to be idle at this point.
+bool BarrierCoalescer::ElideRedundantSyncs(
+    Pal::CmdStream* pCmdStream,
+    SyncReqs*       pSyncReqs)
+{
+    const bool isIdle = (m_pSyncStream == pCmdStream) && (m_syncStreamPos == StreamPosition(pCmdStream));
+
+    if (isIdle)
+    {
+        const SyncReqs origReqs = *pSyncReqs;
+
+        // An EOP timestamp wait covers every pipeline stall we know how to request.
+        pSyncReqs->waitOnEopTs           = 0;
+        pSyncReqs->vsPartialFlush        = 0;
+        pSyncReqs->psPartialFlush        = 0;
+        pSyncReqs->csPartialFlush        = 0;
+        pSyncReqs->cpMeCoherCntl.u32All &= ~CpMeCoherCntlStallMask;
+
+        // No work has touched the caches since they were last flushed or invalidated.
+        pSyncReqs->cacheFlags &= ~m_syncCacheFlags;
+
+        // The EOP wait doesn't wait for CP DMA so that can only be skipped if it was done.
+        if (m_syncCpDma)
+        {
+            pSyncReqs->syncCpDma = 0;
+        }
+
+        // The PFP/ME sync must still follow any ACQUIRE_MEM this sync will issue, otherwise the PFP could run ahead of
+        // the remaining cache operations. It can only be skipped if it was done and no cache operations are left.
+        if (m_syncPfpSyncMe && (pSyncReqs->cacheFlags == 0) && (pSyncReqs->cpMeCoherCntl.u32All == 0))
+        {
+            pSyncReqs->pfpSyncMe = 0;
+        }
+
+        m_eliminatedSyncs += (origReqs.waitOnEopTs    - pSyncReqs->waitOnEopTs)    +
+                             (origReqs.vsPartialFlush - pSyncReqs->vsPartialFlush) +
+                             (origReqs.psPartialFlush - pSyncReqs->psPartialFlush) +
+                             (origReqs.csPartialFlush - pSyncReqs->csPartialFlush) +
+                             (origReqs.syncCpDma      - pSyncReqs->syncCpDma)      +
+                             (origReqs.pfpSyncMe      - pSyncReqs->pfpSyncMe);
+
+        m_eliminatedFlushes += CountSetBits(origReqs.cacheFlags & ~pSyncReqs->cacheFlags);
+    }
+
+    return isIdle;
+}
+
+// =====================================================================================================================
+// Records a full-range sync which was just written to pCmdStream. The completedReqs must only contain operations which
+// are known to be complete once the command processor moves past the sync. If the GPU isn't idle afterwards there is
+// nothing the next sync could coalesce with.
+void BarrierCoalescer::RecordSync(
+    Pal::CmdStream* pCmdStream,
+    const SyncReqs& completedReqs,
+    bool            idle,
+    bool            wasIdle)
+{
+    if (idle)
+    {
+        if (wasIdle == false)
+        {
+            m_syncCacheFlags = 0;
+            m_syncPfpSyncMe  = false;
+            m_syncCpDma      = false;
+        }
+
+        m_pSyncStream     = pCmdStream;
+        m_syncStreamPos   = StreamPosition(pCmdStream);
+        m_syncCacheFlags |= completedReqs.cacheFlags;
+        m_syncPfpSyncMe   = m_syncPfpSyncMe || (completedReqs.pfpSyncMe != 0);
+        m_syncCpDma       = m_syncCpDma     || (completedReqs.syncCpDma != 0);
+    }
+    else
+    {
+        m_pSyncStream = nullptr;
+    }
+}
+
+// =====================================================================================================================
+void BarrierCoalescer::BuildTransitionKey(
+    const ImgBarrier& imgBarrier,
+    TransitionKey*    pKey)
+{
+    pKey->pImage      = imgBarrier.pImage;
+    pKey->subresRange = imgBarrier.subresRange;
+    pKey->oldLayout   = imgBarrier.oldLayout;
+    pKey->newLayout   = imgBarrier.newLayout;
+}
+
+// =====================================================================================================================
+uint32 BarrierCoalescer::HashTransitionKey(
+    const TransitionKey& key)
+{
+    const uint64 imageAddr = reinterpret_cast<uintptr_t>(key.pImage);
+    const uint32 words[]   =
+    {
+        LowPart(imageAddr),
+        HighPart(imageAddr),
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION < 642
+        static_cast<uint32>(key.subresRange.startSubres.aspect),
+#else
+        key.subresRange.startSubres.plane,
+        key.subresRange.numPlanes,
+#endif
+        key.subresRange.startSubres.mipLevel,
+        key.subresRange.startSubres.arraySlice,
+        key.subresRange.numMips,
+        key.subresRange.numSlices,
+        key.oldLayout.usages,
+        key.oldLayout.engines,
+        key.newLayout.usages,
+        key.newLayout.engines,
+    };
+
+    uint32 hash = 2166136261u;
+
+    for (uint32 i = 0; i < ArrayLen32(words); i++)
+    {
+        hash = (hash ^ words[i]) * 16777619u;
+    }
+
+    return (hash ^ (hash >> 16)) & (TransitionMemoSize - 1);
+}
+
+// =====================================================================================================================
+bool BarrierCoalescer::TransitionKeysEqual(
+    const TransitionKey& lhs,
+    const TransitionKey& rhs)
+{
+    return (lhs.pImage                             == rhs.pImage)                             &&
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION < 642
+           (lhs.subresRange.startSubres.aspect     == rhs.subresRange.startSubres.aspect)     &&
+#else
+           (lhs.subresRange.startSubres.plane      == rhs.subresRange.startSubres.plane)      &&
+           (lhs.subresRange.numPlanes              == rhs.subresRange.numPlanes)              &&
+#endif
+           (lhs.subresRange.startSubres.mipLevel   == rhs.subresRange.startSubres.mipLevel)   &&
+           (lhs.subresRange.startSubres.arraySlice == rhs.subresRange.startSubres.arraySlice) &&
+           (lhs.subresRange.numMips                == rhs.subresRange.numMips)                &&
+           (lhs.subresRange.numSlices              == rhs.subresRange.numSlices)              &&
+           (lhs.oldLayout.usages                   == rhs.oldLayout.usages)                   &&
+           (lhs.oldLayout.engines                  == rhs.oldLayout.engines)                  &&
+           (lhs.newLayout.usages                   == rhs.newLayout.usages)                   &&
+           (lhs.newLayout.engines                  == rhs.newLayout.engines);
+}
+
+// =====================================================================================================================
+// Looks up a previously memoized layout transition decision. Returns true and fills out pInfo on a hit.
+bool BarrierCoalescer::FindTransition(
+    const ImgBarrier&     imgBarrier,
+    LayoutTransitionInfo* pInfo)
+{
+    TransitionKey key;
+    BuildTransitionKey(imgBarrier, &key);
+
+    const TransitionEntry& entry = m_transitions[HashTransitionKey(key)];
+    const bool             found = entry.valid && TransitionKeysEqual(entry.key, key);
+
+    if (found)
+    {
+        (*pInfo) = entry.info;
+    }
+
+    return found;
+}
+
+// =====================================================================================================================
+// Memoizes a layout transition decision, replacing whatever decision previously occupied its memo slot.
+void BarrierCoalescer::AddTransition(
+    const ImgBarrier&           imgBarrier,
+    const LayoutTransitionInfo& info)
+{
+    TransitionKey key;
+    BuildTransitionKey(imgBarrier, &key);
+
+    TransitionEntry* pEntry = &m_transitions[HashTransitionKey(key)];
+
+    pEntry->key   = key;
+    pEntry->info  = info;
+    pEntry->valid = true;
+}
+
+} // Gfx9
+} // Pal
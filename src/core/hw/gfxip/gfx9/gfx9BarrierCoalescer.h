@@ -0,0 +1,111 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#pragma once
+
+#include "core/hw/gfxip/gfx9/gfx9Device.h"
+
+namespace Pal
+{
+
+class CmdStream;
+
+namespace Gfx9
+{
+
+// =====================================================================================================================
+// Coalesces back-to-back barriers recorded into a universal command buffer.
+//
+// Every full-range barrier sync which leaves the GPU idle is remembered along with the command stream position right
+// after it. If the next barrier sync starts at that same position then no work was recorded in between, so any wait
+// or cache operation which the previous sync already performed is redundant and is removed before the packets are
+// built. This merges adjacent barriers in place without deferring them, so it doesn't matter which command follows.
+//
+// It also memoizes the layout transition decisions made by the acquire/release barrier path, keyed by image,
+// subresource range and old/new layout, so that images which bounce between the same layouts don't pay for the
+// decision each time.
+//
+// The number of eliminated syncs and cache operations is counted so that the owning command buffer can report them to
+// the device.
+class BarrierCoalescer
+{
+public:
+    BarrierCoalescer();
+    ~BarrierCoalescer() { }
+
+    void Reset();
+
+    bool ElideRedundantSyncs(Pal::CmdStream* pCmdStream, SyncReqs* pSyncReqs);
+    void RecordSync(Pal::CmdStream* pCmdStream, const SyncReqs& completedReqs, bool idle, bool wasIdle);
+
+    bool FindTransition(const ImgBarrier& imgBarrier, LayoutTransitionInfo* pInfo);
+    void AddTransition(const ImgBarrier& imgBarrier, const LayoutTransitionInfo& info);
+
+    uint32 EliminatedSyncs()   const { return m_eliminatedSyncs; }
+    uint32 EliminatedFlushes() const { return m_eliminatedFlushes; }
+
+private:
+    static gpusize StreamPosition(Pal::CmdStream* pCmdStream);
+
+    // Identifies one layout transition decision.
+    struct TransitionKey
+    {
+        const IImage* pImage;
+        SubresRange   subresRange;
+        ImageLayout   oldLayout;
+        ImageLayout   newLayout;
+    };
+
+    struct TransitionEntry
+    {
+        TransitionKey        key;
+        LayoutTransitionInfo info;
+        bool                 valid;
+    };
+
+    // Size of the direct-mapped transition memo. Must be a power of two.
+    static constexpr uint32 TransitionMemoSize = 64;
+
+    static void   BuildTransitionKey(const ImgBarrier& imgBarrier, TransitionKey* pKey);
+    static uint32 HashTransitionKey(const TransitionKey& key);
+    static bool   TransitionKeysEqual(const TransitionKey& lhs, const TransitionKey& rhs);
+
+    // The last full-range sync which left the GPU idle, or a null stream if there isn't one to coalesce with.
+    const Pal::CmdStream* m_pSyncStream;
+    gpusize          m_syncStreamPos;   // Command stream position right after the last sync.
+    uint32           m_syncCacheFlags;  // CacheSyncFlags which have been completed since the GPU went idle.
+    bool             m_syncPfpSyncMe;   // If the PFP has been synchronized to the ME since the GPU went idle.
+    bool             m_syncCpDma;       // If CP DMA has been waited on since the GPU went idle.
+
+    uint32           m_eliminatedSyncs;   // Number of stalls and CP syncs removed since the last Reset().
+    uint32           m_eliminatedFlushes; // Number of cache flush or invalidate operations removed since the last Reset().
+
+    TransitionEntry  m_transitions[TransitionMemoSize];
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(BarrierCoalescer);
+};
+
+} // Gfx9
+} // Pal
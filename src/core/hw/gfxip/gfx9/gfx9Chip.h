@@ -29,7 +29,7 @@
 #include "palAssert.h"
 #include "palInlineFuncs.h"
 #include "palCmdBuffer.h"
-#include "palSparseVector.h"
+#include "palKeyRangeArray.h"
 
 #include "core/hw/gfxip/gfx9/chip/gfx9_plus_merged_offset.h"
 #include "core/hw/gfxip/gfxCmdBuffer.h"
@@ -127,12 +127,10 @@ struct RegisterRange
     uint32 regCount;    // Number of registers to load.
 };
 
-// Container used for storing registers during pipeline load.
-using RegisterVector = Util::SparseVector<
+// Container used for storing registers during pipeline load.  This is a flat image with a fixed slot for each register
+// in these ranges, so the metadata's registers map is decoded in one pass and each lookup reads a constant offset.
+using RegisterVector = Util::KeyRangeArray<
     uint32,
-    uint8,
-    50,
-    Platform,
     CONTEXT_SPACE_START,           CntxRegUsedRangeEnd,
     PERSISTENT_SPACE_START,        ShRegUsedRangeEnd,
     Gfx09::mmIA_MULTI_VGT_PARAM,   Gfx09::mmIA_MULTI_VGT_PARAM,
@@ -88,7 +88,7 @@ Result ComputePipeline::HwlInit(
     m_disablePartialPreempt = createInfo.disablePartialDispatchPreemption;
 #endif
 
-    RegisterVector registers(m_pDevice->GetPlatform());
+    RegisterVector registers;
     Result result = pMetadataReader->Seek(metadata.pipeline.registers);
 
     if (result == Result::Success)
@@ -277,6 +277,11 @@ Result ComputePipeline::LinkWithLibraries(
     // Update m_chunCs with updated register values
     m_chunkCs.UpdateComputePgmRsrsAfterLibraryLink(computePgmRsrc1, computePgmRsrc2, computePgmRsrc3);
 
+    if (result == Result::Success)
+    {
+        DumpLinkedLibraryElfs("PipelineCs", ppLibraryList, libraryCount);
+    }
+
     return result;
 }
 
@@ -61,9 +61,14 @@
 #include "palDequeImpl.h"
 
 #include "palFormatInfo.h"
+#include "palSysUtil.h"
 
 #include "core/hw/amdgpu_asic.h"
 
+#if PAL_HAS_CPUID
+#include <immintrin.h>
+#endif
+
 using namespace Util;
 using namespace Pal::Formats::Gfx9;
 
@@ -181,6 +186,9 @@ Device::Device(
               nullptr, // RPM, we don't know it's address until earlyInit timeframe
               GetFrameCountRegister(pDevice)),
     m_cmdUtil(*this),
+    m_metaEquationCache(pDevice->GetPlatform()),
+    m_coalescedBarrierSyncs(0),
+    m_coalescedBarrierFlushes(0),
     m_queueContextUpdateCounter(0),
     // The default value of MSAA rate is 1xMSAA.
     m_msaaRate(1),
@@ -227,6 +235,19 @@ Result Device::Cleanup()
     // RsrcProcMgr is owned by GfxDevice and gets reset on GfxDevice::Cleanup.
     m_pRsrcProcMgr->Cleanup();
 
+    // The cached meta equations depend on settings which may change before the device is finalized again.
+    m_metaEquationCache.Reset();
+
+    if ((m_coalescedBarrierSyncs > 0) || (m_coalescedBarrierFlushes > 0))
+    {
+        PAL_DPINFO("Barrier coalescing eliminated %llu syncs and %llu cache operations",
+                   m_coalescedBarrierSyncs,
+                   m_coalescedBarrierFlushes);
+    }
+
+    m_coalescedBarrierSyncs   = 0;
+    m_coalescedBarrierFlushes = 0;
+
     Result result = Result::Success;
 
     if (m_occlusionSrcMem.IsBound())
@@ -288,6 +309,11 @@ Result Device::EarlyInit()
 
     Result result = m_pRsrcProcMgr->EarlyInit();
 
+    if (result == Result::Success)
+    {
+        result = m_metaEquationCache.Init();
+    }
+
     SetupWorkarounds();
 
     return result;
@@ -1972,6 +1998,119 @@ static uint32 CalcLlcNoalloc(
     return (bypassOnRead << 1) | bypassOnWrite;
 }
 
+// Maximum number of buffer views handed to one call of a PackBufferSrdsFunc.
+constexpr uint32 BufferSrdBatchSize = 16;
+
+// Writes the SRDs of a run of GFX10+ buffer views.  The first three dwords of a buffer SRD only depend on the view's
+// address, stride and range; the caller supplies the fourth dword of each SRD.
+typedef void (*PackBufferSrdsFunc)(
+    uint32                count,
+    const BufferViewInfo* pBufferViewInfo,
+    const uint32*         pWord3,
+    sq_buf_rsrc_t*        pOutSrd);
+
+// =====================================================================================================================
+static void PackBufferSrdsScalar(
+    uint32                count,
+    const BufferViewInfo* pBufferViewInfo,
+    const uint32*         pWord3,
+    sq_buf_rsrc_t*        pOutSrd)
+{
+    for (uint32 idx = 0; idx < count; ++idx)
+    {
+        const BufferViewInfo& viewInfo = pBufferViewInfo[idx];
+
+        pOutSrd[idx].u32All[0] = LowPart(viewInfo.gpuAddr);
+        pOutSrd[idx].u32All[1] =
+            (HighPart(viewInfo.gpuAddr) | (static_cast<uint32>(viewInfo.stride) << SqBufRsrcTWord1StrideShift));
+        pOutSrd[idx].u32All[2] = Device::CalcNumRecords(static_cast<size_t>(viewInfo.range),
+                                                        static_cast<uint32>(viewInfo.stride));
+        pOutSrd[idx].u32All[3] = pWord3[idx];
+    }
+}
+
+#if PAL_HAS_CPUID
+// =====================================================================================================================
+// Packs four SRDs per iteration.  Each word is built for four views at once and the results are transposed into four
+// consecutive SRDs.  The output matches PackBufferSrdsScalar bit for bit.
+PAL_TARGET_AVX2
+static void PackBufferSrdsAvx2(
+    uint32                count,
+    const BufferViewInfo* pBufferViewInfo,
+    const uint32*         pWord3,
+    sq_buf_rsrc_t*        pOutSrd)
+{
+    const __m128i signBit = _mm_set1_epi32(INT32_MIN);
+    const __m128i one     = _mm_set1_epi32(1);
+    const __m256d twoTo31 = _mm256_set1_pd(2147483648.0);
+
+    uint32 idx = 0;
+
+    for (; (idx + 4) <= count; idx += 4)
+    {
+        const BufferViewInfo*const pInfo = pBufferViewInfo + idx;
+
+        const __m128i addrLo = _mm_setr_epi32(static_cast<int32>(LowPart(pInfo[0].gpuAddr)),
+                                              static_cast<int32>(LowPart(pInfo[1].gpuAddr)),
+                                              static_cast<int32>(LowPart(pInfo[2].gpuAddr)),
+                                              static_cast<int32>(LowPart(pInfo[3].gpuAddr)));
+        const __m128i addrHi = _mm_setr_epi32(static_cast<int32>(HighPart(pInfo[0].gpuAddr)),
+                                              static_cast<int32>(HighPart(pInfo[1].gpuAddr)),
+                                              static_cast<int32>(HighPart(pInfo[2].gpuAddr)),
+                                              static_cast<int32>(HighPart(pInfo[3].gpuAddr)));
+        const __m128i stride = _mm_setr_epi32(static_cast<int32>(pInfo[0].stride),
+                                              static_cast<int32>(pInfo[1].stride),
+                                              static_cast<int32>(pInfo[2].stride),
+                                              static_cast<int32>(pInfo[3].stride));
+        const __m128i range  = _mm_setr_epi32(static_cast<int32>(pInfo[0].range),
+                                              static_cast<int32>(pInfo[1].range),
+                                              static_cast<int32>(pInfo[2].range),
+                                              static_cast<int32>(pInfo[3].range));
+
+        // NUM_RECORDS is the range divided by the stride, or the range itself if the stride is zero or one.  The floor
+        // of the double-precision quotient of two 32-bit integers is exact.  There is no unsigned conversion between
+        // dwords and doubles, so values are moved through the signed range by flipping their sign bits.
+        const __m256d rangeF     = _mm256_add_pd(_mm256_cvtepi32_pd(_mm_xor_si128(range, signBit)), twoTo31);
+        const __m256d divisorF   =
+            _mm256_add_pd(_mm256_cvtepi32_pd(_mm_xor_si128(_mm_max_epu32(stride, one), signBit)), twoTo31);
+        const __m256d quotient   = _mm256_floor_pd(_mm256_div_pd(rangeF, divisorF));
+        const __m128i numRecords = _mm_xor_si128(_mm256_cvtpd_epi32(_mm256_sub_pd(quotient, twoTo31)), signBit);
+
+        const __m128i word1 = _mm_or_si128(addrHi, _mm_slli_epi32(stride, SqBufRsrcTWord1StrideShift));
+        const __m128i word3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWord3 + idx));
+
+        const __m128i lo01 = _mm_unpacklo_epi32(addrLo,     word1);
+        const __m128i hi01 = _mm_unpackhi_epi32(addrLo,     word1);
+        const __m128i lo23 = _mm_unpacklo_epi32(numRecords, word3);
+        const __m128i hi23 = _mm_unpackhi_epi32(numRecords, word3);
+
+        __m128i*const pDst = reinterpret_cast<__m128i*>(pOutSrd + idx);
+
+        _mm_storeu_si128(pDst + 0, _mm_unpacklo_epi64(lo01, lo23));
+        _mm_storeu_si128(pDst + 1, _mm_unpackhi_epi64(lo01, lo23));
+        _mm_storeu_si128(pDst + 2, _mm_unpacklo_epi64(hi01, hi23));
+        _mm_storeu_si128(pDst + 3, _mm_unpackhi_epi64(hi01, hi23));
+    }
+
+    PackBufferSrdsScalar(count - idx, pBufferViewInfo + idx, pWord3 + idx, pOutSrd + idx);
+}
+#endif
+
+// =====================================================================================================================
+static PackBufferSrdsFunc SelectPackBufferSrdsKernel()
+{
+    PackBufferSrdsFunc pfnPackBufferSrds = &PackBufferSrdsScalar;
+
+#if PAL_HAS_CPUID
+    if (CpuSupportsFeature(CpuFeature::Avx2))
+    {
+        pfnPackBufferSrds = &PackBufferSrdsAvx2;
+    }
+#endif
+
+    return pfnPackBufferSrds;
+}
+
 // =====================================================================================================================
 // Gfx9 specific function for creating typed buffer view SRDs. Installed in the function pointer table of the parent
 // device during initialization.
@@ -2057,60 +2196,74 @@ void PAL_STDCALL Device::Gfx10CreateTypedBufferViewSrds(
     const auto*const pFmtInfo   = MergedChannelFlatFmtInfoTbl(pPalDevice->ChipProperties().gfxLevel,
                                                               &pGfxDevice->GetPlatform()->PlatformSettings());
 
+    static const PackBufferSrdsFunc pfnPackBufferSrds = SelectPackBufferSrdsKernel();
+
     sq_buf_rsrc_t* pOutSrd = static_cast<sq_buf_rsrc_t*>(pOut);
 
     // This means "(index >= NumRecords)" is out-of-bounds.
     constexpr uint32 OobSelect = SQ_OOB_INDEX_ONLY;
 
-    for (uint32 idx = 0; idx < count; ++idx)
-    {
-        PAL_ASSERT(pBufferViewInfo->gpuAddr != 0);
-        PAL_ASSERT((pBufferViewInfo->stride == 0) ||
-                   ((pBufferViewInfo->gpuAddr % Min<gpusize>(sizeof(uint32), pBufferViewInfo->stride)) == 0));
-
-        pOutSrd->u32All[0] = LowPart(pBufferViewInfo->gpuAddr);
-        pOutSrd->u32All[1] =
-            (HighPart(pBufferViewInfo->gpuAddr) |
-             (static_cast<uint32>(pBufferViewInfo->stride) << SqBufRsrcTWord1StrideShift));
+    const uint32 resourceLevel = pGfxDevice->BufferSrdResourceLevel();
+    const bool   supportsMall  = (pPalDevice->MemoryProperties().flags.supportsMall != 0);
 
-        pOutSrd->u32All[2] = pGfxDevice->CalcNumRecords(static_cast<size_t>(pBufferViewInfo->range),
-                                                        static_cast<uint32>(pBufferViewInfo->stride));
+    // Views tend to come in runs of the same format, so the format-dependent part of the last view's fourth dword is
+    // kept around.  Typed views can't have an undefined format, so it never matches the first view.
+    SwizzledFormat lastFormat = UndefinedSwizzledFormat;
+    uint32         fmtWord3   = 0;
+    uint32         word3[BufferSrdBatchSize];
 
-        uint32 llcNoalloc = 0;
+    for (uint32 batchStart = 0; batchStart < count; batchStart += BufferSrdBatchSize)
+    {
+        const uint32 batchCount = Min(count - batchStart, BufferSrdBatchSize);
 
-        if (pPalDevice->MemoryProperties().flags.supportsMall != 0)
+        for (uint32 idx = 0; idx < batchCount; ++idx)
         {
-            // The SRD has a two-bit field where the high-bit is the control for "read" operations
-            // and the low bit is the control for bypassing the MALL on write operations.
-            llcNoalloc = CalcLlcNoalloc(pBufferViewInfo->flags.bypassMallRead,
-                                        pBufferViewInfo->flags.bypassMallWrite);
-        }
+            const BufferViewInfo& viewInfo = pBufferViewInfo[batchStart + idx];
 
-        PAL_ASSERT(Formats::IsUndefined(pBufferViewInfo->swizzledFormat.format) == false);
-        PAL_ASSERT(Formats::BytesPerPixel(pBufferViewInfo->swizzledFormat.format) == pBufferViewInfo->stride);
+            PAL_ASSERT(viewInfo.gpuAddr != 0);
+            PAL_ASSERT((viewInfo.stride == 0) ||
+                       ((viewInfo.gpuAddr % Min<gpusize>(sizeof(uint32), viewInfo.stride)) == 0));
+            PAL_ASSERT(Formats::IsUndefined(viewInfo.swizzledFormat.format) == false);
+            PAL_ASSERT(Formats::BytesPerPixel(viewInfo.swizzledFormat.format) == viewInfo.stride);
 
-        const SQ_SEL_XYZW01 SqSelX = Formats::Gfx9::HwSwizzle(pBufferViewInfo->swizzledFormat.swizzle.r);
-        const SQ_SEL_XYZW01 SqSelY = Formats::Gfx9::HwSwizzle(pBufferViewInfo->swizzledFormat.swizzle.g);
-        const SQ_SEL_XYZW01 SqSelZ = Formats::Gfx9::HwSwizzle(pBufferViewInfo->swizzledFormat.swizzle.b);
-        const SQ_SEL_XYZW01 SqSelW = Formats::Gfx9::HwSwizzle(pBufferViewInfo->swizzledFormat.swizzle.a);
+            if (memcmp(&viewInfo.swizzledFormat, &lastFormat, sizeof(lastFormat)) != 0)
+            {
+                const SQ_SEL_XYZW01 SqSelX = Formats::Gfx9::HwSwizzle(viewInfo.swizzledFormat.swizzle.r);
+                const SQ_SEL_XYZW01 SqSelY = Formats::Gfx9::HwSwizzle(viewInfo.swizzledFormat.swizzle.g);
+                const SQ_SEL_XYZW01 SqSelZ = Formats::Gfx9::HwSwizzle(viewInfo.swizzledFormat.swizzle.b);
+                const SQ_SEL_XYZW01 SqSelW = Formats::Gfx9::HwSwizzle(viewInfo.swizzledFormat.swizzle.a);
+
+                // Get the HW format enumeration corresponding to the view-specified format.
+                const BUF_FMT hwBufFmt = Formats::Gfx9::HwBufFmt(pFmtInfo, viewInfo.swizzledFormat.format);
+
+                // If we get an invalid format in the buffer SRD, then the memory operation involving this SRD will be
+                // dropped
+                PAL_ASSERT(hwBufFmt != BUF_FMT_INVALID);
+
+                fmtWord3   = ((SqSelX        << SqBufRsrcTWord3DstSelXShift)                |
+                              (SqSelY        << SqBufRsrcTWord3DstSelYShift)                |
+                              (SqSelZ        << SqBufRsrcTWord3DstSelZShift)                |
+                              (SqSelW        << SqBufRsrcTWord3DstSelWShift)                |
+                              (hwBufFmt      << Gfx10CoreSqBufRsrcTWord3FormatShift)        |
+                              (resourceLevel << Gfx10CoreSqBufRsrcTWord3ResourceLevelShift) |
+                              (OobSelect     << SqBufRsrcTWord3OobSelectShift)              |
+                              (SQ_RSRC_BUF   << SqBufRsrcTWord3TypeShift));
+                lastFormat = viewInfo.swizzledFormat;
+            }
 
-        // Get the HW format enumeration corresponding to the view-specified format.
-        const BUF_FMT hwBufFmt = Formats::Gfx9::HwBufFmt(pFmtInfo, pBufferViewInfo->swizzledFormat.format);
+            uint32 llcNoalloc = 0;
 
-        // If we get an invalid format in the buffer SRD, then the memory operation involving this SRD will be dropped
-        PAL_ASSERT(hwBufFmt != BUF_FMT_INVALID);
-        pOutSrd->u32All[3] = ((SqSelX                         << SqBufRsrcTWord3DstSelXShift)                      |
-                              (SqSelY                         << SqBufRsrcTWord3DstSelYShift)                      |
-                              (SqSelZ                         << SqBufRsrcTWord3DstSelZShift)                      |
-                              (SqSelW                         << SqBufRsrcTWord3DstSelWShift)                      |
-                              (hwBufFmt                       << Gfx10CoreSqBufRsrcTWord3FormatShift)              |
-                              (pGfxDevice->BufferSrdResourceLevel() << Gfx10CoreSqBufRsrcTWord3ResourceLevelShift) |
-                              (OobSelect                      << SqBufRsrcTWord3OobSelectShift)                    |
-                              (llcNoalloc                     << Gfx103PlusSqBufRsrcTWord3LlcNoallocShift)         |
-                              (SQ_RSRC_BUF                    << SqBufRsrcTWord3TypeShift));
+            if (supportsMall)
+            {
+                // The SRD has a two-bit field where the high-bit is the control for "read" operations
+                // and the low bit is the control for bypassing the MALL on write operations.
+                llcNoalloc = CalcLlcNoalloc(viewInfo.flags.bypassMallRead, viewInfo.flags.bypassMallWrite);
+            }
 
-        pOutSrd++;
-        pBufferViewInfo++;
+            word3[idx] = (fmtWord3 | (llcNoalloc << Gfx103PlusSqBufRsrcTWord3LlcNoallocShift));
+        }
+
+        pfnPackBufferSrds(batchCount, pBufferViewInfo + batchStart, &word3[0], pOutSrd + batchStart);
     }
 }
 
@@ -2174,55 +2327,57 @@ void PAL_STDCALL Device::Gfx10CreateUntypedBufferViewSrds(
     const auto*const pPalDevice = static_cast<const Pal::Device*>(pDevice);
     const auto*const pGfxDevice = static_cast<const Device*>(pPalDevice->GetGfxDevice());
 
+    static const PackBufferSrdsFunc pfnPackBufferSrds = SelectPackBufferSrdsKernel();
+
     sq_buf_rsrc_t* pOutSrd = static_cast<sq_buf_rsrc_t*>(pOut);
 
-    for (uint32 idx = 0; idx < count; ++idx)
-    {
-        PAL_ASSERT((pBufferViewInfo->gpuAddr != 0) || (pBufferViewInfo->range == 0));
+    const bool   supportsMall = (pPalDevice->MemoryProperties().flags.supportsMall != 0);
+    const uint32 baseWord3    = ((SQ_SEL_X                             << SqBufRsrcTWord3DstSelXShift)         |
+                                 (SQ_SEL_Y                             << SqBufRsrcTWord3DstSelYShift)         |
+                                 (SQ_SEL_Z                             << SqBufRsrcTWord3DstSelZShift)         |
+                                 (SQ_SEL_W                             << SqBufRsrcTWord3DstSelWShift)         |
+                                 (BUF_FMT_32_UINT                      << Gfx10CoreSqBufRsrcTWord3FormatShift) |
+                                 (pGfxDevice->BufferSrdResourceLevel() << Gfx10CoreSqBufRsrcTWord3ResourceLevelShift) |
+                                 (SQ_RSRC_BUF                          << SqBufRsrcTWord3TypeShift));
 
-        pOutSrd->u32All[0] = LowPart(pBufferViewInfo->gpuAddr);
+    uint32 word3[BufferSrdBatchSize];
 
-        pOutSrd->u32All[1] =
-            (HighPart(pBufferViewInfo->gpuAddr) |
-             (static_cast<uint32>(pBufferViewInfo->stride) << SqBufRsrcTWord1StrideShift));
+    for (uint32 batchStart = 0; batchStart < count; batchStart += BufferSrdBatchSize)
+    {
+        const uint32 batchCount = Min(count - batchStart, BufferSrdBatchSize);
 
-        pOutSrd->u32All[2] = pGfxDevice->CalcNumRecords(static_cast<size_t>(pBufferViewInfo->range),
-                                                        static_cast<uint32>(pBufferViewInfo->stride));
+        for (uint32 idx = 0; idx < batchCount; ++idx)
+        {
+            const BufferViewInfo& viewInfo = pBufferViewInfo[batchStart + idx];
 
-        PAL_ASSERT(Formats::IsUndefined(pBufferViewInfo->swizzledFormat.format));
+            PAL_ASSERT((viewInfo.gpuAddr != 0) || (viewInfo.range == 0));
+            PAL_ASSERT(Formats::IsUndefined(viewInfo.swizzledFormat.format));
 
-        uint32 llcNoalloc = 0;
+            if (viewInfo.gpuAddr != 0)
+            {
+                uint32 llcNoalloc = 0;
 
-        if (pPalDevice->MemoryProperties().flags.supportsMall != 0)
-        {
-            // The SRD has a two-bit field where the high-bit is the control for "read" operations
-            // and the low bit is the control for bypassing the MALL on write operations.
-            llcNoalloc = CalcLlcNoalloc(pBufferViewInfo->flags.bypassMallRead,
-                                        pBufferViewInfo->flags.bypassMallWrite);
-        }
+                if (supportsMall)
+                {
+                    // The SRD has a two-bit field where the high-bit is the control for "read" operations
+                    // and the low bit is the control for bypassing the MALL on write operations.
+                    llcNoalloc = CalcLlcNoalloc(viewInfo.flags.bypassMallRead, viewInfo.flags.bypassMallWrite);
+                }
 
-        if (pBufferViewInfo->gpuAddr != 0)
-        {
-            const uint32 oobSelect = ((pBufferViewInfo->stride == 1) ||
-                                      (pBufferViewInfo->stride == 0)) ? SQ_OOB_COMPLETE : SQ_OOB_INDEX_ONLY;
+                const uint32 oobSelect = ((viewInfo.stride == 1) ||
+                                          (viewInfo.stride == 0)) ? SQ_OOB_COMPLETE : SQ_OOB_INDEX_ONLY;
 
-            pOutSrd->u32All[3] = ((SQ_SEL_X                       << SqBufRsrcTWord3DstSelXShift)                      |
-                                  (SQ_SEL_Y                       << SqBufRsrcTWord3DstSelYShift)                      |
-                                  (SQ_SEL_Z                       << SqBufRsrcTWord3DstSelZShift)                      |
-                                  (SQ_SEL_W                       << SqBufRsrcTWord3DstSelWShift)                      |
-                                  (BUF_FMT_32_UINT                << Gfx10CoreSqBufRsrcTWord3FormatShift)              |
-                                  (pGfxDevice->BufferSrdResourceLevel() << Gfx10CoreSqBufRsrcTWord3ResourceLevelShift) |
-                                  (oobSelect                      << SqBufRsrcTWord3OobSelectShift)                    |
-                                  (llcNoalloc                     << Gfx103PlusSqBufRsrcTWord3LlcNoallocShift)         |
-                                  (SQ_RSRC_BUF                    << SqBufRsrcTWord3TypeShift));
-        }
-        else
-        {
-            pOutSrd->u32All[3] = 0;
+                word3[idx] = (baseWord3                                                 |
+                              (oobSelect  << SqBufRsrcTWord3OobSelectShift)             |
+                              (llcNoalloc << Gfx103PlusSqBufRsrcTWord3LlcNoallocShift));
+            }
+            else
+            {
+                word3[idx] = 0;
+            }
         }
 
-        pOutSrd++;
-        pBufferViewInfo++;
+        pfnPackBufferSrds(batchCount, pBufferViewInfo + batchStart, &word3[0], pOutSrd + batchStart);
     }
 }
 
@@ -2376,6 +2531,29 @@ static TEX_BC_SWIZZLE GetBcSwizzle(
     return bcSwizzle;
 }
 
+// =====================================================================================================================
+// Sets the fields of a GFX10+ image SRD which only depend on the image and the subresource plane being viewed.
+static void Gfx10SetImageSrdPlaneFields(
+    const AddrMgr2::AddrMgr2& addrMgr,
+    const Image&              image,
+    const SubResourceInfo*    pSubResInfo,
+    sq_img_rsrc_t*            pSrd)
+{
+    const ImageCreateInfo& imageCreateInfo = image.Parent()->GetImageCreateInfo();
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION < 642
+    const Gfx9MaskRam*     pMaskRam        = image.GetPrimaryMaskRam(pSubResInfo->subresId.aspect);
+#else
+    const Gfx9MaskRam*     pMaskRam        = image.GetPrimaryMaskRam(pSubResInfo->subresId.plane);
+#endif
+
+    // When view3dAs2dArray is enabled for 3d image, we'll use the same mode for writing and viewing
+    // according to the doc, so we don't need to change it here.
+    pSrd->sw_mode           = addrMgr.GetHwSwizzleMode(image.GetAddrSettings(pSubResInfo).swizzleMode);
+    pSrd->bc_swizzle        = GetBcSwizzle(imageCreateInfo);
+    pSrd->meta_pipe_aligned = ((pMaskRam != nullptr) ? pMaskRam->PipeAligned() : 0);
+    pSrd->corner_samples    = imageCreateInfo.usageFlags.cornerSampling;
+}
+
 // =====================================================================================================================
 static ImageViewType GetViewType(
     const ImageViewInfo&   viewInfo)
@@ -3063,6 +3241,42 @@ void Device::Gfx10SetImageSrdDims(
     }
 }
 
+// =====================================================================================================================
+// Builds the SRD template for views of one plane of an image. Views of BC, YUV-planar and macro-pixel-packed images
+// can move their base subresource or change their extents and mip count, so those always take the full path. Every
+// other view programs the plane's own extents (unless it includes padding) and the image's mip count, so those are
+// part of the template along with the fields which never depend on the view.
+void Device::Gfx10InitImageSrdTemplate(
+    const Image&      image,
+    const SubresId&   baseSubResId,  // Mip zero, slice zero of the plane.
+    ImageSrdTemplate* pTemplate
+    ) const
+{
+    const Pal::Image*const pParent    = image.Parent();
+    const ImageCreateInfo& createInfo = pParent->GetImageCreateInfo();
+    const ChNumFormat      imgFormat  = createInfo.swizzledFormat.format;
+
+    memset(pTemplate, 0, sizeof(*pTemplate));
+
+    pTemplate->pBaseSubResInfo = pParent->SubresourceInfo(baseSubResId);
+    pTemplate->valid           = ((Formats::IsBlockCompressed(imgFormat)         == false) &&
+                                  (Formats::IsYuvPlanar(imgFormat)               == false) &&
+                                  (Formats::IsMacroPixelPackedRgbOnly(imgFormat) == false));
+
+    Gfx10SetImageSrdPlaneFields(*static_cast<const AddrMgr2::AddrMgr2*>(Parent()->GetAddrMgr()),
+                                image,
+                                pTemplate->pBaseSubResInfo,
+                                &pTemplate->srd);
+
+    Gfx10SetImageSrdDims(&pTemplate->srd,
+                         pTemplate->pBaseSubResInfo->extentTexels.width,
+                         pTemplate->pBaseSubResInfo->extentTexels.height);
+
+    // MSAA images can't be mipmapped; their MAX_MIP field holds the fragment count instead.
+    pTemplate->srd.gfx10Core.max_mip = (createInfo.samples > 1) ? Log2(createInfo.fragments)
+                                                                : (createInfo.mipLevels - 1);
+}
+
 // =====================================================================================================================
 // Returns true if the supplied meta-data dimension (either width, height or depth) is compatible with the supplied
 // parent image dimension of the same type.
@@ -3373,21 +3587,37 @@ void PAL_STDCALL Device::Gfx10CreateImageViewSrds(
                                                   ? static_cast<const Pal::Image*>(viewInfo.pImage)
                                                   : static_cast<const Pal::Image*>(viewInfo.pPrtParentImg));
         const Image&           image           = static_cast<const Image&>(*(pParent->GetGfxImage()));
-#if PAL_CLIENT_INTERFACE_MAJOR_VERSION < 642
-        const Gfx9MaskRam*     pMaskRam        = image.GetPrimaryMaskRam(viewInfo.subresRange.startSubres.aspect);
-#else
-        const Gfx9MaskRam*     pMaskRam        = image.GetPrimaryMaskRam(viewInfo.subresRange.startSubres.plane);
-#endif
         const ImageInfo&       imageInfo       = pParent->GetImageInfo();
         const ImageCreateInfo& imageCreateInfo = pParent->GetImageCreateInfo();
         const ImageUsageFlags& imageUsageFlags = imageCreateInfo.usageFlags;
-        const bool             imgIsBc         = Formats::IsBlockCompressed(imageCreateInfo.swizzledFormat.format);
-        const bool             imgIsYuvPlanar  = Formats::IsYuvPlanar(imageCreateInfo.swizzledFormat.format);
         const auto             gfxLevel        = pPalDevice->ChipProperties().gfxLevel;
         sq_img_rsrc_t          srd             = {};
         const auto&            boundMem        = pParent->GetBoundGpuMemory();
         ChNumFormat            format          = viewInfo.swizzledFormat.format;
 
+        // Most views don't reinterpret the image's elements, so the image's SRD template already holds their
+        // image-invariant fields and none of the base subresource and extent adjustments below apply to them.
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION < 642
+        const ImageSrdTemplate& srdTemplate    =
+            image.GetSrdTemplate(pParent->GetPlaneFromAspect(viewInfo.subresRange.startSubres.aspect));
+#else
+        const ImageSrdTemplate& srdTemplate    = image.GetSrdTemplate(viewInfo.subresRange.startSubres.plane);
+#endif
+        const bool              useTemplate    =
+            srdTemplate.valid                                   &&
+            (viewInfo.mapAccess == PrtMapAccessType::Raw)       &&
+            (srdTemplate.pBaseSubResInfo->bitsPerTexel == Formats::BitsPerPixel(format));
+
+        const bool imgIsBc        = (useTemplate == false) &&
+                                    Formats::IsBlockCompressed(imageCreateInfo.swizzledFormat.format);
+        const bool imgIsYuvPlanar = (useTemplate == false) &&
+                                    Formats::IsYuvPlanar(imageCreateInfo.swizzledFormat.format);
+
+        if (useTemplate)
+        {
+            srd = srdTemplate.srd;
+        }
+
 #if PAL_CLIENT_INTERFACE_MAJOR_VERSION < 642
         SubresId     baseSubResId   = { viewInfo.subresRange.startSubres.aspect, 0, 0 };
 #else
@@ -3412,11 +3642,11 @@ void PAL_STDCALL Device::Gfx10CreateImageViewSrds(
         bool  overrideBaseResource              = false;
         bool  overrideZRangeOffset              = false;
         bool  includePadding                    = (viewInfo.flags.includePadding != 0);
-        const SubResourceInfo*const pSubResInfo = pParent->SubresourceInfo(baseSubResId);
-        const auto&                 surfSetting = image.GetAddrSettings(pSubResInfo);
+        const SubResourceInfo*const pSubResInfo = useTemplate ? srdTemplate.pBaseSubResInfo
+                                                              : pParent->SubresourceInfo(baseSubResId);
 
         // Validate subresource ranges
-        const SubResourceInfo* pBaseSubResInfo  = pParent->SubresourceInfo(baseSubResId);
+        const SubResourceInfo* pBaseSubResInfo  = pSubResInfo;
 
         Extent3d extent       = pBaseSubResInfo->extentTexels;
         Extent3d actualExtent = pBaseSubResInfo->actualExtentTexels;
@@ -3434,7 +3664,11 @@ void PAL_STDCALL Device::Gfx10CreateImageViewSrds(
         //    can access each array slice).
         //    This has the unfortunate side-effect of making normalized texture coordinates inaccurate.
         //    However, this is required for access to multiple slices.
-        if (imgIsBc && (Formats::IsBlockCompressed(format) == false))
+        if (useTemplate)
+        {
+            // None of these cases can apply; see Gfx10InitImageSrdTemplate.
+        }
+        else if (imgIsBc && (Formats::IsBlockCompressed(format) == false))
         {
             // If we have the following image:
             //              Uncompressed pixels   Compressed block sizes (4x4)
@@ -3665,7 +3899,11 @@ void PAL_STDCALL Device::Gfx10CreateImageViewSrds(
         }
 
         const Extent3d programmedExtent = (includePadding) ? actualExtent : extent;
-        pGfxDevice->Gfx10SetImageSrdDims(&srd, programmedExtent.width, programmedExtent.height);
+
+        if ((useTemplate == false) || includePadding)
+        {
+            pGfxDevice->Gfx10SetImageSrdDims(&srd, programmedExtent.width, programmedExtent.height);
+        }
 
         // Setup CCC filtering optimizations: GCN uses a simple scheme which relies solely on the optimization
         // setting from the CCC rather than checking the render target resolution.
@@ -3712,9 +3950,19 @@ void PAL_STDCALL Device::Gfx10CreateImageViewSrds(
         srd.dst_sel_z = Formats::Gfx9::HwSwizzle(viewInfo.swizzledFormat.swizzle.b);
         srd.dst_sel_w = Formats::Gfx9::HwSwizzle(viewInfo.swizzledFormat.swizzle.a);
 
-        // When view3dAs2dArray is enabled for 3d image, we'll use the same mode for writing and viewing
-        // according to the doc, so we don't need to change it here.
-        srd.sw_mode   = pAddrMgr->GetHwSwizzleMode(surfSetting.swizzleMode);
+        if (useTemplate == false)
+        {
+            Gfx10SetImageSrdPlaneFields(*pAddrMgr, image, pSubResInfo, &srd);
+        }
+#if PAL_ENABLE_PRINTS_ASSERTS
+        else
+        {
+            // The image must not have changed in any way which affects its template since it was built.
+            ImageSrdTemplate freshTemplate = {};
+            pGfxDevice->Gfx10InitImageSrdTemplate(image, baseSubResId, &freshTemplate);
+            PAL_ASSERT(memcmp(&freshTemplate.srd, &srdTemplate.srd, sizeof(sq_img_rsrc_t)) == 0);
+        }
+#endif
 
         const bool isMultiSampled = (imageCreateInfo.samples > 1);
 
@@ -3760,9 +4008,14 @@ void PAL_STDCALL Device::Gfx10CreateImageViewSrds(
             maxMipField    = mipLevels - 1;
         }
 
+        if (useTemplate == false)
         {
             srd.gfx10Core.max_mip = maxMipField;
         }
+        else
+        {
+            PAL_ASSERT(srd.gfx10Core.max_mip == maxMipField);
+        }
 
         {
             srd.gfx10.depth = ComputeImageViewDepth(viewInfo, imageInfo, *pBaseSubResInfo);
@@ -3793,15 +4046,11 @@ void PAL_STDCALL Device::Gfx10CreateImageViewSrds(
             }
         }
 
-        srd.bc_swizzle = GetBcSwizzle(imageCreateInfo);
-
         if (IsGfx10(*pPalDevice))
         {
             srd.gfx10.base_array   = baseArraySlice;
         }
 
-        srd.meta_pipe_aligned  = ((pMaskRam != nullptr) ? pMaskRam->PipeAligned() : 0);
-        srd.corner_samples     = imageCreateInfo.usageFlags.cornerSampling;
         srd.iterate_256        = image.GetIterate256(pSubResInfo);
 
         // Depth images obviously don't have an alpha component, so don't bother...
@@ -5576,6 +5825,24 @@ uint32 Device::ComputeTessPrimGroupSize(
     return (primGroupSize - 1); // The hardware adds 1 to the value we specify, so pre-subtract 1 here.
 }
 
+// =====================================================================================================================
+// Called by command buffers which coalesce barriers to add the work they eliminated to the device totals.
+void Device::AddBarrierCoalescerStats(
+    uint32 eliminatedSyncs,
+    uint32 eliminatedFlushes
+    ) const
+{
+    if (eliminatedSyncs > 0)
+    {
+        Util::AtomicAdd64(&m_coalescedBarrierSyncs, eliminatedSyncs);
+    }
+
+    if (eliminatedFlushes > 0)
+    {
+        Util::AtomicAdd64(&m_coalescedBarrierFlushes, eliminatedFlushes);
+    }
+}
+
 // =====================================================================================================================
 // When creating a image used as color target, we increment the corresponding MSAA histogram pile by 1.
 void Device::IncreaseMsaaHistogram(
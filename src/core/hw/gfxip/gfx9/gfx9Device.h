@@ -45,6 +45,10 @@ struct BarrierInfo;
 namespace Gfx9
 {
 
+class BarrierCoalescer;
+class Image;
+struct ImageSrdTemplate;
+
 // Needed only for VRS support
 class Gfx10DepthStencilView;
 
@@ -148,7 +152,9 @@ struct LayoutTransitionInfo
             uint32 useComputePath   : 1;  // For those transition BLTs that could do either graphics or compute path,
                                           // figure out what path the BLT will use and cache it here.
             uint32 fceIsSkipped     : 1;  // Set if a FastClearEliminate BLT is skipped.
-            uint32 reserved         : 30; // Reserved for future usage.
+            uint32 dependsOnClears  : 1;  // Set if the decision depends on the image's clear history, which means
+                                          // it must not be memoized.
+            uint32 reserved         : 29; // Reserved for future usage.
         };
         uint32 u32All;                    // Flags packed as uint32.
     } flags;
@@ -526,6 +532,8 @@ public:
 
     void FillCacheOperations(const SyncReqs& syncReqs, Developer::BarrierOperations* pOperations) const;
 
+    static BarrierCoalescer* GetBarrierCoalescer(GfxCmdBuffer* pCmdBuf, const CmdStream* pSyncStream);
+
     void IssueSyncs(
         GfxCmdBuffer*                 pCmdBuf,
         CmdStream*                    pCmdStream,
@@ -594,6 +602,9 @@ public:
 
     uint32 GetPipeInterleaveLog2() const;
 
+    // The cache is internally synchronized, so mask-rams may use it through a const device.
+    MetaEquationCache* GetMetaEquationCache() const { return &m_metaEquationCache; }
+
     uint32 GetDbDfsmControl() const;
 
     static uint32 GetMaxWavesPerSh(const GpuChipProperties& chipProps, bool isCompute);
@@ -615,6 +626,8 @@ public:
     uint32 GetPixelCount() const override { return m_presentResolution.height * m_presentResolution.width; }
     uint32 GetMsaaRate() const override { return m_msaaRate; }
 
+    void AddBarrierCoalescerStats(uint32 eliminatedSyncs, uint32 eliminatedFlushes) const;
+
     bool NeedGlobalFlushAndInvL2(
         uint32        srcCacheMask,
         uint32        dstCacheMask,
@@ -694,6 +707,11 @@ public:
     void AssertUserAccumRegsDisabled(const RegisterVector& registers, uint32 firstRegAddr) const;
 #endif
 
+    void Gfx10InitImageSrdTemplate(
+        const Image&      image,
+        const SubresId&   baseSubResId,
+        ImageSrdTemplate* pTemplate) const;
+
 private:
     void Gfx10SetImageSrdDims(sq_img_rsrc_t*  pSrd, uint32 width, uint32  height) const;
 
@@ -807,6 +825,13 @@ private:
     volatile ShaderRingItemSizes  m_largestRingSizes;
     Util::Mutex                   m_ringSizesLock;
 
+    // Meta equations shared by all mask-rams of the same shape.
+    mutable MetaEquationCache     m_metaEquationCache;
+
+    // Totals of the barrier syncs and cache operations which command buffers coalesced away, reported at Cleanup().
+    mutable volatile uint64       m_coalescedBarrierSyncs;
+    mutable volatile uint64       m_coalescedBarrierFlushes;
+
     // Keep a watermark for the number of updates to the queue context. When a QueueContext pre-processes a submit, it
     // will check its watermark against the one owned by the device and update accordingly.
     volatile uint32               m_queueContextUpdateCounter;
@@ -309,7 +309,7 @@ Result GraphicsPipeline::HwlInit(
     const CodeObjectMetadata&         metadata,
     MsgPackReader*                    pMetadataReader)
 {
-    RegisterVector registers(m_pDevice->GetPlatform());
+    RegisterVector registers;
     Result result = pMetadataReader->Seek(metadata.pipeline.registers);
 
     if (result == Result::Success)
@@ -50,7 +50,7 @@ Result HybridGraphicsPipeline::HwlInit(
     const CodeObjectMetadata&         metadata,
     Util::MsgPackReader*              pMetadataReader)
 {
-    RegisterVector registers(m_pDevice->GetPlatform());
+    RegisterVector registers;
     Result result = pMetadataReader->Seek(metadata.pipeline.registers);
 
     if (result == Result::Success)
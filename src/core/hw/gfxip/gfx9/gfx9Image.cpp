@@ -117,6 +117,7 @@ Image::Image(
     memset(m_dccStateMetaDataSize,       0, sizeof(m_dccStateMetaDataSize));
     memset(m_fastClearEliminateMetaDataOffset, 0, sizeof(m_fastClearEliminateMetaDataOffset));
     memset(m_fastClearEliminateMetaDataSize,   0, sizeof(m_fastClearEliminateMetaDataSize));
+    memset(m_srdTemplate,                      0, sizeof(m_srdTemplate));
 
     for (uint32  planeIdx = 0; planeIdx < MaxNumPlanes; planeIdx++)
     {
@@ -957,6 +958,19 @@ Result Image::Finalize(
         InitLayoutStateMasks();
         InitPipeMisalignedMetadataFirstMip();
 
+        if (IsGfx10Plus(m_device))
+        {
+            for (uint32 plane = 0; plane < m_pImageInfo->numPlanes; plane++)
+            {
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION < 642
+                const SubresId baseSubResId = { GetAspectFromPlane(plane), 0, 0 };
+#else
+                const SubresId baseSubResId = { plane, 0, 0 };
+#endif
+                m_gfxDevice.Gfx10InitImageSrdTemplate(*this, baseSubResId, &m_srdTemplate[plane]);
+            }
+        }
+
         if (m_createInfo.flags.prt != 0)
         {
             m_device.GetAddrMgr()->ComputePackedMipInfo(*Parent(), pGpuMemLayout);
@@ -193,6 +193,20 @@ PAL_INLINE DepthStencilCompressionState ImageLayoutToDepthCompressionState(
     return state;
 }
 
+// =====================================================================================================================
+// The part of a GFX10+ image view SRD which only depends on the image and the plane being viewed. It's built once when
+// the image is created so that CreateImageViewSrds only needs to fill in the view-dependent fields for common views.
+// Fields which depend on the bound memory (base address, metadata address, big page and iterate256) are not included.
+// GFX9 image views use a different SRD layout and always take the full path.
+struct ImageSrdTemplate
+{
+    sq_img_rsrc_t          srd;             // Swizzle mode, BC swizzle, metadata pipe alignment, corner sampling,
+                                            // base extents and MAX_MIP; everything else is zero.
+    const SubResourceInfo* pBaseSubResInfo; // Mip zero, slice zero of the plane.
+    bool                   valid;           // False if this plane's views may need their base subresource, extents
+                                            // or mip levels adjusted, which requires the full SRD setup.
+};
+
 // =====================================================================================================================
 // This is the Gfx9 Image class which is derived from GfxImage.  It is responsible for hardware specific Image
 // functionality such as setting up mask ram, metadata, tile info, etc.
@@ -470,6 +484,8 @@ public:
     bool CanMipSupportMetaData(uint32 mip) const override;
 
     uint32 GetIterate256(const SubResourceInfo*  pSubResInfo) const;
+
+    const ImageSrdTemplate& GetSrdTemplate(uint32 plane) const { return m_srdTemplate[plane]; }
     bool Gfx10UseCompToSingleFastClears() const { return m_useCompToSingleForFastClears; };
 
     gpusize GetGpuMemSyncSize() const { return m_gpuMemSyncSize; }
@@ -554,6 +570,8 @@ private:
     // workaround, a value of zero means all mips require it.  See InitPipeMisalignedMetadataFirstMip() for details.
     uint32  m_firstMipMetadataPipeMisaligned[MaxNumPlanes];
 
+    ImageSrdTemplate  m_srdTemplate[MaxNumPlanes]; // Per-plane templates for GFX10+ image view SRDs.
+
 #if PAL_CLIENT_INTERFACE_MAJOR_VERSION < 642
     uint32 GetAspectIndex(ImageAspect  aspect) const;
 #endif
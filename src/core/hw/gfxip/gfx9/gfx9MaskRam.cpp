@@ -948,16 +948,6 @@ void Gfx9MetaEqGenerator::CalcMetaEquationGfx9()
                       compFragLog2 + i);
     }
 
-    // Ok, we always calculate the meta-equation to be 32-bits long, but that's enough to address 4Gnibbles.
-    // Trim this down to be no bigger than log2(mask-ram-size)
-    FinalizeMetaEquation(m_pParent->TotalSize());
-
-    // After meta equation calculation is done extract meta equation parameter information
-    m_meta.GenerateMetaEqParamConst(m_pParent->GetImage(), maxFragsLog2, m_firstUploadBit, &m_metaEqParam);
-
-    // For some reason, the number of samples addressed by the equation sometimes differs from the number of
-    // samples associated with the data-surface.  Still seems to work...
-    PAL_ALERT (m_effectiveSamples != (1u << numSamplesLog2));
 }
 
 // =====================================================================================================================
@@ -1271,16 +1261,101 @@ void Gfx9MetaEqGenerator::CpuUploadEq(
 //      }
 void Gfx9MetaEqGenerator::CalcMetaEquation()
 {
-    const Pal::Image*  pParent   = m_pParent->GetImage().Parent();
-    const Pal::Device& palDevice = *(m_pParent->GetGfxDevice()->Parent());
+    const Pal::Device& palDevice  = *(m_pParent->GetGfxDevice()->Parent());
+    MetaEquationCache* pEqCache   = m_pParent->GetGfxDevice()->GetMetaEquationCache();
+
+    // Mask-rams of the same shape share one untrimmed equation, so only the first of them has to calculate it.
+    MetaEquationKey key = {};
+    BuildMetaEquationKey(&key);
+
+    if (pEqCache->Find(key, &m_meta) == false)
+    {
+        if (IsGfx9(palDevice))
+        {
+            CalcMetaEquationGfx9();
+        }
+        else if (IsGfx10(palDevice))
+        {
+            CalcMetaEquationGfx10();
+        }
+
+        pEqCache->Insert(key, m_meta);
+    }
 
     if (IsGfx9(palDevice))
     {
-        CalcMetaEquationGfx9();
+        const uint32 maxFragsLog2   = m_pParent->GetGfxDevice()->GetMaxFragsLog2();
+        const uint32 numSamplesLog2 = m_pParent->GetNumSamplesLog2();
+
+        // Ok, we always calculate the meta-equation to be 32-bits long, but that's enough to address 4Gnibbles.
+        // Trim this down to be no bigger than log2(mask-ram-size)
+        FinalizeMetaEquation(m_pParent->TotalSize());
+
+        // After meta equation calculation is done extract meta equation parameter information
+        m_meta.GenerateMetaEqParamConst(m_pParent->GetImage(), maxFragsLog2, m_firstUploadBit, &m_metaEqParam);
+
+        // For some reason, the number of samples addressed by the equation sometimes differs from the number of
+        // samples associated with the data-surface.  Still seems to work...
+        PAL_ALERT (m_effectiveSamples != (1u << numSamplesLog2));
     }
     else if (IsGfx10(palDevice))
     {
-        CalcMetaEquationGfx10();
+        // The equation is currently 32-bits long, but on GFX10, the equation is an offset into one meta-block
+        // (unlike on GFX9 where the equation is an offset into the entire mask-ram), so trim this down to the
+        // the log2 of one meta-block.
+        FinalizeMetaEquation(palDevice.GetAddrMgr()->GetBlockSize(m_pParent->GetSwizzleMode()));
+    }
+}
+
+// =====================================================================================================================
+// Fills out the key which identifies this mask-ram's meta equation in the device's meta equation cache.  This must
+// capture every input of CalcMetaEquationGfx9/CalcMetaEquationGfx10 which isn't constant for the whole device.
+void Gfx9MetaEqGenerator::BuildMetaEquationKey(
+    MetaEquationKey* pKey
+    ) const
+{
+    const Pal::Device&     palDevice  = *(m_pParent->GetGfxDevice()->Parent());
+    const ImageCreateInfo& createInfo = m_pParent->GetImage().Parent()->GetImageCreateInfo();
+
+    Gfx9MaskRamBlockSize compBlockLog2 = {};
+    m_pParent->CalcCompBlkSizeLog2(&compBlockLog2);
+
+    pKey->flags.isColor           = m_pParent->IsColor();
+    pKey->flags.isDepth           = m_pParent->IsDepth();
+    pKey->flags.depthStencilUsage = createInfo.usageFlags.depthStencil;
+    pKey->flags.multipleMips      = (createInfo.mipLevels > 1);
+    pKey->flags.isTex3d           = (createInfo.imageType == ImageType::Tex3d);
+    pKey->swizzleMode             = m_pParent->GetSwizzleMode();
+    pKey->bppLog2                 = m_pParent->GetBytesPerPixelLog2();
+    pKey->numSamplesLog2          = m_pParent->GetNumSamplesLog2();
+    pKey->metaDataWordSizeLog2    = m_metaDataWordSizeLog2;
+    pKey->compBlockLog2[0]        = compBlockLog2.width;
+    pKey->compBlockLog2[1]        = compBlockLog2.height;
+    pKey->compBlockLog2[2]        = compBlockLog2.depth;
+
+    if (IsGfx9(palDevice))
+    {
+        const ADDR2_META_FLAGS metaFlags = m_pParent->GetMetaFlags();
+
+        Gfx9MaskRamBlockSize metaBlockLog2 = {};
+        m_pParent->CalcMetaBlkSizeLog2(&metaBlockLog2);
+
+        pKey->flags.pipeAligned = metaFlags.pipeAligned;
+        pKey->flags.rbAligned   = metaFlags.rbAligned;
+        pKey->metaBlockLog2[0]  = metaBlockLog2.width;
+        pKey->metaBlockLog2[1]  = metaBlockLog2.height;
+        pKey->metaBlockLog2[2]  = metaBlockLog2.depth;
+    }
+    else
+    {
+        Gfx9MaskRamBlockSize metaBlockLog2 = {};
+
+        pKey->flags.pipeAligned = m_pParent->PipeAligned();
+        pKey->metaBlockSizeLog2 = m_pParent->GetMetaBlockSize(&metaBlockLog2);
+        pKey->metaBlockLog2[0]  = metaBlockLog2.width;
+        pKey->metaBlockLog2[1]  = metaBlockLog2.height;
+        pKey->metaBlockLog2[2]  = metaBlockLog2.depth;
+        pKey->metaCachelineSize = m_pParent->GetMetaCachelineSize();
     }
 }
 
@@ -3156,11 +3231,6 @@ void Gfx9MetaEqGenerator::CalcMetaEquationGfx10()
             }
         }
     }
-
-    // The equation is currently 32-bits long, but on GFX10, the equation is an offset into one meta-block
-    // (unlike on GFX9 where the equation is an offset into the entire mask-ram), so trim this down to the
-    // the log2 of one meta-block.
-    FinalizeMetaEquation(pPalDevice->GetAddrMgr()->GetBlockSize(swizzleMode));
 }
 
 //=============== Implementation for Gfx9Htile: ========================================================================
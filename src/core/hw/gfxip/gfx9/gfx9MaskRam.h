@@ -273,6 +273,7 @@ protected:
 private:
     void   CalcMetaEquationGfx9();
     void   CalcMetaEquationGfx10();
+    void   BuildMetaEquationKey(MetaEquationKey* pKey) const;
     void   CalcDataOffsetEquation(MetaDataAddrEquation* pDataOffset);
     void   CalcPipeEquation(MetaDataAddrEquation* pPipe, MetaDataAddrEquation* pDataOffset, uint32  numPipesLog2);
     void   CalcRbEquation(MetaDataAddrEquation* pRb, uint32  numSesLog2, uint32  numRbsPerSeLog2);
@@ -25,6 +25,7 @@
 
 #include "pal.h"
 #include "palInlineFuncs.h"
+#include "core/platform.h"
 #include "core/hw/gfxip/gfx9/gfx9CmdStream.h"
 #include "core/hw/gfxip/gfx9/gfx9Device.h"
 #include "core/hw/gfxip/gfx9/gfx9Image.h"
@@ -1120,5 +1121,82 @@ void MetaDataAddrEquation::Rotate(
     }
 }
 
+//=============== Implementation for MetaEquationCache: ================================================================
+// =====================================================================================================================
+MetaEquationCache::MetaEquationCache(
+    Platform*  pPlatform)
+    :
+    m_pPlatform(pPlatform),
+    m_equations(NumBuckets, pPlatform)
+{
+}
+
+// =====================================================================================================================
+MetaEquationCache::~MetaEquationCache()
+{
+    Reset();
+}
+
+// =====================================================================================================================
+Result MetaEquationCache::Init()
+{
+    return m_equations.Init();
+}
+
+// =====================================================================================================================
+// Releases every cached equation.
+void MetaEquationCache::Reset()
+{
+    MutexAuto lock(&m_lock);
+
+    for (auto iter = m_equations.Begin(); iter.Get() != nullptr; iter.Next())
+    {
+        PAL_DELETE(iter.Get()->value, m_pPlatform);
+    }
+
+    m_equations.Reset();
+}
+
+// =====================================================================================================================
+// Copies the cached equation for the given key into pEquation.  Returns false if no equation has been cached for it.
+bool MetaEquationCache::Find(
+    const MetaEquationKey&  key,
+    MetaDataAddrEquation*   pEquation)
+{
+    MutexAuto lock(&m_lock);
+
+    MetaDataAddrEquation*const* ppCached = m_equations.FindKey(key);
+
+    if (ppCached != nullptr)
+    {
+        *pEquation = **ppCached;
+    }
+
+    return (ppCached != nullptr);
+}
+
+// =====================================================================================================================
+// Caches a copy of the given equation.  Failing to allocate the copy is not an error; the equation will simply be
+// recalculated next time.
+void MetaEquationCache::Insert(
+    const MetaEquationKey&       key,
+    const MetaDataAddrEquation&  equation)
+{
+    MutexAuto lock(&m_lock);
+
+    bool                    existed  = false;
+    MetaDataAddrEquation**  ppCached = nullptr;
+
+    if ((m_equations.FindAllocate(key, &existed, &ppCached) == Result::Success) && (existed == false))
+    {
+        *ppCached = PAL_NEW(MetaDataAddrEquation, m_pPlatform, AllocInternal)(equation);
+
+        if (*ppCached == nullptr)
+        {
+            m_equations.Erase(key);
+        }
+    }
+}
+
 } // Gfx9
 } // Pal
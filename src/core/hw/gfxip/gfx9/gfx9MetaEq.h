@@ -26,10 +26,14 @@
 #pragma once
 
 #include "pal.h"
+#include "palHashMap.h"
+#include "palMutex.h"
 
 namespace Pal
 {
 
+class Platform;
+
 namespace Gfx9
 {
 class Device;
@@ -256,5 +260,64 @@ private:
     uint32  m_equation[MaxNumMetaDataAddrBits][MetaDataAddrCompNumTypes];
 };
 
+// =====================================================================================================================
+// Everything a mask-ram's meta equation depends on, other than the device it belongs to.  Mask-rams on the same device
+// with equal keys have identical meta equations before they are trimmed to the size of the mask-ram.
+struct MetaEquationKey
+{
+    union
+    {
+        struct
+        {
+            uint32  isColor           :  1;
+            uint32  isDepth           :  1;
+            uint32  depthStencilUsage :  1;
+            uint32  multipleMips      :  1;
+            uint32  isTex3d           :  1;
+            uint32  pipeAligned       :  1;  // The meta flags' pipe-aligned state (GFX9) or PipeAligned() (GFX10)
+            uint32  rbAligned         :  1;
+            uint32  reserved          : 25;
+        };
+        uint32  u32All;
+    } flags;
+
+    uint32  swizzleMode;
+    uint32  bppLog2;
+    uint32  numSamplesLog2;
+    int32   metaDataWordSizeLog2;
+    uint32  compBlockLog2[3];   // Width, height and depth of the compression block
+    uint32  metaBlockLog2[3];   // Width, height and depth of the meta block
+    uint32  metaBlockSizeLog2;  // GFX10 only
+    uint32  metaCachelineSize;  // GFX10 only
+};
+
+// =====================================================================================================================
+// Device-wide cache of untrimmed meta equations, so that mask-rams of the same shape only calculate their equation
+// once.  This class is thread-safe.
+class MetaEquationCache
+{
+public:
+    explicit MetaEquationCache(Platform* pPlatform);
+    ~MetaEquationCache();
+
+    Result Init();
+    void   Reset();
+
+    bool Find(const MetaEquationKey& key, MetaDataAddrEquation* pEquation);
+    void Insert(const MetaEquationKey& key, const MetaDataAddrEquation& equation);
+
+private:
+    typedef Util::HashMap<MetaEquationKey, MetaDataAddrEquation*, Platform, Util::JenkinsHashFunc> EquationMap;
+
+    static constexpr uint32 NumBuckets = 64;
+
+    Platform*const  m_pPlatform;
+    Util::Mutex     m_lock;
+    EquationMap     m_equations;
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(MetaEquationCache);
+    PAL_DISALLOW_DEFAULT_CTOR(MetaEquationCache);
+};
+
 } // Gfx9
 } // Pal
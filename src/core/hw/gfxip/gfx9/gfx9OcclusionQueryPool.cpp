@@ -34,6 +34,10 @@
 #include "palIntervalTreeImpl.h"
 #include "palSysUtil.h"
 
+#if PAL_HAS_CPUID
+#include <immintrin.h>
+#endif
+
 using namespace Util;
 
 namespace Pal
@@ -433,46 +437,183 @@ static bool IsQueryDataValid(
 }
 
 // =====================================================================================================================
-// Helper function for ComputeResults. It computes the result data according to the given flags, storing all data in
-// integers of type ResultUint. Returns true if all counters were ready. Note that the counters pointer is volatile
-// because the GPU could write them at any time (and if QueryResultWait is set we expect it to do so).
-template <typename ResultUint>
-static bool ComputeResultsForOneSlot(
-    QueryResultFlags                         flags,
-    uint32                                   numTotalRbs,
-    bool                                     isBinary,
+// Sums the z-pass deltas reported by every RB for one slot, skipping any counters which haven't been written yet. The
+// RBs will set the valid bits when they have written their data. We do not need to skip disabled RBs because they are
+// initialized to valid with zPassData equal to zero. Returns true if all counters were ready. Note that the counters
+// pointer is volatile because the GPU could write them at any time.
+static bool ReduceSlotScalar(
     volatile const OcclusionQueryResultPair* pRbCounters,
-    ResultUint*                              pOutputBuffer)
+    uint32                                   numTotalRbs,
+    uint64*                                  pSum)
 {
-    ResultUint result     = 0;
-    bool       queryReady = true;
+    uint64 sum       = 0;
+    bool   slotReady = true;
 
-    // Loop through all the RBs associated with this ASIC.
     for (uint32 idx = 0; idx < numTotalRbs; idx++)
     {
-        bool countersReady = false;
+        const bool countersReady = IsQueryDataValid(&pRbCounters[idx].begin.data) &&
+                                   IsQueryDataValid(&pRbCounters[idx].end.data)   &&
+                                   ((pRbCounters[idx].begin.bits.valid == 1) && (pRbCounters[idx].end.bits.valid == 1));
 
-        do
+        if (countersReady)
         {
-            // The RBs will set the valid bits when they have written their data. We do not need to skip disabled RBs
-            // because they are initialized to valid with zPassData equal to zero. We will loop here for as long as
-            // necessary if the caller has requested it.
-            countersReady = IsQueryDataValid(&pRbCounters[idx].begin.data) &&
-                            IsQueryDataValid(&pRbCounters[idx].end.data)   &&
-                            ((pRbCounters[idx].begin.bits.valid == 1) && (pRbCounters[idx].end.bits.valid == 1));
+            sum += pRbCounters[idx].end.bits.zPassData - pRbCounters[idx].begin.bits.zPassData;
         }
-        while ((countersReady == false) && TestAnyFlagSet(flags, QueryResultWait));
 
-        if (countersReady)
+        // The entire query will only be ready if all of its counters were ready.
+        slotReady = slotReady && countersReady;
+    }
+
+    (*pSum) = sum;
+
+    return slotReady;
+}
+
+// Maximum number of slots reduced by one call to a ReduceSlotsFunc: one bit of its return value per slot.
+constexpr uint32 MaxReduceSlots = 64;
+
+// Sums the z-pass deltas of all RBs for each of slotCount consecutive slots into pSums. Returns a mask with one bit set
+// for every slot whose counters were all ready.
+typedef uint64 (*ReduceSlotsFunc)(
+    const void* pGpuData,
+    size_t      slotSize,
+    uint32      numTotalRbs,
+    uint32      slotCount,
+    uint64*     pSums);
+
+// =====================================================================================================================
+static uint64 ReduceSlotsScalar(
+    const void* pGpuData,
+    size_t      slotSize,
+    uint32      numTotalRbs,
+    uint32      slotCount,
+    uint64*     pSums)
+{
+    uint64 readyMask = 0;
+
+    for (uint32 slot = 0; slot < slotCount; slot++)
+    {
+        const auto* pRbCounters = static_cast<const OcclusionQueryResultPair*>(VoidPtrInc(pGpuData, slot * slotSize));
+
+        if (ReduceSlotScalar(pRbCounters, numTotalRbs, &pSums[slot]))
         {
-            result += static_cast<ResultUint>(pRbCounters[idx].end.bits.zPassData -
-                                              pRbCounters[idx].begin.bits.zPassData);
+            readyMask |= (1ull << slot);
         }
+    }
 
-        // The entire query will only be ready if all of its counters were ready.
-        queryReady = queryReady && countersReady;
+    return readyMask;
+}
+
+#if PAL_HAS_CPUID
+// =====================================================================================================================
+// Reduces two RBs (four counters) per iteration. Each 256-bit load holds the begin and end counters of two RBs; the
+// begin counters are negated so that a single running sum yields the total z-pass delta. Slots which aren't entirely
+// ready are handed to the scalar path so that partial results match it exactly.
+PAL_TARGET_AVX2
+static uint64 ReduceSlotsAvx2(
+    const void* pGpuData,
+    size_t      slotSize,
+    uint32      numTotalRbs,
+    uint32      slotCount,
+    uint64*     pSums)
+{
+    const __m256i zero      = _mm256_setzero_si256();
+    const __m256i validMask = _mm256_set1_epi64x(static_cast<int64>(0x8000000000000000ull));
+    const __m256i countMask = _mm256_set1_epi64x(static_cast<int64>(0x7FFFFFFFFFFFFFFFull));
+    // Used to pad an odd RB count: valid, no unwritten halves and an end - begin delta of zero.
+    const __m128i padPair   = _mm_set1_epi64x(static_cast<int64>(0x8000000100000001ull));
+
+    uint64 readyMask = 0;
+
+    for (uint32 slot = 0; slot < slotCount; slot++)
+    {
+        const auto* pRbCounters = static_cast<const OcclusionQueryResultPair*>(VoidPtrInc(pGpuData, slot * slotSize));
+
+        __m256i sum   = zero;
+        __m256i valid = validMask;
+
+        // The write from the HW isn't atomic at the host/CPU level so we can end up with half the data. If any half
+        // looks unwritten, insert a memory barrier and read the slot once more, just like IsQueryDataValid.
+        for (uint32 pass = 0; pass < 2; pass++)
+        {
+            __m256i halfZero = zero;
+
+            sum   = zero;
+            valid = validMask;
+
+            for (uint32 rb = 0; rb < numTotalRbs; rb += 2)
+            {
+                const __m256i data = ((rb + 1) < numTotalRbs)
+                    ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pRbCounters + rb))
+                    : _mm256_inserti128_si256(
+                          _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pRbCounters + rb))),
+                          padPair,
+                          1);
+
+                const __m256i counts = _mm256_and_si256(data, countMask);
+
+                valid    = _mm256_and_si256(valid, data);
+                halfZero = _mm256_or_si256(halfZero, _mm256_cmpeq_epi32(data, zero));
+
+                // Lanes 0 and 2 hold begin counters, lanes 1 and 3 hold end counters.
+                sum = _mm256_add_epi64(sum, _mm256_blend_epi32(counts, _mm256_sub_epi64(zero, counts), 0x33));
+            }
+
+            if (_mm256_testz_si256(halfZero, halfZero) != 0)
+            {
+                break;
+            }
+
+            Util::MemoryBarrier();
+        }
+
+        if (_mm256_movemask_pd(_mm256_castsi256_pd(valid)) == 0xF)
+        {
+            const __m128i halves = _mm_add_epi64(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+
+            pSums[slot] = static_cast<uint64>(_mm_cvtsi128_si64(halves)) +
+                          static_cast<uint64>(_mm_extract_epi64(halves, 1));
+            readyMask  |= (1ull << slot);
+        }
+        else if (ReduceSlotScalar(pRbCounters, numTotalRbs, &pSums[slot]))
+        {
+            // The GPU finished writing the slot between the two reads.
+            readyMask |= (1ull << slot);
+        }
     }
 
+    return readyMask;
+}
+#endif
+
+// =====================================================================================================================
+static ReduceSlotsFunc SelectReduceSlotsKernel()
+{
+    ReduceSlotsFunc pfnReduceSlots = &ReduceSlotsScalar;
+
+#if PAL_HAS_CPUID
+    if (CpuSupportsFeature(CpuFeature::Avx2))
+    {
+        pfnReduceSlots = &ReduceSlotsAvx2;
+    }
+#endif
+
+    return pfnReduceSlots;
+}
+
+// =====================================================================================================================
+// Helper function for ComputeResults. It stores the result data for one slot according to the given flags, storing all
+// data in integers of type ResultUint.
+template <typename ResultUint>
+static void StoreResultsForOneSlot(
+    QueryResultFlags flags,
+    bool             isBinary,
+    uint64           sum,
+    bool             queryReady,
+    ResultUint*      pOutputBuffer)
+{
+    ResultUint result = static_cast<ResultUint>(sum);
+
     // Store the result in the output buffer if it's legal for us to do so.
     if (queryReady || TestAnyFlagSet(flags, QueryResultPartial))
     {
@@ -496,14 +637,12 @@ static bool ComputeResultsForOneSlot(
 
         pOutputBuffer[1] = queryReady;
     }
-
-    return queryReady;
 }
 
 // =====================================================================================================================
 // Adds up all the results from each RB (stored in pGpuData) and puts the accumulated result in the memory pointed to in
-// pData. This function wraps a template function to reduce code duplication due to selecting between 32-bit and 64-bit
-// results. Returns true if all counters were ready.
+// pData. The RB counters of up to MaxReduceSlots slots are reduced at once; slots which aren't ready are then polled
+// with a backoff if the caller asked us to wait for them. Returns true if all counters were ready.
 bool OcclusionQueryPool::ComputeResults(
     QueryResultFlags flags,
     QueryType        queryType,
@@ -514,21 +653,51 @@ bool OcclusionQueryPool::ComputeResults(
 {
     PAL_ASSERT((queryType == QueryType::Occlusion) || (queryType == QueryType::BinaryOcclusion));
 
+    static const ReduceSlotsFunc pfnReduceSlots = SelectReduceSlotsKernel();
+
     const uint32 numTotalRbs = m_device.Parent()->ChipProperties().gfx9.numTotalRbs;
     const bool   isBinary    = (queryType == QueryType::BinaryOcclusion);
+    const size_t slotSize    = GetGpuResultSizeInBytes(1);
 
     bool allQueriesReady = true;
-    for (uint32 queryIdx = 0; queryIdx < queryCount; ++queryIdx)
+    for (uint32 batchStart = 0; batchStart < queryCount; batchStart += MaxReduceSlots)
     {
-        const auto* pRbCounters = static_cast<const OcclusionQueryResultPair*>(pGpuData);
+        const uint32 batchCount = Min(queryCount - batchStart, MaxReduceSlots);
+        uint64       sums[MaxReduceSlots];
+
+        const uint64 readyMask = pfnReduceSlots(pGpuData, slotSize, numTotalRbs, batchCount, &sums[0]);
+
+        for (uint32 slot = 0; slot < batchCount; slot++)
+        {
+            bool queryReady = (((readyMask >> slot) & 1) != 0);
+
+            if ((queryReady == false) && TestAnyFlagSet(flags, QueryResultWait))
+            {
+                const auto* pRbCounters =
+                    static_cast<const OcclusionQueryResultPair*>(VoidPtrInc(pGpuData, slot * slotSize));
 
-        const bool queryReady = ((TestAnyFlagSet(flags, QueryResult64Bit))
-            ? ComputeResultsForOneSlot(flags, numTotalRbs, isBinary, pRbCounters, static_cast<uint64*>(pData))
-            : ComputeResultsForOneSlot(flags, numTotalRbs, isBinary, pRbCounters, static_cast<uint32*>(pData)));
+                // We will loop here for as long as necessary since the caller has requested it.
+                for (uint32 pollCount = 0; queryReady == false; pollCount++)
+                {
+                    WaitBackoff(pollCount);
+                    queryReady = ReduceSlotScalar(pRbCounters, numTotalRbs, &sums[slot]);
+                }
+            }
+
+            if (TestAnyFlagSet(flags, QueryResult64Bit))
+            {
+                StoreResultsForOneSlot(flags, isBinary, sums[slot], queryReady, static_cast<uint64*>(pData));
+            }
+            else
+            {
+                StoreResultsForOneSlot(flags, isBinary, sums[slot], queryReady, static_cast<uint32*>(pData));
+            }
+
+            allQueriesReady = allQueriesReady && queryReady;
+            pData           = VoidPtrInc(pData, stride);
+        }
 
-        allQueriesReady = allQueriesReady && queryReady;
-        pGpuData        = VoidPtrInc(pGpuData, GetGpuResultSizeInBytes(1));
-        pData           = VoidPtrInc(pData,    stride);
+        pGpuData = VoidPtrInc(pGpuData, batchCount * slotSize);
     }
 
     return allQueriesReady;
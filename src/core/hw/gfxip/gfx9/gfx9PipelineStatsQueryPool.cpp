@@ -477,9 +477,16 @@ static bool ComputeResultsForOneSlot(
         {
             const uint32 counterOffset = PipelineStatsLayout[layoutIdx].counterOffset;
             bool         countersReady = false;
+            uint32       pollCount     = 0;
 
             do
             {
+                if (pollCount > 0)
+                {
+                    QueryPool::WaitBackoff(pollCount - 1);
+                }
+                pollCount++;
+
                 // If the initial value is still in one of the counters it implies that the query hasn't finished yet.
                 // We will loop here for as long as necessary if the caller has requested it.
                 countersReady = IsQueryDataValid(&pBeginCounters[counterOffset]) &&
@@ -94,7 +94,7 @@ Result ShaderLibrary::HwlInit(
     const auto&              regInfo   = cmdUtil.GetRegInfo();
     const GpuChipProperties& chipProps = m_pDevice->Parent()->ChipProperties();
 
-    RegisterVector registers(m_pDevice->GetPlatform());
+    RegisterVector registers;
     Result result = pMetadataReader->Seek(metadata.pipeline.registers);
 
     if (result == Result::Success)
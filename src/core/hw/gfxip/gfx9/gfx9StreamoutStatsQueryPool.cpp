@@ -400,9 +400,16 @@ bool StreamoutStatsQueryPool::ComputeResults(
         const StreamoutStatsDataPair* pDataPair = static_cast<const StreamoutStatsDataPair*>(pGpuData);
         StreamoutStatsData* pQueryData = static_cast<StreamoutStatsData*>(pData);
 
-        bool countersReady = false;
+        bool   countersReady = false;
+        uint32 pollCount     = 0;
         do
         {
+            if (pollCount > 0)
+            {
+                WaitBackoff(pollCount - 1);
+            }
+            pollCount++;
+
             // Check if 64bit data is valid first,
             // then AND all 4 counters together and check whether the 63rd bit is 1 or not
             countersReady = IsQueryDataValid(&pDataPair->end.primCountWritten)    &&
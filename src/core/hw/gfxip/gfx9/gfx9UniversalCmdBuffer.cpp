@@ -294,6 +294,7 @@ UniversalCmdBuffer::UniversalCmdBuffer(
     m_activeOcclusionQueryWriteRanges(m_device.GetPlatform()),
     m_gangedCmdStreamSemAddr(0),
     m_barrierCount(0),
+    m_pBarrierCoalescer(nullptr),
     m_meshPipeStatsGpuAddr(0)
 {
     const auto&                palDevice        = *(m_device.Parent());
@@ -356,6 +357,9 @@ UniversalCmdBuffer::UniversalCmdBuffer(
     m_cachedSettings.waLegacyGsCutModeFlush                    = settings.waLegacyGsCutModeFlush;
     m_cachedSettings.supportsVrs                               = chipProps.gfxip.supportsVrs;
     m_cachedSettings.vrsForceRateFine                          = settings.vrsForceRateFine;
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    m_cachedSettings.coalesceBarriers                          = palDevice.GetPublicSettings()->coalesceBarriers;
+#endif
 
     // Here we pre-calculate constants used in gfx10 PBB bin sizing calculations.
     // The logic is based on formulas that account for the number of RBs and Channels on the ASIC.
@@ -473,6 +477,12 @@ UniversalCmdBuffer::UniversalCmdBuffer(
 UniversalCmdBuffer::~UniversalCmdBuffer()
 {
     PAL_SAFE_DELETE(m_pAceCmdStream, m_device.GetPlatform());
+
+    if (m_pBarrierCoalescer != nullptr)
+    {
+        ReportBarrierCoalescerStats();
+        PAL_SAFE_DELETE(m_pBarrierCoalescer, m_device.GetPlatform());
+    }
 }
 
 // =====================================================================================================================
@@ -509,6 +519,16 @@ Result UniversalCmdBuffer::Init(
         result = m_ceCmdStream.Init();
     }
 
+    if ((result == Result::Success) && m_cachedSettings.coalesceBarriers)
+    {
+        m_pBarrierCoalescer = PAL_NEW(BarrierCoalescer, m_device.GetPlatform(), AllocInternal)();
+
+        if (m_pBarrierCoalescer == nullptr)
+        {
+            result = Result::ErrorOutOfMemory;
+        }
+    }
+
     return result;
 }
 
@@ -772,6 +792,12 @@ void UniversalCmdBuffer::ResetState()
     m_gangedCmdStreamSemAddr = 0;
     m_barrierCount = 0;
 
+    if (m_pBarrierCoalescer != nullptr)
+    {
+        ReportBarrierCoalescerStats();
+        m_pBarrierCoalescer->Reset();
+    }
+
     m_meshPipeStatsGpuAddr = 0;
 
 }
@@ -1479,6 +1505,30 @@ void UniversalCmdBuffer::CmdBarrier(
     }
 }
 
+// =====================================================================================================================
+// Returns the barrier coalescer if this command buffer coalesces back-to-back barriers, otherwise null. If pSyncStream
+// is non-null this also returns null unless the syncs written to that stream can be coalesced: work on the ganged ACE
+// stream can touch memory in between two DE barriers without writing anything to the DE stream.
+BarrierCoalescer* UniversalCmdBuffer::GetBarrierCoalescer(
+    const Pal::CmdStream* pSyncStream)
+{
+    bool canCoalesce = (m_pBarrierCoalescer != nullptr);
+
+    if (canCoalesce && (pSyncStream != nullptr))
+    {
+        canCoalesce = (pSyncStream == &m_deCmdStream) && ((m_pAceCmdStream == nullptr) || m_pAceCmdStream->IsEmpty());
+    }
+
+    return canCoalesce ? m_pBarrierCoalescer : nullptr;
+}
+
+// =====================================================================================================================
+// Adds the work the barrier coalescer eliminated since it was last reset to the device-wide totals.
+void UniversalCmdBuffer::ReportBarrierCoalescerStats() const
+{
+    m_device.AddBarrierCoalescerStats(m_pBarrierCoalescer->EliminatedSyncs(), m_pBarrierCoalescer->EliminatedFlushes());
+}
+
 // =====================================================================================================================
 void UniversalCmdBuffer::OptimizePipeAndCacheMaskForRelease(
     uint32* pStageMask,
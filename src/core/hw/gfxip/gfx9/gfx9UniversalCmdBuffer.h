@@ -26,6 +26,7 @@
 #pragma once
 
 #include "core/hw/gfxip/universalCmdBuffer.h"
+#include "core/hw/gfxip/gfx9/gfx9BarrierCoalescer.h"
 #include "core/hw/gfxip/gfx9/gfx9Chip.h"
 #include "core/hw/gfxip/gfx9/gfx9CmdStream.h"
 #include "core/hw/gfxip/gfx9/gfx9ComputeCmdBuffer.h"
@@ -260,7 +261,7 @@ union CachedSettings
 
         uint64 supportsVrs                               :  1;
         uint64 vrsForceRateFine                          :  1;
-        uint64 reserved7                                 :  1;
+        uint64 coalesceBarriers                          :  1; // True if back-to-back barriers are coalesced.
         uint64 reserved8                  :  9;
         uint64 reserved9                  :  1;
         uint64 reserved                   : 13;
@@ -546,6 +547,9 @@ public:
     Util::IntervalTree<gpusize, bool, Platform>* ActiveOcclusionQueryWriteRanges()
         { return &m_activeOcclusionQueryWriteRanges; }
 
+    BarrierCoalescer* GetBarrierCoalescer(const Pal::CmdStream* pSyncStream);
+    void ReportBarrierCoalescerStats() const;
+
     void CmdSetTriangleRasterStateInternal(
         const TriangleRasterStateParams& params,
         bool                             optimizeLinearDestGfxCopy);
@@ -1127,6 +1131,10 @@ private:
     gpusize m_gangedCmdStreamSemAddr;
     uint32  m_barrierCount;
 
+    // Removes redundant syncs from back-to-back barriers and memoizes layout transition decisions. Only allocated if
+    // the coalesceBarriers setting is enabled.
+    BarrierCoalescer* m_pBarrierCoalescer;
+
     // MS/TS pipeline stats query is emulated by shader. A 6-DWORD scratch memory chunk is needed to store for shader
     // to store the three counter values.
     gpusize m_meshPipeStatsGpuAddr;
@@ -79,7 +79,8 @@ GfxDevice::GfxDevice(
     m_waEnableDccCacheFlushAndInvalidate(false),
     m_waTcCompatZRange(false),
     m_degeneratePrimFilter(false),
-    m_pSettingsLoader(nullptr)
+    m_pSettingsLoader(nullptr),
+    m_deferRpmComputePipelines(false)
 {
     for (uint32 i = 0; i < QueueType::QueueTypeCount; i++)
     {
@@ -271,15 +272,22 @@ Result GfxDevice::CreateComputePipelineInternal(
 {
     Result result = Result::ErrorOutOfMemory;
 
-    void* pMemory = PAL_MALLOC(GetComputePipelineSize(createInfo, nullptr), GetPlatform(), allocType);
-
-    if (pMemory != nullptr)
+    if (m_deferRpmComputePipelines)
     {
-        result = CreateComputePipeline(createInfo, pMemory, true, reinterpret_cast<IPipeline**>(ppPipeline));
+        result = m_pRsrcProcMgr->DeferComputePipeline(createInfo, ppPipeline);
+    }
+    else
+    {
+        void* pMemory = PAL_MALLOC(GetComputePipelineSize(createInfo, nullptr), GetPlatform(), allocType);
 
-        if (result != Result::Success)
+        if (pMemory != nullptr)
         {
-            PAL_SAFE_FREE(pMemory, GetPlatform());
+            result = CreateComputePipeline(createInfo, pMemory, true, reinterpret_cast<IPipeline**>(ppPipeline));
+
+            if (result != Result::Success)
+            {
+                PAL_SAFE_FREE(pMemory, GetPlatform());
+            }
         }
     }
 
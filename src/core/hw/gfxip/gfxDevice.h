@@ -377,6 +377,11 @@ public:
         ComputePipeline**                ppPipeline,
         Util::SystemAllocType            allocType);
 
+    // While set, CreateComputePipelineInternal hands every pipeline to RsrcProcMgr::DeferComputePipeline instead of
+    // creating it. RsrcProcMgr sets this around the generated CreateRpmComputePipelines() to find the pipelines this
+    // device supports without creating any of them, so nothing else may create internal compute pipelines meanwhile.
+    void SetDeferRpmComputePipelines(bool defer) { m_deferRpmComputePipelines = defer; }
+
    virtual size_t GetShaderLibrarySize(
         const ShaderLibraryCreateInfo&  createInfo,
         Result*                         pResult) const = 0;
@@ -733,6 +738,8 @@ protected:
     bool    m_degeneratePrimFilter;
     ISettingsLoader*  m_pSettingsLoader;
 
+    bool    m_deferRpmComputePipelines;
+
     PAL_ALIGN(32) uint32 m_fastClearImageRefs[MaxNumFastClearImageRefs];
 
 private:
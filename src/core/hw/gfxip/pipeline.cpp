@@ -29,8 +29,10 @@
 #include "core/platform.h"
 #include "core/hw/gfxip/gfxDevice.h"
 #include "core/hw/gfxip/pipeline.h"
+#include "core/hw/gfxip/shaderLibrary.h"
 #include "palFile.h"
 #include "palEventDefs.h"
+#include "palPipelineAbiProcessorImpl.h"
 #include "palSysUtil.h"
 
 #include "core/devDriverUtil.h"
@@ -85,6 +87,14 @@ Pipeline::~Pipeline()
 {
     if (m_gpuMem.IsBound())
     {
+        // Our upload may still be waiting to be coalesced with others; it must reach the DMA queue before our memory
+        // can be handed out again.
+        if (m_uploadFenceToken != 0)
+        {
+            const Result result = m_pDevice->FlushPendingUpload(m_uploadFenceToken);
+            PAL_ASSERT(result == Result::Success);
+        }
+
         m_pDevice->MemMgr()->FreeGpuMem(m_gpuMem.Memory(), m_gpuMem.Offset());
         m_gpuMem.Update(nullptr, 0);
     }
@@ -536,6 +546,61 @@ void Pipeline::DumpPipelineElf(
 #endif
 }
 
+// =====================================================================================================================
+// Dumps the code objects of the shader libraries which this pipeline was linked with next to the pipeline's own ELF dump
+// so that the whole linked program can be inspected.  Each library ELF is re-emitted through the ABI processor, which
+// references the library's sections in place and streams them to the file in one pass.
+void Pipeline::DumpLinkedLibraryElfs(
+    const char*                 pPrefix,
+    const IShaderLibrary*const* ppLibraryList,
+    uint32                      libraryCount
+    ) const
+{
+#if PAL_ENABLE_PRINTS_ASSERTS
+    const PalSettings& settings = m_pDevice->Settings();
+    uint64 hashToDump = settings.pipelineElfLogConfig.logHash;
+    bool hashMatches = ((hashToDump == 0) || (m_info.internalPipelineHash.stable == hashToDump));
+
+    const bool dumpInternal  = settings.pipelineElfLogConfig.logInternal;
+    const bool dumpExternal  = settings.pipelineElfLogConfig.logExternal;
+    const bool dumpPipeline  =
+        (settings.logPipelineElf && hashMatches && ((dumpExternal && !IsInternal()) || (dumpInternal && IsInternal())));
+
+    for (uint32 idx = 0; dumpPipeline && (idx < libraryCount); ++idx)
+    {
+        const auto*const pLibrary = static_cast<const ShaderLibrary*>(ppLibraryList[idx]);
+
+        Abi::PipelineAbiProcessor<Platform> abiProcessor(m_pDevice->GetPlatform());
+
+        Result result = abiProcessor.LoadFromBufferNoCopy(pLibrary->CodeObjectBinary(),
+                                                          pLibrary->CodeObjectBinaryLen());
+
+        char fileName[512] = { };
+        Snprintf(&fileName[0],
+                 sizeof(fileName),
+                 "%s/%s_0x%016llX_Lib%u.elf",
+                 &settings.pipelineElfLogConfig.logDirectory[0],
+                 pPrefix,
+                 m_info.internalPipelineHash.stable,
+                 idx);
+
+        File file;
+
+        if (result == Result::Success)
+        {
+            result = file.Open(fileName, FileAccessWrite | FileAccessBinary);
+        }
+
+        if (result == Result::Success)
+        {
+            result = abiProcessor.SaveToSink(&file);
+        }
+
+        PAL_ALERT(result != Result::Success);
+    }
+#endif
+}
+
 // =====================================================================================================================
 void* SectionInfo::GetCpuMappedAddr(
     gpusize offset
@@ -655,24 +720,24 @@ Result PipelineUploader::UploadPipelineSections(
     size_t localOffset    = 0;
     while (bytesRemaining > 0)
     {
-        void* pEmbeddedData = nullptr;
-        size_t bytesCopied = m_pDevice->UploadUsingEmbeddedData(
+        void* pStagingData = nullptr;
+        size_t bytesCopied = m_pDevice->UploadUsingStagingMemory(
                                                         m_slotId,
                                                         m_pGpuMemory,
                                                         m_baseOffset + m_heapInvisUploadOffset,
                                                         bytesRemaining,
-                                                        &pEmbeddedData);
+                                                        &pStagingData);
 
         if (pChunks != nullptr)
         {
-            result = pChunks->AddCpuMappedChunk({pEmbeddedData, bytesCopied});
+            result = pChunks->AddCpuMappedChunk({pStagingData, bytesCopied});
             if (result != Result::Success)
             {
                 break;
             }
         }
 
-        memcpy(pEmbeddedData, VoidPtrInc(pSectionBuffer, localOffset), bytesCopied);
+        memcpy(pStagingData, VoidPtrInc(pSectionBuffer, localOffset), bytesCopied);
         localOffset             += bytesCopied;
         m_heapInvisUploadOffset += bytesCopied;
         bytesRemaining          -= bytesCopied;
@@ -186,6 +186,11 @@ protected:
         const char*         pPrefix,
         const char*         pName) const;
 
+    void DumpLinkedLibraryElfs(
+        const char*                 pPrefix,
+        const IShaderLibrary*const* ppLibraryList,
+        uint32                      libraryCount) const;
+
     size_t PerformanceDataSize(
         const CodeObjectMetadata& metadata) const;
 
@@ -27,6 +27,7 @@
 #include "core/eventDefs.h"
 #include "core/hw/gfxip/gfxCmdBuffer.h"
 #include "core/hw/gfxip/queryPool.h"
+#include "palSysUtil.h"
 
 using namespace Util;
 
@@ -47,7 +48,8 @@ QueryPool::QueryPool(
     m_timestampSizePerSlotInBytes(tsSizeInBytes),
     m_boundSizeInBytes((querySizeInBytes + tsSizeInBytes) * createInfo.numSlots),
     m_device(device),
-    m_timestampStartOffset(m_createInfo.numSlots * m_gpuResultSizePerSlotInBytes)
+    m_timestampStartOffset(m_createInfo.numSlots * m_gpuResultSizePerSlotInBytes),
+    m_pMappedGpuData(nullptr)
 {
     ResourceDescriptionQueryPool desc = {};
     desc.pCreateInfo = &m_createInfo;
@@ -62,6 +64,8 @@ QueryPool::QueryPool(
 // =====================================================================================================================
 QueryPool::~QueryPool()
 {
+    ReleaseGpuMemoryMap();
+
     ResourceDestroyEventData data = {};
     data.pObj = this;
     m_device.GetPlatform()->GetEventProvider()->LogGpuMemoryResourceDestroyEvent(data);
@@ -135,7 +139,7 @@ Result QueryPool::GetResults(
             {
                 if (pMappedGpuAddr == nullptr)
                 {
-                    result = m_gpuMemory.Map(&pGpuData);
+                    result = MapGpuMemory(&pGpuData);
                 }
                 else
                 {
@@ -158,7 +162,7 @@ Result QueryPool::GetResults(
                 if (pMappedGpuAddr == nullptr)
                 {
                     // Don't store the result from this as it will overwrite the result from retrieving the data.
-                    const Result unmapResult = m_gpuMemory.Unmap();
+                    const Result unmapResult = UnmapGpuMemory();
                     PAL_ASSERT(unmapResult == Result::Success);
                 }
             }
@@ -210,6 +214,9 @@ Result QueryPool::BindGpuMemory(
 
     if (result == Result::Success)
     {
+        // Any mapping we kept belongs to the previously bound memory.
+        ReleaseGpuMemoryMap();
+
         m_gpuMemory.Update(pGpuMemory, offset);
 
         GpuMemoryResourceBindEventData data = {};
@@ -245,6 +252,96 @@ void QueryPool::Reset(
     }
 }
 
+// =====================================================================================================================
+// Maps the bound GPU memory for CPU access. Pools which were created for CPU readback keep their mapping until the
+// memory is unbound or the pool is destroyed so that frequent GetResults() calls don't map and unmap the allocation
+// each time.
+Result QueryPool::MapGpuMemory(
+    void** ppGpuData)
+{
+    Result result = Result::Success;
+
+    if (m_createInfo.flags.enableCpuAccess)
+    {
+        void* pGpuData = m_pMappedGpuData;
+
+        if (pGpuData == nullptr)
+        {
+            MutexAuto lock(&m_mapMutex);
+
+            pGpuData = m_pMappedGpuData;
+
+            if (pGpuData == nullptr)
+            {
+                result = m_gpuMemory.Map(&pGpuData);
+
+                if (result == Result::Success)
+                {
+                    // Make sure the mapping is visible before other threads can observe the pointer.
+                    MemoryBarrier();
+                    m_pMappedGpuData = pGpuData;
+                }
+            }
+        }
+
+        if (result == Result::Success)
+        {
+            *ppGpuData = pGpuData;
+        }
+    }
+    else
+    {
+        result = m_gpuMemory.Map(ppGpuData);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Balances a call to MapGpuMemory().
+Result QueryPool::UnmapGpuMemory()
+{
+    return m_createInfo.flags.enableCpuAccess ? Result::Success : m_gpuMemory.Unmap();
+}
+
+// =====================================================================================================================
+// Drops the mapping kept by MapGpuMemory() for pools created for CPU readback, if there is one.
+void QueryPool::ReleaseGpuMemoryMap()
+{
+    MutexAuto lock(&m_mapMutex);
+
+    if (m_pMappedGpuData != nullptr)
+    {
+        const Result result = m_gpuMemory.Unmap();
+        PAL_ASSERT(result == Result::Success);
+
+        m_pMappedGpuData = nullptr;
+    }
+}
+
+// =====================================================================================================================
+// Waits between two polls of query data which the GPU hasn't finished writing. The first few polls spin, the next few
+// yield the rest of the time slice, and after that the thread sleeps for an exponentially increasing but bounded time
+// so that long waits don't burn a CPU core.
+void QueryPool::WaitBackoff(
+    uint32 pollCount)
+{
+    constexpr uint32 SpinPolls    = 64;
+    constexpr uint32 YieldPolls   = 64;
+    constexpr uint32 SleepPolls   = 16; // Number of sleeps between each doubling of the sleep time.
+    constexpr uint32 MaxSleepLog2 = 2;  // Never sleep for longer than 4ms between polls.
+
+    if (pollCount >= (SpinPolls + YieldPolls))
+    {
+        const uint32 sleepLog2 = Min((pollCount - SpinPolls - YieldPolls) / SleepPolls, MaxSleepLog2);
+        SleepMs(1u << sleepLog2);
+    }
+    else if (pollCount >= SpinPolls)
+    {
+        YieldThread();
+    }
+}
+
 // =====================================================================================================================
 // Reset this query pool with CPU.
 Result QueryPool::DoReset(
@@ -262,7 +359,7 @@ Result QueryPool::DoReset(
 
         if (pGpuData == nullptr)
         {
-            result = m_gpuMemory.Map(&pGpuData);
+            result = MapGpuMemory(&pGpuData);
         }
 
         if (result == Result::Success)
@@ -288,7 +385,7 @@ Result QueryPool::DoReset(
 
             if (pMappedCpuAddr == nullptr)
             {
-                result = m_gpuMemory.Unmap();
+                result = UnmapGpuMemory();
             }
         }
     }
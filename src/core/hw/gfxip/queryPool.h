@@ -26,6 +26,7 @@
 #pragma once
 
 #include "palCmdBuffer.h"
+#include "palMutex.h"
 #include "palQueryPool.h"
 #include "core/gpuMemory.h"
 
@@ -110,6 +111,9 @@ public:
 
     bool HasTimestamps() const { return (m_timestampSizePerSlotInBytes != 0); }
 
+    // Called between two polls of a query slot which isn't ready yet when the caller was asked to wait for it.
+    static void WaitBackoff(uint32 pollCount);
+
     virtual bool HasForcedQueryResult() const { return false; }
     virtual uint32 GetForcedQueryResult() const { return 0; }
 
@@ -134,6 +138,9 @@ protected:
 
     Result ValidateSlot(uint32 slot) const;
 
+    Result MapGpuMemory(void** ppGpuData);
+    Result UnmapGpuMemory();
+
     virtual size_t GetResultSizeForOneSlot(QueryResultFlags flags) const = 0;
     virtual bool ComputeResults(
         QueryResultFlags flags,
@@ -165,6 +172,11 @@ private:
                                                  // address when the End() is called. And in WaitForSlots() we wait for
                                                  // this timestamp.
 
+    void ReleaseGpuMemoryMap();
+
+    void* volatile m_pMappedGpuData;             // CPU mapping of the bound memory kept for pools with enableCpuAccess.
+    Util::Mutex    m_mapMutex;                   // Serializes creating and releasing m_pMappedGpuData.
+
     PAL_DISALLOW_COPY_AND_ASSIGN(QueryPool);
     PAL_DISALLOW_DEFAULT_CTOR(QueryPool);
 };
@@ -0,0 +1,219 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "core/device.h"
+#include "core/platform.h"
+#include "core/hw/gfxip/rpm/rpmPipelineUsageFile.h"
+#include "palAutoBuffer.h"
+#include "palFile.h"
+#include "palInlineFuncs.h"
+#include "palPlatformKey.h"
+
+using namespace Util;
+
+namespace Pal
+{
+
+constexpr uint32 UsageFileMagic   = 0x55505052; // "RPPU"
+constexpr uint32 UsageFileVersion = 1;          // Bump this whenever the meaning or layout of the file changes.
+
+struct UsageFileHeader
+{
+    uint32 magic;
+    uint32 version;
+    uint64 key;             // IPlatformKey digest of the PAL version and the device identity.
+    uint32 maskBytes;       // Size of the bitfield of used pipelines which follows this header.
+    uint32 reserved;
+};
+
+// =====================================================================================================================
+// Hashes everything which the file's contents depend on into a platform key.
+Result RpmPipelineUsageFile::ComputeKey(
+    uint64* pKey
+    ) const
+{
+    const GpuChipProperties& chipProps = m_device.ChipProperties();
+
+    const uint32 identity[] =
+    {
+        UsageFileVersion,
+        PAL_VERSION_NUMBER_MAJOR,
+        PAL_VERSION_NUMBER_MINOR,
+        PAL_CLIENT_INTERFACE_MAJOR_VERSION,
+        static_cast<uint32>(chipProps.gfxLevel),
+        chipProps.familyId,
+        chipProps.eRevId,
+        chipProps.revisionId,
+        chipProps.deviceId,
+    };
+
+    AutoBuffer<uint8, 1024, Platform> keyMemory(GetPlatformKeySize(HashAlgorithm::Sha1), m_device.GetPlatform());
+
+    IPlatformKey* pPlatformKey = nullptr;
+    Result        result       = Result::ErrorOutOfMemory;
+
+    if (keyMemory.Capacity() >= GetPlatformKeySize(HashAlgorithm::Sha1))
+    {
+        result = CreatePlatformKey(HashAlgorithm::Sha1,
+                                   const_cast<uint32*>(&identity[0]),
+                                   sizeof(identity),
+                                   &keyMemory[0],
+                                   &pPlatformKey);
+    }
+
+    if (result == Result::Success)
+    {
+        *pKey = pPlatformKey->GetKey64();
+        pPlatformKey->Destroy();
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Builds the name of this device's usage file.  Each kind of GPU gets its own file so that devices of different kinds
+// in one system don't keep replacing each other's file.
+void RpmPipelineUsageFile::GetFilePath(
+    const char* pBasePath,
+    char*       pFilePath,
+    size_t      bufferLength
+    ) const
+{
+    const GpuChipProperties& chipProps = m_device.ChipProperties();
+
+    Snprintf(pFilePath, bufferLength, "%s.%04x.%02x", pBasePath, chipProps.deviceId, chipProps.revisionId);
+}
+
+// =====================================================================================================================
+// Reads the set of used pipelines from this device's usage file.  Returns NotFound if the file doesn't exist and
+// ErrorIncompatibleLibrary if it was written by a different PAL version, for a different device or is damaged.  The
+// output is only written on success.
+Result RpmPipelineUsageFile::Load(
+    const char* pBasePath,
+    uint32*     pUsedPipelines,   // [out] Bitfield of the pipelines which the previous run used.
+    uint32      maskDwords
+    ) const
+{
+    char pFilePath[MaxPathStrLen];
+    GetFilePath(pBasePath, pFilePath, sizeof(pFilePath));
+
+    const uint32 maskBytes = maskDwords * sizeof(uint32);
+
+    Result result = File::Exists(pFilePath) ? Result::Success : Result::NotFound;
+
+    File            file;
+    UsageFileHeader header    = {};
+    uint64          key       = 0;
+    size_t          bytesRead = 0;
+
+    AutoBuffer<uint32, 8, Platform> usedPipelines(maskDwords, m_device.GetPlatform());
+
+    if ((result == Result::Success) && (usedPipelines.Capacity() < maskDwords))
+    {
+        result = Result::ErrorOutOfMemory;
+    }
+
+    if (result == Result::Success)
+    {
+        result = ComputeKey(&key);
+    }
+
+    if (result == Result::Success)
+    {
+        result = file.Open(pFilePath, FileAccessRead | FileAccessBinary);
+    }
+
+    if (result == Result::Success)
+    {
+        result = file.Read(&header, sizeof(header), &bytesRead);
+    }
+
+    if ((result == Result::Success) &&
+        ((bytesRead        != sizeof(header))   ||
+         (header.magic     != UsageFileMagic)   ||
+         (header.version   != UsageFileVersion) ||
+         (header.key       != key)              ||
+         (header.maskBytes != maskBytes)        ||
+         (File::GetFileSize(pFilePath) != (sizeof(header) + maskBytes))))
+    {
+        result = Result::ErrorIncompatibleLibrary;
+    }
+
+    if (result == Result::Success)
+    {
+        result = file.Read(&usedPipelines[0], maskBytes, &bytesRead);
+    }
+
+    if ((result == Result::Success) && (bytesRead != maskBytes))
+    {
+        result = Result::ErrorIncompatibleLibrary;
+    }
+
+    if (result == Result::Success)
+    {
+        memcpy(pUsedPipelines, &usedPipelines[0], maskBytes);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Writes the set of used pipelines to this device's usage file, replacing the file if it already exists.
+Result RpmPipelineUsageFile::Save(
+    const char*   pBasePath,
+    const uint32* pUsedPipelines,
+    uint32        maskDwords
+    ) const
+{
+    char pFilePath[MaxPathStrLen];
+    GetFilePath(pBasePath, pFilePath, sizeof(pFilePath));
+
+    UsageFileHeader header = {};
+    header.magic     = UsageFileMagic;
+    header.version   = UsageFileVersion;
+    header.maskBytes = maskDwords * sizeof(uint32);
+
+    File   file;
+    Result result = ComputeKey(&header.key);
+
+    if (result == Result::Success)
+    {
+        result = file.Open(pFilePath, FileAccessWrite | FileAccessBinary);
+    }
+
+    if (result == Result::Success)
+    {
+        result = file.Write(&header, sizeof(header));
+    }
+
+    if (result == Result::Success)
+    {
+        result = file.Write(pUsedPipelines, header.maskBytes);
+    }
+
+    return result;
+}
+
+} // Pal
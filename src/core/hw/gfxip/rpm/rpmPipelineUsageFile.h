@@ -0,0 +1,62 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#pragma once
+
+#include "pal.h"
+
+namespace Pal
+{
+
+class Device;
+
+// =====================================================================================================================
+// Records which RPM compute pipelines a device used, so that the next process which creates the same kind of device
+// can create just those pipelines ahead of time and leave the rest for first use.  Each device reads and writes its own
+// small versioned file, named by appending the device's PCI device ID and revision to the configured path.  Each file
+// is also keyed by an IPlatformKey digest of the PAL version and the device's identity; files with a different key or
+// format version are rejected.
+//
+// The restored set must only ever be used as a hint: a missing or stale file must not change behavior.
+class RpmPipelineUsageFile
+{
+public:
+    explicit RpmPipelineUsageFile(const Device& device) : m_device(device) { }
+    ~RpmPipelineUsageFile() { }
+
+    Result Load(const char* pBasePath, uint32* pUsedPipelines, uint32 maskDwords) const;
+    Result Save(const char* pBasePath, const uint32* pUsedPipelines, uint32 maskDwords) const;
+
+private:
+    Result ComputeKey(uint64* pKey) const;
+    void   GetFilePath(const char* pBasePath, char* pFilePath, size_t bufferLength) const;
+
+    const Device& m_device;
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(RpmPipelineUsageFile);
+    PAL_DISALLOW_DEFAULT_CTOR(RpmPipelineUsageFile);
+};
+
+} // Pal
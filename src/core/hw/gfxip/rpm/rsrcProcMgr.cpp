@@ -35,6 +35,7 @@
 #include "core/hw/gfxip/gfxDevice.h"
 #include "core/hw/gfxip/indirectCmdGenerator.h"
 #include "core/hw/gfxip/msaaState.h"
+#include "core/hw/gfxip/rpm/rpmPipelineUsageFile.h"
 #include "core/hw/gfxip/rpm/rpmUtil.h"
 #include "core/hw/gfxip/rpm/rsrcProcMgr.h"
 #include "core/hw/gfxip/universalCmdBuffer.h"
@@ -46,6 +47,7 @@
 #include "palFormatInfo.h"
 #include "palMsaaState.h"
 #include "palInlineFuncs.h"
+#include "palSysUtil.h"
 
 #include <float.h>
 #include <math.h>
@@ -81,17 +83,26 @@ RsrcProcMgr::RsrcProcMgr(
     m_pStencilResolveState(nullptr),
     m_pDepthStencilResolveState(nullptr),
     m_pDevice(pDevice),
-    m_srdAlignment(0)
+    m_srdAlignment(0),
+    m_deferComputePipelines(false),
+    m_numPrewarmThreads(0),
+    m_prewarmNextPipeline(0)
 {
     memset(&m_pMsaaState[0], 0, sizeof(m_pMsaaState));
     memset(&m_pComputePipelines[0], 0, sizeof(m_pComputePipelines));
     memset(&m_pGraphicsPipelines[0], 0, sizeof(m_pGraphicsPipelines));
+    memset(&m_deferredComputePipelines[0], 0, sizeof(m_deferredComputePipelines));
+    memset(const_cast<uint32*>(&m_computePipelineState[0]), 0, sizeof(m_computePipelineState));
+    memset(&m_prewarmPipelines[0], 0, sizeof(m_prewarmPipelines));
+    memset(const_cast<uint32*>(&m_usedComputePipelines[0]), 0, sizeof(m_usedComputePipelines));
 }
 
 // =====================================================================================================================
 RsrcProcMgr::~RsrcProcMgr()
 {
     // These objects must be destroyed in Cleanup().
+    PAL_ASSERT(m_numPrewarmThreads == 0);
+
     for (uint32 idx = 0; idx < static_cast<uint32>(RpmComputePipeline::Count); ++idx)
     {
         PAL_ASSERT(m_pComputePipelines[idx] == nullptr);
@@ -128,6 +139,16 @@ RsrcProcMgr::~RsrcProcMgr()
 // this object.
 void RsrcProcMgr::Cleanup()
 {
+    // The pre-warm threads may still be creating pipelines, so they must finish before anything is destroyed.
+    StopPrewarmThreads();
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    if (m_deferComputePipelines)
+    {
+        SaveUsedPipelines();
+    }
+#endif
+
     // Destroy all compute pipeline objects.
     for (uint32 idx = 0; idx < static_cast<uint32>(RpmComputePipeline::Count); ++idx)
     {
@@ -136,8 +157,16 @@ void RsrcProcMgr::Cleanup()
             m_pComputePipelines[idx]->DestroyInternal();
             m_pComputePipelines[idx] = nullptr;
         }
+
+        m_deferredComputePipelines[idx] = { };
+        m_computePipelineState[idx]     = DeferredPipelinePending;
     }
 
+    memset(&m_prewarmPipelines[0], 0, sizeof(m_prewarmPipelines));
+    memset(const_cast<uint32*>(&m_usedComputePipelines[0]), 0, sizeof(m_usedComputePipelines));
+
+    m_deferComputePipelines = false;
+
     // Destroy all graphics pipeline objects.
     for (uint32 idx = 0; idx < RpmGfxPipelineCount; ++idx)
     {
@@ -205,10 +234,24 @@ Result RsrcProcMgr::LateInit()
 {
     Result result = Result::Success;
 
-    if (m_pDevice->Parent()->GetPublicSettings()->disableResourceProcessingManager == false)
+    const PalPublicSettings& publicSettings = *m_pDevice->Parent()->GetPublicSettings();
+
+    if (publicSettings.disableResourceProcessingManager == false)
     {
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+        // In the deferred modes only the binaries of the supported compute pipelines are looked up here; each pipeline
+        // is created by the first call to GetPipeline() which needs it.
+        m_deferComputePipelines = (publicSettings.rpmPipelineCreateMode != RpmPipelineCreateMode::Immediate);
+#endif
+
+        // The generated CreateRpmComputePipelines() picks the pipelines this device supports. When deferring, the
+        // device saves the create info of each of them instead of creating it.
+        m_pDevice->SetDeferRpmComputePipelines(m_deferComputePipelines);
+
         result = CreateRpmComputePipelines(m_pDevice, m_pComputePipelines);
 
+        m_pDevice->SetDeferRpmComputePipelines(false);
+
         if (result == Result::Success)
         {
             result = CreateRpmGraphicsPipelines(m_pDevice, m_pGraphicsPipelines);
@@ -219,11 +262,278 @@ Result RsrcProcMgr::LateInit()
             result = CreateCommonStateObjects();
         }
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+        if ((result == Result::Success) && m_deferComputePipelines)
+        {
+            // The usage file from a previous run narrows pre-warming down to the pipelines that run used, in both
+            // deferred modes.  Without one, the Prewarm mode pre-warms every pipeline and OnFirstUse pre-warms none.
+            const bool restored = RestoreUsedPipelines();
+
+            if ((restored == false) && (publicSettings.rpmPipelineCreateMode == RpmPipelineCreateMode::Prewarm))
+            {
+                memset(&m_prewarmPipelines[0], 0xFF, sizeof(m_prewarmPipelines));
+            }
+
+            if (restored || (publicSettings.rpmPipelineCreateMode == RpmPipelineCreateMode::Prewarm))
+            {
+                result = StartPrewarmThreads();
+            }
+        }
+#endif
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Saves the create info of one of our compute pipelines instead of creating it. The generated CreateRpmComputePipelines()
+// identifies each pipeline by where it stores it in m_pComputePipelines.
+Result RsrcProcMgr::DeferComputePipeline(
+    const ComputePipelineCreateInfo& createInfo,
+    ComputePipeline**                ppPipeline)
+{
+    PAL_ASSERT(m_deferComputePipelines);
+
+    const size_t index  = ppPipeline - &m_pComputePipelines[0];
+    Result       result = Result::ErrorInvalidValue;
+
+    if (index < static_cast<size_t>(RpmComputePipeline::Count))
+    {
+        m_deferredComputePipelines[index] = createInfo;
+
+        (*ppPipeline) = nullptr;
+        result        = Result::Success;
+    }
+    else
+    {
+        PAL_ASSERT_ALWAYS_MSG("Only RPM compute pipelines can be deferred.");
     }
 
     return result;
 }
 
+// =====================================================================================================================
+// Implements GetPipeline() when compute pipelines are created on first use. The callers have no way to handle a missing
+// pipeline, so if the first attempt fails (most likely because the pre-warm threads are using the memory it needed) the
+// pre-warm threads are stopped and the pipeline is created again on this thread. Only if that also fails, which would
+// have failed LateInit had the pipeline been created up front, is null returned.
+const ComputePipeline* RsrcProcMgr::GetPipelineOnFirstUse(
+    RpmComputePipeline pipeline
+    ) const
+{
+    Result                 result    = Result::Success;
+    const ComputePipeline* pPipeline = GetDeferredPipeline(pipeline, true, &result);
+
+    if (pPipeline == nullptr)
+    {
+        const_cast<RsrcProcMgr*>(this)->StopPrewarmThreads();
+
+        pPipeline = GetDeferredPipeline(pipeline, true, &result);
+
+        if (pPipeline == nullptr)
+        {
+            PAL_ASSERT_ALWAYS_MSG("RPM compute pipeline %u could not be created on first use (result %d).",
+                                  static_cast<uint32>(pipeline),
+                                  static_cast<int32>(result));
+        }
+    }
+
+    return pPipeline;
+}
+
+// =====================================================================================================================
+// Returns the given compute pipeline when compute pipelines are created on first use, creating it if this is the first
+// time it has been requested. Exactly one caller creates each pipeline; any other thread which requests the pipeline
+// while it is being created waits for the creation to finish. If creation fails the pipeline goes back to the pending
+// state so that a later request tries again, the error is returned in pResult (if non-null) and null is returned.
+const ComputePipeline* RsrcProcMgr::GetDeferredPipeline(
+    RpmComputePipeline pipeline,
+    bool               markUsed,    // Set if the pipeline is going to be used, rather than just pre-warmed.
+    Result*            pResult      // [out] Optional. Result of creating the pipeline, if this call created it.
+    ) const
+{
+    const uint32 index   = static_cast<uint32>(pipeline);
+    const uint32 usedBit = 1u << (index % 32);
+
+    // Check first so that the common case doesn't need an atomic operation.
+    if (markUsed && ((m_usedComputePipelines[index / 32] & usedBit) == 0))
+    {
+        AtomicOr(&m_usedComputePipelines[index / 32], usedBit);
+    }
+
+    volatile uint32*const pState = &m_computePipelineState[index];
+    Result                result = Result::Success;
+
+    while (*pState != DeferredPipelineReady)
+    {
+        if (AtomicCompareAndSwap(pState, DeferredPipelinePending, DeferredPipelineCreating) == DeferredPipelinePending)
+        {
+            if (m_deferredComputePipelines[index].pPipelineBinary != nullptr)
+            {
+                result = m_pDevice->CreateComputePipelineInternal(m_deferredComputePipelines[index],
+                                                                  &m_pComputePipelines[index],
+                                                                  AllocInternal);
+            }
+
+            // The exchange is a full barrier which publishes the new pipeline before any thread can see it as ready.
+            AtomicExchange(pState, (result == Result::Success) ? DeferredPipelineReady : DeferredPipelinePending);
+
+            if (result != Result::Success)
+            {
+                PAL_ALERT_ALWAYS_MSG("Failed to create RPM compute pipeline %u (result %d).",
+                                     index,
+                                     static_cast<int32>(result));
+                break;
+            }
+        }
+        else
+        {
+            // Another thread is creating the pipeline. If it fails, the state goes back to pending and this thread
+            // makes its own attempt.
+            YieldThread();
+        }
+    }
+
+    if (pResult != nullptr)
+    {
+        *pResult = result;
+    }
+
+    // Make sure the pipeline pointer isn't read before the creation state.
+    MemoryBarrier();
+
+    return (result == Result::Success) ? m_pComputePipelines[index] : nullptr;
+}
+
+// =====================================================================================================================
+// Starts the threads which create all deferred compute pipelines in parallel, ahead of their first use.
+Result RsrcProcMgr::StartPrewarmThreads()
+{
+    PAL_ASSERT(m_deferComputePipelines && (m_numPrewarmThreads == 0));
+
+    Result result = Result::Success;
+
+    // Leave one core for the client's own initialization.
+    SystemInfo systemInfo = { };
+    uint32     numThreads = 1;
+
+    if ((QuerySystemInfo(&systemInfo) == Result::Success) && (systemInfo.cpuLogicalCoreCount > 2))
+    {
+        numThreads = Min(systemInfo.cpuLogicalCoreCount - 1, MaxPrewarmThreads);
+    }
+
+    m_prewarmNextPipeline = 0;
+
+    for (uint32 idx = 0; (result == Result::Success) && (idx < numThreads); ++idx)
+    {
+        result = m_prewarmThreads[idx].Begin(&PrewarmThreadFunc, this);
+
+        if (result == Result::Success)
+        {
+            m_numPrewarmThreads++;
+        }
+    }
+
+    // Pre-warming is only an optimization; the pipelines which aren't pre-warmed will still be created on first use.
+    if (m_numPrewarmThreads > 0)
+    {
+        result = Result::Success;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Stops the pre-warm threads (if any) and waits for them to finish creating their current pipelines. This is safe to
+// call from any thread other than a pre-warm thread.
+void RsrcProcMgr::StopPrewarmThreads()
+{
+    // Any number of threads may fail to create a pipeline on first use and stop the pre-warm threads at the same time.
+    MutexAuto lock(&m_prewarmThreadMutex);
+
+    // Claim every remaining pipeline so the pre-warm threads stop picking up new work.
+    AtomicExchange(&m_prewarmNextPipeline, static_cast<uint32>(RpmComputePipeline::Count));
+
+    for (uint32 idx = 0; idx < m_numPrewarmThreads; ++idx)
+    {
+        m_prewarmThreads[idx].Join();
+    }
+
+    m_numPrewarmThreads = 0;
+}
+
+// =====================================================================================================================
+// Entry point for the pre-warm threads: repeatedly claims the next compute pipeline and creates it.
+void RsrcProcMgr::PrewarmThreadFunc(
+    void* pThis)
+{
+    RsrcProcMgr*const pRsrcProcMgr = static_cast<RsrcProcMgr*>(pThis);
+
+    constexpr uint32 PipelineCount = static_cast<uint32>(RpmComputePipeline::Count);
+
+    for (uint32 index = AtomicIncrement(&pRsrcProcMgr->m_prewarmNextPipeline) - 1;
+         index < PipelineCount;
+         index = AtomicIncrement(&pRsrcProcMgr->m_prewarmNextPipeline) - 1)
+    {
+        if (WideBitfieldIsSet(pRsrcProcMgr->m_prewarmPipelines, index))
+        {
+            Result result = Result::Success;
+            pRsrcProcMgr->GetDeferredPipeline(static_cast<RpmComputePipeline>(index), false, &result);
+
+            // A pipeline which failed to pre-warm is left pending and will be retried on first use. There's no point
+            // in trying more pipelines if we've run out of memory.
+            if (result == Result::ErrorOutOfMemory)
+            {
+                break;
+            }
+        }
+    }
+}
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+// =====================================================================================================================
+// Loads the set of compute pipelines which the previous run used from the RPM pipeline usage file into the set of
+// pipelines to pre-warm.  Returns false if there is no usable file.
+bool RsrcProcMgr::RestoreUsedPipelines()
+{
+    const char*const pBasePath = m_pDevice->Parent()->GetPublicSettings()->rpmPipelineUsagePath;
+
+    bool restored = false;
+
+    if (pBasePath[0] != '\0')
+    {
+        const RpmPipelineUsageFile usageFile(*m_pDevice->Parent());
+
+        restored = (usageFile.Load(pBasePath, &m_prewarmPipelines[0], PipelineMaskDwords) == Result::Success);
+    }
+
+    return restored;
+}
+
+// =====================================================================================================================
+// Saves the set of compute pipelines which this run used to the RPM pipeline usage file.
+void RsrcProcMgr::SaveUsedPipelines() const
+{
+    const char*const pBasePath = m_pDevice->Parent()->GetPublicSettings()->rpmPipelineUsagePath;
+
+    if (pBasePath[0] != '\0')
+    {
+        uint32 usedPipelines[PipelineMaskDwords];
+        for (uint32 idx = 0; idx < PipelineMaskDwords; ++idx)
+        {
+            usedPipelines[idx] = m_usedComputePipelines[idx];
+        }
+
+        const RpmPipelineUsageFile usageFile(*m_pDevice->Parent());
+
+        const Result result = usageFile.Save(pBasePath, &usedPipelines[0], PipelineMaskDwords);
+
+        // The file is only a hint for the next run, so failing to write it isn't an error.
+        PAL_ALERT(result != Result::Success);
+    }
+}
+#endif
+
 // =====================================================================================================================
 // Builds commands to copy one or more regions from one GPU memory location to another with a compute shader.
 void RsrcProcMgr::CopyMemoryCs(
@@ -28,6 +28,8 @@
 #include "core/hw/gfxip/rpm/g_rpmComputePipelineInit.h"
 #include "core/hw/gfxip/rpm/g_rpmGfxPipelineInit.h"
 #include "palCmdBuffer.h"
+#include "palMutex.h"
+#include "palThread.h"
 
 namespace Pal
 {
@@ -97,6 +99,10 @@ public:
     Result LateInit();
     void Cleanup();
 
+    // Called by GfxDevice::CreateComputePipelineInternal for each of our compute pipelines while LateInit has deferral
+    // turned on. Saves the create info so the pipeline can be created later.
+    Result DeferComputePipeline(const ComputePipelineCreateInfo& createInfo, ComputePipeline** ppPipeline);
+
     void CmdCopyImage(
         GfxCmdBuffer*          pCmdBuffer,
         const Image&           srcImage,
@@ -349,7 +355,10 @@ protected:
         const CmdBuffer&            cmdBuffer) const = 0;
 
     const ComputePipeline* GetPipeline(RpmComputePipeline pipeline) const
-        { return m_pComputePipelines[static_cast<size_t>(pipeline)]; }
+    {
+        return m_deferComputePipelines ? GetPipelineOnFirstUse(pipeline)
+                                       : m_pComputePipelines[static_cast<size_t>(pipeline)];
+    }
 
     const GraphicsPipeline* GetGfxPipeline(RpmGfxPipeline pipeline) const
         { return m_pGraphicsPipelines[pipeline]; }
@@ -724,9 +733,49 @@ private:
     GfxDevice*const  m_pDevice;
     uint32           m_srdAlignment; // All SRDs must be offset and size aligned to this many DWORDs.
 
-    // All internal RPM pipelines are stored here.
-    ComputePipeline*   m_pComputePipelines[static_cast<size_t>(RpmComputePipeline::Count)];
-    GraphicsPipeline*  m_pGraphicsPipelines[RpmGfxPipelineCount];
+    const ComputePipeline* GetDeferredPipeline(RpmComputePipeline pipeline, bool markUsed, Result* pResult) const;
+    const ComputePipeline* GetPipelineOnFirstUse(RpmComputePipeline pipeline) const;
+
+    Result StartPrewarmThreads();
+    void   StopPrewarmThreads();
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    bool RestoreUsedPipelines();
+    void SaveUsedPipelines() const;
+#endif
+
+    static void PrewarmThreadFunc(void* pThis);
+
+    // Creation state of each compute pipeline when they are created on first use.
+    enum DeferredPipelineState : uint32
+    {
+        DeferredPipelinePending  = 0,
+        DeferredPipelineCreating = 1,
+        DeferredPipelineReady    = 2,
+    };
+
+    static constexpr uint32 MaxPrewarmThreads  = 4;
+    static constexpr uint32 PipelineMaskDwords = (static_cast<uint32>(RpmComputePipeline::Count) + 31) / 32;
+
+    // All internal RPM pipelines are stored here. The compute pipelines are created on first use if
+    // m_deferComputePipelines is set; m_computePipelineState then acts as a once-flag for each pipeline.
+    mutable ComputePipeline*   m_pComputePipelines[static_cast<size_t>(RpmComputePipeline::Count)];
+    GraphicsPipeline*          m_pGraphicsPipelines[RpmGfxPipelineCount];
+
+    // Create info of each deferred compute pipeline. The binary is null if the device doesn't support the pipeline.
+    bool                       m_deferComputePipelines;
+    ComputePipelineCreateInfo  m_deferredComputePipelines[static_cast<size_t>(RpmComputePipeline::Count)];
+    mutable volatile uint32    m_computePipelineState[static_cast<size_t>(RpmComputePipeline::Count)];
+
+    // Background threads which create all deferred compute pipelines ahead of their first use.
+    Util::Thread               m_prewarmThreads[MaxPrewarmThreads];
+    uint32                     m_numPrewarmThreads;
+    Util::Mutex                m_prewarmThreadMutex;    // Serializes StopPrewarmThreads().
+    volatile uint32            m_prewarmNextPipeline;
+    uint32                     m_prewarmPipelines[PipelineMaskDwords];    // Pipelines the threads should create.
+
+    // Deferred compute pipelines which GetPipeline() has returned.  These are saved in the RPM pipeline usage file.
+    mutable volatile uint32    m_usedComputePipelines[PipelineMaskDwords];
 
     PAL_DISALLOW_DEFAULT_CTOR(RsrcProcMgr);
     PAL_DISALLOW_COPY_AND_ASSIGN(RsrcProcMgr);
@@ -89,6 +89,8 @@ public:
         uint32                     funcCount);
 
     uint32 GetMaxStackSizeInBytes() const { return m_maxStackSizeInBytes; }
+    const void* CodeObjectBinary() const { return m_pCodeObjectBinary; }
+    size_t CodeObjectBinaryLen() const { return m_codeObjectBinaryLen; }
     UploadFenceToken GetUploadFenceToken() const { return m_uploadFenceToken; }
     uint64 GetPagingFenceVal() const { return m_pagingFenceVal; }
 
@@ -5095,6 +5095,25 @@ uint32* CmdBuffer::CmdAllocateEmbeddedData(
     return GetNextLayer()->CmdAllocateEmbeddedData(sizeInDwords, alignmentInDwords, pGpuAddress);
 }
 
+// =====================================================================================================================
+Result CmdBuffer::CmdAllocatePatchableData(
+    uint32             sizeInDwords,
+    uint32             alignmentInDwords,
+    PatchableDataInfo* pInfo)
+{
+    return GetNextLayer()->CmdAllocatePatchableData(sizeInDwords, alignmentInDwords, pInfo);
+}
+
+// =====================================================================================================================
+Result CmdBuffer::PatchEmbeddedData(
+    uint32        patchId,
+    uint32        dwordOffset,
+    uint32        dwordCount,
+    const uint32* pData)
+{
+    return GetNextLayer()->PatchEmbeddedData(patchId, dwordOffset, dwordCount, pData);
+}
+
 // =====================================================================================================================
 Result CmdBuffer::AllocateAndBindGpuMemToEvent(
     IGpuEvent* pGpuEvent)
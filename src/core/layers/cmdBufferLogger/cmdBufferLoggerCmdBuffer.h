@@ -423,6 +423,15 @@ public:
         uint32   sizeInDwords,
         uint32   alignmentInDwords,
         gpusize* pGpuAddress) override;
+    virtual Result CmdAllocatePatchableData(
+        uint32             sizeInDwords,
+        uint32             alignmentInDwords,
+        PatchableDataInfo* pInfo) override;
+    virtual Result PatchEmbeddedData(
+        uint32        patchId,
+        uint32        dwordOffset,
+        uint32        dwordCount,
+        const uint32* pData) override;
     virtual Result AllocateAndBindGpuMemToEvent(
         IGpuEvent* pGpuEvent) override;
     virtual void CmdExecuteNestedCmdBuffers(
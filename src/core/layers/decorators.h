@@ -1943,6 +1943,19 @@ public:
         gpusize* pGpuAddress) override
         { return m_pNextLayer->CmdAllocateEmbeddedData(sizeInDwords, alignmentInDwords, pGpuAddress); }
 
+    virtual Result CmdAllocatePatchableData(
+        uint32             sizeInDwords,
+        uint32             alignmentInDwords,
+        PatchableDataInfo* pInfo) override
+        { return m_pNextLayer->CmdAllocatePatchableData(sizeInDwords, alignmentInDwords, pInfo); }
+
+    virtual Result PatchEmbeddedData(
+        uint32        patchId,
+        uint32        dwordOffset,
+        uint32        dwordCount,
+        const uint32* pData) override
+        { return m_pNextLayer->PatchEmbeddedData(patchId, dwordOffset, dwordCount, pData); }
+
     virtual Result AllocateAndBindGpuMemToEvent(
         IGpuEvent* pGpuEvent) override
     { return m_pNextLayer->AllocateAndBindGpuMemToEvent(NextGpuEvent(pGpuEvent)); }
@@ -32,7 +32,9 @@
 #include "core/layers/gpuDebug/gpuDebugDevice.h"
 #include "core/layers/gpuDebug/gpuDebugImage.h"
 #include "core/layers/gpuDebug/gpuDebugPipeline.h"
+#include "core/layers/gpuDebug/gpuDebugPlatform.h"
 #include "core/layers/gpuDebug/gpuDebugQueue.h"
+#include "core/layers/gpuDebug/gpuDebugSurfaceCaptureWriter.h"
 #include "core/g_palPlatformSettings.h"
 #include "palAutoBuffer.h"
 #include "palFile.h"
@@ -575,49 +577,27 @@ Result CmdBuffer::CaptureImageSurface(
 
     if (result == Result::Success)
     {
-        // Create the backing memory for our image and attach it
+        // Get staging memory for our image and attach it
         PAL_ASSERT(pDstImageMem == pDstImage);
 
         GpuMemoryRequirements gpuMemReqs = { 0 };
         pDstImage->GetGpuMemoryRequirements(&gpuMemReqs);
 
-        GpuMemoryCreateInfo gpuMemCreateInfo = { 0 };
-        gpuMemCreateInfo.size       = gpuMemReqs.size;
-        gpuMemCreateInfo.alignment  = gpuMemReqs.alignment;
-        gpuMemCreateInfo.vaRange    = VaRange::Default;
-        gpuMemCreateInfo.priority   = GpuMemPriority::Normal;
-        gpuMemCreateInfo.heapCount  = 3;
-        gpuMemCreateInfo.heaps[0]   = GpuHeap::GpuHeapLocal;
-        gpuMemCreateInfo.heaps[1]   = GpuHeap::GpuHeapGartUswc;
-        gpuMemCreateInfo.heaps[2]   = GpuHeap::GpuHeapGartCacheable;
-        const size_t gpuMemSize = m_pDevice->GetGpuMemorySize(gpuMemCreateInfo, &result);
-
-        void* pGpuMemMem = nullptr;
-        pGpuMemMem = PAL_MALLOC(gpuMemSize, m_pDevice->GetPlatform(), AllocInternal);
-
-        if (pGpuMemMem == nullptr)
-        {
-            result = Result::ErrorOutOfMemory;
-        }
+        IGpuMemory* pGpuMem = nullptr;
+        result = m_pDevice->AcquireSurfaceCaptureMemory(gpuMemReqs, &pGpuMem);
 
         if (result == Result::Success)
         {
-            IGpuMemory* pGpuMem = nullptr;
-            result = m_pDevice->CreateGpuMemory(gpuMemCreateInfo, pGpuMemMem, &pGpuMem);
+            result = pDstImage->BindGpuMemory(pGpuMem, 0);
 
             if (result == Result::Success)
             {
-                result = pDstImage->BindGpuMemory(pGpuMem, 0);
-
-                if (result == Result::Success)
-                {
-                    m_surfaceCapture.ppGpuMem[m_surfaceCapture.gpuMemObjsCount] = pGpuMem;
-                    m_surfaceCapture.gpuMemObjsCount++;
-                }
+                m_surfaceCapture.ppGpuMem[m_surfaceCapture.gpuMemObjsCount] = pGpuMem;
+                m_surfaceCapture.gpuMemObjsCount++;
             }
             else
             {
-                PAL_SAFE_FREE(pGpuMemMem, m_pDevice->GetPlatform());
+                m_pDevice->ReleaseSurfaceCaptureMemory(pGpuMem);
             }
         }
     }
@@ -994,20 +974,37 @@ void CmdBuffer::OutputSurfaceCaptureImage(
                  pFileName,
                  canUseDds ? "dds" : "bin");
 
-        File outFile;
-        result = outFile.Open(&(filePathNameExt[0]), FileAccessBinary | FileAccessWrite);
+        const size_t dataSize = static_cast<size_t>(pImage->GetMemoryLayout().dataSize);
+
+        SurfaceCaptureWriter*const pWriter =
+            static_cast<Platform*>(m_pDevice->GetPlatform())->GetSurfaceCaptureWriter();
 
-        if ((result == Result::Success) && outFile.IsOpen())
+        if (pWriter != nullptr)
+        {
+            // Only the copy into staging memory happens here, the writer thread does the file I/O.
+            result = pWriter->Enqueue(&filePathNameExt[0],
+                                      &ddsHeader,
+                                      canUseDds ? ddsHeaderSize : 0,
+                                      pImageMap,
+                                      dataSize);
+        }
+        else
         {
-            if (canUseDds)
+            File outFile;
+            result = outFile.Open(&(filePathNameExt[0]), FileAccessBinary | FileAccessWrite);
+
+            if ((result == Result::Success) && outFile.IsOpen())
             {
-                outFile.Write(&ddsHeader, ddsHeaderSize);
-            }
+                if (canUseDds)
+                {
+                    outFile.Write(&ddsHeader, ddsHeaderSize);
+                }
 
-            outFile.Write(pImageMap, static_cast<size_t>(pImage->GetMemoryLayout().dataSize));
+                outFile.Write(pImageMap, dataSize);
 
-            outFile.Flush();
-            outFile.Close();
+                outFile.Flush();
+                outFile.Close();
+            }
         }
 
         pImage->GetBoundMemory()->Unmap();
@@ -1053,8 +1050,8 @@ void CmdBuffer::DestroySurfaceCaptureData()
         {
             if (m_surfaceCapture.ppGpuMem[i] != nullptr)
             {
-                m_surfaceCapture.ppGpuMem[i]->Destroy();
-                PAL_SAFE_FREE(m_surfaceCapture.ppGpuMem[i], m_pDevice->GetPlatform());
+                m_pDevice->ReleaseSurfaceCaptureMemory(m_surfaceCapture.ppGpuMem[i]);
+                m_surfaceCapture.ppGpuMem[i] = nullptr;
             }
         }
 
@@ -4031,6 +4028,25 @@ uint32* CmdBuffer::CmdAllocateEmbeddedData(
     return GetNextLayer()->CmdAllocateEmbeddedData(sizeInDwords, alignmentInDwords, pGpuAddress);
 }
 
+// =====================================================================================================================
+Result CmdBuffer::CmdAllocatePatchableData(
+    uint32             sizeInDwords,
+    uint32             alignmentInDwords,
+    PatchableDataInfo* pInfo)
+{
+    return GetNextLayer()->CmdAllocatePatchableData(sizeInDwords, alignmentInDwords, pInfo);
+}
+
+// =====================================================================================================================
+Result CmdBuffer::PatchEmbeddedData(
+    uint32        patchId,
+    uint32        dwordOffset,
+    uint32        dwordCount,
+    const uint32* pData)
+{
+    return GetNextLayer()->PatchEmbeddedData(patchId, dwordOffset, dwordCount, pData);
+}
+
 // =====================================================================================================================
 Result CmdBuffer::AllocateAndBindGpuMemToEvent(
     IGpuEvent* pGpuEvent)
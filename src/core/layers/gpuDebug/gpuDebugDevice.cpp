@@ -65,14 +65,17 @@ Device::Device(
     IDevice*           pNextDevice)
     :
     DeviceDecorator(pPlatform, pNextDevice),
-    m_pPublicSettings(nullptr)
+    m_pPublicSettings(nullptr),
+    m_idleSurfaceCaptureMemoryCount(0)
 {
     memset(&m_deviceProperties, 0, sizeof(m_deviceProperties));
+    memset(&m_pIdleSurfaceCaptureMemory[0], 0, sizeof(m_pIdleSurfaceCaptureMemory));
 }
 
 // =====================================================================================================================
 Device::~Device()
 {
+    DestroyIdleSurfaceCaptureMemory();
 }
 
 // =====================================================================================================================
@@ -99,6 +102,133 @@ Result Device::Finalize(
     return result;
 }
 
+// =====================================================================================================================
+Result Device::Cleanup()
+{
+    // The staging memory must be destroyed before the next layer tears down its memory manager.
+    DestroyIdleSurfaceCaptureMemory();
+
+    return DeviceDecorator::Cleanup();
+}
+
+// =====================================================================================================================
+// Returns GPU memory which can back a surface capture image with the given requirements. The memory lives in CPU
+// cacheable system memory because it is only written by a GPU copy and then read back by the CPU. Previously released
+// memory is reused if it is large enough.
+Result Device::AcquireSurfaceCaptureMemory(
+    const GpuMemoryRequirements& memReqs,
+    IGpuMemory**                 ppGpuMemory)
+{
+    PAL_ASSERT(ppGpuMemory != nullptr);
+
+    IGpuMemory* pGpuMemory = nullptr;
+
+    {
+        MutexAuto lock(&m_surfaceCaptureMemoryLock);
+
+        for (uint32 i = 0; i < m_idleSurfaceCaptureMemoryCount; i++)
+        {
+            const GpuMemoryDesc& desc = m_pIdleSurfaceCaptureMemory[i]->Desc();
+
+            if ((desc.size >= memReqs.size) && IsPow2Aligned(desc.gpuVirtAddr, memReqs.alignment))
+            {
+                pGpuMemory = m_pIdleSurfaceCaptureMemory[i];
+
+                m_idleSurfaceCaptureMemoryCount--;
+                m_pIdleSurfaceCaptureMemory[i] = m_pIdleSurfaceCaptureMemory[m_idleSurfaceCaptureMemoryCount];
+                m_pIdleSurfaceCaptureMemory[m_idleSurfaceCaptureMemoryCount] = nullptr;
+                break;
+            }
+        }
+    }
+
+    Result result = Result::Success;
+
+    if (pGpuMemory == nullptr)
+    {
+        // Round the size up so that captures of slightly different sizes can share the same staging memory later.
+        GpuMemoryCreateInfo createInfo = {};
+        createInfo.size      = Pow2Align(memReqs.size, 64 * 1024);
+        createInfo.alignment = memReqs.alignment;
+        createInfo.vaRange   = VaRange::Default;
+        createInfo.priority  = GpuMemPriority::Normal;
+        createInfo.heapCount = 2;
+        createInfo.heaps[0]  = GpuHeapGartCacheable;
+        createInfo.heaps[1]  = GpuHeapGartUswc;
+
+        const size_t objectSize = GetGpuMemorySize(createInfo, &result);
+
+        void* pMemory = nullptr;
+
+        if (result == Result::Success)
+        {
+            pMemory = PAL_MALLOC(objectSize, GetPlatform(), AllocInternal);
+
+            if (pMemory == nullptr)
+            {
+                result = Result::ErrorOutOfMemory;
+            }
+        }
+
+        if (result == Result::Success)
+        {
+            result = CreateGpuMemory(createInfo, pMemory, &pGpuMemory);
+
+            if (result != Result::Success)
+            {
+                PAL_SAFE_FREE(pMemory, GetPlatform());
+            }
+        }
+    }
+
+    if (result == Result::Success)
+    {
+        *ppGpuMemory = pGpuMemory;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Returns surface capture memory which is no longer referenced by any command buffer so that it can be reused.
+void Device::ReleaseSurfaceCaptureMemory(
+    IGpuMemory* pGpuMemory)
+{
+    PAL_ASSERT(pGpuMemory != nullptr);
+
+    bool kept = false;
+
+    {
+        MutexAuto lock(&m_surfaceCaptureMemoryLock);
+
+        if (m_idleSurfaceCaptureMemoryCount < MaxIdleSurfaceCaptureMemory)
+        {
+            m_pIdleSurfaceCaptureMemory[m_idleSurfaceCaptureMemoryCount++] = pGpuMemory;
+            kept = true;
+        }
+    }
+
+    if (kept == false)
+    {
+        pGpuMemory->Destroy();
+        PAL_FREE(pGpuMemory, GetPlatform());
+    }
+}
+
+// =====================================================================================================================
+void Device::DestroyIdleSurfaceCaptureMemory()
+{
+    MutexAuto lock(&m_surfaceCaptureMemoryLock);
+
+    for (uint32 i = 0; i < m_idleSurfaceCaptureMemoryCount; i++)
+    {
+        m_pIdleSurfaceCaptureMemory[i]->Destroy();
+        PAL_SAFE_FREE(m_pIdleSurfaceCaptureMemory[i], GetPlatform());
+    }
+
+    m_idleSurfaceCaptureMemoryCount = 0;
+}
+
 // =====================================================================================================================
 size_t Device::GetCmdBufferSize(
     const CmdBufferCreateInfo& createInfo,
@@ -28,6 +28,7 @@
 #if PAL_BUILD_GPU_DEBUG
 
 #include "core/layers/decorators.h"
+#include "palMutex.h"
 
 namespace Pal
 {
@@ -181,16 +182,30 @@ public:
 
     virtual Result CommitSettingsAndInit() override;
     virtual Result Finalize(const DeviceFinalizeInfo& finalizeInfo) override;
+    virtual Result Cleanup() override;
 
     const PalPublicSettings* PublicSettings() const { return m_pPublicSettings; }
     const DeviceProperties&  DeviceProps() const { return m_deviceProperties; }
 
+    Result AcquireSurfaceCaptureMemory(const GpuMemoryRequirements& memReqs, IGpuMemory** ppGpuMemory);
+    void   ReleaseSurfaceCaptureMemory(IGpuMemory* pGpuMemory);
+
 private:
     virtual ~Device();
 
+    void DestroyIdleSurfaceCaptureMemory();
+
     const PalPublicSettings* m_pPublicSettings;
     DeviceProperties         m_deviceProperties;
 
+    // Surface capture copies every captured target into staging GPU memory which the CPU reads back after the submit.
+    // Released staging memory is kept here so that later captures can reuse it instead of allocating for each draw.
+    static constexpr uint32 MaxIdleSurfaceCaptureMemory = 16;
+
+    Util::Mutex m_surfaceCaptureMemoryLock;
+    IGpuMemory* m_pIdleSurfaceCaptureMemory[MaxIdleSurfaceCaptureMemory];
+    uint32      m_idleSurfaceCaptureMemoryCount;
+
     PAL_DISALLOW_DEFAULT_CTOR(Device);
     PAL_DISALLOW_COPY_AND_ASSIGN(Device);
 };
@@ -29,6 +29,7 @@
 #include "core/layers/gpuDebug/gpuDebugCmdBuffer.h"
 #include "core/layers/gpuDebug/gpuDebugDevice.h"
 #include "core/layers/gpuDebug/gpuDebugPlatform.h"
+#include "core/layers/gpuDebug/gpuDebugSurfaceCaptureWriter.h"
 #include "palSysUtil.h"
 #include <ctime>
 
@@ -47,10 +48,18 @@ Platform::Platform(
     bool                        enabled)
     :
     // GpuDebug doesn't install callback
-    PlatformDecorator(createInfo, allocCb, GpuDebugCb, enabled, enabled, pNextPlatform)
+    PlatformDecorator(createInfo, allocCb, GpuDebugCb, enabled, enabled, pNextPlatform),
+    m_pSurfaceCaptureWriter(nullptr)
 {
 }
 
+// =====================================================================================================================
+Platform::~Platform()
+{
+    // This waits for any captured surfaces which haven't been written to disk yet.
+    PAL_DELETE(m_pSurfaceCaptureWriter, this);
+}
+
 // =====================================================================================================================
 Result Platform::Create(
     const PlatformCreateInfo&   createInfo,
@@ -83,7 +92,25 @@ Result Platform::Create(
 // =====================================================================================================================
 Result Platform::Init()
 {
-    return PlatformDecorator::Init();
+    Result result = PlatformDecorator::Init();
+
+    if ((result == Result::Success) &&
+        m_layerEnabled &&
+        (PlatformSettings().gpuDebugConfig.surfaceCaptureDrawCount > 0))
+    {
+        m_pSurfaceCaptureWriter = PAL_NEW(SurfaceCaptureWriter, this, AllocInternal)(this);
+
+        if (m_pSurfaceCaptureWriter == nullptr)
+        {
+            result = Result::ErrorOutOfMemory;
+        }
+        else
+        {
+            result = m_pSurfaceCaptureWriter->Init();
+        }
+    }
+
+    return result;
 }
 
 // =====================================================================================================================
@@ -34,6 +34,8 @@ namespace Pal
 namespace GpuDebug
 {
 
+class SurfaceCaptureWriter;
+
 // =====================================================================================================================
 class Platform final : public PlatformDecorator
 {
@@ -64,6 +66,9 @@ public:
 
     bool IsEnabled() const { return m_layerEnabled; }
 
+    // Returns the background writer for captured surfaces, or null if surface capture is disabled.
+    SurfaceCaptureWriter* GetSurfaceCaptureWriter() const { return m_pSurfaceCaptureWriter; }
+
     static void PAL_STDCALL GpuDebugCb(
         void*                   pPrivateData,
         const uint32            deviceIndex,
@@ -71,7 +76,9 @@ public:
         void*                   pCbData);
 
 private:
-    virtual ~Platform() { }
+    virtual ~Platform();
+
+    SurfaceCaptureWriter* m_pSurfaceCaptureWriter;
 
     PAL_DISALLOW_DEFAULT_CTOR(Platform);
     PAL_DISALLOW_COPY_AND_ASSIGN(Platform);
@@ -0,0 +1,222 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#if PAL_BUILD_GPU_DEBUG
+
+#include "core/layers/gpuDebug/gpuDebugPlatform.h"
+#include "core/layers/gpuDebug/gpuDebugSurfaceCaptureWriter.h"
+#include "palFile.h"
+#include "palInlineFuncs.h"
+
+using namespace Util;
+
+namespace Pal
+{
+namespace GpuDebug
+{
+
+// =====================================================================================================================
+SurfaceCaptureWriter::SurfaceCaptureWriter(
+    Platform* pPlatform)
+    :
+    m_pPlatform(pPlatform),
+    m_writeIdx(0),
+    m_readIdx(0),
+    m_terminate(false),
+    m_pendingCount(0)
+{
+    memset(&m_slots[0], 0, sizeof(m_slots));
+}
+
+// =====================================================================================================================
+SurfaceCaptureWriter::~SurfaceCaptureWriter()
+{
+    if (m_writerThread.IsCreated())
+    {
+        // Let the writer thread drain everything that was queued before asking it to exit.
+        WaitIdle();
+
+        m_terminate = true;
+        m_pendingSlots.Post();
+        m_writerThread.Join();
+    }
+
+    for (uint32 i = 0; i < NumStagingSlots; i++)
+    {
+        PAL_SAFE_FREE(m_slots[i].pData, m_pPlatform);
+    }
+}
+
+// =====================================================================================================================
+Result SurfaceCaptureWriter::Init()
+{
+    Result result = m_freeSlots.Init(NumStagingSlots, NumStagingSlots);
+
+    if (result == Result::Success)
+    {
+        result = m_pendingSlots.Init(NumStagingSlots + 1, 0);
+    }
+
+    if (result == Result::Success)
+    {
+        result = m_writerThread.Begin(&WriterThreadFunc, this);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Copies a surface into a staging slot and queues it to be written to pFilePathName.  The caller may reuse or unmap
+// pHeader and pData as soon as this returns.
+Result SurfaceCaptureWriter::Enqueue(
+    const char* pFilePathName,
+    const void* pHeader,
+    size_t      headerSize,
+    const void* pData,
+    size_t      dataSize)
+{
+    PAL_ASSERT(pFilePathName != nullptr);
+    PAL_ASSERT(pData != nullptr);
+
+    Result result = m_freeSlots.Wait(UINT32_MAX);
+
+    if (result == Result::Success)
+    {
+        // The writer thread consumes slots in order, so a slot must be filled before the next one can be claimed.
+        MutexAuto lock(&m_slotLock);
+
+        StagingSlot*const pSlot = &m_slots[m_writeIdx];
+        m_writeIdx = (m_writeIdx + 1) % NumStagingSlots;
+
+        const size_t totalSize = headerSize + dataSize;
+
+        if (pSlot->capacity < totalSize)
+        {
+            PAL_SAFE_FREE(pSlot->pData, m_pPlatform);
+
+            pSlot->pData    = PAL_MALLOC(totalSize, m_pPlatform, AllocInternal);
+            pSlot->capacity = (pSlot->pData != nullptr) ? totalSize : 0;
+        }
+
+        if (pSlot->pData != nullptr)
+        {
+            if (headerSize > 0)
+            {
+                memcpy(pSlot->pData, pHeader, headerSize);
+            }
+
+            memcpy(VoidPtrInc(pSlot->pData, headerSize), pData, dataSize);
+
+            pSlot->size = totalSize;
+            Strncpy(pSlot->filePathName, pFilePathName, sizeof(pSlot->filePathName));
+        }
+        else
+        {
+            // Still hand the slot to the writer thread so that slots keep being consumed in order; it will skip it.
+            pSlot->size = 0;
+            result      = Result::ErrorOutOfMemory;
+        }
+
+        {
+            MutexAuto idleLock(&m_idleLock);
+            m_pendingCount++;
+        }
+
+        m_pendingSlots.Post();
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Waits until every queued surface has been written to disk.
+void SurfaceCaptureWriter::WaitIdle()
+{
+    MutexAuto lock(&m_idleLock);
+
+    while (m_pendingCount > 0)
+    {
+        m_idleCondition.Wait(&m_idleLock, UINT32_MAX);
+    }
+}
+
+// =====================================================================================================================
+void SurfaceCaptureWriter::WriterThreadFunc(
+    void* pParam)
+{
+    static_cast<SurfaceCaptureWriter*>(pParam)->WriterThreadLoop();
+}
+
+// =====================================================================================================================
+void SurfaceCaptureWriter::WriterThreadLoop()
+{
+    while (true)
+    {
+        m_pendingSlots.Wait(UINT32_MAX);
+
+        if (m_terminate)
+        {
+            break;
+        }
+
+        // Only this thread consumes slots, so the read index doesn't need the slot lock.
+        StagingSlot*const pSlot = &m_slots[m_readIdx];
+        m_readIdx = (m_readIdx + 1) % NumStagingSlots;
+
+        if (pSlot->size > 0)
+        {
+            File   outFile;
+            Result result = outFile.Open(&pSlot->filePathName[0], FileAccessBinary | FileAccessWrite);
+
+            if (result == Result::Success)
+            {
+                result = outFile.Write(pSlot->pData, pSlot->size);
+                outFile.Close();
+            }
+
+            if (result != Result::Success)
+            {
+                PAL_DPWARN("Surface Capture failed to write %s, Error:0x%x", &pSlot->filePathName[0], result);
+            }
+        }
+
+        m_freeSlots.Post();
+
+        MutexAuto idleLock(&m_idleLock);
+
+        PAL_ASSERT(m_pendingCount > 0);
+        m_pendingCount--;
+
+        if (m_pendingCount == 0)
+        {
+            m_idleCondition.WakeAll();
+        }
+    }
+}
+
+} // GpuDebug
+} // Pal
+
+#endif
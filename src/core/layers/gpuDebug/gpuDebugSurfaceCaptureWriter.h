@@ -0,0 +1,101 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#pragma once
+
+#if PAL_BUILD_GPU_DEBUG
+
+#include "palConditionVariable.h"
+#include "palMutex.h"
+#include "palSemaphore.h"
+#include "palThread.h"
+
+namespace Pal
+{
+namespace GpuDebug
+{
+
+class Platform;
+
+// =====================================================================================================================
+// Writes captured surfaces to disk on a background thread.  The submitting thread only has to copy each mapped capture
+// image into one of a small ring of staging buffers; the file I/O happens asynchronously.  Staging buffers are reused
+// and grow to fit the largest surface written through them.  If every staging buffer is in flight the submitting thread
+// waits for the writer to catch up.
+class SurfaceCaptureWriter
+{
+public:
+    explicit SurfaceCaptureWriter(Platform* pPlatform);
+    ~SurfaceCaptureWriter();
+
+    Result Init();
+
+    Result Enqueue(
+        const char* pFilePathName,
+        const void* pHeader,
+        size_t      headerSize,
+        const void* pData,
+        size_t      dataSize);
+
+    void WaitIdle();
+
+private:
+    static void WriterThreadFunc(void* pParam);
+    void        WriterThreadLoop();
+
+    // A surface waiting to be written.  The header and the surface data are packed back to back in pData.
+    struct StagingSlot
+    {
+        void*  pData;
+        size_t capacity;
+        size_t size;
+        char   filePathName[512];
+    };
+
+    static constexpr uint32 NumStagingSlots = 8;
+
+    Platform*const  m_pPlatform;
+    Util::Thread    m_writerThread;
+    Util::Semaphore m_freeSlots;      // Signaled when a staging slot is available to the submitting thread.
+    Util::Semaphore m_pendingSlots;   // Signaled when a staging slot is ready to be written out.
+    Util::Mutex     m_slotLock;       // Serializes submitting threads which claim slots.
+    uint32          m_writeIdx;       // Next slot to be claimed by a submitting thread.
+    uint32          m_readIdx;        // Next slot to be written by the writer thread.
+    volatile bool   m_terminate;
+
+    Util::Mutex             m_idleLock;       // Protects m_pendingCount.
+    Util::ConditionVariable m_idleCondition;  // Signaled when m_pendingCount drops to zero.
+    uint32                  m_pendingCount;   // Number of slots which have been queued but not fully written yet.
+
+    StagingSlot     m_slots[NumStagingSlots];
+
+    PAL_DISALLOW_DEFAULT_CTOR(SurfaceCaptureWriter);
+    PAL_DISALLOW_COPY_AND_ASSIGN(SurfaceCaptureWriter);
+};
+
+} // GpuDebug
+} // Pal
+
+#endif
@@ -3235,6 +3235,25 @@ uint32* CmdBuffer::CmdAllocateEmbeddedData(
     return NextLayer()->CmdAllocateEmbeddedData(sizeInDwords, alignmentInDwords, pGpuAddress);
 }
 
+// =====================================================================================================================
+Result CmdBuffer::CmdAllocatePatchableData(
+    uint32             sizeInDwords,
+    uint32             alignmentInDwords,
+    PatchableDataInfo* pInfo)
+{
+    return NextLayer()->CmdAllocatePatchableData(sizeInDwords, alignmentInDwords, pInfo);
+}
+
+// =====================================================================================================================
+Result CmdBuffer::PatchEmbeddedData(
+    uint32        patchId,
+    uint32        dwordOffset,
+    uint32        dwordCount,
+    const uint32* pData)
+{
+    return NextLayer()->PatchEmbeddedData(patchId, dwordOffset, dwordCount, pData);
+}
+
 // =====================================================================================================================
 Result CmdBuffer::AllocateAndBindGpuMemToEvent(
     IGpuEvent* pGpuEvent)
@@ -0,0 +1,257 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "core/layers/gpuProfiler/gpuProfilerLogWriter.h"
+#include "core/layers/gpuProfiler/gpuProfilerPlatform.h"
+#include "palInlineFuncs.h"
+#include "palSysUtil.h"
+
+using namespace Util;
+
+namespace Pal
+{
+namespace GpuProfiler
+{
+
+// =====================================================================================================================
+LogWriter::LogWriter(
+    Platform* pPlatform)
+    :
+    m_pPlatform(pPlatform),
+    m_pRing(nullptr),
+    m_ringSize(0),
+    m_reserveOffset(0),
+    m_reserveSize(0),
+    m_stallCount(0),
+    m_publishedOffset(0),
+    m_wrapOffset(0),
+    m_consumedOffset(0),
+    m_terminate(false)
+{
+}
+
+// =====================================================================================================================
+LogWriter::~LogWriter()
+{
+    if (m_writerThread.IsCreated())
+    {
+        // The writer thread drains the ring one last time before it exits.
+        m_terminate = true;
+        m_dataReady.Post();
+        m_writerThread.Join();
+    }
+
+    m_file.Close();
+
+    PAL_SAFE_FREE(m_pRing, m_pPlatform);
+}
+
+// =====================================================================================================================
+Result LogWriter::Init(
+    const char* pFileName,
+    size_t      ringSize)
+{
+    PAL_ASSERT(IsPow2Aligned(ringSize, BinaryLogRecordAlignment));
+
+    Result result = m_file.Open(pFileName, FileAccessWrite | FileAccessBinary);
+
+    if (result == Result::Success)
+    {
+        m_pRing = PAL_MALLOC(ringSize, m_pPlatform, AllocInternal);
+
+        if (m_pRing == nullptr)
+        {
+            result = Result::ErrorOutOfMemory;
+        }
+        else
+        {
+            m_ringSize = ringSize;
+        }
+    }
+
+    if (result == Result::Success)
+    {
+        result = m_dataReady.Init(Semaphore::MaximumCountLimit, 0);
+    }
+
+    if (result == Result::Success)
+    {
+        result = m_writerThread.Begin(&WriterThreadFunc, this);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+void* LogWriter::BeginRecord(
+    BinaryLogRecordType type,
+    uint32              flags,
+    size_t              payloadSize)
+{
+    const size_t size = Pow2Align(sizeof(BinaryLogRecordHeader) + payloadSize, BinaryLogRecordAlignment);
+
+    // Records are tiny compared to the ring, this just makes sure a record can always fit once the ring is drained.
+    PAL_ASSERT(size < (m_ringSize / 2));
+
+    size_t offset  = m_publishedOffset;
+    bool   stalled = false;
+
+    while (true)
+    {
+        const size_t consumed = m_consumedOffset;
+
+        if (offset >= consumed)
+        {
+            // The writer thread is behind us in the same lap, so everything from here to the end of the ring is free.
+            if ((offset + size) <= m_ringSize)
+            {
+                break;
+            }
+            else if (consumed > 0)
+            {
+                // Wrap back to the start of the ring.  This can't be done while the writer thread sits at offset zero
+                // because the published and consumed offsets would become equal, which means the ring is empty.
+                m_wrapOffset = offset;
+                MemoryBarrier();
+                m_publishedOffset = 0;
+                offset            = 0;
+                continue;
+            }
+        }
+        else if ((offset + size) < consumed)
+        {
+            // We already wrapped and there is enough room before the data the writer thread still has to write.  The
+            // record must not reach the consumed offset, again because equal offsets would mean the ring is empty.
+            break;
+        }
+
+        // The ring is full.  Make sure the writer thread is awake and give it a chance to catch up.
+        if (stalled == false)
+        {
+            stalled = true;
+            m_stallCount++;
+        }
+
+        m_dataReady.Post();
+        YieldThread();
+    }
+
+    // Don't write into the ring until we've seen the consumed offset that freed this space.
+    MemoryBarrier();
+
+    m_reserveOffset = offset;
+    m_reserveSize   = size;
+
+    auto*const pHeader = static_cast<BinaryLogRecordHeader*>(VoidPtrInc(m_pRing, offset));
+    pHeader->type      = static_cast<uint16>(type);
+    pHeader->flags     = static_cast<uint16>(flags);
+    pHeader->size      = static_cast<uint32>(size);
+
+    // Zero the padding so that the file contents don't depend on stale ring data.
+    const size_t paddedPayloadSize = size - sizeof(BinaryLogRecordHeader);
+    memset(VoidPtrInc(pHeader, sizeof(BinaryLogRecordHeader) + payloadSize), 0, paddedPayloadSize - payloadSize);
+
+    return (pHeader + 1);
+}
+
+// =====================================================================================================================
+void LogWriter::EndRecord()
+{
+    // The record's contents must be visible before the writer thread can see the new published offset.
+    MemoryBarrier();
+    m_publishedOffset = m_reserveOffset + m_reserveSize;
+}
+
+// =====================================================================================================================
+void LogWriter::Flush()
+{
+    m_dataReady.Post();
+}
+
+// =====================================================================================================================
+void LogWriter::WriterThreadFunc(
+    void* pParam)
+{
+    static_cast<LogWriter*>(pParam)->WriterThreadLoop();
+}
+
+// =====================================================================================================================
+void LogWriter::WriterThreadLoop()
+{
+    while (m_terminate == false)
+    {
+        m_dataReady.Wait(UINT32_MAX);
+        Drain();
+    }
+
+    // The last records may have been published after the final drain above already read the published offset.
+    Drain();
+}
+
+// =====================================================================================================================
+// Writes every published record to the file.  Only called by the writer thread.
+void LogWriter::Drain()
+{
+    size_t consumed = m_consumedOffset;
+    bool   wrote    = false;
+
+    while (true)
+    {
+        const size_t published = m_publishedOffset;
+
+        // Don't read the ring (or the wrap offset) until we've seen the published offset that covers it.
+        MemoryBarrier();
+
+        if (published == consumed)
+        {
+            break;
+        }
+        else if (published > consumed)
+        {
+            m_file.Write(VoidPtrInc(m_pRing, consumed), published - consumed);
+            consumed = published;
+        }
+        else
+        {
+            // The producer wrapped back to the start of the ring.
+            m_file.Write(VoidPtrInc(m_pRing, consumed), m_wrapOffset - consumed);
+            consumed = 0;
+        }
+
+        // We must be done reading this part of the ring before the producer is allowed to overwrite it.
+        MemoryBarrier();
+        m_consumedOffset = consumed;
+        wrote            = true;
+    }
+
+    if (wrote)
+    {
+        // Keep the file current so it's useful even if the application crashes.
+        m_file.Flush();
+    }
+}
+
+} // GpuProfiler
+} // Pal
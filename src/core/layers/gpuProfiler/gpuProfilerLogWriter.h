@@ -0,0 +1,174 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#pragma once
+
+#include "pal.h"
+#include "palFile.h"
+#include "palSemaphore.h"
+#include "palThread.h"
+
+namespace Pal
+{
+namespace GpuProfiler
+{
+
+class Platform;
+
+// The binary log is a flat sequence of records, each of which begins with a BinaryLogRecordHeader and is padded to a
+// multiple of BinaryLogRecordAlignment bytes.  Everything is little-endian and fields inside a record are tightly
+// packed.  The first record of every file is a FileHeader record.  tools/gpuProfilerTools/binaryLogToCsv.py converts
+// these files back into the .csv files the profiler writes when binary logging is disabled, so any change to this
+// layout must be mirrored there and must bump BinaryLogVersion.
+constexpr uint32 BinaryLogMagic           = 0x424C4750; // "PGLB"
+constexpr uint32 BinaryLogVersion         = 1;
+constexpr uint32 BinaryLogRecordAlignment = 8;
+
+enum class BinaryLogRecordType : uint16
+{
+    FileHeader = 0, // BinaryLogFileHeader, then the perf counter, queue call and cmd buffer call name strings.
+    FrameStart,     // uint32 frameId. Starts a new per-frame .csv file.
+    QueueCall,      // uint32 frameId, uint32 callId.
+    CmdBufCall,     // BinaryLogCmdBufCall, then the optional sections selected by the record flags.
+    Frame,          // uint32 frameId, then the optional sections selected by the record flags.
+};
+
+// Selects which optional sections follow a record's fixed-size payload.  The sections appear in this order:
+//   - Pipeline:        apiPsoHash, stable hash, unique hash, 5 x 128-bit shader hashes, 2 x uint32 counts.
+//   - Comment:         String.
+//   - Timestamps:      2 x uint64 (start and end clock).
+//   - PipelineStats:   BinaryLogNumPipelineStats x uint64.
+//   - PerfCounters:    numReportedPerfCounters x uint64.
+// CmdBufCall and Frame records always end with the ThreadTraceId column text as a String.  Strings are stored as a
+// uint32 byte count followed by that many bytes, without a terminator.
+enum BinaryLogRecordFlags : uint16
+{
+    BinaryLogDraw          = 0x0001,
+    BinaryLogDispatch      = 0x0002,
+    BinaryLogTaskMesh      = 0x0004,
+    BinaryLogComment       = 0x0008,
+    BinaryLogNested        = 0x0010,
+    BinaryLogTimestamps    = 0x0020,
+    BinaryLogHideElapsed   = 0x0040,
+    BinaryLogPipelineStats = 0x0080,
+    BinaryLogPerfCounters  = 0x0100,
+};
+
+constexpr uint32 BinaryLogNumPipelineStats = 14;
+constexpr uint32 BinaryLogNumShaderHashes  = 5;  // One per shader column: VS/CS/TS, HS, DS, MS/GS and PS.
+
+struct BinaryLogRecordHeader
+{
+    uint16 type;  // BinaryLogRecordType
+    uint16 flags; // Mask of BinaryLogRecordFlags.
+    uint32 size;  // Size of the record in bytes, including this header and any padding.
+};
+
+// Flags which describe the .csv columns the profiler would have written.
+enum BinaryLogFileFlags : uint32
+{
+    BinaryLogFileFullPipelineHash = 0x1,
+    BinaryLogFileThreadTrace      = 0x2,
+    BinaryLogFilePipelineStats    = 0x4,
+};
+
+struct BinaryLogFileHeader
+{
+    uint32 magic;
+    uint32 version;
+    uint64 timestampFreq;
+    uint32 deviceId;
+    uint32 engineIndex;
+    uint32 queueId;
+    uint32 fileFlags;               // Mask of BinaryLogFileFlags.
+    uint32 numPerfCounters;         // Number of perf counter name strings.
+    uint32 numReportedPerfCounters; // Number of perf counter values in each record with BinaryLogPerfCounters.
+    uint32 numQueueCallNames;
+    uint32 numCmdBufCallNames;
+    char   engineName[8];
+};
+
+struct BinaryLogCmdBufCall
+{
+    uint32 frameId;
+    uint32 cmdBufIdx;
+    uint32 callId;
+    uint32 subQueueIdx;
+};
+
+// =====================================================================================================================
+// Writes binary log records to a file on a background thread.  The queue which owns the writer is the only producer:
+// it reserves space for each record directly in a ring buffer, fills it in place and then publishes it.  The writer
+// thread copies published records from the ring to the file without looking at them, so handing off a record costs a
+// memory barrier.  The producer only waits if the ring is full.
+class LogWriter
+{
+public:
+    explicit LogWriter(Platform* pPlatform);
+    ~LogWriter();
+
+    Result Init(const char* pFileName, size_t ringSize);
+
+    // Reserves a record with room for payloadSize bytes after its header and returns a pointer to the payload.  The
+    // record is invisible to the writer thread until EndRecord() is called.  Only one record may be open at a time.
+    void* BeginRecord(BinaryLogRecordType type, uint32 flags, size_t payloadSize);
+    void  EndRecord();
+
+    // Wakes the writer thread so it writes out everything published so far.
+    void Flush();
+
+    // Number of times BeginRecord() had to wait for the writer thread to free up space in the ring.
+    uint32 StallCount() const { return m_stallCount; }
+
+private:
+    static void WriterThreadFunc(void* pParam);
+    void        WriterThreadLoop();
+    void        Drain();
+
+    Platform*const  m_pPlatform;
+    Util::File      m_file;
+    Util::Thread    m_writerThread;
+    Util::Semaphore m_dataReady;     // Signaled when the writer thread should look for published records.
+
+    void*           m_pRing;
+    size_t          m_ringSize;
+
+    // Owned by the producer.
+    size_t          m_reserveOffset; // Start of the record which is currently open.
+    size_t          m_reserveSize;   // Size of the record which is currently open.
+    uint32          m_stallCount;
+
+    // Shared between the producer and the writer thread.
+    volatile size_t m_publishedOffset; // Everything before this offset (since the last wrap) can be written.
+    volatile size_t m_wrapOffset;      // End of the valid data when the producer last wrapped back to offset zero.
+    volatile size_t m_consumedOffset;  // Everything before this offset (since the last wrap) has been written.
+    volatile bool   m_terminate;
+
+    PAL_DISALLOW_DEFAULT_CTOR(LogWriter);
+    PAL_DISALLOW_COPY_AND_ASSIGN(LogWriter);
+};
+
+} // GpuProfiler
+} // Pal
@@ -42,7 +42,8 @@ Platform::Platform(
     const PlatformCreateInfo&   createInfo,
     const Util::AllocCallbacks& allocCb,
     IPlatform*                  pNextPlatform,
-    GpuProfilerMode             mode)
+    GpuProfilerMode             mode,
+    bool                        binaryLog)
     :
     PlatformDecorator(createInfo,
                       allocCb,
@@ -51,6 +52,7 @@ Platform::Platform(
                       (mode != GpuProfilerDisabled),
                       pNextPlatform),
     m_profilerMode(mode),
+    m_binaryLog(binaryLog),
     m_frameId(0),
     m_forceLogging(false),
     m_apiMajorVer(createInfo.apiMajorVer),
@@ -65,6 +67,7 @@ Result Platform::Create(
     IPlatform*                  pNextPlatform,
     GpuProfilerMode             mode,
     const char*                 pTargetApp,
+    bool                        binaryLog,
     void*                       pPlacementAddr,
     IPlatform**                 ppPlatform)
 {
@@ -87,7 +90,11 @@ Result Platform::Create(
         }
     }
 
-    Platform* pPlatform = PAL_PLACEMENT_NEW(pPlacementAddr) Platform(createInfo, allocCb, pNextPlatform, mode);
+    Platform* pPlatform = PAL_PLACEMENT_NEW(pPlacementAddr) Platform(createInfo,
+                                                                     allocCb,
+                                                                     pNextPlatform,
+                                                                     mode,
+                                                                     binaryLog);
     Result result = pPlatform->Init();
 
     if (result == Result::Success)
@@ -50,6 +50,7 @@ public:
         IPlatform*                  pNextPlatform,
         GpuProfilerMode             mode,
         const char*                 pTargetApp,
+        bool                        binaryLog,
         void*                       pPlacementAddr,
         IPlatform**                 ppPlatform);
 
@@ -57,7 +58,8 @@ public:
         const PlatformCreateInfo&   createInfo,
         const Util::AllocCallbacks& allocCb,
         IPlatform*                  pNextPlatform,
-        GpuProfilerMode             mode);
+        GpuProfilerMode             mode,
+        bool                        binaryLog);
 
     virtual Result Init() override;
 
@@ -85,11 +87,13 @@ public:
 
     Util::Mutex* PipelinePerfDataLock() { return &m_pipelinePerfDataLock;  }
     GpuProfilerMode GetProfilerMode() const { return m_profilerMode; }
+    bool UseBinaryLog() const { return m_binaryLog; }
 
 private:
     virtual ~Platform() { }
 
     GpuProfilerMode m_profilerMode;
+    bool            m_binaryLog;            // Queues write binary log files from a background thread instead of .csv.
     uint32          m_frameId;              // ID incremented on every present call.
     bool            m_forceLogging;         // Indicates logging has been enabled by the user hitting Shift-F11.
     uint16          m_apiMajorVer;          // API major version, used in RGP dumps.
@@ -62,7 +62,10 @@ Queue::Queue(
     m_logItems(static_cast<Platform*>(pDevice->GetPlatform())),
     m_curLogFrame(0),
     m_curLogCmdBufIdx(0),
-    m_curLogSqttIdx(0)
+    m_curLogSqttIdx(0),
+    m_pLogWriter(nullptr),
+    m_binaryLogFrameOpen(false),
+    m_logOutputTicks(0)
 {
     memset(&m_gpaSessionSampleConfig,    0, sizeof(m_gpaSessionSampleConfig));
     memset(&m_nextSubmitInfo,            0, sizeof(m_nextSubmitInfo));
@@ -77,7 +80,13 @@ Queue::~Queue()
     ProcessIdleSubmits();
     m_logFile.Close();
 
+    PAL_DPINFO("GpuProfiler queue %u spent %llu us logging retired items (%u binary log stalls).",
+               m_queueId,
+               (m_logOutputTicks * 1000000ull) / GetPerfFrequency(),
+               (m_pLogWriter != nullptr) ? m_pLogWriter->StallCount() : 0u);
+
     Platform* pPlatform = static_cast<Platform*>(m_pDevice->GetPlatform());
+    PAL_DELETE(m_pLogWriter, pPlatform);
     if (m_nextSubmitInfo.pCmdBufCount != nullptr)
     {
         PAL_SAFE_DELETE_ARRAY(m_nextSubmitInfo.pCmdBufCount, pPlatform);
@@ -320,6 +329,14 @@ Result Queue::Init(
         m_numReportedPerfCounters = numGlobalPerfCounters;
     }
 
+    // Failing to set up the binary log isn't fatal, the queue just goes back to writing .csv files.
+    if ((result == Result::Success) &&
+        static_cast<Platform*>(m_pDevice->GetPlatform())->UseBinaryLog() &&
+        (InitBinaryLog() != Result::Success))
+    {
+        PAL_DPWARN("GpuProfiler failed to create the binary log for queue %u, falling back to .csv logging.", m_queueId);
+    }
+
     return result;
 }
 
@@ -1075,7 +1092,16 @@ void Queue::ProcessIdleSubmits()
         m_pendingSubmits.PopFront(&submitInfo);
 
         // Output items from the log item queue that are now known to be idle.
-        OutputLogItemsToFile(submitInfo.logItemCount, submitInfo.hasDrawOrDispatch);
+        const uint64 logStart = GetPerfCpuTime();
+        if (m_pLogWriter != nullptr)
+        {
+            OutputLogItemsToBinaryLog(submitInfo.logItemCount, submitInfo.hasDrawOrDispatch);
+        }
+        else
+        {
+            OutputLogItemsToFile(submitInfo.logItemCount, submitInfo.hasDrawOrDispatch);
+        }
+        m_logOutputTicks += GetPerfCpuTime() - logStart;
 
         PAL_ASSERT((submitInfo.pCmdBufCount != nullptr) && (submitInfo.pNestedCmdBufCount != nullptr));
 
@@ -27,6 +27,7 @@
 
 #include "core/layers/decorators.h"
 #include "core/layers/functionIds.h"
+#include "core/layers/gpuProfiler/gpuProfilerLogWriter.h"
 #include "palDeque.h"
 #include "palFile.h"
 #include "palGpaSession.h"
@@ -258,6 +259,18 @@ private:
     void OutputGlobalPerfCountersToFile(const LogItem& logItem);
     void OutputTraceDataToFile(const LogItem& logItem);
 
+    Result InitBinaryLog();
+    void   OutputLogItemsToBinaryLog(size_t count, bool hasDrawsDispatches);
+    void   WriteBinaryFrameStart(uint32 frameId);
+    void   WriteBinaryQueueCall(const LogItem& logItem);
+    void   WriteBinaryCmdBufCall(const LogItem& logItem, bool nested);
+    void   WriteBinaryFrame(const LogItem& logItem);
+
+    bool GetTimestampResults(const LogItem& logItem, uint64* pClocks) const;
+    bool GetPipelineStatsResults(const LogItem& logItem, uint64* pStats) const;
+    bool GetGlobalPerfCounterResults(const LogItem& logItem, uint64* pCounters) const;
+    void DumpTraceData(const LogItem& logItem, char* pColumn, size_t columnSize);
+
     Device*const     m_pDevice;
 
     uint32           m_queueCount;
@@ -321,6 +334,10 @@ private:
 
     LogItem                           m_perFrameLogItem;  // Log item used when the profiling granularity is per frame.
 
+    LogWriter*                        m_pLogWriter;         // Writes binary log records in place of m_logFile, if set.
+    bool                              m_binaryLogFrameOpen; // The binary log equivalent of m_logFile.IsOpen().
+    uint64                            m_logOutputTicks;     // Total CPU time spent logging retired items.
+
     PAL_DISALLOW_DEFAULT_CTOR(Queue);
     PAL_DISALLOW_COPY_AND_ASSIGN(Queue);
 };
@@ -595,97 +595,87 @@ void Queue::OutputFrameToFile(
 }
 
 // =====================================================================================================================
-// Output the portion of a .csv with the start/end clock values and time elapsed.  Shared code by all profile
-// granularities.
-void Queue::OutputTimestampsToFile(
+// Returns true if the elapsed time column should be left blank for this log item.  In draw granularity the timestamps
+// of a Begin() call bracket nothing interesting.
+static bool HideElapsedTime(
+    const Device&  device,
     const LogItem& logItem)
 {
-    if (HasValidGpaSample(&logItem, GpuUtil::GpaSampleType::Timing))
-    {
-        uint64 pResult[2] = {};
-        Result result     = logItem.pGpaSession->GetResults(logItem.gpaSampleIdTs,
-                                                            nullptr,
-                                                            pResult);
+    return (device.GetPlatform()->PlatformSettings().gpuProfilerConfig.granularity == GpuProfilerGranularityDraw) &&
+           (logItem.type == LogItemType::CmdBufferCall) &&
+           (logItem.cmdBufCall.callId == CmdBufCallId::Begin);
+}
 
-        m_logFile.Printf("%llu,%llu,", pResult[0], pResult[1]);
+// =====================================================================================================================
+// Fetches the start and end clocks of this log item.  Returns false if the item has no timing sample.
+bool Queue::GetTimestampResults(
+    const LogItem& logItem,
+    uint64*        pClocks  // [out] Two clock values.
+    ) const
+{
+    const bool valid = HasValidGpaSample(&logItem, GpuUtil::GpaSampleType::Timing);
 
-        bool hideElapsedTime =
-            (m_pDevice->GetPlatform()->PlatformSettings().gpuProfilerConfig.granularity ==
-                GpuProfilerGranularityDraw) &&
-            (logItem.type == LogItemType::CmdBufferCall) &&
-            (logItem.cmdBufCall.callId == CmdBufCallId::Begin);
+    pClocks[0] = 0;
+    pClocks[1] = 0;
 
-        // Print the elapsed time for this call if pre-call/post-call timestamps were inserted.
-        if (!hideElapsedTime)
-        {
-            const double tsDiff   = static_cast<double>(pResult[1] - pResult[0]);
-            const double timeInUs = 1000000 * tsDiff / m_pDevice->TimestampFreq();
-
-            m_logFile.Printf("%.2lf,", timeInUs);
-        }
-        else
-        {
-            m_logFile.Printf(",");
-        }
-    }
-    else
+    if (valid)
     {
-        m_logFile.Printf(",,,");
+        logItem.pGpaSession->GetResults(logItem.gpaSampleIdTs, nullptr, pClocks);
     }
+
+    return valid;
 }
 
 // =====================================================================================================================
-// Output pipeline stats to file.  Only supported by draw/cmdbuf granularities.
-void Queue::OutputPipelineStatsToFile(
-    const LogItem& logItem)
+// Fetches the pipeline stats of this log item.  Returns false if the item has no pipeline stats sample.
+bool Queue::GetPipelineStatsResults(
+    const LogItem& logItem,
+    uint64*        pStats   // [out] BinaryLogNumPipelineStats values.
+    ) const
 {
-    if (HasValidGpaSample(&logItem, GpuUtil::GpaSampleType::Query))
+    const bool valid = HasValidGpaSample(&logItem, GpuUtil::GpaSampleType::Query);
+
+    memset(pStats, 0, sizeof(uint64) * BinaryLogNumPipelineStats);
+
+    if (valid)
     {
         // Allocate max number of pipeline stats counters.
-        uint64 pipelineStats[14] = {};
-        size_t pipelineStatsSize = sizeof(pipelineStats);
+        size_t pipelineStatsSize = sizeof(uint64) * BinaryLogNumPipelineStats;
         const Result result = logItem.pGpaSession->GetResults(logItem.gpaSampleIdQuery,
                                                               &pipelineStatsSize,
-                                                              pipelineStats);
+                                                              pStats);
 
         PAL_ASSERT(result == Result::Success);
 #if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 631
-        PAL_ASSERT(pipelineStatsSize == sizeof(pipelineStats));
+        PAL_ASSERT(pipelineStatsSize == sizeof(uint64) * BinaryLogNumPipelineStats);
 #else
         // Mesh/task pipeline stats are not available until interface exposes them.
-        PAL_ASSERT(pipelineStatsSize <= sizeof(pipelineStats));
+        PAL_ASSERT(pipelineStatsSize <= sizeof(uint64) * BinaryLogNumPipelineStats);
 #endif
-
-        // PAL hardcodes the layout of the return pipeline stats values based on the client, leading to different
-        // versions of this code to a uniform log layout.
-        m_logFile.Printf("%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,", pipelineStats[0],
-                         pipelineStats[1], pipelineStats[2], pipelineStats[3], pipelineStats[4], pipelineStats[5],
-                         pipelineStats[6], pipelineStats[7], pipelineStats[8], pipelineStats[9], pipelineStats[10],
-                         pipelineStats[11], pipelineStats[12], pipelineStats[13]);
-
-    }
-    else if (m_pDevice->GetPlatform()->PlatformSettings().gpuProfilerConfig.recordPipelineStats)
-    {
-        m_logFile.Printf(",,,,,,,,,,,,,,");
     }
+
+    return valid;
 }
 
 // =====================================================================================================================
-// Dump the enabled global perf counters to file.  Shared code between draw/cmdbuf and per-frame profile granularities.
-void Queue::OutputGlobalPerfCountersToFile(
-    const LogItem& logItem)
+// Fetches the enabled global perf counters of this log item, summing the results from every instance of each counter.
+// Returns false if the item has no perf counter sample or its results couldn't be read.
+bool Queue::GetGlobalPerfCounterResults(
+    const LogItem& logItem,
+    uint64*        pCounters    // [out] m_numReportedPerfCounters values.
+    ) const
 {
-    const PerfCounter* pGlobalPerfCounters   = m_pDevice->GlobalPerfCounters();
+    const PerfCounter* pPerfCounters         = m_pDevice->GlobalPerfCounters();
     const uint32       numGlobalPerfCounters = m_pDevice->NumGlobalPerfCounters();
 
+    Result result = Result::ErrorUnavailable;
+
     if ((numGlobalPerfCounters > 0) && HasValidGpaSample(&logItem, GpuUtil::GpaSampleType::Cumulative))
     {
         void*  pResult  = nullptr;
         size_t dataSize = 0;
 
-        Result result = logItem.pGpaSession->GetResults(logItem.gpaSampleId,
-                                                        &dataSize,
-                                                        pResult);
+        result = logItem.pGpaSession->GetResults(logItem.gpaSampleId, &dataSize, pResult);
         PAL_ASSERT(dataSize != 0);
 
         if (result == Result::Success)
@@ -699,44 +689,104 @@ void Queue::OutputGlobalPerfCountersToFile(
 
         if (result == Result::Success)
         {
-            result = logItem.pGpaSession->GetResults(logItem.gpaSampleId,
-                                                             &dataSize,
-                                                             pResult);
+            result = logItem.pGpaSession->GetResults(logItem.gpaSampleId, &dataSize, pResult);
         }
 
         if (result == Result::Success)
         {
-            AutoBuffer<uint64, 128, PlatformDecorator> data(m_numReportedPerfCounters, m_pDevice->GetPlatform());
-            PAL_ASSERT(data.Capacity() >= m_numReportedPerfCounters);
-
-            // Zero out the reported value for each counter.  The results from each instance of that counter will be
-            // accumulated into this array.
-
-            const PerfCounter* pPerfCounters = m_pDevice->GlobalPerfCounters();
+            // The results from each instance of a counter are accumulated into its reported value.
             uint32 pidIndex = 0;
 
             for (uint32 i = 0; i < numGlobalPerfCounters; i++)
             {
                 const uint64 instanceMask = pPerfCounters[i].instanceMask;
-                data[i] = 0;
+                pCounters[i] = 0;
                 for (uint32 j = 0; j < pPerfCounters[i].instanceCount; j++)
                 {
                     if ((instanceMask == 0) || Util::BitfieldIsSet(instanceMask, j))
                     {
-                        data[i] += static_cast<uint64*>(pResult)[pidIndex++];
+                        pCounters[i] += static_cast<uint64*>(pResult)[pidIndex++];
                     }
                 }
             }
 
             PAL_ASSERT(pidIndex == m_gpaSessionSampleConfig.perfCounters.numCounters);
+        }
 
-            PAL_SAFE_FREE(pResult, m_pDevice->GetPlatform());
+        PAL_SAFE_FREE(pResult, m_pDevice->GetPlatform());
+    }
 
-            // Output into .csv file.
-            for (uint32 i = 0; i < m_numReportedPerfCounters; i++)
-            {
-                m_logFile.Printf("%llu,", data[i]);
-            }
+    return (result == Result::Success);
+}
+
+// =====================================================================================================================
+// Output the portion of a .csv with the start/end clock values and time elapsed.  Shared code by all profile
+// granularities.
+void Queue::OutputTimestampsToFile(
+    const LogItem& logItem)
+{
+    uint64 clocks[2] = {};
+
+    if (GetTimestampResults(logItem, &clocks[0]))
+    {
+        m_logFile.Printf("%llu,%llu,", clocks[0], clocks[1]);
+
+        // Print the elapsed time for this call if pre-call/post-call timestamps were inserted.
+        if (HideElapsedTime(*m_pDevice, logItem) == false)
+        {
+            const double tsDiff   = static_cast<double>(clocks[1] - clocks[0]);
+            const double timeInUs = 1000000 * tsDiff / m_pDevice->TimestampFreq();
+
+            m_logFile.Printf("%.2lf,", timeInUs);
+        }
+        else
+        {
+            m_logFile.Printf(",");
+        }
+    }
+    else
+    {
+        m_logFile.Printf(",,,");
+    }
+}
+
+// =====================================================================================================================
+// Output pipeline stats to file.  Only supported by draw/cmdbuf granularities.
+void Queue::OutputPipelineStatsToFile(
+    const LogItem& logItem)
+{
+    uint64 pipelineStats[BinaryLogNumPipelineStats] = {};
+
+    if (GetPipelineStatsResults(logItem, &pipelineStats[0]))
+    {
+        // PAL hardcodes the layout of the return pipeline stats values based on the client, leading to different
+        // versions of this code to a uniform log layout.
+        m_logFile.Printf("%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,", pipelineStats[0],
+                         pipelineStats[1], pipelineStats[2], pipelineStats[3], pipelineStats[4], pipelineStats[5],
+                         pipelineStats[6], pipelineStats[7], pipelineStats[8], pipelineStats[9], pipelineStats[10],
+                         pipelineStats[11], pipelineStats[12], pipelineStats[13]);
+
+    }
+    else if (m_pDevice->GetPlatform()->PlatformSettings().gpuProfilerConfig.recordPipelineStats)
+    {
+        m_logFile.Printf(",,,,,,,,,,,,,,");
+    }
+}
+
+// =====================================================================================================================
+// Dump the enabled global perf counters to file.  Shared code between draw/cmdbuf and per-frame profile granularities.
+void Queue::OutputGlobalPerfCountersToFile(
+    const LogItem& logItem)
+{
+    AutoBuffer<uint64, 128, PlatformDecorator> data(m_numReportedPerfCounters, m_pDevice->GetPlatform());
+    PAL_ASSERT(data.Capacity() >= m_numReportedPerfCounters);
+
+    if ((m_numReportedPerfCounters > 0) && GetGlobalPerfCounterResults(logItem, &data[0]))
+    {
+        // Output into .csv file.
+        for (uint32 i = 0; i < m_numReportedPerfCounters; i++)
+        {
+            m_logFile.Printf("%llu,", data[i]);
         }
     }
     else
@@ -749,12 +799,31 @@ void Queue::OutputGlobalPerfCountersToFile(
 }
 
 // =====================================================================================================================
-// Dumps the SQ thread trace data and/or spm trace data from this experiment out to file.
+// Writes the ThreadTraceId column to the log file after dumping any trace data out to separate files.
 void Queue::OutputTraceDataToFile(
     const LogItem& logItem)
+{
+    char column[64];
+    DumpTraceData(logItem, &column[0], sizeof(column));
+
+    if (column[0] != '\0')
+    {
+        m_logFile.Write(&column[0], strlen(&column[0]));
+    }
+}
+
+// =====================================================================================================================
+// Dumps the SQ thread trace data and/or spm trace data from this experiment out to file and returns the text of the
+// ThreadTraceId column in pColumn.  The column is empty if nothing should be printed for it.
+void Queue::DumpTraceData(
+    const LogItem& logItem,
+    char*          pColumn,
+    size_t         columnSize)
 {
     const auto& settings = m_pDevice->GetPlatform()->PlatformSettings();
 
+    pColumn[0] = '\0';
+
     if ((m_pDevice->NumGlobalPerfCounters() == 0) &&
         (m_pDevice->IsSpmTraceEnabled() || m_pDevice->IsThreadTraceEnabled()) &&
         (HasValidGpaSample(&logItem, GpuUtil::GpaSampleType::Trace)))
@@ -766,11 +835,11 @@ void Queue::OutputTraceDataToFile(
                 GpuProfilerGranularity::GpuProfilerGranularityFrame)
             {
                 OutputRgpFile(*logItem.pGpaSession, logItem.gpaSampleId);
-                m_logFile.Printf("%u,", m_curLogFrame);
+                Snprintf(pColumn, columnSize, "%u,", m_curLogFrame);
             }
             else
             {
-                m_logFile.Printf("USE FRAME-GRANULARITY FOR RGP,");
+                Snprintf(pColumn, columnSize, "USE FRAME-GRANULARITY FOR RGP,");
             }
         }
         else if (m_pDevice->GetProfilerMode() == GpuProfilerTraceEnabledTtv)
@@ -836,7 +905,7 @@ void Queue::OutputTraceDataToFile(
                         pDesc = static_cast<const SqttFileChunkSqttDesc*>(VoidPtrInc(pResult, offset));
                     }
 
-                    m_logFile.Printf("%u,", m_curLogSqttIdx++);
+                    Snprintf(pColumn, columnSize, "%u,", m_curLogSqttIdx++);
                 }
 
                 // Spm trace chunk: Begin output of Spm trace data as a separate .csv file
@@ -926,17 +995,441 @@ void Queue::OutputTraceDataToFile(
     {
         // TODO: this error is set under none case yet.
         // GpaSession::BeginSample hits an ASSERT if this error happens.
-        m_logFile.Printf("ERROR: OUT OF MEMORY,");
+        Snprintf(pColumn, columnSize, "ERROR: OUT OF MEMORY,");
     }
     else if (logItem.errors.perfExpUnsupported != 0)
     {
-        m_logFile.Printf("ERROR: THREAD TRACE UNSUPPORTED,");
+        Snprintf(pColumn, columnSize, "ERROR: THREAD TRACE UNSUPPORTED,");
     }
     else
     {
-        m_logFile.Printf(",");
+        Snprintf(pColumn, columnSize, ",");
     }
 }
 
+// =====================================================================================================================
+// Copies size bytes into a binary log record and returns the location following them.
+static void* AppendToRecord(
+    void*       pDst,
+    const void* pSrc,
+    size_t      size)
+{
+    memcpy(pDst, pSrc, size);
+    return VoidPtrInc(pDst, size);
+}
+
+// =====================================================================================================================
+// Copies a string into a binary log record and returns the location following it.
+static void* AppendStringToRecord(
+    void*       pDst,
+    const char* pString,
+    uint32      length)
+{
+    pDst = AppendToRecord(pDst, &length, sizeof(length));
+    return AppendToRecord(pDst, pString, length);
+}
+
+// =====================================================================================================================
+// Creates the binary log writer for this queue and writes the file header record.  Every queue gets its own file,
+// which is named like the per-frame .csv files but without the frame number.
+Result Queue::InitBinaryLog()
+{
+    // The ring must be able to hold a good number of frames worth of draw-granularity records so the writer thread
+    // only holds up the queue if the disk can't keep up.
+    constexpr size_t RingSize = 4 * 1024 * 1024;
+
+    Platform* pPlatform = static_cast<Platform*>(m_pDevice->GetPlatform());
+    Result    result    = Result::ErrorOutOfMemory;
+
+    m_pLogWriter = PAL_NEW(LogWriter, pPlatform, AllocInternal)(pPlatform);
+
+    if (m_pLogWriter != nullptr)
+    {
+        char fileName[512];
+        Snprintf(&fileName[0],
+                 sizeof(fileName),
+                 "%s/Dev%uEng%s%u-%02u.pgl",
+                 pPlatform->LogDirPath(),
+                 m_pDevice->Id(),
+                 EngineTypeStrings[static_cast<uint32>(m_pQueueInfos[0].engineType)],
+                 m_pQueueInfos[0].engineIndex,
+                 m_queueId);
+
+        result = m_pLogWriter->Init(&fileName[0], RingSize);
+    }
+
+    if (result == Result::Success)
+    {
+        const auto&        settings              = pPlatform->PlatformSettings();
+        const uint32       numGlobalPerfCounters = m_pDevice->NumGlobalPerfCounters();
+        const PerfCounter* pPerfCounters         = m_pDevice->GlobalPerfCounters();
+
+        BinaryLogFileHeader header = {};
+        header.magic                   = BinaryLogMagic;
+        header.version                 = BinaryLogVersion;
+        header.timestampFreq           = m_pDevice->TimestampFreq();
+        header.deviceId                = m_pDevice->Id();
+        header.engineIndex             = m_pQueueInfos[0].engineIndex;
+        header.queueId                 = m_queueId;
+        header.numPerfCounters         = numGlobalPerfCounters;
+        header.numReportedPerfCounters = m_numReportedPerfCounters;
+        header.numQueueCallNames       = static_cast<uint32>(QueueCallId::Count);
+        header.numCmdBufCallNames      = static_cast<uint32>(CmdBufCallId::Count);
+        Strncpy(&header.engineName[0],
+                EngineTypeStrings[static_cast<uint32>(m_pQueueInfos[0].engineType)],
+                sizeof(header.engineName));
+
+        if (settings.gpuProfilerConfig.useFullPipelineHash)
+        {
+            header.fileFlags |= BinaryLogFileFullPipelineHash;
+        }
+        if (m_pDevice->IsThreadTraceEnabled())
+        {
+            header.fileFlags |= BinaryLogFileThreadTrace;
+        }
+        if (settings.gpuProfilerConfig.recordPipelineStats)
+        {
+            header.fileFlags |= BinaryLogFilePipelineStats;
+        }
+
+        // Storing the names makes the files self-describing, so they can still be converted after the function IDs
+        // change.
+        size_t payloadSize = sizeof(header);
+        for (uint32 i = 0; i < numGlobalPerfCounters; i++)
+        {
+            payloadSize += sizeof(uint32) + strlen(&pPerfCounters[i].name[0]);
+        }
+        for (uint32 i = 0; i < header.numQueueCallNames; i++)
+        {
+            payloadSize += sizeof(uint32) + strlen(QueueCallIdStrings[i]);
+        }
+        for (uint32 i = 0; i < header.numCmdBufCallNames; i++)
+        {
+            payloadSize += sizeof(uint32) + strlen(CmdBufCallIdStrings[i]);
+        }
+
+        void* pData = m_pLogWriter->BeginRecord(BinaryLogRecordType::FileHeader, 0, payloadSize);
+
+        pData = AppendToRecord(pData, &header, sizeof(header));
+        for (uint32 i = 0; i < numGlobalPerfCounters; i++)
+        {
+            const char* pName = &pPerfCounters[i].name[0];
+            pData = AppendStringToRecord(pData, pName, static_cast<uint32>(strlen(pName)));
+        }
+        for (uint32 i = 0; i < header.numQueueCallNames; i++)
+        {
+            pData = AppendStringToRecord(pData,
+                                         QueueCallIdStrings[i],
+                                         static_cast<uint32>(strlen(QueueCallIdStrings[i])));
+        }
+        for (uint32 i = 0; i < header.numCmdBufCallNames; i++)
+        {
+            pData = AppendStringToRecord(pData,
+                                         CmdBufCallIdStrings[i],
+                                         static_cast<uint32>(strlen(CmdBufCallIdStrings[i])));
+        }
+
+        m_pLogWriter->EndRecord();
+        m_pLogWriter->Flush();
+    }
+    else
+    {
+        PAL_SAFE_DELETE(m_pLogWriter, pPlatform);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Binary log equivalent of OutputLogItemsToFile().  The caller guarantees that all of these calls are idle.  The GPA
+// session results are still resolved here because the sessions are recycled as soon as this returns, but all of the
+// formatting and file I/O is left to the converter and the writer thread respectively.
+void Queue::OutputLogItemsToBinaryLog(
+    size_t count,
+    bool   hasDrawsDispatches)
+{
+    PAL_ASSERT(count <= m_logItems.NumElements());
+
+    // See OutputLogItemsToFile() for how nested command buffers and m_curLogCmdBufIdx are tracked.
+    uint32 activeCmdBufs = 0;
+
+    const auto& settings = m_pDevice->GetPlatform()->PlatformSettings();
+
+    const bool writeResults = (settings.gpuProfilerConfig.ignoreNonDrawDispatchCmdBufs) ? hasDrawsDispatches : true;
+
+    for (uint32 i = 0; i < count; i++)
+    {
+        LogItem logItem = { };
+        m_logItems.PopFront(&logItem);
+
+        // The fence bundled to this submit wave should promise GpaSession ready.
+        PAL_ASSERT((logItem.pGpaSession == nullptr) || logItem.pGpaSession->IsReady());
+
+        if (logItem.type == CmdBufferCall)
+        {
+            if (logItem.cmdBufCall.callId == CmdBufCallId::Begin)
+            {
+                PAL_ASSERT(activeCmdBufs <= 1);
+                activeCmdBufs++;
+
+                m_curLogSqttIdx = 0;
+            }
+
+            if ((m_binaryLogFrameOpen == false) || (m_curLogFrame != logItem.frameId))
+            {
+                WriteBinaryFrameStart(logItem.frameId);
+            }
+
+            if (writeResults)
+            {
+                WriteBinaryCmdBufCall(logItem, (activeCmdBufs == 2));
+            }
+
+            if (logItem.cmdBufCall.callId == CmdBufCallId::End)
+            {
+                PAL_ASSERT((activeCmdBufs > 0) && (activeCmdBufs <= 2));
+                m_curLogCmdBufIdx += (--activeCmdBufs == 0) ? 1 : 0;
+            }
+        }
+        else if (logItem.type == QueueCall)
+        {
+            if ((m_binaryLogFrameOpen == false) || (m_curLogFrame != logItem.frameId))
+            {
+                WriteBinaryFrameStart(logItem.frameId);
+            }
+
+            WriteBinaryQueueCall(logItem);
+        }
+        else if (logItem.type == Frame)
+        {
+            m_curLogFrame = logItem.frameId;
+            WriteBinaryFrame(logItem);
+        }
+    }
+
+    m_pLogWriter->Flush();
+}
+
+// =====================================================================================================================
+// Binary log equivalent of OpenLogFile().
+void Queue::WriteBinaryFrameStart(
+    uint32 frameId)
+{
+    void* pData = m_pLogWriter->BeginRecord(BinaryLogRecordType::FrameStart, 0, sizeof(frameId));
+    AppendToRecord(pData, &frameId, sizeof(frameId));
+    m_pLogWriter->EndRecord();
+
+    m_binaryLogFrameOpen = true;
+    m_curLogFrame        = frameId;
+    m_curLogCmdBufIdx    = 0;
+}
+
+// =====================================================================================================================
+// Binary log equivalent of OutputQueueCallToFile().
+void Queue::WriteBinaryQueueCall(
+    const LogItem& logItem)
+{
+    PAL_ASSERT(logItem.type == QueueCall);
+
+    const uint32 payload[] = { logItem.frameId, static_cast<uint32>(logItem.queueCall.callId) };
+
+    void* pData = m_pLogWriter->BeginRecord(BinaryLogRecordType::QueueCall, 0, sizeof(payload));
+    AppendToRecord(pData, &payload[0], sizeof(payload));
+    m_pLogWriter->EndRecord();
+}
+
+// =====================================================================================================================
+// Binary log equivalent of OutputCmdBufCallToFile().
+void Queue::WriteBinaryCmdBufCall(
+    const LogItem& logItem,
+    bool           nested)
+{
+    PAL_ASSERT(logItem.type == CmdBufferCall);
+
+    constexpr uint32 CsIdx = static_cast<uint32>(ShaderType::Compute);
+    constexpr uint32 TsIdx = static_cast<uint32>(ShaderType::Task);
+    constexpr uint32 VsIdx = static_cast<uint32>(ShaderType::Vertex);
+    constexpr uint32 HsIdx = static_cast<uint32>(ShaderType::Hull);
+    constexpr uint32 DsIdx = static_cast<uint32>(ShaderType::Domain);
+    constexpr uint32 GsIdx = static_cast<uint32>(ShaderType::Geometry);
+    constexpr uint32 MsIdx = static_cast<uint32>(ShaderType::Mesh);
+    constexpr uint32 PsIdx = static_cast<uint32>(ShaderType::Pixel);
+
+    const auto& cmdBufItem = logItem.cmdBufCall;
+
+    BinaryLogCmdBufCall call = {};
+    call.frameId     = m_curLogFrame;
+    call.cmdBufIdx   = m_curLogCmdBufIdx;
+    call.callId      = static_cast<uint32>(cmdBufItem.callId);
+    call.subQueueIdx = cmdBufItem.subQueueIdx;
+
+    uint32 flags       = nested ? BinaryLogNested : 0;
+    size_t payloadSize = sizeof(call);
+
+    // The pipeline section is the same for every kind of pipelined call, only the shader columns differ.
+    uint64 pipelineHashes[3 + (2 * BinaryLogNumShaderHashes)] = {};
+    uint32 counts[2]                                           = {};
+    if (cmdBufItem.flags.draw || cmdBufItem.flags.dispatch || cmdBufItem.flags.taskmesh)
+    {
+        const PipelineInfo& pipelineInfo = cmdBufItem.draw.pipelineInfo;
+
+        // Shader columns which don't apply to this kind of call are left zeroed and converted into blank columns.
+        constexpr uint32 NoShader = UINT32_MAX;
+        uint32 shaderIdx[BinaryLogNumShaderHashes] = { NoShader, NoShader, NoShader, NoShader, NoShader };
+
+        if (cmdBufItem.flags.draw)
+        {
+            flags       |= BinaryLogDraw;
+            shaderIdx[0] = VsIdx;
+            shaderIdx[1] = HsIdx;
+            shaderIdx[2] = DsIdx;
+            shaderIdx[3] = GsIdx;
+            shaderIdx[4] = PsIdx;
+            counts[0]    = cmdBufItem.draw.vertexCount;
+            counts[1]    = cmdBufItem.draw.instanceCount;
+        }
+        else if (cmdBufItem.flags.dispatch)
+        {
+            flags       |= BinaryLogDispatch;
+            shaderIdx[0] = CsIdx;
+            counts[0]    = cmdBufItem.dispatch.threadGroupCount;
+        }
+        else
+        {
+            flags       |= BinaryLogTaskMesh;
+            shaderIdx[0] = TsIdx;
+            shaderIdx[3] = MsIdx;
+            shaderIdx[4] = PsIdx;
+            counts[0]    = cmdBufItem.taskmesh.threadGroupCount;
+        }
+
+        pipelineHashes[0] = cmdBufItem.draw.apiPsoHash;
+        pipelineHashes[1] = pipelineInfo.internalPipelineHash.stable;
+        pipelineHashes[2] = pipelineInfo.internalPipelineHash.unique;
+
+        for (uint32 i = 0; i < BinaryLogNumShaderHashes; i++)
+        {
+            if (shaderIdx[i] != NoShader)
+            {
+                pipelineHashes[3 + (2 * i)] = pipelineInfo.shader[shaderIdx[i]].hash.upper;
+                pipelineHashes[4 + (2 * i)] = pipelineInfo.shader[shaderIdx[i]].hash.lower;
+            }
+        }
+
+        payloadSize += sizeof(pipelineHashes) + sizeof(counts);
+    }
+
+    const char* pComment      = nullptr;
+    uint32      commentLength = 0;
+    if (cmdBufItem.flags.barrier || cmdBufItem.flags.comment)
+    {
+        pComment = cmdBufItem.flags.barrier ? cmdBufItem.barrier.pComment : cmdBufItem.comment.string;
+        pComment = (pComment != nullptr) ? pComment : "";
+
+        commentLength = static_cast<uint32>(strlen(pComment));
+        flags        |= BinaryLogComment;
+        payloadSize  += sizeof(uint32) + commentLength;
+    }
+
+    uint64 clocks[2] = {};
+    if (GetTimestampResults(logItem, &clocks[0]))
+    {
+        flags       |= BinaryLogTimestamps | (HideElapsedTime(*m_pDevice, logItem) ? BinaryLogHideElapsed : 0);
+        payloadSize += sizeof(clocks);
+    }
+
+    uint64 pipelineStats[BinaryLogNumPipelineStats] = {};
+    if (GetPipelineStatsResults(logItem, &pipelineStats[0]))
+    {
+        flags       |= BinaryLogPipelineStats;
+        payloadSize += sizeof(pipelineStats);
+    }
+
+    AutoBuffer<uint64, 128, PlatformDecorator> perfCounters(m_numReportedPerfCounters, m_pDevice->GetPlatform());
+    if ((m_numReportedPerfCounters > 0) && GetGlobalPerfCounterResults(logItem, &perfCounters[0]))
+    {
+        flags       |= BinaryLogPerfCounters;
+        payloadSize += sizeof(uint64) * m_numReportedPerfCounters;
+    }
+
+    char traceColumn[64];
+    DumpTraceData(logItem, &traceColumn[0], sizeof(traceColumn));
+
+    const uint32 traceColumnLength = static_cast<uint32>(strlen(&traceColumn[0]));
+    payloadSize += sizeof(uint32) + traceColumnLength;
+
+    void* pData = m_pLogWriter->BeginRecord(BinaryLogRecordType::CmdBufCall, flags, payloadSize);
+
+    pData = AppendToRecord(pData, &call, sizeof(call));
+    if (TestAnyFlagSet(flags, BinaryLogDraw | BinaryLogDispatch | BinaryLogTaskMesh))
+    {
+        pData = AppendToRecord(pData, &pipelineHashes[0], sizeof(pipelineHashes));
+        pData = AppendToRecord(pData, &counts[0], sizeof(counts));
+    }
+    if (TestAnyFlagSet(flags, BinaryLogComment))
+    {
+        pData = AppendStringToRecord(pData, pComment, commentLength);
+    }
+    if (TestAnyFlagSet(flags, BinaryLogTimestamps))
+    {
+        pData = AppendToRecord(pData, &clocks[0], sizeof(clocks));
+    }
+    if (TestAnyFlagSet(flags, BinaryLogPipelineStats))
+    {
+        pData = AppendToRecord(pData, &pipelineStats[0], sizeof(pipelineStats));
+    }
+    if (TestAnyFlagSet(flags, BinaryLogPerfCounters))
+    {
+        pData = AppendToRecord(pData, &perfCounters[0], sizeof(uint64) * m_numReportedPerfCounters);
+    }
+    AppendStringToRecord(pData, &traceColumn[0], traceColumnLength);
+
+    m_pLogWriter->EndRecord();
+}
+
+// =====================================================================================================================
+// Binary log equivalent of OutputFrameToFile().
+void Queue::WriteBinaryFrame(
+    const LogItem& logItem)
+{
+    uint32 flags       = 0;
+    size_t payloadSize = sizeof(uint32);
+
+    uint64 clocks[2] = {};
+    if (GetTimestampResults(logItem, &clocks[0]))
+    {
+        flags       |= BinaryLogTimestamps;
+        payloadSize += sizeof(clocks);
+    }
+
+    AutoBuffer<uint64, 128, PlatformDecorator> perfCounters(m_numReportedPerfCounters, m_pDevice->GetPlatform());
+    if ((m_numReportedPerfCounters > 0) && GetGlobalPerfCounterResults(logItem, &perfCounters[0]))
+    {
+        flags       |= BinaryLogPerfCounters;
+        payloadSize += sizeof(uint64) * m_numReportedPerfCounters;
+    }
+
+    char traceColumn[64];
+    DumpTraceData(logItem, &traceColumn[0], sizeof(traceColumn));
+
+    const uint32 traceColumnLength = static_cast<uint32>(strlen(&traceColumn[0]));
+    payloadSize += sizeof(uint32) + traceColumnLength;
+
+    void* pData = m_pLogWriter->BeginRecord(BinaryLogRecordType::Frame, flags, payloadSize);
+
+    pData = AppendToRecord(pData, &logItem.frameId, sizeof(uint32));
+    if (TestAnyFlagSet(flags, BinaryLogTimestamps))
+    {
+        pData = AppendToRecord(pData, &clocks[0], sizeof(clocks));
+    }
+    if (TestAnyFlagSet(flags, BinaryLogPerfCounters))
+    {
+        pData = AppendToRecord(pData, &perfCounters[0], sizeof(uint64) * m_numReportedPerfCounters);
+    }
+    AppendStringToRecord(pData, &traceColumn[0], traceColumnLength);
+
+    m_pLogWriter->EndRecord();
+}
+
 } // GpuProfiler
 } // Pal
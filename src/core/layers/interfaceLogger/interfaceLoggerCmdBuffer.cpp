@@ -2993,6 +2993,77 @@ uint32* CmdBuffer::CmdAllocateEmbeddedData(
     return pCpuAddr;
 }
 
+// =====================================================================================================================
+Result CmdBuffer::CmdAllocatePatchableData(
+    uint32             sizeInDwords,
+    uint32             alignmentInDwords,
+    PatchableDataInfo* pInfo)
+{
+    BeginFuncInfo funcInfo;
+    funcInfo.funcId       = InterfaceFunc::CmdBufferCmdAllocatePatchableData;
+    funcInfo.objectId     = m_objectId;
+    funcInfo.preCallTime  = m_pPlatform->GetTime();
+    const Result result   = m_pNextLayer->CmdAllocatePatchableData(sizeInDwords, alignmentInDwords, pInfo);
+    funcInfo.postCallTime = m_pPlatform->GetTime();
+
+    LogContext* pLogContext = nullptr;
+    if (m_pPlatform->LogBeginFunc(funcInfo, &pLogContext))
+    {
+        pLogContext->BeginInput();
+        pLogContext->KeyAndValue("sizeInDwords", sizeInDwords);
+        pLogContext->KeyAndValue("alignmentInDwords", alignmentInDwords);
+        pLogContext->EndInput();
+
+        pLogContext->BeginOutput();
+        pLogContext->KeyAndEnum("result", result);
+
+        if (result == Result::Success)
+        {
+            pLogContext->KeyAndValue("gpuAddr", pInfo->gpuAddr);
+            pLogContext->KeyAndValue("patchId", pInfo->patchId);
+        }
+
+        pLogContext->EndOutput();
+
+        m_pPlatform->LogEndFunc(pLogContext);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+Result CmdBuffer::PatchEmbeddedData(
+    uint32        patchId,
+    uint32        dwordOffset,
+    uint32        dwordCount,
+    const uint32* pData)
+{
+    BeginFuncInfo funcInfo;
+    funcInfo.funcId       = InterfaceFunc::CmdBufferPatchEmbeddedData;
+    funcInfo.objectId     = m_objectId;
+    funcInfo.preCallTime  = m_pPlatform->GetTime();
+    const Result result   = m_pNextLayer->PatchEmbeddedData(patchId, dwordOffset, dwordCount, pData);
+    funcInfo.postCallTime = m_pPlatform->GetTime();
+
+    LogContext* pLogContext = nullptr;
+    if (m_pPlatform->LogBeginFunc(funcInfo, &pLogContext))
+    {
+        pLogContext->BeginInput();
+        pLogContext->KeyAndValue("patchId", patchId);
+        pLogContext->KeyAndValue("dwordOffset", dwordOffset);
+        pLogContext->KeyAndValue("dwordCount", dwordCount);
+        pLogContext->EndInput();
+
+        pLogContext->BeginOutput();
+        pLogContext->KeyAndEnum("result", result);
+        pLogContext->EndOutput();
+
+        m_pPlatform->LogEndFunc(pLogContext);
+    }
+
+    return result;
+}
+
 // =====================================================================================================================
 Result CmdBuffer::AllocateAndBindGpuMemToEvent(
     IGpuEvent* pGpuEvent)
@@ -178,6 +178,8 @@ enum class InterfaceFunc : uint32
     CmdBufferCmdDumpCeRam,
     CmdBufferCmdWriteCeRam,
     CmdBufferCmdAllocateEmbeddedData,
+    CmdBufferCmdAllocatePatchableData,
+    CmdBufferPatchEmbeddedData,
     CmdBufferCmdExecuteNestedCmdBuffers,
     CmdBufferCmdSaveComputeState,
     CmdBufferCmdRestoreComputeState,
@@ -163,6 +163,8 @@ static constexpr FuncLoggingTableEntry FuncLoggingTable[] =
     { InterfaceFunc::CmdBufferCmdDumpCeRam,                         (CmdBuild)            },
     { InterfaceFunc::CmdBufferCmdWriteCeRam,                        (CmdBuild)            },
     { InterfaceFunc::CmdBufferCmdAllocateEmbeddedData,              (CmdBuild)            },
+    { InterfaceFunc::CmdBufferCmdAllocatePatchableData,             (CmdBuild)            },
+    { InterfaceFunc::CmdBufferPatchEmbeddedData,                    (CmdBuild)            },
     { InterfaceFunc::CmdBufferCmdExecuteNestedCmdBuffers,           (CmdBuild)            },
     { InterfaceFunc::CmdBufferCmdSaveComputeState,                  (CmdBuild)            },
     { InterfaceFunc::CmdBufferCmdRestoreComputeState,               (CmdBuild)            },
@@ -182,9 +182,25 @@ Result PAL_STDCALL CreatePlatform(
 
     Platform* pCorePlatform = nullptr;
 
+    InternalSlabAllocator* pSlabAllocator = nullptr;
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    if ((result == Result::Success) && createInfo.flags.enableSlabAllocator)
+    {
+        // Every layer and the core platform must see the slab allocator's callbacks so that all internal allocations
+        // are routed through it.  The core platform takes ownership of it below.
+        result = Platform::CreateSlabAllocator(allocCb, &pSlabAllocator);
+
+        if (result == Result::Success)
+        {
+            pSlabAllocator->slabAllocator.GetAllocCallbacks(&allocCb);
+        }
+    }
+#endif
+
     if (result == Result::Success)
     {
-        result = Platform::Create(createInfo, allocCb, pPlacementAddr, &pCorePlatform);
+        result = Platform::Create(createInfo, allocCb, pSlabAllocator, pPlacementAddr, &pCorePlatform);
     }
 
     IPlatform* pCurPlatform = pCorePlatform;
@@ -245,6 +261,7 @@ Result PAL_STDCALL CreatePlatform(
                                                pCurPlatform,
                                                pCorePlatform->PlatformSettings().gpuProfilerMode,
                                                pCorePlatform->PlatformSettings().gpuProfilerConfig.targetApplication,
+                                               pCorePlatform->GpuProfilerBinaryLog(),
                                                pPlacementAddr,
                                                &pCurPlatform);
     }
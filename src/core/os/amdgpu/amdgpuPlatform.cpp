@@ -74,7 +74,12 @@ void Platform::Destroy()
 {
     TearDownDevices();
 
+    // The slab allocator (if any) backs memory which is freed by our destructor, so it must be destroyed last.
+    InternalSlabAllocator*const pSlabAllocator = m_pSlabAllocator;
+
     this->~Platform();
+
+    DestroySlabAllocator(pSlabAllocator);
 }
 
 // =====================================================================================================================
@@ -218,6 +223,10 @@ Result Platform::ReQueryDevices()
                        pDevices[i]->businfo.pci->dev,
                        pDevices[i]->businfo.pci->func);
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+        const uint64 startTicks = GetPerfCpuTime();
+#endif
+
         result = Device::Create(this,
                                 &m_settingsPath[0],
                                 busId,
@@ -228,6 +237,9 @@ Result Platform::ReQueryDevices()
                                 &pDevice);
         if (result == Result::Success)
         {
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+            SetDeviceInitTicks(m_deviceCount, DeviceInitPhase::Create, GetPerfCpuTime() - startTicks);
+#endif
             m_pDevice[m_deviceCount] = pDevice;
             ++m_deviceCount;
         }
@@ -35,6 +35,9 @@ namespace Pal
 namespace Amdgpu
 {
 
+Util::Mutex            VamMgr::s_cacheLock;
+VamMgr::VaThreadCache* VamMgr::s_pCacheList = nullptr;
+
 // =====================================================================================================================
 // Note that this constructor is invoked before settings have been committed.
 VamMgr::VamMgr()
@@ -42,7 +45,11 @@ VamMgr::VamMgr()
     Pal::VamMgr(),
     m_mutex(),
     m_mapAllocator(),
-    m_sharedBoMap(InitialBoCount, &m_mapAllocator)
+    m_sharedBoMap(InitialBoCount, &m_mapAllocator),
+    m_vamLock(),
+    m_cacheKey(),
+    m_cacheKeyValid(false),
+    m_pendingCacheFlushes(0)
 {
     for (uint32 partIndex = 0; partIndex < static_cast<uint32>(VaPartition::Count); partIndex++)
     {
@@ -58,6 +65,8 @@ VamMgr::~VamMgr()
 // Note: OCL API doesn't provide explicit device destruction
     // The VAM instance must be destroyed by calling Cleanup().
     PAL_ASSERT(m_hVamInstance == nullptr);
+
+    DestroyThreadCaches();
 }
 
 // =====================================================================================================================
@@ -111,6 +120,13 @@ Result VamMgr::LateInit(
         PAL_ALERT_ALWAYS();
         result = Result::ErrorInitializationFailed;
     }
+    else if (m_cacheKeyValid == false)
+    {
+        // Cleanup deletes the key, so it's created here to turn the magazines back on if VAM is started again. The
+        // magazines are only an optimization; without them every assignment goes straight to VAM.
+        m_cacheKeyValid = (CreateThreadLocalKey(&m_cacheKey, &ThreadCacheDestructor) == Result::Success);
+        PAL_ALERT(m_cacheKeyValid == false);
+    }
 
     return result;
 }
@@ -151,35 +167,61 @@ Result VamMgr::AssignVirtualAddress(
 {
     Result result = Result::Success;
 
-    VAM_ALLOC_INPUT  vamAllocIn  = { };
-    VAM_ALLOC_OUTPUT vamAllocOut = { };
-
-    vamAllocIn.virtualAddress = *pGpuVirtAddr;
-    vamAllocIn.sizeInBytes    = vaInfo.size;
-    vamAllocIn.alignment      = Max(LowPart(vaInfo.alignment), MinVamAllocAlignment);
-
-    // VAM takes a 32-bit alignment so the high part needs to be zero.
-    PAL_ASSERT(HighPart(vaInfo.alignment) == 0);
+    const uint32   sizeClass = MagazineClass(vaInfo.partition, vaInfo.size, vaInfo.alignment);
+    VaThreadCache* pCache    = nullptr;
 
-    vamAllocIn.hSection = m_hSection[static_cast<uint32>(vaInfo.partition)];
-    PAL_ASSERT(vamAllocIn.hSection != nullptr);
-
-    MutexAuto lock(&m_mutex);
+    // Requests for a particular VA must go to VAM.
+    if ((*pGpuVirtAddr == 0) && (sizeClass < NumMagazineClasses))
+    {
+        pCache = GetThreadCache();
+    }
 
-    if (VAMAlloc(m_hVamInstance, &vamAllocIn, &vamAllocOut) == VAM_OK)
+    if (pCache != nullptr)
     {
-        // Applications are expected to size-align their allocations to the largest size-alignment amongst the
-        // heaps they want the allocation to go into.
-        PAL_ASSERT(vamAllocOut.actualSize == vamAllocIn.sizeInBytes);
+        VaMagazine*const pMagazine = &pCache->magazines[sizeClass];
 
-        // If the caller had a particular VA in mind we should make sure VAM gave it to us.
-        PAL_ASSERT((*pGpuVirtAddr == 0) || (*pGpuVirtAddr == vamAllocOut.virtualAddress));
+        if (pMagazine->count == 0)
+        {
+            result = RefillMagazine(sizeClass, pMagazine);
+        }
 
-        *pGpuVirtAddr = vamAllocOut.virtualAddress;
+        if (result == Result::Success)
+        {
+            *pGpuVirtAddr = pMagazine->gpuVirtAddr[--pMagazine->count];
+        }
     }
     else
     {
-        result = Result::ErrorOutOfGpuMemory;
+        VAM_ALLOC_INPUT  vamAllocIn  = { };
+        VAM_ALLOC_OUTPUT vamAllocOut = { };
+
+        vamAllocIn.virtualAddress = *pGpuVirtAddr;
+        vamAllocIn.sizeInBytes    = vaInfo.size;
+        vamAllocIn.alignment      = Max(LowPart(vaInfo.alignment), MinVamAllocAlignment);
+
+        // VAM takes a 32-bit alignment so the high part needs to be zero.
+        PAL_ASSERT(HighPart(vaInfo.alignment) == 0);
+
+        vamAllocIn.hSection = m_hSection[static_cast<uint32>(vaInfo.partition)];
+        PAL_ASSERT(vamAllocIn.hSection != nullptr);
+
+        MutexAuto lock(&m_vamLock);
+
+        if (VAMAlloc(m_hVamInstance, &vamAllocIn, &vamAllocOut) == VAM_OK)
+        {
+            // Applications are expected to size-align their allocations to the largest size-alignment amongst the
+            // heaps they want the allocation to go into.
+            PAL_ASSERT(vamAllocOut.actualSize == vamAllocIn.sizeInBytes);
+
+            // If the caller had a particular VA in mind we should make sure VAM gave it to us.
+            PAL_ASSERT((*pGpuVirtAddr == 0) || (*pGpuVirtAddr == vamAllocOut.virtualAddress));
+
+            *pGpuVirtAddr = vamAllocOut.virtualAddress;
+        }
+        else
+        {
+            result = Result::ErrorOutOfGpuMemory;
+        }
     }
 
     return result;
@@ -189,7 +231,8 @@ Result VamMgr::AssignVirtualAddress(
 // Unmaps a previously-allocated GPU virtual address described by the associated GPU memory object. This is called when
 // allocations are destroyed.
 //
-// On Linux, since we don't use an unmap-info buffer, we ask VAM to free the unmapped address immediately.
+// On Linux, since we don't use an unmap-info buffer, we ask VAM to free the unmapped address immediately.  Small
+// descriptor table ranges are kept in the calling thread's magazine instead.
 Result VamMgr::FreeVirtualAddress(
     Pal::Device*          pDevice,
     const Pal::GpuMemory* pGpuMemory)
@@ -199,22 +242,310 @@ Result VamMgr::FreeVirtualAddress(
     PAL_ASSERT((pGpuMemory != nullptr) &&
                IsVamPartition(pGpuMemory->VirtAddrPartition()));
 
-    VAM_FREE_INPUT vamFreeIn = { };
-    vamFreeIn.virtualAddress = pGpuMemory->Desc().gpuVirtAddr;
-    vamFreeIn.actualSize     = pGpuMemory->Desc().size;
-    vamFreeIn.hSection       = m_hSection[static_cast<uint32>(pGpuMemory->VirtAddrPartition())];
+    const gpusize  gpuVirtAddr = pGpuMemory->Desc().gpuVirtAddr;
+    const gpusize  size        = pGpuMemory->Desc().size;
+    const uint32   sizeClass   = MagazineClass(pGpuMemory->VirtAddrPartition(), size, size);
+    VaThreadCache* pCache      = nullptr;
 
-    MutexAuto lock(&m_mutex);
+    // Ranges which were assigned at a particular VA may not be aligned to their size.
+    if ((sizeClass < NumMagazineClasses) && IsPow2Aligned(gpuVirtAddr, size))
+    {
+        pCache = GetThreadCache();
+    }
+
+    if (pCache != nullptr)
+    {
+        VaMagazine*const pMagazine = &pCache->magazines[sizeClass];
+
+        if (pMagazine->count == MagazineCapacity)
+        {
+            DrainMagazine(sizeClass, pMagazine, MagazineBatchSize);
+        }
 
-    if (VAMFree(m_hVamInstance, &vamFreeIn) != VAM_OK)
+        pMagazine->gpuVirtAddr[pMagazine->count++] = gpuVirtAddr;
+    }
+    else
     {
-        PAL_ASSERT_ALWAYS();
-        result = Result::ErrorOutOfGpuMemory;
+        VAM_FREE_INPUT vamFreeIn = { };
+        vamFreeIn.virtualAddress = gpuVirtAddr;
+        vamFreeIn.actualSize     = size;
+        vamFreeIn.hSection       = m_hSection[static_cast<uint32>(pGpuMemory->VirtAddrPartition())];
+
+        MutexAuto lock(&m_vamLock);
+
+        if (VAMFree(m_hVamInstance, &vamFreeIn) != VAM_OK)
+        {
+            PAL_ASSERT_ALWAYS();
+            result = Result::ErrorOutOfGpuMemory;
+        }
     }
 
     return result;
 }
 
+// =====================================================================================================================
+// Returns the magazine size class which serves VA ranges of the given size and alignment, or NumMagazineClasses if
+// such ranges must always go to VAM.  Only the descriptor table partition is cached: shadow descriptor tables mirror
+// descriptor table addresses and capture-replay needs VAM's placement to be reproducible.
+uint32 VamMgr::MagazineClass(
+    VaPartition vaPartition,
+    gpusize     size,
+    gpusize     alignment)
+{
+    uint32 sizeClass = NumMagazineClasses;
+
+    if ((vaPartition == VaPartition::DescriptorTable) && IsPowerOfTwo(size) && (alignment <= size))
+    {
+        const uint32 sizeLog2 = Log2(size);
+
+        if ((sizeLog2 >= MagazineMinSizeLog2) && (sizeLog2 < (MagazineMinSizeLog2 + NumMagazineClasses)))
+        {
+            sizeClass = sizeLog2 - MagazineMinSizeLog2;
+        }
+    }
+
+    return sizeClass;
+}
+
+// =====================================================================================================================
+// Reserves a batch of size-aligned VA ranges from VAM for an empty magazine.  Only fails if no range at all could be
+// reserved.
+Result VamMgr::RefillMagazine(
+    uint32      sizeClass,
+    VaMagazine* pMagazine)
+{
+    PAL_ASSERT(pMagazine->count == 0);
+
+    VAM_ALLOC_INPUT vamAllocIn = { };
+    vamAllocIn.sizeInBytes     = (1ull << (MagazineMinSizeLog2 + sizeClass));
+    vamAllocIn.alignment       = Max(static_cast<uint32>(vamAllocIn.sizeInBytes), MinVamAllocAlignment);
+    vamAllocIn.hSection        = m_hSection[static_cast<uint32>(VaPartition::DescriptorTable)];
+    PAL_ASSERT(vamAllocIn.hSection != nullptr);
+
+    MutexAuto lock(&m_vamLock);
+
+    for (uint32 idx = 0; idx < MagazineBatchSize; ++idx)
+    {
+        VAM_ALLOC_OUTPUT vamAllocOut = { };
+
+        if (VAMAlloc(m_hVamInstance, &vamAllocIn, &vamAllocOut) != VAM_OK)
+        {
+            break;
+        }
+
+        PAL_ASSERT(vamAllocOut.actualSize == vamAllocIn.sizeInBytes);
+
+        // Hand out the lowest address first.
+        pMagazine->gpuVirtAddr[MagazineBatchSize - 1 - idx] = vamAllocOut.virtualAddress;
+        pMagazine->count++;
+    }
+
+    if (pMagazine->count < MagazineBatchSize)
+    {
+        // Compact a partial batch to the bottom of the magazine.
+        memmove(&pMagazine->gpuVirtAddr[0],
+                &pMagazine->gpuVirtAddr[MagazineBatchSize - pMagazine->count],
+                sizeof(gpusize) * pMagazine->count);
+    }
+
+    return (pMagazine->count > 0) ? Result::Success : Result::ErrorOutOfGpuMemory;
+}
+
+// =====================================================================================================================
+// Returns the top "count" VA ranges of a magazine to VAM.
+void VamMgr::DrainMagazine(
+    uint32      sizeClass,
+    VaMagazine* pMagazine,
+    uint32      count)
+{
+    PAL_ASSERT(count <= pMagazine->count);
+
+    VAM_FREE_INPUT vamFreeIn = { };
+    vamFreeIn.actualSize     = (1ull << (MagazineMinSizeLog2 + sizeClass));
+    vamFreeIn.hSection       = m_hSection[static_cast<uint32>(VaPartition::DescriptorTable)];
+
+    MutexAuto lock(&m_vamLock);
+
+    for (uint32 idx = 0; idx < count; ++idx)
+    {
+        vamFreeIn.virtualAddress = pMagazine->gpuVirtAddr[--pMagazine->count];
+
+        if (VAMFree(m_hVamInstance, &vamFreeIn) != VAM_OK)
+        {
+            PAL_ASSERT_ALWAYS();
+        }
+    }
+}
+
+// =====================================================================================================================
+// Returns the calling thread's magazines, creating them on first use.  Returns null if they could not be created.
+//
+// Like the VamMgr itself, caches come from the generic allocator rather than from any one platform's allocator: a VamMgr
+// outlives the devices which use it and its caches may be freed by a thread-exit destructor.
+VamMgr::VaThreadCache* VamMgr::GetThreadCache()
+{
+    VaThreadCache* pCache = nullptr;
+
+    if (m_cacheKeyValid)
+    {
+        pCache = static_cast<VaThreadCache*>(GetThreadLocalValue(m_cacheKey));
+
+        if (pCache == nullptr)
+        {
+            GenericAllocator genericAllocator;
+
+            pCache = static_cast<VaThreadCache*>(PAL_CALLOC(sizeof(VaThreadCache), &genericAllocator, AllocInternal));
+
+            if (pCache != nullptr)
+            {
+                pCache->pOwner = this;
+
+                if (SetThreadLocalValue(m_cacheKey, pCache) == Result::Success)
+                {
+                    MutexAuto lock(&s_cacheLock);
+
+                    pCache->pNext = s_pCacheList;
+                    if (s_pCacheList != nullptr)
+                    {
+                        s_pCacheList->pPrev = pCache;
+                    }
+                    s_pCacheList = pCache;
+                }
+                else
+                {
+                    PAL_SAFE_FREE(pCache, &genericAllocator);
+                }
+            }
+        }
+    }
+
+    return pCache;
+}
+
+// =====================================================================================================================
+// Removes a cache from the cache list.  The caller must hold s_cacheLock.
+void VamMgr::UnlinkThreadCache(
+    VaThreadCache* pCache)
+{
+    if (pCache->pPrev != nullptr)
+    {
+        pCache->pPrev->pNext = pCache->pNext;
+    }
+    else
+    {
+        s_pCacheList = pCache->pNext;
+    }
+
+    if (pCache->pNext != nullptr)
+    {
+        pCache->pNext->pPrev = pCache->pPrev;
+    }
+
+    pCache->pPrev = nullptr;
+    pCache->pNext = nullptr;
+}
+
+// =====================================================================================================================
+// Called when a thread which owns magazines exits.  Deleting the key in DestroyThreadCaches doesn't wait for destructors
+// which are already running, so the owner may have claimed and freed this cache already.  The cache is only touched if
+// it is still in the cache list, and the owner waits for this flush before it shuts VAM down.
+void VamMgr::ThreadCacheDestructor(
+    void* pCache)
+{
+    VaThreadCache* pThreadCache = nullptr;
+
+    {
+        MutexAuto lock(&s_cacheLock);
+
+        for (VaThreadCache* pCur = s_pCacheList; pCur != nullptr; pCur = pCur->pNext)
+        {
+            if (pCur == pCache)
+            {
+                pThreadCache = pCur;
+                UnlinkThreadCache(pThreadCache);
+                pThreadCache->pOwner->m_pendingCacheFlushes++;
+                break;
+            }
+        }
+    }
+
+    if (pThreadCache != nullptr)
+    {
+        VamMgr*const pOwner = pThreadCache->pOwner;
+
+        pOwner->FlushThreadCache(pThreadCache);
+
+        MutexAuto lock(&s_cacheLock);
+        pOwner->m_pendingCacheFlushes--;
+    }
+}
+
+// =====================================================================================================================
+// Returns every VA range held by a cache to VAM, then frees it.  The cache must already be unlinked from the cache list.
+void VamMgr::FlushThreadCache(
+    VaThreadCache* pCache)
+{
+    for (uint32 sizeClass = 0; sizeClass < NumMagazineClasses; ++sizeClass)
+    {
+        VaMagazine*const pMagazine = &pCache->magazines[sizeClass];
+
+        if ((pMagazine->count > 0) && (m_hVamInstance != nullptr))
+        {
+            DrainMagazine(sizeClass, pMagazine, pMagazine->count);
+        }
+    }
+
+    GenericAllocator genericAllocator;
+    PAL_FREE(pCache, &genericAllocator);
+}
+
+// =====================================================================================================================
+// Returns the VA ranges held by every thread's magazines to VAM and stops using magazines until VAM is started again.
+void VamMgr::DestroyThreadCaches()
+{
+    if (m_cacheKeyValid)
+    {
+        // After this no thread can create a new cache or start a new thread-exit destructor for this manager.
+        const Result result = DeleteThreadLocalKey(m_cacheKey);
+        PAL_ASSERT(result == Result::Success);
+
+        m_cacheKeyValid = false;
+    }
+
+    bool done = false;
+
+    while (done == false)
+    {
+        VaThreadCache* pCache = nullptr;
+
+        {
+            MutexAuto lock(&s_cacheLock);
+
+            for (VaThreadCache* pCur = s_pCacheList; pCur != nullptr; pCur = pCur->pNext)
+            {
+                if (pCur->pOwner == this)
+                {
+                    pCache = pCur;
+                    UnlinkThreadCache(pCache);
+                    break;
+                }
+            }
+
+            // Destructors which claimed one of our caches before the key was deleted must finish flushing it first.
+            done = (pCache == nullptr) && (m_pendingCacheFlushes == 0);
+        }
+
+        if (pCache != nullptr)
+        {
+            FlushThreadCache(pCache);
+        }
+        else if (done == false)
+        {
+            YieldThread();
+        }
+    }
+}
+
 // =====================================================================================================================
 // Creates a GPU memory object for a page table block.  This method is protected by VAM's use of m_vamSyncObj.
 Result VamMgr::AllocPageTableBlock(
@@ -253,6 +584,8 @@ bool VamMgr::IsVamPartition(
 Result VamMgr::Cleanup(
     Pal::Device* pDevice)
 {
+    // The magazines' ranges must go back to VAM before it is destroyed.
+    DestroyThreadCaches();
     FreeReservedVaRanges(static_cast<Device*>(pDevice));
 
     return Pal::VamMgr::Cleanup(pDevice);
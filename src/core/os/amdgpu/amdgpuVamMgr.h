@@ -29,6 +29,7 @@
 #include "core/vamMgr.h"
 #include "palMutex.h"
 #include "palSysMemory.h"
+#include "palThread.h"
 
 namespace Pal
 {
@@ -151,6 +152,51 @@ protected:
     SharedBoMap                   m_sharedBoMap;
 
     static constexpr uint32 InitialBoCount = 8;
+
+private:
+    // Small descriptor table VA ranges are handed out from per-thread magazines: stacks of free ranges of one
+    // power-of-two size which are reserved from VAM in batches.  Frees go back to the freeing thread's magazine and
+    // are only returned to VAM in batches once it overflows.  Magazine ranges are always aligned to their size.
+    static constexpr uint32 MagazineMinSizeLog2 = 12;                      // 4KB
+    static constexpr uint32 NumMagazineClasses  = 5;                       // 4KB through 64KB
+    static constexpr uint32 MagazineCapacity    = 16;
+    static constexpr uint32 MagazineBatchSize   = MagazineCapacity / 2;   // Ranges moved to or from VAM at a time.
+
+    struct VaMagazine
+    {
+        uint32  count;
+        gpusize gpuVirtAddr[MagazineCapacity];
+    };
+
+    // Each thread's magazines.  Every live cache of every VamMgr is linked into one process-wide list.  Whoever
+    // unlinks a cache (its thread's exit destructor or the owner's cleanup) is the only one allowed to flush and free
+    // it, so the two can never both release the same cache.
+    struct VaThreadCache
+    {
+        VamMgr*         pOwner;
+        VaThreadCache*  pPrev;
+        VaThreadCache*  pNext;
+        VaMagazine      magazines[NumMagazineClasses];
+    };
+
+    static uint32 MagazineClass(VaPartition vaPartition, gpusize size, gpusize alignment);
+    static void   ThreadCacheDestructor(void* pCache);
+    static void   UnlinkThreadCache(VaThreadCache* pCache);
+
+    VaThreadCache* GetThreadCache();
+    void           FlushThreadCache(VaThreadCache* pCache);
+    void           DestroyThreadCaches();
+
+    Result RefillMagazine(uint32 sizeClass, VaMagazine* pMagazine);
+    void   DrainMagazine(uint32 sizeClass, VaMagazine* pMagazine, uint32 count);
+
+    Util::Mutex                   m_vamLock;         // Serializes calls into the VAM library.
+    Util::ThreadLocalKey          m_cacheKey;
+    bool                          m_cacheKeyValid;
+    uint32                        m_pendingCacheFlushes; // Caches being flushed by thread-exit destructors.
+
+    static Util::Mutex            s_cacheLock;       // Protects the cache list and every m_pendingCacheFlushes.
+    static VaThreadCache*         s_pCacheList;
 };
 
 // =====================================================================================================================
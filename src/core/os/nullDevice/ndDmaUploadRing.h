@@ -41,7 +41,8 @@ class DmaUploadRing final : public Pal::DmaUploadRing
 public:
     explicit DmaUploadRing(Device* pDevice);
     virtual ~DmaUploadRing() {};
-    virtual Result WaitForPendingUpload(Pal::Queue* pWaiter, UploadFenceToken fenceValue);
+protected:
+    virtual Result WaitForSubmission(Pal::Queue* pWaiter, uint64 timestamp) override;
 private:
     PAL_DISALLOW_DEFAULT_CTOR(DmaUploadRing);
     PAL_DISALLOW_COPY_AND_ASSIGN(DmaUploadRing);
@@ -27,6 +27,7 @@
 
 #include "core/os/nullDevice/ndDevice.h"
 #include "core/os/nullDevice/ndPlatform.h"
+#include "palSysUtil.h"
 
 using namespace Util;
 
@@ -46,6 +47,17 @@ Platform::Platform(
 {
 }
 
+// =====================================================================================================================
+void Platform::Destroy()
+{
+    // The slab allocator (if any) backs memory which is freed by our destructor, so it must be destroyed last.
+    InternalSlabAllocator*const pSlabAllocator = m_pSlabAllocator;
+
+    this->~Platform();
+
+    DestroySlabAllocator(pSlabAllocator);
+}
+
 // =====================================================================================================================
 // Windows-specific platform factory function which instantiates a new Windows::Platform object.
 Platform* Platform::CreateInstance(
@@ -75,6 +87,19 @@ size_t Platform::GetScreenObjectSize() const
     return 0;
 }
 
+// =====================================================================================================================
+// Creates one null device.  This is the entry point of the device creation worker threads.
+void Platform::RunDeviceCreateJob(
+    void* pParam)
+{
+    DeviceCreateJob*const pJob = static_cast<DeviceCreateJob*>(pParam);
+
+    const uint64 startTicks = GetPerfCpuTime();
+
+    pJob->result = Device::Create(pJob->pPlatform, &pJob->pDevice, pJob->nullGpuId);
+    pJob->ticks  = GetPerfCpuTime() - startTicks;
+}
+
 // =====================================================================================================================
 // Enumerates all devices and LDA chains present in the system. For each device and LDA chain, the adapter info
 // structures for the chains themselves and their connected devices will be queried from the KMD.
@@ -116,19 +141,50 @@ Result Platform::ReQueryDevices()
 
     // Only create the last MaxDevices null devices if we are in NullGpuId::All mode.
     const uint32 firstNullGpu = (nullGpuCount > MaxDevices) ? (nullGpuCount - MaxDevices) : 0;
+    const uint32 jobCount     = nullGpuCount - firstNullGpu;
 
-    for (uint32 nullGpu = firstNullGpu; nullGpu < nullGpuCount; nullGpu++)
+    // Null devices don't share any state with each other, so they can be created on worker threads.  If a thread
+    // can't be started its device is created on this thread instead.
+    const bool      parallel = ParallelDeviceInitEnabled() && (jobCount > 1);
+    DeviceCreateJob jobs[MaxDevices];
+
+    for (uint32 job = 0; job < jobCount; job++)
+    {
+        jobs[job].pPlatform = this;
+        jobs[job].nullGpuId = nullGpus[firstNullGpu + job].nullGpuId;
+        jobs[job].pDevice   = nullptr;
+        jobs[job].result    = Result::ErrorUnknown;
+        jobs[job].ticks     = 0;
+
+        if ((parallel == false) || (jobs[job].thread.Begin(&RunDeviceCreateJob, &jobs[job]) != Result::Success))
+        {
+            RunDeviceCreateJob(&jobs[job]);
+        }
+    }
+
+    // Add the devices in enumeration order regardless of which finished first.
+    for (uint32 job = 0; job < jobCount; job++)
     {
-        NullDevice::Device* pDevice = nullptr;
+        if (jobs[job].thread.IsCreated())
+        {
+            jobs[job].thread.Join();
+        }
 
-        result = Device::Create(this, &pDevice, nullGpus[nullGpu].nullGpuId);
+        result = jobs[job].result;
 
-        if ((result == Result::Success) && (pDevice != nullptr))
+        if ((result == Result::Success) && (jobs[job].pDevice != nullptr))
         {
-            m_pDevice[m_deviceCount++] = pDevice;
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+            SetDeviceInitTicks(m_deviceCount, DeviceInitPhase::Create, jobs[job].ticks);
+#endif
+            m_pDevice[m_deviceCount++] = jobs[job].pDevice;
         }
     }
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    m_properties.startupProfile.parallelDeviceInit = parallel;
+#endif
+
     return result;
 }
 
@@ -28,6 +28,7 @@
 #if PAL_BUILD_NULL_DEVICE
 
 #include "core/platform.h"
+#include "palThread.h"
 
 namespace Pal
 {
@@ -36,6 +37,7 @@ struct PlatformCreateInfo;
 
 namespace NullDevice
 {
+class Device;
 
 // =====================================================================================================================
 // Windows flavor of the Platform singleton. The responsibilities of the OS-specific Platform classes are interacting
@@ -47,7 +49,7 @@ public:
     Platform(const PlatformCreateInfo& createInfo, const Util::AllocCallbacks& allocCb);
     virtual ~Platform() {}
 
-    virtual void Destroy() override { this->~Platform(); }
+    virtual void Destroy() override;
 
     static Platform* CreateInstance(
         const PlatformCreateInfo&   createInfo,
@@ -62,6 +64,19 @@ public:
     virtual Result TurboSyncControl(const TurboSyncControlInput& turboSyncControlInput) override;
 
 private:
+    // State for creating one null device, possibly on a worker thread.
+    struct DeviceCreateJob
+    {
+        Platform*    pPlatform;
+        NullGpuId    nullGpuId;
+        Device*      pDevice;
+        Result       result;
+        uint64       ticks;     // Time spent in Device::Create().
+        Util::Thread thread;
+    };
+
+    static void RunDeviceCreateJob(void* pParam);
+
     virtual Result ConnectToOsInterface() override;
     virtual Result ReQueryDevices() override;
     virtual Result ReQueryScreens(
@@ -31,6 +31,7 @@
 #include "palDbgPrint.h"
 #include "palSysUtil.h"
 #include "palSysMemory.h"
+#include "palSlabAllocatorImpl.h"
 
 #if PAL_BUILD_LAYERS
 #include "core/layers/decorators.h"
@@ -96,6 +97,7 @@ Platform::Platform(
     const AllocCallbacks&     allocCb)
     :
     Pal::IPlatform(allocCb),
+    m_pSlabAllocator(nullptr),
     m_deviceCount(0),
     m_pDevDriverServer(nullptr),
     m_settingsLoader(this),
@@ -118,6 +120,9 @@ Platform::Platform(
     m_flags.requestShadowDescVaRange     = createInfo.flags.requestShadowDescriptorVaRange;
     m_flags.disableInternalResidencyOpts = createInfo.flags.disableInternalResidencyOpts;
     m_flags.supportRgpTraces             = createInfo.flags.supportRgpTraces;
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    m_flags.parallelDeviceInit           = createInfo.flags.parallelDeviceInit;
+#endif
 
     if (createInfo.pLogInfo != nullptr)
     {
@@ -146,9 +151,13 @@ Platform::~Platform()
 // DllMain() function on Windows.
 //
 // This function is not re-entrant!
+//
+// If pSlabAllocator is non-null, ownership of it is transferred to the new platform (even on failure).  allocCb must
+// already refer to it.
 Result Platform::Create(
     const PlatformCreateInfo& createInfo,
     const AllocCallbacks&     allocCb,
+    InternalSlabAllocator*    pSlabAllocator,
     void*                     pPlacementAddr,
     Platform**                ppPlatform)
 {
@@ -172,8 +181,14 @@ Result Platform::Create(
 
     if (pPlatform != nullptr)
     {
+        pPlatform->m_pSlabAllocator = pSlabAllocator;
+
         result = pPlatform->Init();
     }
+    else
+    {
+        DestroySlabAllocator(pSlabAllocator);
+    }
 
     if (result == Result::Success)
     {
@@ -187,6 +202,53 @@ Result Platform::Create(
     return result;
 }
 
+// =====================================================================================================================
+// Creates a slab allocator on top of the given callbacks.  Its own storage comes directly from those callbacks.
+Result Platform::CreateSlabAllocator(
+    const AllocCallbacks&   allocCb,
+    InternalSlabAllocator** ppSlabAllocator)
+{
+    Result result = Result::ErrorOutOfMemory;
+
+    void*const pMemory = allocCb.pfnAlloc(allocCb.pClientData,
+                                          sizeof(InternalSlabAllocator),
+                                          alignof(InternalSlabAllocator),
+                                          AllocInternal);
+
+    if (pMemory != nullptr)
+    {
+        InternalSlabAllocator*const pSlabAllocator = PAL_PLACEMENT_NEW(pMemory) InternalSlabAllocator(allocCb);
+
+        result = pSlabAllocator->slabAllocator.Init();
+
+        if (result == Result::Success)
+        {
+            *ppSlabAllocator = pSlabAllocator;
+        }
+        else
+        {
+            DestroySlabAllocator(pSlabAllocator);
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Destroys a slab allocator created by CreateSlabAllocator(), releasing all memory still allocated from it.  Safe to
+// call with a null pointer.
+void Platform::DestroySlabAllocator(
+    InternalSlabAllocator* pSlabAllocator)
+{
+    if (pSlabAllocator != nullptr)
+    {
+        const AllocCallbacks allocCb = pSlabAllocator->allocCb;
+
+        pSlabAllocator->~InternalSlabAllocator();
+        allocCb.pfnFree(allocCb.pClientData, pSlabAllocator);
+    }
+}
+
 // =====================================================================================================================
 // Returns a count and list of devices attached to the system.  If this function is called more than once, then it will
 // also cleanup any device objects enumerated on the previous call, a sequence expected when the client is returned an
@@ -336,19 +398,48 @@ void Platform::TearDownDevices()
     m_deviceCount = 0;
 }
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+// =====================================================================================================================
+// Records the time spent in a platform initialization phase which began at startTicks.  Returns the current time so
+// that it can be used as the start of the next phase.
+static uint64 EndInitPhase(
+    PlatformStartupProfile* pProfile,
+    PlatformInitPhase       phase,
+    uint64                  startTicks)
+{
+    const uint64 endTicks = GetPerfCpuTime();
+
+    pProfile->platformTicks[static_cast<uint32>(phase)] = endTicks - startTicks;
+
+    return endTicks;
+}
+#endif
+
 // =====================================================================================================================
 // Initializes the platform singleton's connection to the host operating system and kernel-mode driver.
 //
 // This function is not re-entrant!
 Result Platform::Init()
 {
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    PlatformStartupProfile*const pProfile = &m_properties.startupProfile;
+    pProfile->perfFrequency = GetPerfFrequency();
+#endif
+
     Result result = IPlatform::Init();
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    uint64 phaseStart = GetPerfCpuTime();
+#endif
+
     // Perform early initialization of the developer driver after the platform is available.
     if (result == Result::Success)
     {
         result = EarlyInitDevDriver();
     }
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    phaseStart = EndInitPhase(pProfile, PlatformInitPhase::EarlyInitDevDriver, phaseStart);
+#endif
 
 #if PAL_ENABLE_PRINTS_ASSERTS
     // Set the debug print callback to make debug prints visible over the logging protocol.
@@ -358,26 +449,47 @@ Result Platform::Init()
     Util::SetDbgPrintCallback(dbgPrintCallback);
 #endif
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    phaseStart = GetPerfCpuTime();
+#endif
+
     if (result == Result::Success)
     {
         result = ConnectToOsInterface();
     }
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    phaseStart = EndInitPhase(pProfile, PlatformInitPhase::ConnectToOsInterface, phaseStart);
+#endif
 
     if (result == Result::Success)
     {
         result = ReEnumerateDevices();
     }
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    phaseStart = EndInitPhase(pProfile, PlatformInitPhase::EnumerateDevices, phaseStart);
+#endif
 
     // Perform late initialization of the developer driver after devices have been enumerated.
     if (result == Result::Success)
     {
         LateInitDevDriver();
     }
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    phaseStart = EndInitPhase(pProfile, PlatformInitPhase::LateInitDevDriver, phaseStart);
+#endif
 
     if (result == Result::Success)
     {
         result = InitProperties();
     }
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    EndInitPhase(pProfile, PlatformInitPhase::InitProperties, phaseStart);
+
+    if (result == Result::Success)
+    {
+        LogStartupProfile();
+    }
+#endif
 
     return result;
 }
@@ -558,6 +670,7 @@ void Platform::LateInitDevDriver()
     if (m_deviceCount >= 1)
     {
         m_settingsLoader.ReadSettings(m_pDevice[0]);
+        m_settingsLoader.ReadLayerSettings(m_pDevice[0]);
     }
 
     // And then before finishing init we have an opportunity to override the settings default values based on
@@ -680,15 +793,79 @@ Result Platform::ReEnumerateDevices()
 {
     TearDownDevices();
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    PlatformStartupProfile*const pProfile = &m_properties.startupProfile;
+    memset(&pProfile->deviceTicks[0][0], 0, sizeof(pProfile->deviceTicks));
+#endif
+
     Result result = ReQueryDevices();
 
     if (result != Result::Success)
     {
         TearDownDevices();
     }
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    pProfile->deviceCount = m_deviceCount;
+#endif
+
     return result;
 }
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+// =====================================================================================================================
+// Records the time one of the enumerated devices spent in one of its initialization phases.
+void Platform::RecordDeviceInitTicks(
+    const Device*   pDevice,
+    DeviceInitPhase phase,
+    uint64          ticks)
+{
+    for (uint32 gpu = 0; gpu < m_deviceCount; ++gpu)
+    {
+        if (m_pDevice[gpu] == pDevice)
+        {
+            SetDeviceInitTicks(gpu, phase, ticks);
+            break;
+        }
+    }
+}
+
+// =====================================================================================================================
+// Prints the startup profile so that it shows up in the debug output and, when developer mode is enabled, over the
+// developer driver logging protocol.
+void Platform::LogStartupProfile() const
+{
+#if PAL_ENABLE_PRINTS_ASSERTS
+    static constexpr const char* PhaseNames[] =
+    {
+        "EarlyInitDevDriver",
+        "ConnectToOsInterface",
+        "EnumerateDevices",
+        "LateInitDevDriver",
+        "InitProperties",
+    };
+    static_assert(ArrayLen(PhaseNames) == static_cast<uint32>(PlatformInitPhase::Count),
+                  "PhaseNames must have an entry for every PlatformInitPhase!");
+
+    const PlatformStartupProfile& profile = m_properties.startupProfile;
+    const double                  usPerTick = 1000000.0 / static_cast<double>(profile.perfFrequency);
+
+    for (uint32 phase = 0; phase < static_cast<uint32>(PlatformInitPhase::Count); ++phase)
+    {
+        PAL_DPINFO("Platform startup: %s took %.1f us", PhaseNames[phase], profile.platformTicks[phase] * usPerTick);
+    }
+
+    for (uint32 gpu = 0; gpu < profile.deviceCount; ++gpu)
+    {
+        PAL_DPINFO("Platform startup: device %u creation took %.1f us%s",
+                   gpu,
+                   profile.deviceTicks[gpu][static_cast<uint32>(DeviceInitPhase::Create)] * usPerTick,
+                   profile.parallelDeviceInit ? " (parallel)" : "");
+    }
+#endif
+}
+#endif
+
 // =====================================================================================================================
 bool Platform::IsDevDriverProfilingEnabled() const
 {
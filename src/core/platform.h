@@ -27,6 +27,7 @@
 
 #include "palLib.h"
 #include "palPlatform.h"
+#include "palSlabAllocator.h"
 #include "platformSettingsLoader.h"
 #include "core/eventProvider.h"
 #include "core/g_palSettings.h"
@@ -72,6 +73,24 @@ struct GpuId
 extern void PAL_STDCALL GetDefaultAllocCb(
     Util::AllocCallbacks* pAllocCb);
 
+// =====================================================================================================================
+// Slab allocator which is installed as the platform's internal allocator when PlatformCreateInfo::flags has the
+// enableSlabAllocator bit set.  It keeps its own copy of the original allocation callbacks because it must outlive the
+// core Platform object.
+struct InternalSlabAllocator
+{
+    explicit InternalSlabAllocator(const Util::AllocCallbacks& callbacks)
+        :
+        allocCb(callbacks),
+        backingAllocator(callbacks),
+        slabAllocator(&backingAllocator)
+    { }
+
+    const Util::AllocCallbacks                  allocCb;
+    Util::ForwardAllocator                      backingAllocator;
+    Util::SlabAllocator<Util::ForwardAllocator> slabAllocator;
+};
+
 // =====================================================================================================================
 // Class which manages global functionality for a particular PAL instantiation.
 //
@@ -87,9 +106,15 @@ public:
     static Result Create(
         const PlatformCreateInfo&   createInfo,
         const Util::AllocCallbacks& allocCb,
+        InternalSlabAllocator*      pSlabAllocator,
         void*                       pPlacementAddr,
         Platform**                  ppPlatform);
 
+    static Result CreateSlabAllocator(
+        const Util::AllocCallbacks& allocCb,
+        InternalSlabAllocator**     ppSlabAllocator);
+    static void DestroySlabAllocator(InternalSlabAllocator* pSlabAllocator);
+
     virtual Result EnumerateDevices(
         uint32*    pDeviceCount,
         IDevice*   pDevices[MaxDevices]) override;
@@ -129,6 +154,7 @@ public:
     const char*  GetSettingsPath() const { return &m_settingsPath[0]; }
     virtual const PalPlatformSettings& PlatformSettings() const override { return m_settingsLoader.GetSettings(); }
     PalPlatformSettings* PlatformSettingsPtr() { return m_settingsLoader.GetSettingsPtr(); }
+    bool GpuProfilerBinaryLog() const { return m_settingsLoader.GpuProfilerBinaryLog(); }
 
     const PlatformProperties& GetProperties() const { return m_properties; }
 
@@ -172,6 +198,13 @@ public:
 
     bool OverrideGpuId(GpuId* pGpuId) const;
 
+    bool ParallelDeviceInitEnabled() const { return m_flags.parallelDeviceInit; }
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    // Records the time a device spent in one of its initialization phases.
+    void RecordDeviceInitTicks(const Device* pDevice, DeviceInitPhase phase, uint64 ticks);
+#endif
+
 protected:
     Platform(const PlatformCreateInfo& createInfo, const Util::AllocCallbacks& allocCb);
 
@@ -181,6 +214,12 @@ protected:
 
     void TearDownDevices();
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    // Records the time the device in the given slot of m_pDevice spent in one of its initialization phases.
+    void SetDeviceInitTicks(uint32 deviceSlot, DeviceInitPhase phase, uint64 ticks)
+        { m_properties.startupProfile.deviceTicks[deviceSlot][static_cast<uint32>(phase)] = ticks; }
+#endif
+
     // Connects to the host operating system's interface for communicating with the kernel-mode driver.
     virtual Result ConnectToOsInterface() = 0;
 
@@ -204,6 +243,9 @@ protected:
 
     bool DisableGpuTimeout() const { return m_flags.disableGpuTimeout; }
 
+    // Owned by the platform, but must only be destroyed after the platform's destructor has run.
+    InternalSlabAllocator* m_pSlabAllocator;
+
     Device*            m_pDevice[MaxDevices];
     uint32             m_deviceCount;
     PlatformProperties m_properties;
@@ -226,7 +268,8 @@ protected:
             uint32 supportRgpTraces             : 1; // Indicates that the client supports RGP tracing. PAL will use
                                                      // this flag and the hardware support flag to setup the
                                                      // DevDriver RgpServer.
-            uint32 reserved                     : 25; // Reserved for future use.
+            uint32 parallelDeviceInit           : 1; // Creates devices on worker threads during enumeration.
+            uint32 reserved                     : 24; // Reserved for future use.
         };
         uint32 u32All;
     } m_flags;
@@ -248,6 +291,10 @@ private:
 
     void InitRuntimeSettings(Device* pDevice);
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    void LogStartupProfile() const;
+#endif
+
     // Developer Driver functionality.
     // Initialization + Destruction functions
     Result EarlyInitDevDriver();
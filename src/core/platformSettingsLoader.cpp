@@ -50,6 +50,7 @@ PlatformSettingsLoader::PlatformSettingsLoader(
     ISettingsLoader(pPlatform, static_cast<DriverSettings*>(&m_settings), g_palPlatformNumSettings),
     m_pPlatform(pPlatform),
     m_settings(),
+    m_gpuProfilerBinaryLog(false),
     m_pComponentName("Pal_Platform")
 {
     memset(&m_settings, 0, sizeof(PalPlatformSettings));
@@ -266,6 +267,17 @@ Result PlatformSettingsLoader::Init()
     return ret;
 }
 
+// =====================================================================================================================
+// Reads the layer settings which aren't part of the generated settings.
+void PlatformSettingsLoader::ReadLayerSettings(
+    Pal::Device* pDevice)
+{
+    pDevice->ReadSetting("GpuProfilerBinaryLog",
+                         ValueType::Boolean,
+                         &m_gpuProfilerBinaryLog,
+                         InternalSettingScope::PrivatePalKey);
+}
+
 // =====================================================================================================================
 // Overrides defaults for the settings based on runtime information.
 void PlatformSettingsLoader::OverrideDefaults()
@@ -55,6 +55,13 @@ public:
     // auto-generated function
     void ReadSettings(Pal::Device* pDevice);
 
+    void ReadLayerSettings(Pal::Device* pDevice);
+
+    // GpuProfilerBinaryLog isn't part of the generated settings: if true, the GPU profiler layer hands its log items to
+    // a background thread which writes a compact binary file per queue instead of formatting .csv files on the thread
+    // which submits.  The binary files can be turned into the usual .csv files offline.
+    bool GpuProfilerBinaryLog() const { return m_gpuProfilerBinaryLog; }
+
 protected:
     virtual DevDriver::Result PerformSetValue(
         SettingNameHash     hash,
@@ -75,6 +82,7 @@ private:
 
     Pal::Platform*       m_pPlatform;
     PalPlatformSettings  m_settings;
+    bool                 m_gpuProfilerBinaryLog;
 
     // This base class function will be empty for the platform settings. Instead a separate function is defined that
     // will take a device pointer as a parameter which is required for reading from the registry or settings file.
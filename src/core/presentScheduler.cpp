@@ -28,6 +28,7 @@
 #include "core/queue.h"
 #include "core/swapChain.h"
 #include "palIntrusiveListImpl.h"
+#include "palSysUtil.h"
 using namespace Util;
 
 namespace Pal
@@ -92,7 +93,10 @@ PresentSchedulerJob::PresentSchedulerJob()
 #if !defined(__unix__)
     m_pPriorWorkFence(nullptr),
 #endif
-    m_type(PresentJobType::Terminate)
+    m_type(PresentJobType::Terminate),
+    m_pQueue(nullptr),
+    m_enqueueTime(0),
+    m_startTime(0)
 {
     memset(&m_presentInfo, 0, sizeof(m_presentInfo));
 }
@@ -115,13 +119,24 @@ PresentScheduler::PresentScheduler(
     :
     m_pDevice(pDevice),
     m_pSignalQueue(nullptr),
+    m_jobRingTail(0),
+    m_jobRingHead(0),
     m_workerActive(false),
-    m_previousPresentResult(Result::Success)
+    m_previousPresentResult(Result::Success),
+    m_perfFrequency(GetPerfFrequency())
 {
     for (uint32 deviceIndex = 0; deviceIndex < XdmaMaxDevices; deviceIndex++)
     {
         m_pPresentQueues[deviceIndex] = nullptr;
     }
+
+    for (uint32 slot = 0; slot < JobRingSize; slot++)
+    {
+        m_jobRing[slot].sequence = slot;
+        m_jobRing[slot].pJob     = nullptr;
+    }
+
+    memset(&m_jobLatency[0], 0, sizeof(m_jobLatency));
 }
 
 // =====================================================================================================================
@@ -139,6 +154,8 @@ PresentScheduler::~PresentScheduler()
 
             EnqueueJob(pJob);
             m_workerThread.Join();
+
+            LogJobLatency();
         }
         else
         {
@@ -169,11 +186,15 @@ PresentScheduler::~PresentScheduler()
         pJob->DestroyInternal(m_pDevice);
     }
 
-    for (auto iter = m_activeJobList.Begin(); iter.IsValid(); )
+    // The worker thread has terminated so any jobs left in the ring will never be consumed.
+    for (; m_jobRingHead != m_jobRingTail; m_jobRingHead++)
     {
-        PresentSchedulerJob*const pJob = iter.Get();
-        m_activeJobList.Erase(&iter);
-        pJob->DestroyInternal(m_pDevice);
+        JobRingSlot*const pSlot = &m_jobRing[m_jobRingHead % JobRingSize];
+
+        if (pSlot->sequence == (m_jobRingHead + 1))
+        {
+            pSlot->pJob->DestroyInternal(m_pDevice);
+        }
     }
 }
 
@@ -431,18 +452,182 @@ Result PresentScheduler::GetIdleJob(
 }
 
 // =====================================================================================================================
-// A thread-safe helper function to add the given job to the job queue and signal the job semaphore.
+// Copies the worker thread's latency histograms for the given type of job.
+void PresentScheduler::GetJobLatency(
+    PresentJobType     type,
+    PresentJobLatency* pLatency
+    ) const
+{
+    PAL_ASSERT((type < PresentJobType::Count) && (pLatency != nullptr));
+
+    memcpy(pLatency, &m_jobLatency[static_cast<uint32>(type)], sizeof(PresentJobLatency));
+}
+
+// =====================================================================================================================
+// A thread-safe helper function to add the given job to the job ring and signal the job semaphore. Any number of
+// threads may call this function concurrently; none of them will take a lock.
 void PresentScheduler::EnqueueJob(
     PresentSchedulerJob* pJob)
 {
-    m_activeJobMutex.Lock();
-    m_activeJobList.PushBack(pJob->ListNode());
-    m_activeJobMutex.Unlock();
+    pJob->SetEnqueueTime(GetPerfCpuTime());
+
+    uint32       position = m_jobRingTail;
+    JobRingSlot* pSlot    = nullptr;
+
+    while (pSlot == nullptr)
+    {
+        JobRingSlot*const pCandidate = &m_jobRing[position % JobRingSize];
+        const int32       distance   = static_cast<int32>(pCandidate->sequence - position);
+
+        if (distance == 0)
+        {
+            // The slot is free for this position; try to claim it by advancing the tail.
+            const uint32 oldTail = AtomicCompareAndSwap(&m_jobRingTail, position, position + 1);
+
+            if (oldTail == position)
+            {
+                pSlot = pCandidate;
+            }
+            else
+            {
+                position = oldTail;
+            }
+        }
+        else
+        {
+            if (distance < 0)
+            {
+                // The ring is full; give the worker thread a chance to consume a job.
+                YieldThread();
+            }
+
+            position = m_jobRingTail;
+        }
+    }
+
+    pSlot->pJob = pJob;
+
+    // The job pointer must be visible before the sequence number marks the slot as readable.
+    MemoryBarrier();
+    pSlot->sequence = position + 1;
 
-    // Post after we unlock the mutex to prevent the worker thread from blocking if it wakes up too quickly.
     m_activeJobSemaphore.Post();
 }
 
+// =====================================================================================================================
+// Removes the oldest job from the job ring. Must only be called by the worker thread after it has successfully waited
+// on the job semaphore.
+PresentSchedulerJob* PresentScheduler::DequeueJob()
+{
+    JobRingSlot*const pSlot = &m_jobRing[m_jobRingHead % JobRingSize];
+
+    // The semaphore guarantees that this slot has been claimed, but a producer which claimed it may still be writing
+    // the job pointer if a later producer finished first. That window is a handful of instructions long.
+    while (pSlot->sequence != (m_jobRingHead + 1))
+    {
+        YieldThread();
+    }
+
+    MemoryBarrier();
+    PresentSchedulerJob*const pJob = pSlot->pJob;
+
+    pSlot->pJob = nullptr;
+    MemoryBarrier();
+
+    // Hand the slot back to producers for the next lap around the ring.
+    pSlot->sequence = m_jobRingHead + JobRingSize;
+    m_jobRingHead++;
+
+    pJob->SetStartTime(GetPerfCpuTime());
+
+    return pJob;
+}
+
+// =====================================================================================================================
+// Blocks the worker thread until the given present job's image is ready to be presented. On Linux the kernel already
+// orders each present after the rendering which uses the same buffer objects, so there is nothing to wait for.
+void PresentScheduler::WaitForPriorWork(
+    PresentSchedulerJob* pJob)
+{
+#if !defined(__unix__)
+    // Directly waiting on the fence is preferable to submitting a queue semaphore wait because some OS-specific
+    // presentation logic that requires the CPU to know that we can begin executing a present before preceeding.
+    constexpr uint64 Timeout    = 2000000000;
+    IFence*const     pFence     = pJob->PriorWorkFence();
+    const Result     waitResult = m_pDevice->WaitForFences(1, &pFence, true, Timeout);
+    PAL_ALERT(IsErrorResult(waitResult) || (waitResult == Result::Timeout));
+#endif
+}
+
+// =====================================================================================================================
+// Records the given job's latencies and returns it to the idle list. Must only be called by the worker thread.
+void PresentScheduler::RetireJob(
+    PresentSchedulerJob* pJob)
+{
+    const int64 retireTime = GetPerfCpuTime();
+    const int64 latencies[] =
+    {
+        pJob->GetStartTime() - pJob->GetEnqueueTime(),
+        retireTime - pJob->GetStartTime(),
+    };
+
+    PresentJobLatency*const pLatency   = &m_jobLatency[static_cast<uint32>(pJob->GetType())];
+    uint32*const            pBuckets[] = { &pLatency->queueLatency[0], &pLatency->executeLatency[0] };
+
+    for (uint32 idx = 0; idx < ArrayLen(latencies); idx++)
+    {
+        const uint64 microseconds = (static_cast<uint64>(Max(latencies[idx], int64(0))) * 1000000) /
+                                    static_cast<uint64>(m_perfFrequency);
+        const uint32 bucket       = Min(Log2(microseconds), PresentLatencyBucketCount - 1);
+
+        pBuckets[idx][bucket]++;
+    }
+
+    pLatency->jobCount++;
+
+    MutexAuto lock(&m_idleJobMutex);
+    m_idleJobList.PushBack(pJob->ListNode());
+}
+
+// =====================================================================================================================
+// Prints the worker thread's latency histograms. Must only be called once the worker thread has terminated.
+void PresentScheduler::LogJobLatency() const
+{
+#if PAL_ENABLE_PRINTS_ASSERTS
+    static constexpr const char* JobTypeNames[] =
+    {
+        "Terminate",
+        "Notify",
+        "Present",
+    };
+    static_assert(ArrayLen(JobTypeNames) == static_cast<uint32>(PresentJobType::Count),
+                  "JobTypeNames must have an entry for every PresentJobType!");
+
+    for (uint32 type = 0; type < static_cast<uint32>(PresentJobType::Count); type++)
+    {
+        PresentJobLatency latency = {};
+        GetJobLatency(static_cast<PresentJobType>(type), &latency);
+
+        if (latency.jobCount > 0)
+        {
+            PAL_DPINFO("Present scheduler: %llu %s jobs", latency.jobCount, JobTypeNames[type]);
+        }
+
+        for (uint32 bucket = 0; bucket < PresentLatencyBucketCount; bucket++)
+        {
+            if ((latency.queueLatency[bucket] > 0) || (latency.executeLatency[bucket] > 0))
+            {
+                PAL_DPINFO("Present scheduler: %s latency >= %llu us: %u queued, %u executed",
+                           JobTypeNames[type],
+                           (bucket > 0) ? (1ull << bucket) : 0ull,
+                           latency.queueLatency[bucket],
+                           latency.executeLatency[bucket]);
+            }
+        }
+    }
+#endif
+}
+
 // =====================================================================================================================
 // Executes the background thread used to schedule presents at the appropriate times.
 void PresentScheduler::RunWorkerThread()
@@ -455,18 +640,12 @@ void PresentScheduler::RunWorkerThread()
 
         if (result == Result::Success)
         {
-            m_activeJobMutex.Lock();
-            PresentSchedulerJob*const pJob = m_activeJobList.Front();
-            m_activeJobList.Erase(pJob->ListNode());
-
-            m_activeJobMutex.Unlock();
+            PresentSchedulerJob*const pJob = DequeueJob();
 
             switch (pJob->GetType())
             {
             case PresentJobType::Terminate:
-                m_idleJobMutex.Lock();
-                m_idleJobList.PushBack(pJob->ListNode());
-                m_idleJobMutex.Unlock();
+                RetireJob(pJob);
 
                 // We've been asked to kill this thread.
                 m_workerActive = false;
@@ -474,33 +653,21 @@ void PresentScheduler::RunWorkerThread()
                 break;
 
             case PresentJobType::Notify:
-                m_idleJobMutex.Lock();
-                m_idleJobList.PushBack(pJob->ListNode());
-                m_idleJobMutex.Unlock();
+                RetireJob(pJob);
 
                 m_workerThreadNotify.Post();
                 break;
 
             case PresentJobType::Present:
                 {
-#if !defined(__unix__)
-                    // Block the thread until the current job's image is ready to be presented. Directly waiting on
-                    // the fence is preferable to submitting a queue semaphore wait because some OS-specific
-                    // presentation logic that requires the CPU to know that we can begin executing a present before
-                    // preceeding.
-                    constexpr uint64 Timeout    = 2000000000;
-                    IFence*const     pFence     = pJob->PriorWorkFence();
-                    const Result     waitResult = m_pDevice->WaitForFences(1, &pFence, true, Timeout);
-                    PAL_ALERT(IsErrorResult(waitResult) || (waitResult == Result::Timeout));
-#endif
+                    WaitForPriorWork(pJob);
+
                     const Result presentResult = ProcessPresent(pJob->GetPresentInfo(), pJob->GetQueue(), false);
                     m_previousPresentResult    = presentResult;
                     PAL_ALERT(IsErrorResult(presentResult));
                 }
 
-                m_idleJobMutex.Lock();
-                m_idleJobList.PushBack(pJob->ListNode());
-                m_idleJobMutex.Unlock();
+                RetireJob(pJob);
                 break;
 
             default:
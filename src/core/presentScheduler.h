@@ -43,6 +43,20 @@ enum class PresentJobType : uint32
     Terminate = 0, // The worker thread should terminate itself.
     Notify,        // The worker thread should signal a semaphore to let another thread know it has flushed prior work.
     Present,       // A present should be executed.
+    Count
+};
+
+// Number of buckets in each of the present scheduler's job latency histograms.
+constexpr uint32 PresentLatencyBucketCount = 24;
+
+// Latency histograms recorded by the present scheduler's worker thread for one type of job. Bucket N counts the jobs
+// whose latency fell within [2^N, 2^(N+1)) microseconds; bucket zero also counts sub-microsecond latencies and the last
+// bucket counts everything too large to fit in the others.
+struct PresentJobLatency
+{
+    uint64 jobCount;                                   // Total number of jobs of this type retired by the worker.
+    uint32 queueLatency[PresentLatencyBucketCount];    // Time between a job being queued and the worker starting it.
+    uint32 executeLatency[PresentLatencyBucketCount];  // Time between the worker starting and retiring a job.
 };
 
 // =====================================================================================================================
@@ -70,6 +84,12 @@ public:
     void SetQueue(IQueue* pQueue) { m_pQueue = pQueue; }
     IQueue* GetQueue() const { return m_pQueue; }
 
+    void SetEnqueueTime(int64 time) { m_enqueueTime = time; }
+    int64 GetEnqueueTime() const { return m_enqueueTime; }
+
+    void SetStartTime(int64 time) { m_startTime = time; }
+    int64 GetStartTime() const { return m_startTime; }
+
 private:
     PresentSchedulerJob();
     ~PresentSchedulerJob();
@@ -81,6 +101,8 @@ private:
     PresentJobType       m_type;            // How to interpret this job (e.g., execute a present).
     PresentSwapChainInfo m_presentInfo;     // All of the information for a present.
     IQueue*              m_pQueue;          // Internal queue of the same device as the original presentation queue.
+    int64                m_enqueueTime;     // CPU timestamp taken when this job was given to the worker thread.
+    int64                m_startTime;       // CPU timestamp taken when the worker thread began processing this job.
 };
 
 // =====================================================================================================================
@@ -104,6 +126,10 @@ public:
     // Waits for all internal present work to be idle before returning.
     Result WaitIdle();
 
+    // Returns a snapshot of the worker thread's latency histograms for the given type of job. The snapshot is not
+    // synchronized with the worker thread so it may be slightly out of date.
+    void GetJobLatency(PresentJobType type, PresentJobLatency* pLatency) const;
+
     // Must be declared public but meant for internal use only.
     void RunWorkerThread();
 
@@ -132,21 +158,39 @@ protected:
 private:
     Result GetIdleJob(PresentSchedulerJob** ppJob);
     void EnqueueJob(PresentSchedulerJob* pJob);
+    PresentSchedulerJob* DequeueJob();
+    void WaitForPriorWork(PresentSchedulerJob* pJob);
+    void RetireJob(PresentSchedulerJob* pJob);
+    void LogJobLatency() const;
+
+    // Jobs are passed from application threads to the worker thread through a bounded lock-free ring. Each slot's
+    // sequence number tells producers and the consumer whose turn it is to use the slot.
+    static constexpr uint32 JobRingSize = 64;
+
+    struct JobRingSlot
+    {
+        volatile uint32      sequence;
+        PresentSchedulerJob* pJob;
+    };
 
     // All of this state is used to store and process asynchronous presentation requests. If all presents can be inlined
     // none of it will be used and the worker thread will never be started.
 
-    JobList         m_idleJobList;        // Idle job objects which are waiting to be reused.
-    Util::Mutex     m_idleJobMutex;       // Protects access to m_idleJobList.
-    JobList         m_activeJobList;      // Passes jobs from application threads to the worker thread.
-    Util::Mutex     m_activeJobMutex;     // Protects access to m_activeJobList.
-    Util::Semaphore m_activeJobSemaphore; // Signaled when a job is added to m_activeJobList.
-    Util::Semaphore m_workerThreadNotify; // Signaled when the worker thread completes a Notify job.
-    Util::Thread    m_workerThread;       // The driver thread that executes presents later on.
-    volatile bool   m_workerActive;       // If the driver thread has been created.
+    JobList         m_idleJobList;          // Idle job objects which are waiting to be reused.
+    Util::Mutex     m_idleJobMutex;         // Protects access to m_idleJobList.
+    JobRingSlot     m_jobRing[JobRingSize]; // Passes jobs from application threads to the worker thread.
+    volatile uint32 m_jobRingTail;          // Index of the next ring slot that an application thread will claim.
+    uint32          m_jobRingHead;          // Index of the next ring slot the worker thread will consume.
+    Util::Semaphore m_activeJobSemaphore;   // Signaled when a job is added to m_jobRing.
+    Util::Semaphore m_workerThreadNotify;   // Signaled when the worker thread completes a Notify job.
+    Util::Thread    m_workerThread;         // The driver thread that executes presents later on.
+    volatile bool   m_workerActive;         // If the driver thread has been created.
 
     volatile Result m_previousPresentResult; // Result of the last presentation that took place.
 
+    const int64       m_perfFrequency;                              // CPU timestamp ticks per second.
+    PresentJobLatency m_jobLatency[uint32(PresentJobType::Count)];  // Written only by the worker thread.
+
     PAL_DISALLOW_DEFAULT_CTOR(PresentScheduler);
     PAL_DISALLOW_COPY_AND_ASSIGN(PresentScheduler);
 };
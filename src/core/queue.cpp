@@ -24,6 +24,7 @@
  **********************************************************************************************************************/
 
 #include "core/cmdBuffer.h"
+#include "core/cmdCapture.h"
 #include "core/fence.h"
 #include "core/cmdStream.h"
 #include "core/device.h"
@@ -34,6 +35,7 @@
 #include "core/queue.h"
 #include "core/queueContext.h"
 #include "core/queueSemaphore.h"
+#include "core/settingsLoader.h"
 #include "core/swapChain.h"
 #include "core/hw/ossip/ossDevice.h"
 #include "core/hw/gfxip/gfxDevice.h"
@@ -245,7 +247,8 @@ Queue::Queue(
     m_batchedCmds(pDevice->GetPlatform()),
     m_deviceMembershipNode(this),
     m_lastFrameCnt(0),
-    m_submitIdPerFrame(0)
+    m_submitIdPerFrame(0),
+    m_pCmdCapture(nullptr)
 {
     if (m_pDevice->Settings().ifhGpuMask & (0x1 << m_pDevice->ChipProperties().gpuIndex))
     {
@@ -278,6 +281,8 @@ void Queue::Destroy()
     // slow and have chance to be preempted. Solution is call WaitIdle before doing anything else.
     WaitIdle();
 
+    EndCmdCapture();
+
     if (m_pDummyCmdBuffer != nullptr)
     {
         m_pDummyCmdBuffer->DestroyInternal();
@@ -512,12 +517,38 @@ Result Queue::Init(
         }
     }
 
+    // Each queue records its own capture file in the command buffer dump directory. The file name includes this queue's
+    // address so that several queues on the same engine don't overwrite each other's captures.
+    if ((result == Result::Success) &&
+        m_pDevice->GetSettingsLoader()->CmdCaptureEnabled() &&
+        (GetEngineType() != EngineTypeTimer))
+    {
+        const char* pLogDir = &m_pDevice->Settings().cmdBufDumpDirectory[0];
+
+        // Create the directory. We don't care if it fails (existing is fine, failure is caught when opening the file).
+        MkDir(pLogDir);
+
+        char filename[MaxPathStrLen] = {};
+        Snprintf(filename, sizeof(filename), "%s/CmdCapture_%u_%u_%p.pcap",
+                 pLogDir,
+                 GetEngineType(),
+                 m_pQueueInfos[0].createInfo.engineIndex,
+                 this);
+
+        // A capture which can't be opened shouldn't prevent the queue from being created.
+        if (BeginCmdCapture(&filename[0]) != Result::Success)
+        {
+            PAL_ALERT_ALWAYS_MSG("Failed to open the command capture file %s", &filename[0]);
+        }
+    }
+
     return result;
 }
 
 // =====================================================================================================================
 // If any command buffer submitted on this queue contains a pipeline, which is uploaded using an internal dma queue,
-// this client queue needs to wait until the pipeline finishes uploading.
+// this client queue needs to wait until the pipeline finishes uploading.  Otherwise, any uploads which are still being
+// coalesced are submitted now so that they don't wait for the first submission which needs them.
 Result Queue::GfxIpWaitPipelineUploading(
     const MultiSubmitInfo& submitInfo)
 {
@@ -542,6 +573,10 @@ Result Queue::GfxIpWaitPipelineUploading(
     {
         result = m_pDevice->WaitForPendingUpload(this, maxUploadFenceToken);
     }
+    else
+    {
+        result = m_pDevice->FlushPendingUploads();
+    }
     return result;
 }
 
@@ -639,6 +674,19 @@ Result Queue::SubmitInternal(
             DumpCmdBuffers(submitInfo, internalSubmitInfos[0]);
         }
 
+        if ((m_pCmdCapture != nullptr) && (result == Result::Success))
+        {
+            // A failed capture shouldn't affect the submit itself; the writer stops writing after its first error.
+            if (m_pCmdCapture->BeginSubmit(*this, submitInfo, internalSubmitInfos[0]) == Result::Success)
+            {
+                MultiSubmitInfo submitInfoCopy = submitInfo;
+                submitInfoCopy.pfnCmdDumpCb    = &CmdCaptureWriter::WriteCmdStream;
+                submitInfoCopy.pUserData       = m_pCmdCapture;
+
+                DumpCmdBuffers(submitInfoCopy, internalSubmitInfos[0]);
+            }
+        }
+
         if (result == Result::Success)
         {
             if (m_ifhMode == IfhModeDisabled)
@@ -686,6 +734,36 @@ Result Queue::SubmitInternal(
     return result;
 }
 
+// =====================================================================================================================
+// Creates a command capture file which will record every following submit on this queue until EndCmdCapture is called.
+Result Queue::BeginCmdCapture(
+    const char* pFilename)
+{
+    EndCmdCapture();
+
+    Result result = Result::ErrorOutOfMemory;
+    m_pCmdCapture = PAL_NEW(CmdCaptureWriter, m_pDevice->GetPlatform(), AllocInternal)(*m_pDevice);
+
+    if (m_pCmdCapture != nullptr)
+    {
+        result = m_pCmdCapture->Open(pFilename);
+
+        if (result != Result::Success)
+        {
+            EndCmdCapture();
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Closes the current command capture file, if any.
+void Queue::EndCmdCapture()
+{
+    PAL_SAFE_DELETE(m_pCmdCapture, m_pDevice->GetPlatform());
+}
+
 // =====================================================================================================================
 // Calls DumpCmdStream on the preamble, postamble, and all the command streams in the submitInfo.
 void Queue::DumpCmdBuffers(
@@ -1456,6 +1534,59 @@ Result Queue::CopyVirtualMemoryPageMappings(
 
 }
 
+// =====================================================================================================================
+// Checks that each remap range references live GPU memory objects of this device and stays inside both of them.  A
+// destroyed object is no longer in the device's GPU memory range index, so remapping to or from it is caught here.  The
+// objects are looked up by pointer value and only dereferenced once the lookup has shown that they are still alive.
+static Result ValidateRemapRanges(
+    const GpuMemoryRangeIndex&     rangeIndex,
+    uint32                         rangeCount,
+    const VirtualMemoryRemapRange* pRanges)
+{
+    Result result = Result::Success;
+
+    // If the index failed to add an object we can't tell a destroyed object from one which is missing from the index.
+    if (rangeIndex.IsComplete())
+    {
+        for (uint32 i = 0; (result == Result::Success) && (i < rangeCount); i++)
+        {
+            const GpuMemory*const pVirtualGpuMem = static_cast<const GpuMemory*>(pRanges[i].pVirtualGpuMem);
+            const GpuMemory*const pRealGpuMem    = static_cast<const GpuMemory*>(pRanges[i].pRealGpuMem);
+
+            gpusize gpuVirtAddr = 0;
+            gpusize size        = 0;
+
+            PAL_ASSERT(pVirtualGpuMem != nullptr);
+
+            if (rangeIndex.FindRange(pVirtualGpuMem, &gpuVirtAddr, &size) == false)
+            {
+                PAL_ALERT_ALWAYS_MSG("Remapping pages of a destroyed virtual GPU memory object.");
+                result = Result::ErrorInvalidValue;
+            }
+            else if ((pVirtualGpuMem->IsVirtual() == false) ||
+                     ((pRanges[i].virtualStartOffset + pRanges[i].size) > size))
+            {
+                result = Result::ErrorInvalidValue;
+            }
+
+            if ((result == Result::Success) && (pRealGpuMem != nullptr))
+            {
+                if (rangeIndex.FindRange(pRealGpuMem, &gpuVirtAddr, &size) == false)
+                {
+                    PAL_ALERT_ALWAYS_MSG("Remapping pages to a destroyed GPU memory object.");
+                    result = Result::ErrorInvalidValue;
+                }
+                else if ((pRanges[i].realStartOffset + pRanges[i].size) > size)
+                {
+                    result = Result::ErrorInvalidValue;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
 // =====================================================================================================================
 // Updates page mappings for virtual GPU memory allocations.
 Result Queue::RemapVirtualMemoryPages(
@@ -1466,8 +1597,17 @@ Result Queue::RemapVirtualMemoryPages(
 {
     Result result = Result::ErrorUnavailable;
 
+    // If the device indexes its GPU memory, reject ranges which reference destroyed objects or run past their ends.
+    const GpuMemoryRangeIndex*const pRangeIndex = m_pDevice->GetGpuMemoryRangeIndex();
+    const bool validRanges = (pRangeIndex == nullptr) ||
+                             (ValidateRemapRanges(*pRangeIndex, rangeCount, pRanges) == Result::Success);
+
+    if (validRanges == false)
+    {
+        result = Result::ErrorInvalidValue;
+    }
     // Either execute the delay immediately, or enqueue it for later, depending on whether or not we are stalled.
-    if (m_stalled == false)
+    else if (m_stalled == false)
     {
         result = OsRemapVirtualMemoryPages(rangeCount, pRanges, doNotWait, pFence);
     }
@@ -35,6 +35,7 @@ namespace Pal
 {
 
 class CmdBuffer;
+class CmdCaptureWriter;
 class CmdStream;
 class Device;
 class Fence;
@@ -333,6 +334,12 @@ public:
 
     SubmissionContext* GetSubmissionContext() const { return m_pSubmissionContext; }
 
+    // Starts writing every submit on this queue to a command capture file, replacing any capture already in progress.
+    // Init calls this when the CmdCaptureEnable setting is set. Neither function may be called concurrently with a
+    // submit on this queue.
+    Result BeginCmdCapture(const char* pFilename);
+    void EndCmdCapture();
+
     // Performs OS-specific Queue submission behavior.
     virtual Result OsSubmit(
         const MultiSubmitInfo&    submitInfo,
@@ -445,6 +452,8 @@ private:
     uint32           m_lastFrameCnt;       // Most recent frame in which the queue submission occurs
     uint32           m_submitIdPerFrame;   // The Nth queue submission of the frame
 
+    CmdCaptureWriter* m_pCmdCapture;       // Writes each submit to a command capture file, if capturing is enabled.
+
     PAL_DISALLOW_DEFAULT_CTOR(Queue);
     PAL_DISALLOW_COPY_AND_ASSIGN(Queue);
 };
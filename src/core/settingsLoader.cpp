@@ -52,6 +52,8 @@ SettingsLoader::SettingsLoader(
     ISettingsLoader(pDevice->GetPlatform(), static_cast<DriverSettings*>(&m_settings), g_palNumSettings),
     m_pDevice(pDevice),
     m_settings(),
+    m_cmdCaptureEnable(false),
+    m_gpuMemoryRangeIndexEnable(false),
     m_pComponentName("Pal")
 {
     memset(&m_settings, 0, sizeof(PalSettings));
@@ -90,6 +92,16 @@ Result SettingsLoader::Init()
         // Read the rest of the settings from the registry
         ReadSettings();
 
+        m_pDevice->ReadSetting("CmdCaptureEnable",
+                               ValueType::Boolean,
+                               &m_cmdCaptureEnable,
+                               InternalSettingScope::PrivatePalKey);
+
+        m_pDevice->ReadSetting("GpuMemoryRangeIndexEnable",
+                               ValueType::Boolean,
+                               &m_gpuMemoryRangeIndexEnable,
+                               InternalSettingScope::PrivatePalKey);
+
         // Register with the DevDriver settings service
         DevDriverRegister();
 
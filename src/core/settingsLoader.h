@@ -47,6 +47,14 @@ public:
     const PalSettings& GetSettings() const { return m_settings; };
     PalSettings* GetSettingsPtr() { return &m_settings; }
 
+    // CmdCaptureEnable isn't part of the generated settings: if true, each queue records all of its submits to a
+    // command capture file in CmdBufDumpDirectory which the palCmdReplay tool can replay on a null device.
+    bool CmdCaptureEnabled() const { return m_cmdCaptureEnable; }
+
+    // GpuMemoryRangeIndexEnable isn't part of the generated settings: if true, the device indexes the VA range of every
+    // GPU memory object so that virtual memory remapping can reject ranges which reference destroyed objects.
+    bool GpuMemoryRangeIndexEnabled() const { return m_gpuMemoryRangeIndexEnable; }
+
 protected:
     void ValidateSettings();
 
@@ -65,6 +73,8 @@ private:
 
     Device*      m_pDevice;
     PalSettings  m_settings;
+    bool         m_cmdCaptureEnable;
+    bool         m_gpuMemoryRangeIndexEnable;
 
     // auto-generated functions
     virtual void SetupDefaults() override;
@@ -36,7 +36,8 @@ namespace Util
 {
 
 // =====================================================================================================================
-// Class requires and will take ownership of fully initialzed objects for pArchiveFile, pHashProvider, and pBaseContext
+// Class requires and will take ownership of fully initialzed objects for pArchiveFile, pHashProvider, and pBaseContext.
+// pBaseContext is null if there is no platform key, in which case entry keys are the plain SHA-1 of the hash ID.
 FileArchiveCacheLayer::FileArchiveCacheLayer(
     const AllocCallbacks& callbacks,
     IArchiveFile*         pArchiveFile,
@@ -53,14 +54,16 @@ FileArchiveCacheLayer::FileArchiveCacheLayer(
     m_entries          { HashTableBucketCount, Allocator() }
 {
     PAL_ASSERT(m_pArchivefile != nullptr);
-    PAL_ASSERT(m_pBaseContext != nullptr);
-    PAL_ASSERT(m_pBaseContext->GetOutputBufferSize() <= sizeof(EntryKey));
+    PAL_ASSERT((m_pBaseContext == nullptr) || (m_pBaseContext->GetOutputBufferSize() <= sizeof(EntryKey)));
 }
 
 // =====================================================================================================================
 FileArchiveCacheLayer::~FileArchiveCacheLayer()
 {
-    m_pBaseContext->Destroy();
+    if (m_pBaseContext != nullptr)
+    {
+        m_pBaseContext->Destroy();
+    }
 }
 
 // =====================================================================================================================
@@ -390,15 +393,26 @@ Result CreateArchiveFileCacheLayer(
         void* pBaseContextMem = VoidPtrInc(pPlacementAddr, sizeof(FileArchiveCacheLayer));
         pTempContextMem       = VoidPtrInc(pBaseContextMem, hashContextSize);
 
+        // Without a platform key there is nothing to seed the entry keys with, so they're hashed directly.
         if (pCreateInfo->pPlatformKey != nullptr)
         {
             result = pCreateInfo->pPlatformKey->GetKeyContext()->Duplicate(pBaseContextMem, &pBaseContext);
         }
-        else
+    }
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    if ((result == Result::Success) &&
+        pCreateInfo->useFastChecksum)
+    {
+        // The layer still works with whatever checksum the archive already uses, so this is only a preference.
+        const Result checksumResult = pCreateInfo->pFile->SetUseFastChecksum(true);
+
+        if ((checksumResult != Result::Success) && (checksumResult != Result::ErrorUnavailable))
         {
-            result = CreateHashContext(HashAlgorithm::Sha1, pBaseContextMem, &pBaseContext);
+            PAL_ALERT_ALWAYS_MSG("Failed to switch the archive to the fast checksum.");
         }
     }
+#endif
 
     if (result == Result::Success)
     {
@@ -493,19 +507,28 @@ void FileArchiveCacheLayer::ConvertToEntryKey(
     PAL_ASSERT(pHashId != nullptr);
     PAL_ASSERT(pKey != nullptr);
 
-    MutexAuto hashContextLock { &m_hashContextMutex };
+    if (m_pBaseContext == nullptr)
+    {
+        // No shared context state is involved, so this doesn't need the hash context lock.
+        const Result result = HashBuffer(HashAlgorithm::Sha1, pHashId, sizeof(Hash128), pKey->value);
+        PAL_ALERT(IsErrorResult(result));
+    }
+    else
+    {
+        MutexAuto hashContextLock { &m_hashContextMutex };
 
-    IHashContext* pContext = nullptr;
-    Result result          = m_pBaseContext->Duplicate(m_pTempContextMem, &pContext);
-    PAL_ALERT(IsErrorResult(result));
+        IHashContext* pContext = nullptr;
+        Result result          = m_pBaseContext->Duplicate(m_pTempContextMem, &pContext);
+        PAL_ALERT(IsErrorResult(result));
 
-    result = pContext->AddData(pHashId, sizeof(Hash128));
-    PAL_ALERT(IsErrorResult(result));
+        result = pContext->AddData(pHashId, sizeof(Hash128));
+        PAL_ALERT(IsErrorResult(result));
 
-    result = pContext->Finish(pKey->value);
-    PAL_ALERT(IsErrorResult(result));
+        result = pContext->Finish(pKey->value);
+        PAL_ALERT(IsErrorResult(result));
 
-    pContext->Destroy();
+        pContext->Destroy();
+    }
 }
 
 } //namespace Util
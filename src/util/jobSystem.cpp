@@ -0,0 +1,609 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "palJobSystem.h"
+#include "palAssert.h"
+#include "palInlineFuncs.h"
+#include "palSysUtil.h"
+
+namespace Util
+{
+
+// Number of fruitless attempts to find a job before an idle worker goes to sleep or a waiter yields its time slice.
+constexpr uint32 IdleSpinCount = 64;
+
+// Idle workers re-check for work at least this often, which bounds the cost of any missed wakeup.
+constexpr uint32 IdleWaitMs = 10;
+
+// State shared by all of the participants of one ParallelFor loop.  Lives on the stack of the calling thread.
+struct ParallelForState
+{
+    JobRangeFunction    pfnRange;
+    void*               pData;
+    uint32              count;
+    uint32              grainSize;
+    std::atomic<uint64> nextBegin;   // 64-bit so that the final fetch-adds of every participant can't wrap.
+};
+
+// =====================================================================================================================
+// Advances a xorshift random number generator and returns the new value.
+static uint32 NextRandom(
+    uint32* pState)
+{
+    uint32 x = *pState;
+    x ^= (x << 13);
+    x ^= (x >> 17);
+    x ^= (x << 5);
+    *pState = x;
+
+    return x;
+}
+
+// =====================================================================================================================
+JobSystem::~JobSystem()
+{
+    Shutdown();
+}
+
+// =====================================================================================================================
+// Allocates the worker deques and the injection queue and launches the worker threads.
+Result JobSystem::Init(
+    const JobSystemCreateInfo& createInfo)
+{
+    Result result = Result::Success;
+
+    if (createInfo.pThreadCallbacks != nullptr)
+    {
+        if ((createInfo.pThreadCallbacks->pfnStartThread == nullptr) ||
+            (createInfo.pThreadCallbacks->pfnJoinThread  == nullptr))
+        {
+            result = Result::ErrorInvalidPointer;
+        }
+        else
+        {
+            m_threadCallbacks  = *createInfo.pThreadCallbacks;
+            m_useClientThreads = true;
+        }
+    }
+
+    uint32 numWorkers = createInfo.numWorkers;
+
+    if ((result == Result::Success) && (numWorkers == 0))
+    {
+        // Leave one logical core for the thread which submits the work and waits on it.
+        SystemInfo systemInfo = {};
+        if ((QuerySystemInfo(&systemInfo) == Result::Success) && (systemInfo.cpuLogicalCoreCount > 1))
+        {
+            numWorkers = systemInfo.cpuLogicalCoreCount - 1;
+        }
+        else
+        {
+            numWorkers = 1;
+        }
+    }
+
+    numWorkers = Min(numWorkers, MaxWorkers);
+
+    const uint32 capacity = Pow2Pad((createInfo.queueCapacity != 0) ? createInfo.queueCapacity : DefaultQueueCapacity);
+
+    if (result == Result::Success)
+    {
+        result = CreateThreadLocalKey(&m_workerKey);
+        m_workerKeyValid = (result == Result::Success);
+    }
+
+    if (result == Result::Success)
+    {
+        result = m_wakeSemaphore.Init(Semaphore::MaximumCountLimit, 0);
+    }
+
+    if (result == Result::Success)
+    {
+        m_pInjectQueue = static_cast<Job*>(PAL_MALLOC(sizeof(Job) * capacity, &m_allocator, AllocInternal));
+        m_pSlots       = static_cast<JobSlot*>(PAL_CALLOC(sizeof(JobSlot) * capacity * numWorkers,
+                                                          &m_allocator,
+                                                          AllocInternal));
+        m_pWorkers     = static_cast<Worker*>(PAL_MALLOC_ALIGNED(sizeof(Worker) * numWorkers,
+                                                                 PAL_CACHE_LINE_BYTES,
+                                                                 &m_allocator,
+                                                                 AllocInternal));
+
+        if ((m_pInjectQueue == nullptr) || (m_pSlots == nullptr) || (m_pWorkers == nullptr))
+        {
+            result = Result::ErrorOutOfMemory;
+        }
+        else
+        {
+            m_injectCapacity = capacity;
+        }
+    }
+
+    if (result == Result::Success)
+    {
+        for (uint32 i = 0; i < numWorkers; ++i)
+        {
+            Worker*const pWorker = PAL_PLACEMENT_NEW(&m_pWorkers[i]) Worker;
+
+            pWorker->top.store(0, std::memory_order_relaxed);
+            pWorker->bottom.store(0, std::memory_order_relaxed);
+            pWorker->pSlots   = m_pSlots + (static_cast<size_t>(i) * capacity);
+            pWorker->mask     = capacity - 1;
+            pWorker->index    = i;
+            pWorker->rngState = 0x9E3779B9u * (i + 1);
+            pWorker->started  = false;
+            pWorker->pOwner   = this;
+        }
+
+        m_numWorkers = numWorkers;
+
+        // The deques must be fully set up before any worker starts stealing from them.
+        for (uint32 i = 0; (i < numWorkers) && (result == Result::Success); ++i)
+        {
+            Worker*const pWorker = &m_pWorkers[i];
+
+            if (m_useClientThreads)
+            {
+                result = m_threadCallbacks.pfnStartThread(m_threadCallbacks.pClientData, i, &WorkerMain, pWorker);
+            }
+            else
+            {
+                result = pWorker->thread.Begin(&WorkerMain, pWorker);
+            }
+
+            pWorker->started = (result == Result::Success);
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Stops and joins the worker threads and releases everything allocated by Init().
+void JobSystem::Shutdown()
+{
+    m_shutdown.store(true, std::memory_order_seq_cst);
+
+    if (m_pWorkers != nullptr)
+    {
+        m_wakeSemaphore.Post(m_numWorkers);
+
+        for (uint32 i = 0; i < m_numWorkers; ++i)
+        {
+            Worker*const pWorker = &m_pWorkers[i];
+
+            if (pWorker->started)
+            {
+                if (m_useClientThreads)
+                {
+                    m_threadCallbacks.pfnJoinThread(m_threadCallbacks.pClientData, i);
+                }
+                else
+                {
+                    pWorker->thread.Join();
+                }
+
+                pWorker->started = false;
+            }
+
+            PAL_ASSERT(pWorker->bottom.load(std::memory_order_relaxed) <= pWorker->top.load(std::memory_order_relaxed));
+            pWorker->~Worker();
+        }
+
+        PAL_SAFE_FREE(m_pWorkers, &m_allocator);
+        m_numWorkers = 0;
+    }
+
+    PAL_ASSERT(m_injectCount == 0);
+
+    PAL_SAFE_FREE(m_pSlots, &m_allocator);
+    PAL_SAFE_FREE(m_pInjectQueue, &m_allocator);
+
+    if (m_workerKeyValid)
+    {
+        const Result result = DeleteThreadLocalKey(m_workerKey);
+        PAL_ASSERT(result == Result::Success);
+
+        m_workerKeyValid = false;
+    }
+}
+
+// =====================================================================================================================
+// Returns the worker which belongs to the calling thread, or null if the calling thread isn't one of our workers.
+JobSystem::Worker* JobSystem::CurrentWorker() const
+{
+    return m_workerKeyValid ? static_cast<Worker*>(GetThreadLocalValue(m_workerKey)) : nullptr;
+}
+
+// =====================================================================================================================
+// Entry point of every worker thread: runs jobs until the JobSystem shuts down, sleeping whenever there is no work.
+void JobSystem::WorkerMain(
+    void* pParam)
+{
+    Worker*const    pWorker = static_cast<Worker*>(pParam);
+    JobSystem*const pSelf   = pWorker->pOwner;
+
+    SetThreadLocalValue(pSelf->m_workerKey, pWorker);
+
+    uint32 idleCount = 0;
+
+    while (pSelf->m_shutdown.load(std::memory_order_acquire) == false)
+    {
+        Job job;
+
+        if (pSelf->FindJob(pWorker, &pWorker->rngState, &job))
+        {
+            pSelf->RunJob(job);
+            idleCount = 0;
+        }
+        else if (++idleCount >= IdleSpinCount)
+        {
+            // Announce that we're about to sleep before checking for work one last time.  Submitters publish their
+            // job before checking m_numSleeping, so either we see their job here or they see us and post a wakeup.
+            pSelf->m_numSleeping.fetch_add(1, std::memory_order_seq_cst);
+
+            if ((pSelf->HasQueuedJobs() == false) && (pSelf->m_shutdown.load(std::memory_order_seq_cst) == false))
+            {
+                pSelf->m_wakeSemaphore.Wait(IdleWaitMs);
+            }
+
+            pSelf->m_numSleeping.fetch_sub(1, std::memory_order_relaxed);
+            idleCount = 0;
+        }
+    }
+
+    SetThreadLocalValue(pSelf->m_workerKey, nullptr);
+}
+
+// =====================================================================================================================
+// Pushes a job onto the bottom of a worker's deque.  Must only be called by the worker's own thread.  Returns false if
+// the deque is full.
+bool JobSystem::Push(
+    Worker*    pWorker,
+    const Job& job)
+{
+    const int64 bottom = pWorker->bottom.load(std::memory_order_relaxed);
+    const int64 top    = pWorker->top.load(std::memory_order_acquire);
+    const bool  hasRoom = ((bottom - top) <= static_cast<int64>(pWorker->mask));
+
+    if (hasRoom)
+    {
+        JobSlot*const pSlot = &pWorker->pSlots[bottom & pWorker->mask];
+
+        pSlot->pfnJob.store(job.pfnJob, std::memory_order_relaxed);
+        pSlot->pData.store(job.pData, std::memory_order_relaxed);
+        pSlot->pCounter.store(job.pCounter, std::memory_order_relaxed);
+
+        // Publish the job to thieves, which read bottom with acquire semantics.
+        pWorker->bottom.store(bottom + 1, std::memory_order_release);
+    }
+
+    return hasRoom;
+}
+
+// =====================================================================================================================
+// Pops the most recently pushed job from the bottom of a worker's deque.  Must only be called by the worker's own
+// thread.  Returns false if the deque is empty or a thief won the race for its last job.
+bool JobSystem::Pop(
+    Worker* pWorker,
+    Job*    pJob)
+{
+    const int64 bottom = pWorker->bottom.load(std::memory_order_relaxed) - 1;
+    pWorker->bottom.store(bottom, std::memory_order_relaxed);
+
+    // Thieves must observe the reservation of the bottom slot before we read top.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    int64 top   = pWorker->top.load(std::memory_order_relaxed);
+    bool  found = (top <= bottom);
+
+    if (found)
+    {
+        const JobSlot& slot = pWorker->pSlots[bottom & pWorker->mask];
+
+        pJob->pfnJob   = slot.pfnJob.load(std::memory_order_relaxed);
+        pJob->pData    = slot.pData.load(std::memory_order_relaxed);
+        pJob->pCounter = slot.pCounter.load(std::memory_order_relaxed);
+
+        if (top == bottom)
+        {
+            // This is the last job so we have to race any thieves for it.
+            found = pWorker->top.compare_exchange_strong(top,
+                                                         top + 1,
+                                                         std::memory_order_seq_cst,
+                                                         std::memory_order_relaxed);
+            pWorker->bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+    }
+    else
+    {
+        pWorker->bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    return found;
+}
+
+// =====================================================================================================================
+// Steals the oldest job from the top of another worker's deque.  Returns false if the deque is empty or another thread
+// won the race for the job.
+bool JobSystem::Steal(
+    Worker* pVictim,
+    Job*    pJob)
+{
+    int64 top = pVictim->top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64 bottom = pVictim->bottom.load(std::memory_order_acquire);
+
+    bool found = (top < bottom);
+
+    if (found)
+    {
+        // The slot may be overwritten by the owner once another thread advances top, in which case our CAS fails and
+        // whatever we read here is discarded.
+        const JobSlot& slot = pVictim->pSlots[top & pVictim->mask];
+
+        pJob->pfnJob   = slot.pfnJob.load(std::memory_order_relaxed);
+        pJob->pData    = slot.pData.load(std::memory_order_relaxed);
+        pJob->pCounter = slot.pCounter.load(std::memory_order_relaxed);
+
+        found = pVictim->top.compare_exchange_strong(top,
+                                                     top + 1,
+                                                     std::memory_order_seq_cst,
+                                                     std::memory_order_relaxed);
+    }
+
+    return found;
+}
+
+// =====================================================================================================================
+// Appends a job to the injection queue.  Returns false if the queue is full.
+bool JobSystem::PushInject(
+    const Job& job)
+{
+    MutexAuto lock(&m_injectLock);
+
+    const bool hasRoom = (m_injectCount < m_injectCapacity);
+
+    if (hasRoom)
+    {
+        m_pInjectQueue[(m_injectHead + m_injectCount) % m_injectCapacity] = job;
+        m_injectCount++;
+        m_injectPending.store(m_injectCount, std::memory_order_relaxed);
+    }
+
+    return hasRoom;
+}
+
+// =====================================================================================================================
+// Removes the oldest job from the injection queue.  Returns false if the queue is empty.
+bool JobSystem::PopInject(
+    Job* pJob)
+{
+    bool found = false;
+
+    // Avoid taking the lock at all while the queue is empty, which is the common case for busy workers.
+    if (m_injectPending.load(std::memory_order_relaxed) != 0)
+    {
+        MutexAuto lock(&m_injectLock);
+
+        found = (m_injectCount > 0);
+
+        if (found)
+        {
+            *pJob        = m_pInjectQueue[m_injectHead];
+            m_injectHead = (m_injectHead + 1) % m_injectCapacity;
+            m_injectCount--;
+            m_injectPending.store(m_injectCount, std::memory_order_relaxed);
+        }
+    }
+
+    return found;
+}
+
+// =====================================================================================================================
+// Finds a job for the calling thread: its own deque first (if it is a worker), then the injection queue, then the
+// deques of the other workers starting at a random victim.
+bool JobSystem::FindJob(
+    Worker* pWorker,    // Calling thread's worker, or null if it isn't a worker.
+    uint32* pRngState,  // [in,out] Victim selection state of the calling thread.
+    Job*    pJob)
+{
+    bool found = ((pWorker != nullptr) && Pop(pWorker, pJob)) || PopInject(pJob);
+
+    if ((found == false) && (m_numWorkers > 0))
+    {
+        const uint32 first = NextRandom(pRngState) % m_numWorkers;
+
+        for (uint32 i = 0; (i < m_numWorkers) && (found == false); ++i)
+        {
+            Worker*const pVictim = &m_pWorkers[(first + i) % m_numWorkers];
+
+            if (pVictim != pWorker)
+            {
+                found = Steal(pVictim, pJob);
+            }
+        }
+    }
+
+    return found;
+}
+
+// =====================================================================================================================
+// Returns true if any queue appears to contain a job.  Used by idle workers to decide whether they may go to sleep.
+bool JobSystem::HasQueuedJobs() const
+{
+    bool hasJobs = (m_injectPending.load(std::memory_order_seq_cst) != 0);
+
+    for (uint32 i = 0; (i < m_numWorkers) && (hasJobs == false); ++i)
+    {
+        hasJobs = (m_pWorkers[i].top.load(std::memory_order_seq_cst) <
+                   m_pWorkers[i].bottom.load(std::memory_order_seq_cst));
+    }
+
+    return hasJobs;
+}
+
+// =====================================================================================================================
+// Executes a job and retires it from its counter.
+void JobSystem::RunJob(
+    const Job& job)
+{
+    job.pfnJob(job.pData);
+
+    if (job.pCounter != nullptr)
+    {
+        const uint32 prevPending = job.pCounter->m_pending.fetch_sub(1, std::memory_order_acq_rel);
+        PAL_ASSERT(prevPending > 0);
+    }
+}
+
+// =====================================================================================================================
+// Wakes up to the given number of sleeping workers.
+void JobSystem::WakeWorkers(
+    uint32 count)
+{
+    // Pairs with the fetch-add in WorkerMain: the job we just published must be visible before we look for sleepers.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    const uint32 numSleeping = m_numSleeping.load(std::memory_order_relaxed);
+
+    if (numSleeping > 0)
+    {
+        m_wakeSemaphore.Post(Min(count, numSleeping));
+    }
+}
+
+// =====================================================================================================================
+void JobSystem::Submit(
+    JobFunction pfnJob,
+    void*       pData,
+    JobCounter* pCounter)
+{
+    PAL_ASSERT(pfnJob != nullptr);
+
+    const Job job = { pfnJob, pData, pCounter };
+
+    if (pCounter != nullptr)
+    {
+        pCounter->m_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Worker*const pWorker = CurrentWorker();
+    const bool   queued  = (pWorker != nullptr) ? Push(pWorker, job) : PushInject(job);
+
+    if (queued)
+    {
+        WakeWorkers(1);
+    }
+    else
+    {
+        // The queue is full; running the job right away provides natural back-pressure on the submitter.
+        RunJob(job);
+    }
+}
+
+// =====================================================================================================================
+void JobSystem::Wait(
+    const JobCounter* pCounter)
+{
+    Worker*const pWorker   = CurrentWorker();
+    uint32       rngState  = (pWorker != nullptr) ? pWorker->rngState
+                                                  : static_cast<uint32>(reinterpret_cast<uintptr_t>(&rngState) | 1);
+    uint32       idleCount = 0;
+
+    while (pCounter->IsDone() == false)
+    {
+        Job job;
+
+        if (FindJob(pWorker, &rngState, &job))
+        {
+            RunJob(job);
+            idleCount = 0;
+        }
+        else if (++idleCount >= IdleSpinCount)
+        {
+            // The remaining jobs are running on other threads; give up our time slice while they finish.
+            SleepMs(0);
+            idleCount = 0;
+        }
+    }
+
+    if (pWorker != nullptr)
+    {
+        pWorker->rngState = rngState;
+    }
+}
+
+// =====================================================================================================================
+// Body of every ParallelFor participant: claims ranges of iterations until there are none left.
+void JobSystem::ParallelForJob(
+    void* pData)
+{
+    ParallelForState*const pState = static_cast<ParallelForState*>(pData);
+
+    uint64 begin = pState->nextBegin.fetch_add(pState->grainSize, std::memory_order_relaxed);
+
+    while (begin < pState->count)
+    {
+        const uint64 end = Min<uint64>(begin + pState->grainSize, pState->count);
+
+        pState->pfnRange(pState->pData, static_cast<uint32>(begin), static_cast<uint32>(end));
+
+        begin = pState->nextBegin.fetch_add(pState->grainSize, std::memory_order_relaxed);
+    }
+}
+
+// =====================================================================================================================
+void JobSystem::ParallelFor(
+    uint32           count,
+    uint32           grainSize,
+    JobRangeFunction pfnRange,
+    void*            pData)
+{
+    PAL_ASSERT(pfnRange != nullptr);
+
+    ParallelForState state;
+    state.pfnRange  = pfnRange;
+    state.pData     = pData;
+    state.count     = count;
+    state.grainSize = Max(grainSize, 1u);
+    state.nextBegin.store(0, std::memory_order_relaxed);
+
+    // Ranges are handed out dynamically, so there's no point in having more helpers than there are ranges to share.
+    const uint32 numRanges  = static_cast<uint32>((static_cast<uint64>(count) + state.grainSize - 1) / state.grainSize);
+    const uint32 numHelpers = (numRanges > 1) ? Min(numRanges - 1, m_numWorkers) : 0;
+
+    JobCounter counter;
+
+    for (uint32 i = 0; i < numHelpers; ++i)
+    {
+        Submit(&ParallelForJob, &state, &counter);
+    }
+
+    // Participate in the loop ourselves, then wait for (or steal) any helpers which haven't finished their last range.
+    ParallelForJob(&state);
+    Wait(&counter);
+}
+
+} // Util
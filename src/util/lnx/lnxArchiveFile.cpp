@@ -32,6 +32,7 @@
 #include "palPlatformKey.h"
 #include "palSysUtil.h"
 #include "palVectorImpl.h"
+#include "palXxHash.h"
 
 #include <fcntl.h>
 #include <limits.h>
@@ -109,21 +110,36 @@ static uint64 GetCurrentFileTime()
 }
 
 // =====================================================================================================================
-// Helper function around MetroHash64 for easy crc64 hashing
+// Helper function to compute the entry checksum used by archives of the given major version
 static uint64 Crc64(
     const void* pData,
     size_t      dataSize,
+    uint32      majorVersion,
     uint64      seed = 0)
 {
     PAL_ASSERT(pData != nullptr);
 
-    union {
-        uint64 crc64;
-        uint8  raw[8];
-    } hashOutput;
-    MetroHash64::Hash(static_cast<const uint8*>(pData), dataSize, hashOutput.raw, seed);
+    uint64 crc64 = 0;
 
-    return hashOutput.crc64;
+    if (majorVersion == XxHashChecksumMajorVersion)
+    {
+        MetroHash::Hash hash = {};
+        XxHash128::Hash(static_cast<const uint8*>(pData), dataSize, hash.bytes, seed);
+
+        crc64 = hash.qwords[0] ^ hash.qwords[1];
+    }
+    else
+    {
+        union {
+            uint64 crc64;
+            uint8  raw[8];
+        } hashOutput;
+        MetroHash64::Hash(static_cast<const uint8*>(pData), dataSize, hashOutput.raw, seed);
+
+        crc64 = hashOutput.crc64;
+    }
+
+    return crc64;
 }
 
 // =====================================================================================================================
@@ -286,7 +302,11 @@ static Result CreateFileInternal(
             } data;
 
             memcpy(data.header.archiveMarker, MagicArchiveMarker, sizeof(data.header.archiveMarker));
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+            data.header.majorVersion = pOpenInfo->useFastChecksum ? XxHashChecksumMajorVersion : CurrentMajorVersion;
+#else
             data.header.majorVersion = CurrentMajorVersion;
+#endif
             data.header.minorVersion = CurrentMinorVersion;
             data.header.firstBlock   = static_cast<uint32>(VoidPtrDiff(&data.footer, &data));
             data.header.archiveType  = pOpenInfo->archiveType;
@@ -384,12 +404,21 @@ static Result ValidateFile(
     {
         valid = false;
     }
-    else if (pHeader->majorVersion != CurrentMajorVersion)
+    else if ((pHeader->majorVersion != CurrentMajorVersion) &&
+             (pHeader->majorVersion != XxHashChecksumMajorVersion))
     {
         valid = false;
     }
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
     else if ((pOpenInfo->useStrictVersionControl == true) &&
-             (pHeader->minorVersion != CurrentMinorVersion))
+             ((pHeader->minorVersion != CurrentMinorVersion) ||
+              (pHeader->majorVersion != (pOpenInfo->useFastChecksum ? XxHashChecksumMajorVersion
+                                                                    : CurrentMajorVersion))))
+#else
+    else if ((pOpenInfo->useStrictVersionControl == true) &&
+             ((pHeader->minorVersion != CurrentMinorVersion) ||
+              (pHeader->majorVersion != CurrentMajorVersion)))
+#endif
     {
         valid = false;
     }
@@ -634,7 +663,7 @@ Result ArchiveFile::Read(
     // ocurred during the file read
     if (result == Result::Success)
     {
-        const uint64 crc = Crc64(pDataBuffer, pHeader->dataSize);
+        const uint64 crc = Crc64(pDataBuffer, pHeader->dataSize, m_archiveHeader.majorVersion);
 
         if (crc != pHeader->dataCrc64)
         {
@@ -672,7 +701,7 @@ Result ArchiveFile::Write(
         pHeader->ordinalId    = m_cachedFooter.entryCount;
         pHeader->nextBlock    = curOffset + sizeof(ArchiveEntryHeader) + pHeader->dataSize;
         pHeader->dataPosition = curOffset + sizeof(ArchiveEntryHeader);
-        pHeader->dataCrc64    = Crc64(pData, pHeader->dataSize);
+        pHeader->dataCrc64    = Crc64(pData, pHeader->dataSize, m_archiveHeader.majorVersion);
 
         size_t writeSize = sizeof(ArchiveEntryHeader) + pHeader->dataSize + sizeof(ArchiveFileFooter);
 
@@ -718,6 +747,45 @@ Result ArchiveFile::Write(
     return result;
 }
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+// =====================================================================================================================
+// Switch the entry checksum by rewriting the header's major version. Only possible while the archive is empty, as the
+// checksum of every entry is determined by the header.
+Result ArchiveFile::SetUseFastChecksum(
+    bool useFastChecksum)
+{
+    const uint32 majorVersion = useFastChecksum ? XxHashChecksumMajorVersion : CurrentMajorVersion;
+
+    Result result = Result::Success;
+
+    if (m_archiveHeader.majorVersion != majorVersion)
+    {
+        if (m_haveWriteAccess == false)
+        {
+            result = Result::Unsupported;
+        }
+        else if (m_cachedFooter.entryCount != 0)
+        {
+            result = Result::ErrorUnavailable;
+        }
+        else
+        {
+            ArchiveFileHeader header = m_archiveHeader;
+            header.majorVersion      = majorVersion;
+
+            result = WriteInternal(0, &header, sizeof(header));
+
+            if (result == Result::Success)
+            {
+                m_archiveHeader = header;
+            }
+        }
+    }
+
+    return result;
+}
+#endif
+
 // =====================================================================================================================
 // Get the memory size needed for an archive file object
 size_t GetArchiveFileObjectSize(
@@ -71,6 +71,11 @@ public:
         ArchiveEntryHeader* pHeader,
         const void*         pData) override;
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 669
+    virtual Result SetUseFastChecksum(
+        bool useFastChecksum) override;
+#endif
+
     virtual void   Destroy() override { this->~ArchiveFile(); }
 
 private:
@@ -145,7 +150,7 @@ private:
 
     // File information
     const int32             m_hFile;
-    const ArchiveFileHeader m_archiveHeader;
+    ArchiveFileHeader       m_archiveHeader;
     uint64                  m_fileSize;
     ArchiveFileFooter       m_cachedFooter;
     uint32                  m_curFooterOffset;
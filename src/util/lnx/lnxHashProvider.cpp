@@ -31,6 +31,7 @@
 
 #include "util/lnx/lnxHashProvider.h"
 #include "util/lnx/lnxOpenssl.h"
+#include "util/shaHash.h"
 
 #include "palAssert.h"
 #include "palInlineFuncs.h"
@@ -136,22 +137,37 @@ Result GetHashContextInfo(
     HashAlgorithm    algorithm,
     HashContextInfo* pInfo)
 {
-    size_t     size    = 0;
-    OpenSslLib* pOpenssl = nullptr;
-    Result     result  = OpenSslLib::OpenLibrary(&pOpenssl);
+    Result result = Result::Success;
 
-    if ((result == Result::Success) &&
-        (pOpenssl != nullptr))
+    if (pInfo == nullptr)
     {
-        OpenSslLib::ProviderInfo providerInfo = {};
-
-        result = pOpenssl->GetProviderInfo(algorithm, &providerInfo);
+        result = Result::ErrorInvalidPointer;
+    }
+    else if (Sha::IsNativeAlgorithm(algorithm))
+    {
+        // SHA-1 and SHA-2 with 32-bit words are built in, so there's no need to load the OS library for them.
+        pInfo->contextObjectSize      = sizeof(Sha::NativeHashContext);
+        pInfo->contextObjectAlignment = alignof(Sha::NativeHashContext);
+        pInfo->outputBufferSize       = Sha::GetDigestSize(algorithm);
+    }
+    else
+    {
+        OpenSslLib* pOpenssl = nullptr;
+        result = OpenSslLib::OpenLibrary(&pOpenssl);
 
-        if (IsErrorResult(result) == false)
+        if ((result == Result::Success) &&
+            (pOpenssl != nullptr))
         {
-            pInfo->contextObjectSize      = providerInfo.objectSize + sizeof(HashContext);
-            pInfo->contextObjectAlignment = alignof(HashContext);
-            pInfo->outputBufferSize       = providerInfo.hashSize;
+            OpenSslLib::ProviderInfo providerInfo = {};
+
+            result = pOpenssl->GetProviderInfo(algorithm, &providerInfo);
+
+            if (IsErrorResult(result) == false)
+            {
+                pInfo->contextObjectSize      = providerInfo.objectSize + sizeof(HashContext);
+                pInfo->contextObjectAlignment = alignof(HashContext);
+                pInfo->outputBufferSize       = providerInfo.hashSize;
+            }
         }
     }
 
@@ -177,9 +193,11 @@ Result CreateHashContext(
         result = Result::ErrorInvalidPointer;
     }
 
+    const bool native = Sha::IsNativeAlgorithm(algorithm);
+
     OpenSslLib* pOpenssl = nullptr;
 
-    if (result == Result::Success)
+    if ((result == Result::Success) && (native == false))
     {
         result = OpenSslLib::OpenLibrary(&pOpenssl);
     }
@@ -187,7 +205,11 @@ Result CreateHashContext(
     ShaContext hContext = { };
     size_t     objectSize;
 
-    if (result == Result::Success)
+    if ((result == Result::Success) && native)
+    {
+        *ppHashContext = PAL_PLACEMENT_NEW(pPlacementAddr) Sha::NativeHashContext(algorithm);
+    }
+    else if (result == Result::Success)
     {
         void* pWorkBuffer = VoidPtrInc(pPlacementAddr, sizeof(HashContext));
         result            = OpenSslLib::CreateHash(
@@ -197,13 +219,13 @@ Result CreateHashContext(
             &objectSize);
     }
 
-    if (result == Result::Success)
+    if ((result == Result::Success) && (native == false))
     {
         PAL_ALERT(hContext.pMd5 == nullptr);
 
         *ppHashContext = PAL_PLACEMENT_NEW(pPlacementAddr) HashContext(hContext, algorithm, objectSize);
     }
-    else
+    else if (result != Result::Success)
     {
         if (ppHashContext != nullptr)
         {
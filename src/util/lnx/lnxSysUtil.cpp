@@ -49,6 +49,8 @@
 #include <dirent.h>
 #include <string.h>
 #include <poll.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
 
 namespace Util
 {
@@ -1175,6 +1177,55 @@ void SleepMs(
     } // while (true)
 }
 
+// =====================================================================================================================
+Result WaitOnAddress(
+    const volatile uint32* pAddress,
+    uint32                 compareValue,
+    uint32                 milliseconds)
+{
+    constexpr uint32 Infinite = UINT32_MAX;
+    constexpr uint32 MsPerSec = 1000;
+    constexpr uint32 NsPerMs  = (1000 * 1000);
+
+    struct timespec timeout = { };
+    timeout.tv_sec  = (milliseconds / MsPerSec);
+    timeout.tv_nsec = ((milliseconds % MsPerSec) * NsPerMs);
+
+    // FUTEX_WAIT takes a relative timeout.  An interrupted wait is reported as a spurious wakeup rather than restarted
+    // so that callers with a deadline don't wait for longer than they asked.
+    const long ret = syscall(SYS_futex,
+                             const_cast<uint32*>(pAddress),
+                             FUTEX_WAIT_PRIVATE,
+                             compareValue,
+                             (milliseconds == Infinite) ? nullptr : &timeout,
+                             nullptr,
+                             0);
+
+    Result result = Result::Success;
+
+    if (ret != 0)
+    {
+        if (errno == ETIMEDOUT)
+        {
+            result = Result::Timeout;
+        }
+        else if ((errno != EAGAIN) && (errno != EINTR))
+        {
+            result = Result::ErrorUnknown;
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+void WakeByAddress(
+    const volatile uint32* pAddress,
+    bool                   wakeAll)
+{
+    syscall(SYS_futex, const_cast<uint32*>(pAddress), FUTEX_WAKE_PRIVATE, wakeAll ? INT32_MAX : 1, nullptr, nullptr, 0);
+}
+
 // =====================================================================================================================
 void BeepSound(
     uint32 frequency,
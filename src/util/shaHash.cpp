@@ -0,0 +1,682 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "util/shaHash.h"
+#include "palAssert.h"
+#include "palInlineFuncs.h"
+#include "palSysMemory.h"
+#include "palSysUtil.h"
+
+#include <string.h>
+
+#if PAL_HAS_CPUID
+#include <immintrin.h>
+#endif
+
+namespace Util
+{
+namespace Sha
+{
+
+// Signature of a single-buffer compression function which processes numBlocks consecutive 64-byte blocks.
+typedef void (*CompressFunc)(uint32* pState, const uint8* pData, size_t numBlocks);
+
+static constexpr uint32 Sha1InitState[5] =
+{
+    0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0
+};
+
+static constexpr uint32 Sha224InitState[8] =
+{
+    0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939, 0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4
+};
+
+static constexpr uint32 Sha256InitState[8] =
+{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static constexpr uint32 Sha256RoundConstants[64] =
+{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static constexpr uint32 Sha1RoundConstants[4] = { 0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xca62c1d6 };
+
+// =====================================================================================================================
+static PAL_INLINE uint32 LoadBigEndian32(
+    const uint8* pData)
+{
+    return (uint32(pData[0]) << 24) | (uint32(pData[1]) << 16) | (uint32(pData[2]) << 8) | uint32(pData[3]);
+}
+
+// =====================================================================================================================
+static PAL_INLINE void StoreBigEndian32(
+    uint8* pData,
+    uint32 value)
+{
+    pData[0] = uint8(value >> 24);
+    pData[1] = uint8(value >> 16);
+    pData[2] = uint8(value >> 8);
+    pData[3] = uint8(value);
+}
+
+// =====================================================================================================================
+static PAL_INLINE uint32 RotateLeft32(
+    uint32 value,
+    uint32 amount)
+{
+    return (value << amount) | (value >> (32 - amount));
+}
+
+// =====================================================================================================================
+static PAL_INLINE uint32 RotateRight32(
+    uint32 value,
+    uint32 amount)
+{
+    return (value >> amount) | (value << (32 - amount));
+}
+
+// =====================================================================================================================
+// Portable SHA-1 compression function.
+static void Sha1CompressScalar(
+    uint32*      pState,
+    const uint8* pData,
+    size_t       numBlocks)
+{
+    for (; numBlocks > 0; numBlocks--, pData += BlockSize)
+    {
+        uint32 w[80];
+
+        for (uint32 t = 0; t < 16; t++)
+        {
+            w[t] = LoadBigEndian32(pData + (t * 4));
+        }
+
+        for (uint32 t = 16; t < 80; t++)
+        {
+            w[t] = RotateLeft32(w[t - 3] ^ w[t - 8] ^ w[t - 14] ^ w[t - 16], 1);
+        }
+
+        uint32 a = pState[0];
+        uint32 b = pState[1];
+        uint32 c = pState[2];
+        uint32 d = pState[3];
+        uint32 e = pState[4];
+
+        for (uint32 t = 0; t < 80; t++)
+        {
+            uint32 f;
+
+            if (t < 20)
+            {
+                f = (b & c) | (~b & d);
+            }
+            else if ((t < 40) || (t >= 60))
+            {
+                f = b ^ c ^ d;
+            }
+            else
+            {
+                f = (b & c) | (b & d) | (c & d);
+            }
+
+            const uint32 temp = RotateLeft32(a, 5) + f + e + w[t] + Sha1RoundConstants[t / 20];
+
+            e = d;
+            d = c;
+            c = RotateLeft32(b, 30);
+            b = a;
+            a = temp;
+        }
+
+        pState[0] += a;
+        pState[1] += b;
+        pState[2] += c;
+        pState[3] += d;
+        pState[4] += e;
+    }
+}
+
+// =====================================================================================================================
+// Portable SHA-256 compression function (also used for SHA-224).
+static void Sha256CompressScalar(
+    uint32*      pState,
+    const uint8* pData,
+    size_t       numBlocks)
+{
+    for (; numBlocks > 0; numBlocks--, pData += BlockSize)
+    {
+        uint32 w[64];
+
+        for (uint32 t = 0; t < 16; t++)
+        {
+            w[t] = LoadBigEndian32(pData + (t * 4));
+        }
+
+        for (uint32 t = 16; t < 64; t++)
+        {
+            const uint32 s0 = RotateRight32(w[t - 15], 7) ^ RotateRight32(w[t - 15], 18) ^ (w[t - 15] >> 3);
+            const uint32 s1 = RotateRight32(w[t - 2], 17) ^ RotateRight32(w[t - 2], 19)  ^ (w[t - 2] >> 10);
+
+            w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+        }
+
+        uint32 a = pState[0];
+        uint32 b = pState[1];
+        uint32 c = pState[2];
+        uint32 d = pState[3];
+        uint32 e = pState[4];
+        uint32 f = pState[5];
+        uint32 g = pState[6];
+        uint32 h = pState[7];
+
+        for (uint32 t = 0; t < 64; t++)
+        {
+            const uint32 s1    = RotateRight32(e, 6) ^ RotateRight32(e, 11) ^ RotateRight32(e, 25);
+            const uint32 ch    = (e & f) ^ (~e & g);
+            const uint32 temp1 = h + s1 + ch + Sha256RoundConstants[t] + w[t];
+            const uint32 s0    = RotateRight32(a, 2) ^ RotateRight32(a, 13) ^ RotateRight32(a, 22);
+            const uint32 maj   = (a & b) ^ (a & c) ^ (b & c);
+            const uint32 temp2 = s0 + maj;
+
+            h = g;
+            g = f;
+            f = e;
+            e = d + temp1;
+            d = c;
+            c = b;
+            b = a;
+            a = temp1 + temp2;
+        }
+
+        pState[0] += a;
+        pState[1] += b;
+        pState[2] += c;
+        pState[3] += d;
+        pState[4] += e;
+        pState[5] += f;
+        pState[6] += g;
+        pState[7] += h;
+    }
+}
+
+#if PAL_HAS_CPUID
+// =====================================================================================================================
+// SHA-1 compression function using the SHA extensions.  Each iteration of the inner loop performs four rounds and, from
+// the fifth group on, derives the next four message schedule words from the previous sixteen.
+PAL_TARGET_SHANI static void Sha1CompressShaNi(
+    uint32*      pState,
+    const uint8* pData,
+    size_t       numBlocks)
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pState)), 0x1B);
+    __m128i e0   = _mm_set_epi32(int(pState[4]), 0, 0, 0);
+
+    for (; numBlocks > 0; numBlocks--, pData += BlockSize)
+    {
+        const __m128i abcdSave = abcd;
+        const __m128i eSave    = e0;
+
+        __m128i msg[4];
+        __m128i prevAbcd = abcd;
+
+        for (uint32 group = 0; group < 20; group++)
+        {
+            const uint32 i = group % 4;
+            __m128i      e;
+
+            if (group < 4)
+            {
+                msg[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + (group * 16))),
+                                          byteSwap);
+            }
+            else
+            {
+                msg[i] = _mm_sha1msg2_epu32(
+                    _mm_xor_si128(_mm_sha1msg1_epu32(msg[i], msg[(i + 1) % 4]), msg[(i + 2) % 4]),
+                    msg[(i + 3) % 4]);
+            }
+
+            if (group == 0)
+            {
+                e = _mm_add_epi32(e0, msg[i]);
+            }
+            else
+            {
+                e = _mm_sha1nexte_epu32(prevAbcd, msg[i]);
+            }
+
+            prevAbcd = abcd;
+
+            switch (group / 5)
+            {
+            case 0:  abcd = _mm_sha1rnds4_epu32(abcd, e, 0); break;
+            case 1:  abcd = _mm_sha1rnds4_epu32(abcd, e, 1); break;
+            case 2:  abcd = _mm_sha1rnds4_epu32(abcd, e, 2); break;
+            default: abcd = _mm_sha1rnds4_epu32(abcd, e, 3); break;
+            }
+        }
+
+        e0   = _mm_sha1nexte_epu32(prevAbcd, eSave);
+        abcd = _mm_add_epi32(abcd, abcdSave);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pState), _mm_shuffle_epi32(abcd, 0x1B));
+    pState[4] = uint32(_mm_extract_epi32(e0, 3));
+}
+
+// =====================================================================================================================
+// SHA-256 compression function using the SHA extensions.  The state is kept in the ABEF/CDGH register layout required
+// by sha256rnds2; each iteration of the inner loop performs four rounds.
+PAL_TARGET_SHANI static void Sha256CompressShaNi(
+    uint32*      pState,
+    const uint8* pData,
+    size_t       numBlocks)
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    __m128i tmp    = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pState)), 0xB1);     // CDAB
+    __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pState + 4)), 0x1B); // EFGH
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);                                                        // ABEF
+    state1         = _mm_blend_epi16(state1, tmp, 0xF0);                                                     // CDGH
+
+    for (; numBlocks > 0; numBlocks--, pData += BlockSize)
+    {
+        const __m128i abefSave = state0;
+        const __m128i cdghSave = state1;
+
+        __m128i msg[4];
+
+        for (uint32 group = 0; group < 16; group++)
+        {
+            const uint32 i = group % 4;
+
+            if (group < 4)
+            {
+                msg[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + (group * 16))),
+                                          byteSwap);
+            }
+            else
+            {
+                const __m128i t = _mm_add_epi32(_mm_sha256msg1_epu32(msg[i], msg[(i + 1) % 4]),
+                                                _mm_alignr_epi8(msg[(i + 3) % 4], msg[(i + 2) % 4], 4));
+                msg[i] = _mm_sha256msg2_epu32(t, msg[(i + 3) % 4]);
+            }
+
+            __m128i k = _mm_add_epi32(msg[i], _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(&Sha256RoundConstants[group * 4])));
+
+            state1 = _mm_sha256rnds2_epu32(state1, state0, k);
+            k      = _mm_shuffle_epi32(k, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, k);
+        }
+
+        state0 = _mm_add_epi32(state0, abefSave);
+        state1 = _mm_add_epi32(state1, cdghSave);
+    }
+
+    tmp    = _mm_shuffle_epi32(state0, 0x1B);       // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1);       // DCHG
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);    // DCBA
+    state1 = _mm_alignr_epi8(state1, tmp, 8);       // HGFE
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pState),     state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pState + 4), state1);
+}
+
+#endif
+
+// Compression functions selected for the current CPU.
+struct Kernels
+{
+    CompressFunc pfnSha1;
+    CompressFunc pfnSha256;
+};
+
+// =====================================================================================================================
+// Picks the fastest kernels the CPU supports.
+static Kernels SelectKernels()
+{
+    Kernels kernels = {};
+
+    kernels.pfnSha1   = &Sha1CompressScalar;
+    kernels.pfnSha256 = &Sha256CompressScalar;
+
+#if PAL_HAS_CPUID
+    if (CpuSupportsFeature(CpuFeature::ShaNi) && CpuSupportsFeature(CpuFeature::Sse41))
+    {
+        kernels.pfnSha1   = &Sha1CompressShaNi;
+        kernels.pfnSha256 = &Sha256CompressShaNi;
+    }
+#endif
+
+    return kernels;
+}
+
+// =====================================================================================================================
+static const Kernels& GetKernels()
+{
+    static const Kernels TheKernels = SelectKernels();
+    return TheKernels;
+}
+
+// =====================================================================================================================
+static PAL_INLINE bool IsSha1(
+    HashAlgorithm algorithm)
+{
+    return (algorithm == HashAlgorithm::Sha1);
+}
+
+// =====================================================================================================================
+static PAL_INLINE CompressFunc GetCompressFunc(
+    HashAlgorithm algorithm)
+{
+    return IsSha1(algorithm) ? GetKernels().pfnSha1 : GetKernels().pfnSha256;
+}
+
+// =====================================================================================================================
+static void InitState(
+    HashAlgorithm algorithm,
+    uint32*       pState)
+{
+    switch (algorithm)
+    {
+    case HashAlgorithm::Sha1:
+        memcpy(pState, Sha1InitState, sizeof(Sha1InitState));
+        break;
+    case HashAlgorithm::Sha224:
+        memcpy(pState, Sha224InitState, sizeof(Sha224InitState));
+        break;
+    case HashAlgorithm::Sha256:
+        memcpy(pState, Sha256InitState, sizeof(Sha256InitState));
+        break;
+    default:
+        PAL_NEVER_CALLED();
+        break;
+    }
+}
+
+// =====================================================================================================================
+// Pads the final partial block, compresses it and writes the big-endian digest.  pTail holds the tailSize (< 64) bytes
+// which follow the last whole block, and totalSize is the total message length in bytes.
+static void FinishState(
+    HashAlgorithm algorithm,
+    uint32*       pState,
+    const uint8*  pTail,
+    size_t        tailSize,
+    uint64        totalSize,
+    void*         pOutput)
+{
+    PAL_ASSERT(tailSize < BlockSize);
+
+    uint8 pad[BlockSize * 2] = {};
+    if (tailSize > 0)
+    {
+        memcpy(pad, pTail, tailSize);
+    }
+    pad[tailSize] = 0x80;
+
+    // The message length in bits goes into the last eight bytes; if it doesn't fit after the 0x80 marker, a second
+    // block is needed.
+    const size_t padSize   = ((tailSize + 1 + sizeof(uint64)) > BlockSize) ? (BlockSize * 2) : BlockSize;
+    const uint64 totalBits = totalSize * 8;
+
+    StoreBigEndian32(&pad[padSize - 8], uint32(totalBits >> 32));
+    StoreBigEndian32(&pad[padSize - 4], uint32(totalBits));
+
+    GetCompressFunc(algorithm)(pState, pad, padSize / BlockSize);
+
+    const size_t digestSize = GetDigestSize(algorithm);
+    uint8*const  pDigest    = static_cast<uint8*>(pOutput);
+
+    for (size_t word = 0; word < (digestSize / sizeof(uint32)); word++)
+    {
+        StoreBigEndian32(pDigest + (word * sizeof(uint32)), pState[word]);
+    }
+}
+
+// =====================================================================================================================
+bool IsNativeAlgorithm(
+    HashAlgorithm algorithm)
+{
+    return ((algorithm == HashAlgorithm::Sha1)   ||
+            (algorithm == HashAlgorithm::Sha224) ||
+            (algorithm == HashAlgorithm::Sha256));
+}
+
+// =====================================================================================================================
+size_t GetDigestSize(
+    HashAlgorithm algorithm)
+{
+    size_t size = 0;
+
+    switch (algorithm)
+    {
+    case HashAlgorithm::Sha1:
+        size = 20;
+        break;
+    case HashAlgorithm::Sha224:
+        size = 28;
+        break;
+    case HashAlgorithm::Sha256:
+        size = 32;
+        break;
+    default:
+        PAL_NEVER_CALLED();
+        break;
+    }
+
+    return size;
+}
+
+// =====================================================================================================================
+void HashBuffer(
+    HashAlgorithm algorithm,
+    const void*   pData,
+    size_t        dataSize,
+    void*         pOutput)
+{
+    PAL_ASSERT(IsNativeAlgorithm(algorithm));
+
+    uint32 state[8];
+    InitState(algorithm, state);
+
+    const uint8* pBytes    = static_cast<const uint8*>(pData);
+    const size_t numBlocks = dataSize / BlockSize;
+
+    if (numBlocks > 0)
+    {
+        GetCompressFunc(algorithm)(state, pBytes, numBlocks);
+    }
+
+    FinishState(algorithm, state, pBytes + (numBlocks * BlockSize), dataSize % BlockSize, dataSize, pOutput);
+}
+
+// =====================================================================================================================
+NativeHashContext::NativeHashContext(
+    HashAlgorithm algorithm)
+    :
+    m_algorithm(algorithm),
+    m_totalSize(0),
+    m_pendingSize(0)
+{
+    PAL_ASSERT(IsNativeAlgorithm(algorithm));
+    InitState(m_algorithm, m_state);
+}
+
+// =====================================================================================================================
+// Appends data to the message.  Whole blocks are compressed straight from the caller's buffer; only the trailing
+// partial block is copied.
+Result NativeHashContext::AddData(
+    const void* pData,
+    size_t      dataSize)
+{
+    Result result = Result::Success;
+
+    if ((pData == nullptr) && (dataSize > 0))
+    {
+        result = Result::ErrorInvalidPointer;
+    }
+    else
+    {
+        const CompressFunc pfnCompress = GetCompressFunc(m_algorithm);
+        const uint8*       pBytes      = static_cast<const uint8*>(pData);
+
+        m_totalSize += dataSize;
+
+        if (m_pendingSize > 0)
+        {
+            const size_t copySize = Min(dataSize, BlockSize - m_pendingSize);
+
+            memcpy(&m_pending[m_pendingSize], pBytes, copySize);
+            m_pendingSize += uint32(copySize);
+            pBytes        += copySize;
+            dataSize      -= copySize;
+
+            if (m_pendingSize == BlockSize)
+            {
+                pfnCompress(m_state, m_pending, 1);
+                m_pendingSize = 0;
+            }
+        }
+
+        const size_t numBlocks = dataSize / BlockSize;
+
+        if (numBlocks > 0)
+        {
+            pfnCompress(m_state, pBytes, numBlocks);
+            pBytes   += numBlocks * BlockSize;
+            dataSize -= numBlocks * BlockSize;
+        }
+
+        if (dataSize > 0)
+        {
+            memcpy(&m_pending[m_pendingSize], pBytes, dataSize);
+            m_pendingSize += uint32(dataSize);
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Writes the digest.  The context is reset afterwards so it can be reused without an explicit Reset().
+Result NativeHashContext::Finish(
+    void* pOutput)
+{
+    Result result = Result::Success;
+
+    if (pOutput == nullptr)
+    {
+        result = Result::ErrorInvalidPointer;
+    }
+    else
+    {
+        FinishState(m_algorithm, m_state, m_pending, m_pendingSize, m_totalSize, pOutput);
+        result = Reset();
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+Result NativeHashContext::Reset()
+{
+    InitState(m_algorithm, m_state);
+    m_totalSize   = 0;
+    m_pendingSize = 0;
+
+    return Result::Success;
+}
+
+// =====================================================================================================================
+Result NativeHashContext::Duplicate(
+    void*           pPlacementAddr,
+    IHashContext**  ppDuplicatedObject
+    ) const
+{
+    Result result = Result::Success;
+
+    if ((pPlacementAddr != nullptr) &&
+        (ppDuplicatedObject != nullptr))
+    {
+        NativeHashContext* pDuplicate = PAL_PLACEMENT_NEW(pPlacementAddr) NativeHashContext(m_algorithm);
+
+        memcpy(pDuplicate->m_state, m_state, sizeof(m_state));
+        memcpy(pDuplicate->m_pending, m_pending, m_pendingSize);
+        pDuplicate->m_totalSize   = m_totalSize;
+        pDuplicate->m_pendingSize = m_pendingSize;
+
+        *ppDuplicatedObject = pDuplicate;
+    }
+    else
+    {
+        PAL_ALERT(pPlacementAddr == nullptr);
+        PAL_ALERT(ppDuplicatedObject == nullptr);
+
+        result = Result::ErrorInvalidPointer;
+    }
+
+    return result;
+}
+
+} // Sha
+
+// =====================================================================================================================
+Result HashBuffer(
+    HashAlgorithm algorithm,
+    const void*   pData,
+    size_t        dataSize,
+    void*         pOutput)
+{
+    Result result = Result::Success;
+
+    if (Sha::IsNativeAlgorithm(algorithm) == false)
+    {
+        result = Result::Unsupported;
+    }
+    else if (((pData == nullptr) && (dataSize > 0)) || (pOutput == nullptr))
+    {
+        result = Result::ErrorInvalidPointer;
+    }
+    else
+    {
+        Sha::HashBuffer(algorithm, pData, dataSize, pOutput);
+    }
+
+    return result;
+}
+
+} // Util
@@ -0,0 +1,91 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#pragma once
+
+#include "palHashProvider.h"
+
+namespace Util
+{
+namespace Sha
+{
+
+/// Size in bytes of a SHA-1/SHA-2 (32-bit word variants) message block.
+constexpr size_t BlockSize = 64;
+
+// Returns true if the algorithm has a built-in implementation which does not need an OS provider.
+extern bool IsNativeAlgorithm(HashAlgorithm algorithm);
+
+// Returns the digest size in bytes of a native algorithm.
+extern size_t GetDigestSize(HashAlgorithm algorithm);
+
+// Hashes a single buffer in one shot. The algorithm must be a native algorithm.
+extern void HashBuffer(
+    HashAlgorithm algorithm,
+    const void*   pData,
+    size_t        dataSize,
+    void*         pOutput);
+
+// =====================================================================================================================
+// Built-in SHA-1/SHA-224/SHA-256 hash context.  The compression function is chosen at runtime: SHA-NI when the CPU
+// supports it, otherwise a portable scalar implementation.
+class NativeHashContext : public IHashContext
+{
+public:
+    explicit NativeHashContext(HashAlgorithm algorithm);
+    virtual ~NativeHashContext() { }
+
+    virtual Result AddData(
+        const void* pData,
+        size_t      dataSize) override;
+
+    virtual size_t GetOutputBufferSize() const override { return GetDigestSize(m_algorithm); }
+
+    virtual Result Finish(
+        void*   pOutput) override;
+
+    virtual Result Reset() override;
+
+    virtual size_t GetDuplicateObjectSize() const override { return sizeof(NativeHashContext); }
+
+    virtual Result Duplicate(
+        void*           pPlacementAddr,
+        IHashContext**  ppDuplicatedObject) const override;
+
+    virtual void Destroy() override { this->~NativeHashContext(); }
+
+private:
+    PAL_DISALLOW_DEFAULT_CTOR(NativeHashContext);
+    PAL_DISALLOW_COPY_AND_ASSIGN(NativeHashContext);
+
+    const HashAlgorithm m_algorithm;
+    uint32              m_state[8];
+    uint64              m_totalSize;            // Total number of bytes added since the last reset.
+    uint8               m_pending[BlockSize];   // Bytes which do not yet fill a whole block.
+    uint32              m_pendingSize;
+};
+
+} // Sha
+} // Util
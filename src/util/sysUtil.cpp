@@ -22,6 +22,7 @@
  *  SOFTWARE.
  *
  **********************************************************************************************************************/
+#include "palInlineFuncs.h"
 #include "palSysUtil.h"
 
 namespace Util
@@ -216,4 +217,66 @@ void QueryIntelCpuType(
 #endif
 }
 
+// =====================================================================================================================
+// Builds a mask of the supported CpuFeature values.  XGETBV is used to confirm that the OS saves the YMM state before
+// any AVX feature is reported.
+static uint32 QueryCpuFeatures()
+{
+    uint32 features = 0;
+
+#if PAL_HAS_CPUID
+    uint32 reg[4] = {};
+
+    CpuId(reg, 0);
+    const uint32 maxLevel = reg[0];
+
+    CpuId(reg, 1);
+    const uint32 ecx1 = reg[2];
+    const uint32 edx1 = reg[3];
+
+    uint32 ebx7 = 0;
+    if (maxLevel >= 7)
+    {
+        CpuId(reg, 7, 0);
+        ebx7 = reg[1];
+    }
+
+    bool osSavesYmm = false;
+    if (TestAnyFlagSet(ecx1, 1u << 27)) // OSXSAVE
+    {
+        uint32 xcr0Lo = 0;
+        uint32 xcr0Hi = 0;
+        asm volatile("xgetbv" : "=a"(xcr0Lo), "=d"(xcr0Hi) : "c"(0));
+        osSavesYmm = TestAllFlagsSet(xcr0Lo, 0x6); // XMM and YMM state.
+    }
+
+    const bool avx = osSavesYmm && TestAnyFlagSet(ecx1, 1u << 28);
+
+    features |= TestAnyFlagSet(edx1, 1u << 26) ? (1u << uint32(CpuFeature::Sse2))   : 0;
+    features |= TestAnyFlagSet(ecx1, 1u << 9)  ? (1u << uint32(CpuFeature::Ssse3))  : 0;
+    features |= TestAnyFlagSet(ecx1, 1u << 19) ? (1u << uint32(CpuFeature::Sse41))  : 0;
+    features |= TestAnyFlagSet(ecx1, 1u << 20) ? (1u << uint32(CpuFeature::Sse42))  : 0;
+    features |= TestAnyFlagSet(ecx1, 1u << 23) ? (1u << uint32(CpuFeature::Popcnt)) : 0;
+    features |= avx                            ? (1u << uint32(CpuFeature::Avx))    : 0;
+    features |= (avx && TestAnyFlagSet(ebx7, 1u << 5)) ? (1u << uint32(CpuFeature::Avx2)) : 0;
+    features |= TestAnyFlagSet(ebx7, 1u << 8)  ? (1u << uint32(CpuFeature::Bmi2))   : 0;
+    features |= TestAnyFlagSet(ebx7, 1u << 29) ? (1u << uint32(CpuFeature::ShaNi))  : 0;
+    features |= (avx && TestAnyFlagSet(ecx1, 1u << 29)) ? (1u << uint32(CpuFeature::F16c)) : 0;
+#endif
+
+    return features;
+}
+
+// =====================================================================================================================
+bool CpuSupportsFeature(
+    CpuFeature feature)
+{
+    static_assert(uint32(CpuFeature::Count) <= 32, "CpuFeature values must fit in the feature mask!");
+
+    // Function-local statics are initialized exactly once, even when first called from several threads.
+    static const uint32 Features = QueryCpuFeatures();
+
+    return TestAnyFlagSet(Features, 1u << uint32(feature));
+}
+
 } // Util
@@ -0,0 +1,903 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "palXxHash.h"
+#include "palAssert.h"
+#include "palInlineFuncs.h"
+#include "palSysUtil.h"
+
+#include <string.h>
+
+#if PAL_HAS_CPUID
+#include <immintrin.h>
+#endif
+
+namespace Util
+{
+
+// The algorithm constants below come from the XXH3 specification and must not be changed, or the hash values will no
+// longer match other XXH3 implementations.
+static constexpr uint32 Prime32_1 = 0x9E3779B1U;
+static constexpr uint32 Prime32_2 = 0x85EBCA77U;
+static constexpr uint32 Prime32_3 = 0xC2B2AE3DU;
+
+static constexpr uint64 Prime64_1 = 0x9E3779B185EBCA87ULL;
+static constexpr uint64 Prime64_2 = 0xC2B2AE3D27D4EB4FULL;
+static constexpr uint64 Prime64_3 = 0x165667B19E3779F9ULL;
+static constexpr uint64 Prime64_4 = 0x85EBCA77C2B2AE63ULL;
+static constexpr uint64 Prime64_5 = 0x27D4EB2F165667C5ULL;
+
+static constexpr uint64 PrimeMx1  = 0x165667919E3779F9ULL;
+static constexpr uint64 PrimeMx2  = 0x9FB21C651E98DF25ULL;
+
+static constexpr size_t StripeLength       = 64;    // Bytes of input consumed by one accumulation step.
+static constexpr size_t SecretConsumeRate  = 8;     // Bytes the secret advances by for each stripe.
+static constexpr size_t MidSizeMax         = 240;   // Inputs up to this size don't use the accumulators.
+static constexpr size_t MidSizeStartOffset = 3;
+static constexpr size_t MidSizeLastOffset  = 17;
+static constexpr size_t SecretSizeMin      = 136;
+static constexpr size_t SecretLastAccStart = 7;
+static constexpr size_t SecretMergeAccsStart = 11;
+
+static constexpr size_t SecretLimit        = XxHash128::SecretSize - StripeLength;
+static constexpr size_t StripesPerBlock    = SecretLimit / SecretConsumeRate;
+static constexpr size_t BlockLength        = StripeLength * StripesPerBlock;
+static constexpr size_t BufferStripes      = XxHash128::BufferSize / StripeLength;
+
+static_assert((XxHash128::BufferSize % StripeLength) == 0, "The input buffer must hold a whole number of stripes!");
+
+static const uint8 DefaultSecret[XxHash128::SecretSize] =
+{
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+static const uint64 InitialAcc[8] =
+{
+    Prime32_3, Prime64_1, Prime64_2, Prime64_3, Prime64_4, Prime32_2, Prime64_5, Prime32_1
+};
+
+struct Hash128Value
+{
+    uint64 low;
+    uint64 high;
+};
+
+// Accumulates numStripes consecutive 64-byte stripes into the eight accumulators, advancing through the secret.
+typedef void (*AccumulateFunc)(uint64* pAcc, const uint8* pInput, const uint8* pSecret, size_t numStripes);
+
+// Scrambles the accumulators at the end of each block.
+typedef void (*ScrambleFunc)(uint64* pAcc, const uint8* pSecret);
+
+// =====================================================================================================================
+static PAL_INLINE uint32 ReadLe32(
+    const uint8* pData)
+{
+    uint32 value;
+    memcpy(&value, pData, sizeof(value));
+    return value;
+}
+
+// =====================================================================================================================
+static PAL_INLINE uint64 ReadLe64(
+    const uint8* pData)
+{
+    uint64 value;
+    memcpy(&value, pData, sizeof(value));
+    return value;
+}
+
+// =====================================================================================================================
+static PAL_INLINE uint32 RotateLeft32(
+    uint32 value,
+    uint32 amount)
+{
+    return (value << amount) | (value >> (32 - amount));
+}
+
+// =====================================================================================================================
+static PAL_INLINE uint64 RotateLeft64(
+    uint64 value,
+    uint32 amount)
+{
+    return (value << amount) | (value >> (64 - amount));
+}
+
+// =====================================================================================================================
+static PAL_INLINE uint32 Swap32(
+    uint32 value)
+{
+    return ((value << 24) & 0xff000000) | ((value << 8) & 0x00ff0000) |
+           ((value >> 8)  & 0x0000ff00) | ((value >> 24) & 0x000000ff);
+}
+
+// =====================================================================================================================
+static PAL_INLINE uint64 Swap64(
+    uint64 value)
+{
+    return (uint64(Swap32(uint32(value))) << 32) | Swap32(uint32(value >> 32));
+}
+
+// =====================================================================================================================
+static PAL_INLINE Hash128Value Multiply64To128(
+    uint64 lhs,
+    uint64 rhs)
+{
+    Hash128Value result;
+
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 product = static_cast<unsigned __int128>(lhs) * rhs;
+
+    result.low  = uint64(product);
+    result.high = uint64(product >> 64);
+#else
+    const uint64 loLo  = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+    const uint64 hiLo  = (lhs >> 32)        * (rhs & 0xFFFFFFFF);
+    const uint64 loHi  = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+    const uint64 hiHi  = (lhs >> 32)        * (rhs >> 32);
+    const uint64 cross = (loLo >> 32) + (hiLo & 0xFFFFFFFF) + loHi;
+
+    result.low  = (cross << 32) | (loLo & 0xFFFFFFFF);
+    result.high = (hiLo >> 32) + (cross >> 32) + hiHi;
+#endif
+
+    return result;
+}
+
+// =====================================================================================================================
+static PAL_INLINE uint64 Multiply128Fold64(
+    uint64 lhs,
+    uint64 rhs)
+{
+    const Hash128Value product = Multiply64To128(lhs, rhs);
+    return product.low ^ product.high;
+}
+
+// =====================================================================================================================
+static PAL_INLINE uint64 XorShift64(
+    uint64 value,
+    uint32 shift)
+{
+    return value ^ (value >> shift);
+}
+
+// =====================================================================================================================
+static PAL_INLINE uint64 Avalanche64(
+    uint64 hash)
+{
+    hash ^= hash >> 33;
+    hash *= Prime64_2;
+    hash ^= hash >> 29;
+    hash *= Prime64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+// =====================================================================================================================
+static PAL_INLINE uint64 Avalanche(
+    uint64 hash)
+{
+    hash  = XorShift64(hash, 37);
+    hash *= PrimeMx1;
+    return XorShift64(hash, 32);
+}
+
+// =====================================================================================================================
+static PAL_INLINE uint64 Mix16Bytes(
+    const uint8* pInput,
+    const uint8* pSecret,
+    uint64       seed)
+{
+    return Multiply128Fold64(ReadLe64(pInput)     ^ (ReadLe64(pSecret)     + seed),
+                             ReadLe64(pInput + 8) ^ (ReadLe64(pSecret + 8) - seed));
+}
+
+// =====================================================================================================================
+static PAL_INLINE Hash128Value Mix32Bytes(
+    Hash128Value acc,
+    const uint8* pInput1,
+    const uint8* pInput2,
+    const uint8* pSecret,
+    uint64       seed)
+{
+    acc.low  += Mix16Bytes(pInput1, pSecret, seed);
+    acc.low  ^= ReadLe64(pInput2) + ReadLe64(pInput2 + 8);
+    acc.high += Mix16Bytes(pInput2, pSecret + 16, seed);
+    acc.high ^= ReadLe64(pInput1) + ReadLe64(pInput1 + 8);
+    return acc;
+}
+
+// =====================================================================================================================
+static Hash128Value HashLength1To3(
+    const uint8* pInput,
+    size_t       length,
+    const uint8* pSecret,
+    uint64       seed)
+{
+    const uint8  c1        = pInput[0];
+    const uint8  c2        = pInput[length >> 1];
+    const uint8  c3        = pInput[length - 1];
+    const uint32 combinedL = (uint32(c1) << 16) | (uint32(c2) << 24) | uint32(c3) | (uint32(length) << 8);
+    const uint32 combinedH = RotateLeft32(Swap32(combinedL), 13);
+    const uint64 bitflipL  = (ReadLe32(pSecret)     ^ ReadLe32(pSecret + 4))  + seed;
+    const uint64 bitflipH  = (ReadLe32(pSecret + 8) ^ ReadLe32(pSecret + 12)) - seed;
+
+    Hash128Value hash;
+    hash.low  = Avalanche64(uint64(combinedL) ^ bitflipL);
+    hash.high = Avalanche64(uint64(combinedH) ^ bitflipH);
+    return hash;
+}
+
+// =====================================================================================================================
+static Hash128Value HashLength4To8(
+    const uint8* pInput,
+    size_t       length,
+    const uint8* pSecret,
+    uint64       seed)
+{
+    seed ^= uint64(Swap32(uint32(seed))) << 32;
+
+    const uint64 input64 = ReadLe32(pInput) + (uint64(ReadLe32(pInput + length - 4)) << 32);
+    const uint64 bitflip = (ReadLe64(pSecret + 16) ^ ReadLe64(pSecret + 24)) + seed;
+
+    Hash128Value hash = Multiply64To128(input64 ^ bitflip, Prime64_1 + (length << 2));
+
+    hash.high += (hash.low << 1);
+    hash.low  ^= (hash.high >> 3);
+    hash.low   = XorShift64(hash.low, 35);
+    hash.low  *= PrimeMx2;
+    hash.low   = XorShift64(hash.low, 28);
+    hash.high  = Avalanche(hash.high);
+    return hash;
+}
+
+// =====================================================================================================================
+static Hash128Value HashLength9To16(
+    const uint8* pInput,
+    size_t       length,
+    const uint8* pSecret,
+    uint64       seed)
+{
+    const uint64 bitflipL = (ReadLe64(pSecret + 32) ^ ReadLe64(pSecret + 40)) - seed;
+    const uint64 bitflipH = (ReadLe64(pSecret + 48) ^ ReadLe64(pSecret + 56)) + seed;
+    const uint64 inputLo  = ReadLe64(pInput);
+    uint64       inputHi  = ReadLe64(pInput + length - 8);
+
+    Hash128Value mul = Multiply64To128(inputLo ^ inputHi ^ bitflipL, Prime64_1);
+
+    mul.low += uint64(length - 1) << 54;
+    inputHi ^= bitflipH;
+    mul.high += inputHi + (uint64(uint32(inputHi)) * (Prime32_2 - 1));
+    mul.low  ^= Swap64(mul.high);
+
+    Hash128Value hash = Multiply64To128(mul.low, Prime64_2);
+    hash.high += mul.high * Prime64_2;
+    hash.low   = Avalanche(hash.low);
+    hash.high  = Avalanche(hash.high);
+    return hash;
+}
+
+// =====================================================================================================================
+static Hash128Value HashLength0To16(
+    const uint8* pInput,
+    size_t       length,
+    const uint8* pSecret,
+    uint64       seed)
+{
+    Hash128Value hash;
+
+    if (length > 8)
+    {
+        hash = HashLength9To16(pInput, length, pSecret, seed);
+    }
+    else if (length >= 4)
+    {
+        hash = HashLength4To8(pInput, length, pSecret, seed);
+    }
+    else if (length > 0)
+    {
+        hash = HashLength1To3(pInput, length, pSecret, seed);
+    }
+    else
+    {
+        hash.low  = Avalanche64(seed ^ ReadLe64(pSecret + 64) ^ ReadLe64(pSecret + 72));
+        hash.high = Avalanche64(seed ^ ReadLe64(pSecret + 80) ^ ReadLe64(pSecret + 88));
+    }
+
+    return hash;
+}
+
+// =====================================================================================================================
+static PAL_INLINE Hash128Value FinalizeMidSize(
+    Hash128Value acc,
+    size_t       length,
+    uint64       seed)
+{
+    Hash128Value hash;
+    hash.low  = Avalanche(acc.low + acc.high);
+    hash.high = 0 - Avalanche((acc.low * Prime64_1) + (acc.high * Prime64_4) + ((length - seed) * Prime64_2));
+    return hash;
+}
+
+// =====================================================================================================================
+static Hash128Value HashLength17To128(
+    const uint8* pInput,
+    size_t       length,
+    const uint8* pSecret,
+    uint64       seed)
+{
+    Hash128Value acc = { length * Prime64_1, 0 };
+
+    if (length > 32)
+    {
+        if (length > 64)
+        {
+            if (length > 96)
+            {
+                acc = Mix32Bytes(acc, pInput + 48, pInput + length - 64, pSecret + 96, seed);
+            }
+            acc = Mix32Bytes(acc, pInput + 32, pInput + length - 48, pSecret + 64, seed);
+        }
+        acc = Mix32Bytes(acc, pInput + 16, pInput + length - 32, pSecret + 32, seed);
+    }
+    acc = Mix32Bytes(acc, pInput, pInput + length - 16, pSecret, seed);
+
+    return FinalizeMidSize(acc, length, seed);
+}
+
+// =====================================================================================================================
+static Hash128Value HashLength129To240(
+    const uint8* pInput,
+    size_t       length,
+    const uint8* pSecret,
+    uint64       seed)
+{
+    Hash128Value acc = { length * Prime64_1, 0 };
+
+    for (size_t i = 32; i < 160; i += 32)
+    {
+        acc = Mix32Bytes(acc, pInput + i - 32, pInput + i - 16, pSecret + i - 32, seed);
+    }
+
+    acc.low  = Avalanche(acc.low);
+    acc.high = Avalanche(acc.high);
+
+    for (size_t i = 160; i <= length; i += 32)
+    {
+        acc = Mix32Bytes(acc, pInput + i - 32, pInput + i - 16, pSecret + MidSizeStartOffset + i - 160, seed);
+    }
+
+    acc = Mix32Bytes(acc,
+                     pInput + length - 16,
+                     pInput + length - 32,
+                     pSecret + SecretSizeMin - MidSizeLastOffset - 16,
+                     0 - seed);
+
+    return FinalizeMidSize(acc, length, seed);
+}
+
+// =====================================================================================================================
+// Portable accumulation of one stripe.
+static PAL_INLINE void Accumulate512Scalar(
+    uint64*      pAcc,
+    const uint8* pInput,
+    const uint8* pSecret)
+{
+    for (uint32 lane = 0; lane < 8; lane++)
+    {
+        const uint64 dataVal = ReadLe64(pInput + (lane * 8));
+        const uint64 dataKey = dataVal ^ ReadLe64(pSecret + (lane * 8));
+
+        pAcc[lane ^ 1] += dataVal;
+        pAcc[lane]     += (dataKey & 0xFFFFFFFF) * (dataKey >> 32);
+    }
+}
+
+// =====================================================================================================================
+static void AccumulateScalar(
+    uint64*      pAcc,
+    const uint8* pInput,
+    const uint8* pSecret,
+    size_t       numStripes)
+{
+    for (size_t n = 0; n < numStripes; n++)
+    {
+        Accumulate512Scalar(pAcc, pInput + (n * StripeLength), pSecret + (n * SecretConsumeRate));
+    }
+}
+
+// =====================================================================================================================
+static void ScrambleScalar(
+    uint64*      pAcc,
+    const uint8* pSecret)
+{
+    for (uint32 lane = 0; lane < 8; lane++)
+    {
+        uint64 acc = XorShift64(pAcc[lane], 47);
+        acc       ^= ReadLe64(pSecret + (lane * 8));
+        pAcc[lane] = acc * Prime32_1;
+    }
+}
+
+#if PAL_HAS_CPUID
+// =====================================================================================================================
+// SSE2 accumulation.  The accumulators stay in registers for the whole run of stripes.
+PAL_TARGET_SSE2 static void AccumulateSse2(
+    uint64*      pAcc,
+    const uint8* pInput,
+    const uint8* pSecret,
+    size_t       numStripes)
+{
+    __m128i acc[4];
+
+    for (uint32 i = 0; i < 4; i++)
+    {
+        acc[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pAcc) + i);
+    }
+
+    for (size_t n = 0; n < numStripes; n++)
+    {
+        const __m128i* pIn  = reinterpret_cast<const __m128i*>(pInput + (n * StripeLength));
+        const __m128i* pKey = reinterpret_cast<const __m128i*>(pSecret + (n * SecretConsumeRate));
+
+        for (uint32 i = 0; i < 4; i++)
+        {
+            const __m128i data    = _mm_loadu_si128(pIn + i);
+            const __m128i dataKey = _mm_xor_si128(data, _mm_loadu_si128(pKey + i));
+            const __m128i product = _mm_mul_epu32(dataKey, _mm_shuffle_epi32(dataKey, _MM_SHUFFLE(0, 3, 0, 1)));
+
+            acc[i] = _mm_add_epi64(acc[i], _mm_add_epi64(product, _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2))));
+        }
+    }
+
+    for (uint32 i = 0; i < 4; i++)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pAcc) + i, acc[i]);
+    }
+}
+
+// =====================================================================================================================
+PAL_TARGET_SSE2 static void ScrambleSse2(
+    uint64*      pAcc,
+    const uint8* pSecret)
+{
+    const __m128i prime = _mm_set1_epi32(int(Prime32_1));
+
+    for (uint32 i = 0; i < 4; i++)
+    {
+        const __m128i acc     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pAcc) + i);
+        const __m128i dataKey = _mm_xor_si128(_mm_xor_si128(acc, _mm_srli_epi64(acc, 47)),
+                                              _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSecret) + i));
+        const __m128i prodLo  = _mm_mul_epu32(dataKey, prime);
+        const __m128i prodHi  = _mm_mul_epu32(_mm_shuffle_epi32(dataKey, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pAcc) + i, _mm_add_epi64(prodLo, _mm_slli_epi64(prodHi, 32)));
+    }
+}
+
+// =====================================================================================================================
+// AVX2 accumulation.  The accumulators stay in registers for the whole run of stripes.
+PAL_TARGET_AVX2 static void AccumulateAvx2(
+    uint64*      pAcc,
+    const uint8* pInput,
+    const uint8* pSecret,
+    size_t       numStripes)
+{
+    __m256i acc0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pAcc));
+    __m256i acc1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pAcc) + 1);
+
+    for (size_t n = 0; n < numStripes; n++)
+    {
+        const __m256i* pIn  = reinterpret_cast<const __m256i*>(pInput + (n * StripeLength));
+        const __m256i* pKey = reinterpret_cast<const __m256i*>(pSecret + (n * SecretConsumeRate));
+
+        const __m256i data0    = _mm256_loadu_si256(pIn);
+        const __m256i data1    = _mm256_loadu_si256(pIn + 1);
+        const __m256i dataKey0 = _mm256_xor_si256(data0, _mm256_loadu_si256(pKey));
+        const __m256i dataKey1 = _mm256_xor_si256(data1, _mm256_loadu_si256(pKey + 1));
+        const __m256i product0 = _mm256_mul_epu32(dataKey0, _mm256_srli_epi64(dataKey0, 32));
+        const __m256i product1 = _mm256_mul_epu32(dataKey1, _mm256_srli_epi64(dataKey1, 32));
+
+        acc0 = _mm256_add_epi64(acc0, _mm256_add_epi64(product0, _mm256_shuffle_epi32(data0, _MM_SHUFFLE(1, 0, 3, 2))));
+        acc1 = _mm256_add_epi64(acc1, _mm256_add_epi64(product1, _mm256_shuffle_epi32(data1, _MM_SHUFFLE(1, 0, 3, 2))));
+    }
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(pAcc),     acc0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(pAcc) + 1, acc1);
+}
+
+// =====================================================================================================================
+PAL_TARGET_AVX2 static void ScrambleAvx2(
+    uint64*      pAcc,
+    const uint8* pSecret)
+{
+    const __m256i prime = _mm256_set1_epi32(int(Prime32_1));
+
+    for (uint32 i = 0; i < 2; i++)
+    {
+        const __m256i acc     = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pAcc) + i);
+        const __m256i dataKey = _mm256_xor_si256(_mm256_xor_si256(acc, _mm256_srli_epi64(acc, 47)),
+                                                 _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSecret) + i));
+        const __m256i prodLo  = _mm256_mul_epu32(dataKey, prime);
+        const __m256i prodHi  = _mm256_mul_epu32(_mm256_srli_epi64(dataKey, 32), prime);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pAcc) + i,
+                            _mm256_add_epi64(prodLo, _mm256_slli_epi64(prodHi, 32)));
+    }
+}
+#endif
+
+// Long-input kernels selected for the current CPU.
+struct XxHashKernels
+{
+    AccumulateFunc pfnAccumulate;
+    ScrambleFunc   pfnScramble;
+};
+
+// =====================================================================================================================
+static XxHashKernels SelectKernels()
+{
+    XxHashKernels kernels = { &AccumulateScalar, &ScrambleScalar };
+
+#if PAL_HAS_CPUID
+    if (CpuSupportsFeature(CpuFeature::Avx2))
+    {
+        kernels.pfnAccumulate = &AccumulateAvx2;
+        kernels.pfnScramble   = &ScrambleAvx2;
+    }
+    else if (CpuSupportsFeature(CpuFeature::Sse2))
+    {
+        kernels.pfnAccumulate = &AccumulateSse2;
+        kernels.pfnScramble   = &ScrambleSse2;
+    }
+#endif
+
+    return kernels;
+}
+
+// =====================================================================================================================
+static const XxHashKernels& GetKernels()
+{
+    static const XxHashKernels Kernels = SelectKernels();
+    return Kernels;
+}
+
+// =====================================================================================================================
+// Derives the secret used for long inputs from a non-zero seed.
+static void InitSecretFromSeed(
+    uint8* pSecret,
+    uint64 seed)
+{
+    for (size_t i = 0; i < XxHash128::SecretSize; i += 16)
+    {
+        const uint64 lo = ReadLe64(DefaultSecret + i)     + seed;
+        const uint64 hi = ReadLe64(DefaultSecret + i + 8) - seed;
+
+        memcpy(pSecret + i,     &lo, sizeof(lo));
+        memcpy(pSecret + i + 8, &hi, sizeof(hi));
+    }
+}
+
+// =====================================================================================================================
+static uint64 MergeAccumulators(
+    const uint64* pAcc,
+    const uint8*  pSecret,
+    uint64        start)
+{
+    uint64 result = start;
+
+    for (uint32 i = 0; i < 4; i++)
+    {
+        result += Multiply128Fold64(pAcc[2 * i]     ^ ReadLe64(pSecret + (16 * i)),
+                                    pAcc[(2 * i) + 1] ^ ReadLe64(pSecret + (16 * i) + 8));
+    }
+
+    return Avalanche(result);
+}
+
+// =====================================================================================================================
+static PAL_INLINE Hash128Value MergeLong(
+    const uint64* pAcc,
+    const uint8*  pSecret,
+    uint64        length)
+{
+    Hash128Value hash;
+    hash.low  = MergeAccumulators(pAcc, pSecret + SecretMergeAccsStart, length * Prime64_1);
+    hash.high = MergeAccumulators(pAcc,
+                                  pSecret + XxHash128::SecretSize - (sizeof(uint64) * 8) - SecretMergeAccsStart,
+                                  ~(length * Prime64_2));
+    return hash;
+}
+
+// =====================================================================================================================
+// Hashes inputs longer than MidSizeMax in one shot.
+static Hash128Value HashLong(
+    const uint8* pInput,
+    size_t       length,
+    const uint8* pSecret)
+{
+    const XxHashKernels& kernels = GetKernels();
+
+    uint64 acc[8];
+    memcpy(acc, InitialAcc, sizeof(acc));
+
+    const size_t numBlocks = (length - 1) / BlockLength;
+
+    for (size_t n = 0; n < numBlocks; n++)
+    {
+        kernels.pfnAccumulate(acc, pInput + (n * BlockLength), pSecret, StripesPerBlock);
+        kernels.pfnScramble(acc, pSecret + SecretLimit);
+    }
+
+    const size_t numStripes = ((length - 1) - (BlockLength * numBlocks)) / StripeLength;
+    kernels.pfnAccumulate(acc, pInput + (numBlocks * BlockLength), pSecret, numStripes);
+
+    // The last stripe always ends at the end of the input, so it may overlap the previous one.
+    Accumulate512Scalar(acc, pInput + length - StripeLength, pSecret + SecretLimit - SecretLastAccStart);
+
+    return MergeLong(acc, pSecret, length);
+}
+
+// =====================================================================================================================
+// Hashes inputs of up to MidSizeMax bytes; these always use the default secret.
+static Hash128Value HashShort(
+    const uint8* pInput,
+    size_t       length,
+    uint64       seed)
+{
+    PAL_ASSERT(length <= MidSizeMax);
+
+    Hash128Value hash;
+
+    if (length <= 16)
+    {
+        hash = HashLength0To16(pInput, length, DefaultSecret, seed);
+    }
+    else if (length <= 128)
+    {
+        hash = HashLength17To128(pInput, length, DefaultSecret, seed);
+    }
+    else
+    {
+        hash = HashLength129To240(pInput, length, DefaultSecret, seed);
+    }
+
+    return hash;
+}
+
+// =====================================================================================================================
+static PAL_INLINE void WriteHash(
+    const Hash128Value& hash,
+    uint8*              pHash)
+{
+    memcpy(pHash,                  &hash.low,  sizeof(hash.low));
+    memcpy(pHash + sizeof(uint64), &hash.high, sizeof(hash.high));
+}
+
+// =====================================================================================================================
+// Consumes numStripes stripes, scrambling the accumulators whenever a block of the secret has been used up.
+static const uint8* ConsumeStripes(
+    uint64*      pAcc,
+    uint32*      pStripesSoFar,
+    const uint8* pInput,
+    size_t       numStripes,
+    const uint8* pSecret)
+{
+    const XxHashKernels& kernels = GetKernels();
+
+    const uint8* pStripeSecret = pSecret + (*pStripesSoFar * SecretConsumeRate);
+
+    if (numStripes >= (StripesPerBlock - *pStripesSoFar))
+    {
+        size_t stripesThisIter = StripesPerBlock - *pStripesSoFar;
+
+        do
+        {
+            kernels.pfnAccumulate(pAcc, pInput, pStripeSecret, stripesThisIter);
+            kernels.pfnScramble(pAcc, pSecret + SecretLimit);
+
+            pInput        += stripesThisIter * StripeLength;
+            numStripes    -= stripesThisIter;
+            stripesThisIter = StripesPerBlock;
+            pStripeSecret   = pSecret;
+        }
+        while (numStripes >= StripesPerBlock);
+
+        *pStripesSoFar = 0;
+    }
+
+    if (numStripes > 0)
+    {
+        kernels.pfnAccumulate(pAcc, pInput, pStripeSecret, numStripes);
+        pInput         += numStripes * StripeLength;
+        *pStripesSoFar += uint32(numStripes);
+    }
+
+    return pInput;
+}
+
+// =====================================================================================================================
+const uint8* XxHash128::GetSecret() const
+{
+    return (m_seed != 0) ? m_secret : DefaultSecret;
+}
+
+// =====================================================================================================================
+void XxHash128::Initialize(
+    uint64 seed)
+{
+    memcpy(m_acc, InitialAcc, sizeof(m_acc));
+
+    m_bufferedSize = 0;
+    m_stripesSoFar = 0;
+    m_totalLength  = 0;
+    m_seed         = seed;
+
+    if (seed != 0)
+    {
+        InitSecretFromSeed(m_secret, seed);
+    }
+}
+
+// =====================================================================================================================
+// Input is gathered in m_buffer until more than BufferSize bytes are available; whole stripes are then consumed
+// straight from the caller's memory.  At least one byte is always left buffered so that Finalize() can treat the
+// final stripe specially.
+void XxHash128::Update(
+    const uint8* pBuffer,
+    uint64       length)
+{
+    PAL_ASSERT((pBuffer != nullptr) || (length == 0));
+
+    if (length > 0)
+    {
+        const uint8*const pEnd    = pBuffer + length;
+        const uint8*const pSecret = GetSecret();
+
+        m_totalLength += length;
+
+        if (length <= (BufferSize - m_bufferedSize))
+        {
+            memcpy(m_buffer + m_bufferedSize, pBuffer, size_t(length));
+            m_bufferedSize += uint32(length);
+        }
+        else
+        {
+            if (m_bufferedSize > 0)
+            {
+                const size_t loadSize = BufferSize - m_bufferedSize;
+
+                memcpy(m_buffer + m_bufferedSize, pBuffer, loadSize);
+                pBuffer += loadSize;
+
+                ConsumeStripes(m_acc, &m_stripesSoFar, m_buffer, BufferStripes, pSecret);
+                m_bufferedSize = 0;
+            }
+
+            if (size_t(pEnd - pBuffer) > BufferSize)
+            {
+                const size_t numStripes = size_t(pEnd - 1 - pBuffer) / StripeLength;
+
+                pBuffer = ConsumeStripes(m_acc, &m_stripesSoFar, pBuffer, numStripes, pSecret);
+
+                // Keep the last consumed stripe in case the final stripe needs to reach back into it.
+                memcpy(m_buffer + BufferSize - StripeLength, pBuffer - StripeLength, StripeLength);
+            }
+
+            memcpy(m_buffer, pBuffer, size_t(pEnd - pBuffer));
+            m_bufferedSize = uint32(pEnd - pBuffer);
+        }
+    }
+}
+
+// =====================================================================================================================
+void XxHash128::Finalize(
+    uint8* pHash
+    ) const
+{
+    Hash128Value hash;
+
+    if (m_totalLength > MidSizeMax)
+    {
+        const uint8*const pSecret = GetSecret();
+
+        uint64 acc[8];
+        memcpy(acc, m_acc, sizeof(acc));
+
+        uint8        lastStripe[StripeLength];
+        const uint8* pLastStripe = nullptr;
+
+        if (m_bufferedSize >= StripeLength)
+        {
+            uint32 stripesSoFar = m_stripesSoFar;
+
+            ConsumeStripes(acc, &stripesSoFar, m_buffer, (m_bufferedSize - 1) / StripeLength, pSecret);
+            pLastStripe = m_buffer + m_bufferedSize - StripeLength;
+        }
+        else
+        {
+            // The final stripe straddles the previously consumed data kept at the end of the buffer.
+            const size_t catchupSize = StripeLength - m_bufferedSize;
+
+            memcpy(lastStripe, m_buffer + BufferSize - catchupSize, catchupSize);
+            memcpy(lastStripe + catchupSize, m_buffer, m_bufferedSize);
+            pLastStripe = lastStripe;
+        }
+
+        Accumulate512Scalar(acc, pLastStripe, pSecret + SecretLimit - SecretLastAccStart);
+
+        hash = MergeLong(acc, pSecret, m_totalLength);
+    }
+    else
+    {
+        hash = HashShort(m_buffer, size_t(m_totalLength), m_seed);
+    }
+
+    WriteHash(hash, pHash);
+}
+
+// =====================================================================================================================
+void XxHash128::Hash(
+    const uint8* pBuffer,
+    uint64       length,
+    uint8*       pHash,
+    uint64       seed)
+{
+    PAL_ASSERT((pBuffer != nullptr) || (length == 0));
+
+    static const uint8 Empty[1] = {};
+
+    Hash128Value hash;
+
+    if (length <= MidSizeMax)
+    {
+        hash = HashShort((pBuffer != nullptr) ? pBuffer : Empty, size_t(length), seed);
+    }
+    else if (seed == 0)
+    {
+        hash = HashLong(pBuffer, size_t(length), DefaultSecret);
+    }
+    else
+    {
+        uint8 secret[SecretSize];
+        InitSecretFromSeed(secret, seed);
+
+        hash = HashLong(pBuffer, size_t(length), secret);
+    }
+
+    WriteHash(hash, pHash);
+}
+
+} // Util
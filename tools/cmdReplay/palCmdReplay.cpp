@@ -0,0 +1,196 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+// palCmdReplay replays a command capture recorded with the CmdCaptureEnable setting on a null device and reports how
+// long PAL spent rebuilding and submitting the captured command buffers. Because the null device never touches hardware
+// this can be used as a reproducible benchmark of PAL's CPU-side submission path on machines without a GPU.
+//
+// Usage: palCmdReplay <capture file> [-iterations <count>] [-gpu <null device name>]
+
+#include "core/cmdCapture.h"
+#include "core/device.h"
+#include "palLib.h"
+#include "palPlatform.h"
+#include "palSysUtil.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace Pal;
+
+// =====================================================================================================================
+// Picks the null device named by the user, or the first null device PAL supports if no name was given.
+static Result SelectNullGpu(
+    const char* pGpuName,
+    NullGpuId*  pNullGpuId)
+{
+    NullGpuInfo nullGpus[static_cast<uint32>(NullGpuId::Max)] = {};
+    uint32      nullGpuCount = static_cast<uint32>(NullGpuId::Max);
+    Result      result       = EnumerateNullDevices(&nullGpuCount, &nullGpus[0]);
+
+    if (result == Result::Success)
+    {
+        result = Result::NotFound;
+
+        for (uint32 idx = 0; idx < nullGpuCount; ++idx)
+        {
+            if ((pGpuName == nullptr) || (strcmp(pGpuName, nullGpus[idx].pGpuName) == 0))
+            {
+                *pNullGpuId = nullGpus[idx].nullGpuId;
+                result      = Result::Success;
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Brings up a null device with one queue of every gfxip engine type and replays the capture on it.
+static Result ReplayCapture(
+    IPlatform*             pPlatform,
+    const char*            pFilename,
+    uint32                 iterations,
+    CmdCaptureReplayStats* pStats)
+{
+    IDevice* pDevices[MaxDevices] = {};
+    uint32   deviceCount          = 0;
+    Result   result               = pPlatform->EnumerateDevices(&deviceCount, pDevices);
+
+    if ((result == Result::Success) && (deviceCount == 0))
+    {
+        result = Result::ErrorUnavailable;
+    }
+
+    if (result == Result::Success)
+    {
+        result = pDevices[0]->CommitSettingsAndInit();
+    }
+
+    if (result == Result::Success)
+    {
+        DeviceFinalizeInfo finalizeInfo = {};
+        finalizeInfo.requestedEngineCounts[EngineTypeUniversal].engines = 1;
+        finalizeInfo.requestedEngineCounts[EngineTypeCompute].engines   = 1;
+        finalizeInfo.requestedEngineCounts[EngineTypeDma].engines       = 1;
+
+        result = pDevices[0]->Finalize(finalizeInfo);
+    }
+
+    if (result == Result::Success)
+    {
+        // The replayer needs PAL's internal device, so PAL's layers must not be enabled in the settings used here.
+        CmdCaptureReplayer replayer(static_cast<Device*>(pDevices[0]));
+
+        result = replayer.Replay(pFilename, iterations, pStats);
+    }
+
+    for (uint32 idx = 0; idx < deviceCount; ++idx)
+    {
+        pDevices[idx]->Cleanup();
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    const char* pFilename  = nullptr;
+    const char* pGpuName   = nullptr;
+    uint32      iterations = 1;
+
+    for (int arg = 1; arg < argc; ++arg)
+    {
+        if ((strcmp(argv[arg], "-iterations") == 0) && ((arg + 1) < argc))
+        {
+            iterations = static_cast<uint32>(strtoul(argv[++arg], nullptr, 0));
+        }
+        else if ((strcmp(argv[arg], "-gpu") == 0) && ((arg + 1) < argc))
+        {
+            pGpuName = argv[++arg];
+        }
+        else
+        {
+            pFilename = argv[arg];
+        }
+    }
+
+    if ((pFilename == nullptr) || (iterations == 0))
+    {
+        fprintf(stderr, "Usage: %s <capture file> [-iterations <count>] [-gpu <null device name>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    PlatformCreateInfo createInfo = {};
+    createInfo.flags.createNullDevice = 1;
+
+    Result result = SelectNullGpu(pGpuName, &createInfo.nullGpuId);
+
+    void*      pPlatformMem = nullptr;
+    IPlatform* pPlatform    = nullptr;
+
+    if (result == Result::Success)
+    {
+        pPlatformMem = malloc(GetPlatformSize());
+        result       = (pPlatformMem != nullptr) ? CreatePlatform(createInfo, pPlatformMem, &pPlatform)
+                                                 : Result::ErrorOutOfMemory;
+    }
+
+    CmdCaptureReplayStats stats = {};
+
+    if (result == Result::Success)
+    {
+        result = ReplayCapture(pPlatform, pFilename, iterations, &stats);
+        pPlatform->Destroy();
+    }
+
+    free(pPlatformMem);
+
+    if (result == Result::Success)
+    {
+        const double seconds = static_cast<double>(stats.elapsedTicks) / static_cast<double>(Util::GetPerfFrequency());
+
+        printf("Replayed %llu submits (%llu command buffers, %llu uploaded) in %.3f ms\n",
+               static_cast<unsigned long long>(stats.submitCount),
+               static_cast<unsigned long long>(stats.cmdBufferCount),
+               static_cast<unsigned long long>(stats.uploadedCount),
+               seconds * 1000.0);
+        printf("Average submit: %.3f us, commands: %.2f MB/s, skipped streams: %llu\n",
+               (stats.submitCount > 0) ? (seconds * 1000000.0 / static_cast<double>(stats.submitCount)) : 0.0,
+               (seconds > 0.0) ? (static_cast<double>(stats.replayedBytes) / (seconds * 1024.0 * 1024.0)) : 0.0,
+               static_cast<unsigned long long>(stats.skippedStreams));
+    }
+    else
+    {
+        fprintf(stderr, "Replay of '%s' failed with result %d\n", pFilename, static_cast<int>(result));
+    }
+
+    return (result == Result::Success) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
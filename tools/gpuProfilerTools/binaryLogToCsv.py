@@ -0,0 +1,255 @@
+##
+ #######################################################################################################################
+ #
+ #  Copyright (c) 2021 Advanced Micro Devices, Inc. All Rights Reserved.
+ #
+ #  Permission is hereby granted, free of charge, to any person obtaining a copy
+ #  of this software and associated documentation files (the "Software"), to deal
+ #  in the Software without restriction, including without limitation the rights
+ #  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ #  copies of the Software, and to permit persons to whom the Software is
+ #  furnished to do so, subject to the following conditions:
+ #
+ #  The above copyright notice and this permission notice shall be included in all
+ #  copies or substantial portions of the Software.
+ #
+ #  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ #  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ #  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ #  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ #  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ #  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ #  SOFTWARE.
+ #
+ #######################################################################################################################
+
+# Converts the binary .pgl logs written by the GPU profiler when the GpuProfilerBinaryLog setting is enabled into the
+# same .csv files the profiler writes when it is disabled.  The record layout is documented in
+# src/core/layers/gpuProfiler/gpuProfilerLogWriter.h.
+#
+# Usage: binaryLogToCsv.py <log dir or .pgl file>... [-o <output dir>]
+#
+# By default the .csv files are written next to the .pgl file they came from.
+
+import glob
+import os
+import struct
+import sys
+
+BinaryLogMagic            = 0x424C4750
+BinaryLogVersion          = 1
+BinaryLogNumPipelineStats = 14
+
+# BinaryLogRecordType
+RecordFileHeader = 0
+RecordFrameStart = 1
+RecordQueueCall  = 2
+RecordCmdBufCall = 3
+RecordFrame      = 4
+
+# BinaryLogRecordFlags
+FlagDraw          = 0x0001
+FlagDispatch      = 0x0002
+FlagTaskMesh      = 0x0004
+FlagComment       = 0x0008
+FlagNested        = 0x0010
+FlagTimestamps    = 0x0020
+FlagHideElapsed   = 0x0040
+FlagPipelineStats = 0x0080
+FlagPerfCounters  = 0x0100
+
+# BinaryLogFileFlags
+FileFullPipelineHash = 0x1
+FileThreadTrace      = 0x2
+FilePipelineStats    = 0x4
+
+RecordHeader = struct.Struct("<HHI")
+FileHeader   = struct.Struct("<IIQ8I8s")
+
+class Reader:
+    def __init__(self, data, offset):
+        self.data   = data
+        self.offset = offset
+
+    def unpack(self, fmt):
+        values = struct.unpack_from("<" + fmt, self.data, self.offset)
+        self.offset += struct.calcsize("<" + fmt)
+        return values
+
+    def string(self):
+        (length,) = self.unpack("I")
+        value = self.data[self.offset:self.offset + length].decode("utf-8", "replace")
+        self.offset += length
+        return value
+
+class Converter:
+    def __init__(self, outDir, frameLogs):
+        self.outDir    = outDir
+        self.frameLogs = frameLogs  # frameLog.csv files are shared by every queue, like in the profiler.
+        self.csv       = None
+
+    def close(self):
+        if self.csv:
+            self.csv.close()
+            self.csv = None
+
+    def readHeader(self, reader):
+        (magic, version, self.freq, self.deviceId, self.engineIndex, self.queueId, self.fileFlags,
+         numPerfCounters, self.numReported, numQueueCalls, numCmdBufCalls, engineName) = reader.unpack("IIQ8I8s")
+        if (magic != BinaryLogMagic) or (version != BinaryLogVersion):
+            raise ValueError("not a version %d GPU profiler binary log" % BinaryLogVersion)
+        self.engineName     = engineName.split(b"\0")[0].decode("ascii")
+        self.perfCounters   = [reader.string() for _ in range(numPerfCounters)]
+        self.queueCalls     = [reader.string() for _ in range(numQueueCalls)]
+        self.cmdBufCalls    = [reader.string() for _ in range(numCmdBufCalls)]
+        self.pipelineStats  = (self.fileFlags & FilePipelineStats) != 0
+        self.threadTrace    = (self.fileFlags & FileThreadTrace) != 0
+        self.fullHash       = (self.fileFlags & FileFullPipelineHash) != 0
+
+    def counterHeaders(self):
+        text = "".join("%s," % name for name in self.perfCounters)
+        if self.threadTrace:
+            text += "ThreadTraceId,"
+        return text
+
+    def openFrame(self, frameId):
+        self.close()
+        path = os.path.join(self.outDir, "frame%06uDev%uEng%s%u-%02u.csv" %
+                            (frameId, self.deviceId, self.engineName, self.engineIndex, self.queueId))
+        self.csv = open(path, "w")
+        self.csv.write("Queue Call,CmdBuffer Index,CmdBuffer Call,SubQueueIdx,Start Clock,End Clock,Time (us) "
+                       "[Frequency: %u],PipelineHash,CompilerHash,VS/CS/TS,HS,DS,MS/GS,PS,"
+                       "Verts/ThreadGroups,Instances,Comments," % self.freq)
+        if self.pipelineStats:
+            self.csv.write("IaVertices,IaPrimitives,VsInvocations,GsInvocations,GsPrimitives,"
+                           "CInvocations,CPrimitives,PsInvocations,HsInvocations,DsInvocations,"
+                           "CsInvocations,TsInvocations,MsInvocations,MsPrimitives,")
+        self.csv.write(self.counterHeaders() + "\n")
+
+    def timestamps(self, reader, flags):
+        if flags & FlagTimestamps:
+            start, end = reader.unpack("QQ")
+            text = "%u,%u," % (start, end)
+            if flags & FlagHideElapsed:
+                return text + ","
+            return text + "%.2f," % (1000000.0 * (end - start) / self.freq)
+        return ",,,"
+
+    def perfCounterColumns(self, reader, flags):
+        if flags & FlagPerfCounters:
+            return "".join("%u," % value for value in reader.unpack("%dQ" % self.numReported))
+        return "," * self.numReported
+
+    def cmdBufCall(self, reader, flags):
+        frameId, cmdBufIdx, callId, subQueueIdx = reader.unpack("4I")
+        prefix = "- " if (flags & FlagNested) else ""
+        row    = ",%d,%s%s,%d," % (cmdBufIdx, prefix, self.cmdBufCalls[callId], subQueueIdx)
+
+        pipeline = None
+        counts   = None
+        if flags & (FlagDraw | FlagDispatch | FlagTaskMesh):
+            pipeline = reader.unpack("13Q")
+            counts   = reader.unpack("2I")
+        comment = reader.string() if (flags & FlagComment) else None
+
+        row += self.timestamps(reader, flags)
+
+        if pipeline:
+            shader = lambda i: "0x%016x%016x" % (pipeline[3 + 2 * i], pipeline[4 + 2 * i])
+            row += "0x%016x,0x%016x" % (pipeline[0], pipeline[1])
+            if self.fullHash:
+                row += "-0x%016x" % pipeline[2]
+            if flags & FlagDraw:
+                row += ",%s,%s,%s,%s,%s,%u,%u,," % (shader(0), shader(1), shader(2), shader(3), shader(4),
+                                                     counts[0], counts[1])
+            elif flags & FlagDispatch:
+                row += ",%s,,,,,%u,,," % (shader(0), counts[0])
+            else:
+                row += ",%s,,,%s,%s,%u,,," % (shader(0), shader(3), shader(4), counts[0])
+        elif comment is not None:
+            row += ",,,,,,,,,\"%s\"," % comment
+        else:
+            row += ",,,,,,,,,,"
+
+        if flags & FlagPipelineStats:
+            row += "".join("%u," % value for value in reader.unpack("%dQ" % BinaryLogNumPipelineStats))
+        elif self.pipelineStats:
+            row += "," * BinaryLogNumPipelineStats
+
+        row += self.perfCounterColumns(reader, flags)
+        row += reader.string()
+        self.csv.write(row + "\n")
+
+    def frame(self, reader, flags):
+        (frameId,) = reader.unpack("I")
+        path = os.path.join(self.outDir, "frameLog.csv")
+        if path not in self.frameLogs:
+            frameLog = open(path, "w")
+            frameLog.write("Frame #,Start Clock,End Clock,Time (us) [Frequency: %u]," % self.freq)
+            frameLog.write(self.counterHeaders() + "\n")
+            self.frameLogs[path] = frameLog
+        row  = "%u," % frameId
+        row += self.timestamps(reader, flags)
+        row += self.perfCounterColumns(reader, flags)
+        row += reader.string()
+        self.frameLogs[path].write(row + "\n")
+
+    def convert(self, data):
+        offset = 0
+        while offset + RecordHeader.size <= len(data):
+            recordType, flags, size = RecordHeader.unpack_from(data, offset)
+            if (size < RecordHeader.size) or (offset + size > len(data)):
+                # The application may have been killed while the writer thread was in the middle of a record.
+                print("Warning: truncated record at offset %u" % offset)
+                break
+            reader = Reader(data, offset + RecordHeader.size)
+            if recordType == RecordFileHeader:
+                self.readHeader(reader)
+            elif recordType == RecordFrameStart:
+                (frameId,) = reader.unpack("I")
+                self.openFrame(frameId)
+            elif recordType == RecordQueueCall:
+                frameId, callId = reader.unpack("2I")
+                self.csv.write("%s,,,,,,,,,,,,,,,,," % self.queueCalls[callId])
+                if self.pipelineStats:
+                    self.csv.write("," * BinaryLogNumPipelineStats)
+                self.csv.write("," * self.numReported + "\n")
+            elif recordType == RecordCmdBufCall:
+                self.cmdBufCall(reader, flags)
+            elif recordType == RecordFrame:
+                self.frame(reader, flags)
+            offset += size
+        self.close()
+
+def main(args):
+    outDir = None
+    if "-o" in args:
+        index  = args.index("-o")
+        outDir = args[index + 1]
+        del args[index:index + 2]
+
+    inputs = []
+    for arg in args:
+        if os.path.isdir(arg):
+            inputs += sorted(glob.glob(os.path.join(arg, "*.pgl")))
+        else:
+            inputs.append(arg)
+
+    if not inputs:
+        print("Usage: binaryLogToCsv.py <log dir or .pgl file>... [-o <output dir>]")
+        return 1
+
+    frameLogs = {}
+    for path in inputs:
+        with open(path, "rb") as logFile:
+            data = logFile.read()
+        Converter(outDir if outDir else os.path.dirname(os.path.abspath(path)), frameLogs).convert(data)
+        print("Converted " + path)
+
+    for frameLog in frameLogs.values():
+        frameLog.close()
+
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))